@@ -40,6 +40,7 @@
 #include "bin/elog.h"
 #include "lib/string.h"
 #include "PageCompression.h"
+#include "replication/incrbackup.h"
 
 
 #ifdef ENABLE_MOT
@@ -77,6 +78,8 @@ bool includewal = true;
 bool streamwal = true;
 bool fastcheckpoint = false;
 logstreamer_param *g_childParam = NULL;
+static char *incrementalRefDir = NULL; /* reference backup of an incremental backup */
+static int prefetchDepth = 0;
 
 extern char **tblspaceDirectory;
 extern int tblspaceCount;
@@ -116,6 +119,8 @@ static void progress_report(int tablespacenum, const char* filename);
 
 static void ReceiveTarFile(PGconn *conn, PGresult *res, int rownum);
 static void ReceiveAndUnpackTarFile(PGconn *conn, PGresult *res, int rownum);
+static bool RefSegmentExtended(const char *refPath);
+static void MergeIncrementalFile(const char *incrPath, const char *refPath, int filemode);
 static void BaseBackup(void);
 static void backup_dw_file(const char *target_dir);
 
@@ -245,10 +250,15 @@ static void usage(void)
              "                         include required WAL files with specified method\n"));
     printf(_("  -z, --gzip             compress tar output\n"));
     printf(_("  -Z, --compress=0-9     compress tar output with given compression level\n"));
+    printf(_("      --incremental=REFDIR\n"
+             "                         only receive blocks changed since the plain backup in REFDIR\n"));
     printf(_("\nGeneral options:\n"));
     printf(_("  -c, --checkpoint=fast|spread\n"
              "                         set fast or spread checkpointing\n"));
     printf(_("  -l, --label=LABEL      set backup label\n"));
+    printf(_("      --prefetch-depth=NUM\n"
+             "                         number of read-ahead windows the server keeps in flight (1 .. %d)\n"),
+        MAX_BACKUP_PREFETCH_DEPTH);
     printf(_("  -P, --progress         show progress information\n"));
     printf(_("  -v, --verbose          output verbose messages\n"));
     printf(_("  -V, --version          output version information, then exit\n"));
@@ -864,9 +874,24 @@ static void ReceiveAndUnpackTarFile(PGconn *conn, PGresult *res, int rownum)
     char* copybuf = NULL;
     FILE* file = NULL;
     const char* get_value = NULL;
+    char ref_path[MAXPGPATH] = {0};
+    char ref_filename[MAXPGPATH] = {0};
+    int current_filemode = 0;
 
     errno_t errorno = EOK;
 
+    /* where the reference backup keeps the files of this tablespace */
+    if (incrementalRefDir != NULL) {
+        if (basetablespace) {
+            errorno = strncpy_s(ref_path, MAXPGPATH, incrementalRefDir, strlen(incrementalRefDir));
+            securec_check_c(errorno, "\0", "\0");
+        } else {
+            errorno = snprintf_s(ref_path, MAXPGPATH, MAXPGPATH - 1, "%s/pg_tblspc/%s", incrementalRefDir,
+                PQgetvalue(res, rownum, 0));
+            securec_check_ss_c(errorno, "\0", "\0");
+        }
+    }
+
     if (basetablespace) {
         errorno = strncpy_s(current_path, MAXPGPATH, basedir, strlen(basedir));
         securec_check_c(errorno, "", "");
@@ -966,6 +991,14 @@ static void ReceiveAndUnpackTarFile(PGconn *conn, PGresult *res, int rownum)
             }
             errorno = snprintf_s(filename, sizeof(filename), sizeof(filename) - 1, "%s/%s", current_path, copybuf);
             securec_check_ss_c(errorno, "", "");
+            if (incrementalRefDir != NULL && pg_str_endswith(copybuf, INCR_BACKUP_SUFFIX)) {
+                errorno = snprintf_s(ref_filename, sizeof(ref_filename), sizeof(ref_filename) - 1, "%s/%.*s",
+                    ref_path, (int)(strlen(copybuf) - strlen(INCR_BACKUP_SUFFIX)), copybuf);
+                securec_check_ss_c(errorno, "", "");
+            } else {
+                ref_filename[0] = '\0';
+            }
+            current_filemode = filemode;
 
             if (filename[strlen(filename) - 1] == '/') {
                 /*
@@ -1087,6 +1120,9 @@ static void ReceiveAndUnpackTarFile(PGconn *conn, PGresult *res, int rownum)
                 fclose(file);
                 file = NULL;
                 totaldone += (uint64)r;
+                if (ref_filename[0] != '\0') {
+                    MergeIncrementalFile(filename, ref_filename, current_filemode);
+                }
                 continue;
             }
 
@@ -1112,6 +1148,9 @@ static void ReceiveAndUnpackTarFile(PGconn *conn, PGresult *res, int rownum)
                 PunchHoleForCompressedFile(file, filename);
                 fclose(file);
                 file = NULL;
+                if (ref_filename[0] != '\0') {
+                    MergeIncrementalFile(filename, ref_filename, current_filemode);
+                }
                 continue;
             }
         } /* continuing data in existing file */
@@ -1130,6 +1169,182 @@ static void ReceiveAndUnpackTarFile(PGconn *conn, PGresult *res, int rownum)
     }
 }
 
+/*
+ * Whether a relation segment missing from the reference backup was added by
+ * the relation growing past its previous segment, which the reference holds
+ * in full. Any other missing segment means the reference does not match.
+ */
+static bool RefSegmentExtended(const char *refPath)
+{
+    char prevPath[MAXPGPATH] = {0};
+    struct stat st;
+    const char *dot = strrchr(refPath, '.');
+    const char *slash = strrchr(refPath, '/');
+    char *endPtr = NULL;
+    errno_t rc = EOK;
+
+    if (dot == NULL || (slash != NULL && dot < slash) || !isdigit((unsigned char)dot[1])) {
+        return false;
+    }
+    unsigned long segNo = strtoul(dot + 1, &endPtr, 10);
+    if (*endPtr != '\0' || segNo == 0) {
+        return false;
+    }
+    if (segNo == 1) {
+        rc = snprintf_s(prevPath, sizeof(prevPath), sizeof(prevPath) - 1, "%.*s", (int)(dot - refPath), refPath);
+    } else {
+        rc = snprintf_s(prevPath, sizeof(prevPath), sizeof(prevPath) - 1, "%.*s.%lu", (int)(dot - refPath), refPath,
+            segNo - 1);
+    }
+    securec_check_ss_c(rc, "", "");
+
+    return stat(prevPath, &st) == 0 && st.st_size == (off_t)RELSEG_SIZE * BLCKSZ;
+}
+
+/*
+ * Rebuild a relation segment received as "<segment>.incr" from its copy in
+ * the reference backup, see replication/incrbackup.h.
+ */
+static void MergeIncrementalFile(const char *incrPath, const char *refPath, int filemode)
+{
+    char target[MAXPGPATH] = {0};
+    char page[BLCKSZ];
+    IncrBackupFileHeader header;
+    uint32 *blocks = NULL;
+    FILE *incr = NULL;
+    FILE *ref = NULL;
+    FILE *out = NULL;
+    uint32 next = 0;
+    bool refEnded = false;
+    errno_t rc = EOK;
+
+    rc = snprintf_s(target, sizeof(target), sizeof(target) - 1, "%.*s",
+        (int)(strlen(incrPath) - strlen(INCR_BACKUP_SUFFIX)), incrPath);
+    securec_check_ss_c(rc, "", "");
+
+    incr = fopen(incrPath, "rb");
+    if (incr == NULL) {
+        pg_log(stderr, _("%s: could not open file \"%s\": %s\n"), progname, incrPath, strerror(errno));
+        disconnect_and_exit(1);
+    }
+    if (fread(&header, sizeof(header), 1, incr) != 1 || header.magic != INCR_BACKUP_MAGIC ||
+        header.nblocks > header.truncateBlock) {
+        pg_log(stderr, _("%s: invalid incremental file \"%s\"\n"), progname, incrPath);
+        fclose(incr);
+        disconnect_and_exit(1);
+    }
+    if (header.nblocks > 0) {
+        blocks = (uint32 *)xmalloc(header.nblocks * sizeof(uint32));
+        if (fread(blocks, sizeof(uint32), header.nblocks, incr) != header.nblocks) {
+            pg_log(stderr, _("%s: invalid incremental file \"%s\"\n"), progname, incrPath);
+            fclose(incr);
+            disconnect_and_exit(1);
+        }
+    }
+
+    /*
+     * The server sends every file of a relation, database or tablespace created
+     * after the reference whole, so the reference must have this segment unless
+     * the relation has grown into it since.
+     */
+    ref = fopen(refPath, "rb");
+    if (ref == NULL) {
+        int saveErrno = errno;
+        if (saveErrno != ENOENT || !RefSegmentExtended(refPath)) {
+            pg_log(stderr, _("%s: could not open reference file \"%s\": %s\n"), progname, refPath,
+                strerror(saveErrno));
+            fclose(incr);
+            disconnect_and_exit(1);
+        }
+    }
+    out = fopen(target, "wb");
+    if (out == NULL) {
+        pg_log(stderr, _("%s: could not create file \"%s\": %s\n"), progname, target, strerror(errno));
+        disconnect_and_exit(1);
+    }
+
+    /* both inputs are in block order, so this is a single sequential pass */
+    for (uint32 blkno = 0; blkno < header.truncateBlock; blkno++) {
+        bool changed = (next < header.nblocks && blocks[next] == blkno);
+        bool fromRef = false;
+
+        if (ref != NULL && !refEnded) {
+            fromRef = (fread(page, 1, BLCKSZ, ref) == BLCKSZ);
+            refEnded = !fromRef;
+        }
+        if (changed) {
+            if (fread(page, 1, BLCKSZ, incr) != BLCKSZ) {
+                pg_log(stderr, _("%s: invalid incremental file \"%s\"\n"), progname, incrPath);
+                disconnect_and_exit(1);
+            }
+            next++;
+        } else if (!fromRef) {
+            /* extended after the reference but never WAL-logged, an empty page is fine */
+            rc = memset_s(page, BLCKSZ, 0, BLCKSZ);
+            securec_check_c(rc, "", "");
+        }
+        if (fwrite(page, BLCKSZ, 1, out) != 1) {
+            pg_log(stderr, _("%s: could not write to file \"%s\": %s\n"), progname, target, strerror(errno));
+            disconnect_and_exit(1);
+        }
+    }
+
+    if (ref != NULL) {
+        fclose(ref);
+    }
+    fclose(incr);
+    if (fclose(out) != 0) {
+        pg_log(stderr, _("%s: could not write to file \"%s\": %s\n"), progname, target, strerror(errno));
+        disconnect_and_exit(1);
+    }
+#ifndef WIN32
+    if (chmod(target, (mode_t)filemode))
+        pg_log(stderr, _("%s: could not set permissions on file \"%s\": %s\n"), progname, target, strerror(errno));
+#endif
+    if (unlink(incrPath) != 0) {
+        pg_log(stderr, _("%s: could not remove file \"%s\": %s\n"), progname, incrPath, strerror(errno));
+        disconnect_and_exit(1);
+    }
+    GS_FREE(blocks);
+}
+
+/*
+ * Read the start point of the plain backup in incrementalRefDir from its
+ * backup_label. The reference must not have been started: once it has
+ * replayed WAL its pages no longer match that start point.
+ */
+static void GetReferenceStartPoint(char *startpoint, size_t len)
+{
+    char labelpath[MAXPGPATH] = {0};
+    char line[MAXPGPATH];
+    uint32 hi = 0;
+    uint32 lo = 0;
+    bool found = false;
+    errno_t rc = EOK;
+
+    rc = snprintf_s(labelpath, sizeof(labelpath), sizeof(labelpath) - 1, "%s/backup_label", incrementalRefDir);
+    securec_check_ss_c(rc, "", "");
+    FILE *fp = fopen(labelpath, "r");
+    if (fp == NULL) {
+        pg_log(stderr, _("%s: could not open \"%s\" of the reference backup: %s\n"), progname, labelpath,
+            strerror(errno));
+        exit(1);
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (sscanf_s(line, "START WAL LOCATION: %X/%X", &hi, &lo) == 2) {
+            found = true;
+            break;
+        }
+    }
+    fclose(fp);
+    if (!found) {
+        pg_log(stderr, _("%s: invalid backup_label in reference backup \"%s\"\n"), progname, incrementalRefDir);
+        exit(1);
+    }
+    rc = snprintf_s(startpoint, len, len - 1, "INCREMENTAL '%X/%X'", hi, lo);
+    securec_check_ss_c(rc, "", "");
+}
+
 static void BaseBackup(void)
 {
     PGresult *res = NULL;
@@ -1141,6 +1356,8 @@ static void BaseBackup(void)
     int i = 0;
     char xlogstart[64];
     char xlogend[64];
+    char incremental[64] = {0};
+    char prefetch[32] = {0};
     errno_t rc = EOK;
     char *get_value = NULL;
 
@@ -1181,10 +1398,17 @@ static void BaseBackup(void)
      * Start the actual backup
      */
     PQescapeStringConn(conn, escaped_label, label, sizeof(escaped_label), &i);
+    if (incrementalRefDir != NULL) {
+        GetReferenceStartPoint(incremental, sizeof(incremental));
+    }
+    if (prefetchDepth > 0) {
+        rc = snprintf_s(prefetch, sizeof(prefetch), sizeof(prefetch) - 1, "PREFETCH_DEPTH %d", prefetchDepth);
+        securec_check_ss_c(rc, "", "");
+    }
     rc = snprintf_s(current_path, sizeof(current_path), sizeof(current_path) - 1,
-        "BASE_BACKUP LABEL '%s' %s %s %s %s %s", escaped_label, showprogress ? "PROGRESS" : "",
+        "BASE_BACKUP LABEL '%s' %s %s %s %s %s %s %s", escaped_label, showprogress ? "PROGRESS" : "",
         includewal && !streamwal ? "WAL" : "", fastcheckpoint ? "FAST" : "", includewal ? "NOWAIT" : "",
-        format == 't' ? "TABLESPACE_MAP" : "");
+        format == 't' ? "TABLESPACE_MAP" : "", incremental, prefetch);
     securec_check_ss_c(rc, "", "");
 
     if (PQsendQuery(conn, current_path) == 0) {
@@ -1918,6 +2142,8 @@ static int GsBaseBackup(int argc, char** argv)
                                            {"rw-timeout", required_argument, NULL, 't'},
                                            {"verbose", no_argument, NULL, 'v'},
                                            {"progress", no_argument, NULL, 'P'},
+                                           {"incremental", required_argument, NULL, 1},
+                                           {"prefetch-depth", required_argument, NULL, 2},
                                            {NULL, 0, NULL, 0}};
     int c = 0, option_index = 0;
     GS_FREE(progname);
@@ -2102,6 +2328,25 @@ static int GsBaseBackup(int argc, char** argv)
             case 'P':
                 showprogress = true;
                 break;
+            case 1: {
+                GS_FREE(incrementalRefDir);
+                check_env_value_c(optarg);
+                char realDir[PATH_MAX] = {0};
+                if (realpath(optarg, realDir) == nullptr) {
+                    pg_log(stderr, _("%s: realpath dir \"%s\" failed: %m\n"), progname, optarg);
+                    exit(1);
+                }
+                incrementalRefDir = xstrdup(realDir);
+                break;
+            }
+            case 2:
+                prefetchDepth = atoi(optarg);
+                if (prefetchDepth < 1 || prefetchDepth > MAX_BACKUP_PREFETCH_DEPTH) {
+                    fprintf(stderr, _("%s: invalid prefetch depth \"%s\", must be in range 1 .. %d\n"), progname,
+                        optarg, MAX_BACKUP_PREFETCH_DEPTH);
+                    exit(1);
+                }
+                break;
             default:
 
                 /*
@@ -2155,6 +2400,12 @@ static int GsBaseBackup(int argc, char** argv)
         exit(1);
     }
 
+    if (format != 'p' && incrementalRefDir != NULL) {
+        fprintf(stderr, _("%s: incremental backups can only be taken in plain mode\n"), progname);
+        fprintf(stderr, _("Try \"%s --help\" for more information.\n"), progname);
+        exit(1);
+    }
+
     if (format != 'p' && streamwal) {
         fprintf(stderr, _("%s: wal streaming can only be used in plain mode\n"), progname);
         fprintf(stderr, _("Try \"%s --help\" for more information.\n"), progname);
@@ -2194,4 +2445,5 @@ static void free_basebackup()
     GS_FREE(dbhost);
     GS_FREE(dbport);
     GS_FREE(dbuser);
+    GS_FREE(incrementalRefDir);
 }
@@ -16,6 +16,7 @@
 #include "knl/knl_variable.h"
 
 #include <dirent.h>
+#include <float.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <sys/time.h>
@@ -24,6 +25,7 @@
 #include "streamutil.h"
 
 #include "access/xlog_internal.h"
+#include "catalog/pg_type.h"
 #include "common/fe_memutils.h"
 #include "getopt_long.h"
 #include "libpq/libpq-fe.h"
@@ -49,6 +51,7 @@ static bool do_drop_slot = false;
 static bool g_parallel_decode = false;
 static char g_decode_style = 'b';
 static bool g_batch_sending = false;
+static bool g_binary_send = false;
 static bool g_raw = false;
 
 /* filled pairwise with option, value. value may be NULL */
@@ -294,6 +297,80 @@ static inline void AppendSeperator(PQExpBuffer res, uint16 attr, uint16 maxAttr)
     }
 }
 
+/*
+ * Render a column value shipped in its type's binary send format (option binary-send). Common
+ * fixed-width and string types are converted here, anything else is printed in hex.
+ */
+static void ResolveBinaryValue(const char* data, uint32 dataLen, Oid typid, PQExpBuffer res)
+{
+    errno_t rc = 0;
+    switch (typid) {
+        case BOOLOID:
+            if (dataLen == sizeof(bool)) {
+                appendPQExpBufferStr(res, data[0] ? "t" : "f");
+                return;
+            }
+            break;
+        case INT2OID:
+            if (dataLen == sizeof(uint16)) {
+                uint16 val16 = 0;
+                rc = memcpy_s(&val16, sizeof(uint16), data, sizeof(uint16));
+                securec_check(rc, "\0", "\0");
+                appendPQExpBuffer(res, "%d", (int16)ntohs(val16));
+                return;
+            }
+            break;
+        case INT4OID:
+        case OIDOID:
+        case FLOAT4OID:
+            if (dataLen == sizeof(uint32)) {
+                uint32 val32 = 0;
+                rc = memcpy_s(&val32, sizeof(uint32), data, sizeof(uint32));
+                securec_check(rc, "\0", "\0");
+                val32 = ntohl(val32);
+                if (typid == INT4OID) {
+                    appendPQExpBuffer(res, "%d", (int32)val32);
+                } else if (typid == OIDOID) {
+                    appendPQExpBuffer(res, "%u", val32);
+                } else {
+                    float4 fval = 0;
+                    rc = memcpy_s(&fval, sizeof(float4), &val32, sizeof(uint32));
+                    securec_check(rc, "\0", "\0");
+                    appendPQExpBuffer(res, "%.*g", FLT_DIG, fval);
+                }
+                return;
+            }
+            break;
+        case INT8OID:
+        case FLOAT8OID:
+            if (dataLen == sizeof(uint64)) {
+                uint64 val64 = fe_recvint64(data);
+                if (typid == INT8OID) {
+                    appendPQExpBuffer(res, "%ld", (int64)val64);
+                } else {
+                    float8 dval = 0;
+                    rc = memcpy_s(&dval, sizeof(float8), &val64, sizeof(uint64));
+                    securec_check(rc, "\0", "\0");
+                    appendPQExpBuffer(res, "%.*g", DBL_DIG, dval);
+                }
+                return;
+            }
+            break;
+        case TEXTOID:
+        case VARCHAROID:
+        case BPCHAROID:
+        case NAMEOID:
+            appendBinaryPQExpBuffer(res, data, dataLen);
+            return;
+        default:
+            break;
+    }
+    appendPQExpBufferStr(res, "\\x");
+    for (uint32 i = 0; i < dataLen; i++) {
+        appendPQExpBuffer(res, "%02x", (unsigned char)data[i]);
+    }
+}
+
 /*
  * decode binary style tuple to text
  */
@@ -325,7 +402,11 @@ static void ResolveTuple(const char* stream, uint32* curpos, PQExpBuffer res, bo
             appendPQExpBufferStr(res, "\"\"");
         } else {
             appendPQExpBufferChar(res, '\"');
-            appendBinaryPQExpBuffer(res, stream + *curpos, dataLen);
+            if (g_binary_send) {
+                ResolveBinaryValue(stream + *curpos, dataLen, typid, res);
+            } else {
+                appendBinaryPQExpBuffer(res, stream + *curpos, dataLen);
+            }
             appendPQExpBufferChar(res, '\"');
             *curpos += dataLen;
         }
@@ -426,6 +507,37 @@ static void CommitToText(const char* stream, uint32 *curPos, PQExpBuffer res)
     }
 }
 
+/*
+ * decode binary style stream start/stop/commit/abort message to text
+ */
+static void StreamMessageToText(const char* stream, uint32 *curPos, PQExpBuffer res)
+{
+    char mtype = stream[*curPos];
+    *curPos += 1;
+    uint64 xid = fe_recvint64(&stream[*curPos]);
+    *curPos += sizeof(uint64);
+    if (mtype == 'S') {
+        appendPQExpBuffer(res, "STREAM START xid: %lu first_segment: %s", xid, stream[*curPos] ? "true" : "false");
+        *curPos += 1;
+    } else if (mtype == 'E') {
+        appendPQExpBuffer(res, "STREAM STOP xid: %lu", xid);
+    } else if (mtype == 'A') {
+        appendPQExpBuffer(res, "STREAM ABORT xid: %lu", xid);
+    } else {
+        uint64 csn = fe_recvint64(&stream[*curPos]);
+        *curPos += sizeof(uint64);
+        appendPQExpBuffer(res, "STREAM COMMIT xid: %lu CSN: %lu", xid, csn);
+        if (stream[*curPos] == 'T') {
+            *curPos += 1;
+            uint32 timeLen = ntohl(*(uint32 *)(&stream[*curPos]));
+            *curPos += sizeof(uint32);
+            appendPQExpBufferStr(res, " commit_time: ");
+            appendBinaryPQExpBuffer(res, &stream[*curPos], timeLen);
+            *curPos += timeLen;
+        }
+    }
+}
+
 /*
  * decode binary style log stream to text
  */
@@ -448,6 +560,8 @@ static void StreamToText(const char* stream, PQExpBuffer res)
         BeginToText(stream, &pos, res);
     } else if (stream[pos] == 'C') {
         CommitToText(stream, &pos, res);
+    } else if (stream[pos] == 'S' || stream[pos] == 'E' || stream[pos] == 'c' || stream[pos] == 'A') {
+        StreamMessageToText(stream, &pos, res);
     } else if (stream[pos] != 'P' && stream[pos] != 'F') {
         DMLToText(stream, &pos, res);
     }
@@ -836,6 +950,14 @@ static void CheckParallelDecoding(const char *data, const char *val)
     }
 }
 
+static void CheckBinarySend(const char *data, const char *val)
+{
+    if (strncmp(data, "binary-send", sizeof("binary-send")) == 0) {
+        g_binary_send = (val == NULL || pg_strcasecmp(val, "true") == 0 || pg_strcasecmp(val, "on") == 0 ||
+            pg_strcasecmp(val, "yes") == 0 || strcmp(val, "1") == 0);
+    }
+}
+
 static void CheckBatchSending(const char *data, const char *val)
 {
     if (strncmp(data, "sending-batch", sizeof("sending-batch")) == 0) {
@@ -953,6 +1075,7 @@ static int getOptions(const int argc, char* const* argv)
                 options[(noptions - 1) * 2 + 1] = val;
                 CheckParallelDecoding(data, val);
                 CheckBatchSending(data, val);
+                CheckBinarySend(data, val);
             }
 
             break;
@@ -3987,6 +3987,7 @@ CREATE OR REPLACE FUNCTION DBE_PERF.get_global_full_sql_by_timestamp
    OUT lock_wait_count bigint,
    OUT lock_wait_time bigint,
    OUT lock_max_count bigint,
+   OUT lock_fastpath_overflow_count bigint,
    OUT lwlock_count bigint,
    OUT lwlock_wait_count bigint,
    OUT lwlock_time bigint,
@@ -4054,6 +4055,7 @@ CREATE OR REPLACE FUNCTION DBE_PERF.get_global_full_sql_by_timestamp
           lock_wait_count := row_data.lock_wait_count;
           lock_wait_time := row_data.lock_wait_time;
           lock_max_count := row_data.lock_max_count;
+          lock_fastpath_overflow_count := row_data.lock_fastpath_overflow_count;
           lwlock_count := row_data.lwlock_count;
           lwlock_wait_count := row_data.lwlock_wait_count;
           lwlock_time := row_data.lwlock_time;
@@ -4117,6 +4119,7 @@ CREATE OR REPLACE FUNCTION DBE_PERF.get_global_slow_sql_by_timestamp
    OUT lock_wait_count bigint,
    OUT lock_wait_time bigint,
    OUT lock_max_count bigint,
+   OUT lock_fastpath_overflow_count bigint,
    OUT lwlock_count bigint,
    OUT lwlock_wait_count bigint,
    OUT lwlock_time bigint,
@@ -4184,6 +4187,7 @@ CREATE OR REPLACE FUNCTION DBE_PERF.get_global_slow_sql_by_timestamp
           lock_wait_count := row_data.lock_wait_count;
           lock_wait_time := row_data.lock_wait_time;
           lock_max_count := row_data.lock_max_count;
+          lock_fastpath_overflow_count := row_data.lock_fastpath_overflow_count;
           lwlock_count := row_data.lwlock_count;
           lwlock_wait_count := row_data.lwlock_wait_count;
           lwlock_time := row_data.lwlock_time;
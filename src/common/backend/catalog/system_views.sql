@@ -3467,6 +3467,7 @@ CREATE unlogged table statement_history(
     lock_wait_count bigint,
     lock_wait_time bigint,
     lock_max_count bigint,
+    lock_fastpath_overflow_count bigint,
     lwlock_count bigint,
     lwlock_wait_count bigint,
     lwlock_time bigint,
@@ -13757,6 +13757,42 @@ Datum local_xlog_redo_statics(PG_FUNCTION_ARGS)
     return (Datum)0;
 }
 
+/*
+ * gs_lwlock_wait_histogram
+ *		Per-tranche histogram of the time LWLock acquisitions spent sleeping.
+ *		Only non-empty buckets are returned; wait_time_us is the exclusive
+ *		upper bound of the bucket, NULL for the last, open-ended one.
+ */
+Datum gs_lwlock_wait_histogram(PG_FUNCTION_ARGS)
+{
+    TupleDesc tupdesc;
+    Tuplestorestate *tupstore = BuildTupleResult(fcinfo, &tupdesc);
+    const uint32 lwlock_wait_hist_cols = 3;
+    Datum values[lwlock_wait_hist_cols];
+    bool nulls[lwlock_wait_hist_cols];
+    LWLockTrancheStat *stats = g_instance.stat_cxt.lwlockTrancheStats;
+
+    for (int i = 0; stats != NULL && i < LWTRANCHE_NATIVE_TRANCHE_NUM; i++) {
+        const char *tranche = GetLWLockIdentifier(PG_WAIT_LWLOCK, (uint16)i);
+
+        for (int j = 0; j < LWLOCK_WAIT_HIST_BUCKETS; j++) {
+            uint64 count = pg_atomic_read_u64(&stats[i].waitHist[j]);
+            if (count == 0) {
+                continue;
+            }
+            values[0] = CStringGetTextDatum(tranche);
+            nulls[0] = false;
+            values[1] = Int64GetDatum(INT64CONST(1) << (j + 1));
+            nulls[1] = (j == LWLOCK_WAIT_HIST_BUCKETS - 1);
+            values[2] = Int64GetDatum((int64)count);
+            nulls[2] = false;
+            tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+        }
+    }
+    tuplestore_donestoring(tupstore);
+    return (Datum)0;
+}
+
 Datum local_redo_stat(PG_FUNCTION_ARGS)
 {
     TupleDesc tupdesc = NULL;
@@ -104,6 +104,10 @@
 #include "port/dynloader/win32.h"
 #endif
 
+#ifdef ENABLE_MOT
+#include "storage/mot/jit_exec.h"
+#endif
+
 #ifdef PGXC
 #include "catalog/pgxc_node.h"
 #include "utils/rel.h"
@@ -2194,6 +2198,13 @@ void PostgresInitializer::InitSession()
 
     FinishInit();
 
+#ifdef ENABLE_MOT
+    /* compile the MOT JIT queries recorded by previous runs, once the database is opened first */
+    if (IsUnderPostmaster && !dummyStandbyMode && !IS_PGXC_COORDINATOR) {
+        JitExec::WarmupJitDatabase();
+    }
+#endif
+
     AuditUserLogin();
 }
 
@@ -2616,6 +2627,9 @@ void PostgresInitializer::LockDatabase()
      * the correct value on their next try.
      */
     t_thrd.proc->databaseId = u_sess->proc_cxt.MyDatabaseId;
+
+    /* From now on we only need invalidations of our own database */
+    SharedInvalSetDatabase(u_sess->proc_cxt.MyDatabaseId);
 }
 
 void PostgresInitializer::RecheckDatabaseExists()
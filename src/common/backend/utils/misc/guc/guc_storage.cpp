@@ -744,6 +744,42 @@ static void InitStorageConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_early_lock_release",
+            PGC_SIGHUP,
+            NODE_ALL,
+            REPLICATION_MASTER,
+            gettext_noop("Releases transaction locks before waiting for the commit record to be flushed "
+                         "and replicated."),
+            NULL},
+            &u_sess->attr.attr_storage.enable_early_lock_release,
+            false,
+            NULL,
+            NULL,
+            NULL},
+        {{"enable_logical_replication_streaming",
+            PGC_SIGHUP,
+            NODE_SINGLENODE,
+            REPLICATION,
+            gettext_noop("Lets subscriptions receive large transactions from the publisher while they are "
+                         "still in progress."),
+            gettext_noop("Has to be on for both the publisher and the subscriber. With wal_level = logical, "
+                         "the publisher then logs the assignment of every subtransaction to its parent.")},
+            &u_sess->attr.attr_storage.enable_logical_replication_streaming,
+            false,
+            NULL,
+            NULL,
+            NULL},
+        {{"enable_hot_row_queue",
+            PGC_USERSET,
+            NODE_ALL,
+            LOCK_MANAGEMENT,
+            gettext_noop("Makes concurrent updaters of the same row wait in arrival order."),
+            NULL},
+            &u_sess->attr.attr_storage.enable_hot_row_queue,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_show_any_tuples",
             PGC_USERSET,
             NODE_ALL,
@@ -1268,6 +1304,19 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+        {{"catchup_parallel_relations",
+            PGC_SIGHUP,
+            NODE_ALL,
+            REPLICATION_SENDING,
+            gettext_noop("Sets the number of relations catchup sends before waiting for the standby to confirm them."),
+            NULL},
+            &u_sess->attr.attr_storage.catchup_parallel_relations,
+            8,
+            1,
+            256,
+            NULL,
+            NULL,
+            NULL},
         {{"catchup2normal_wait_time",
             PGC_SIGHUP,
             NODE_ALL,
@@ -1391,6 +1440,20 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL},
 
+        {{"wal_receiver_decompress_workers",
+            PGC_SIGHUP,
+            NODE_ALL,
+            REPLICATION_STANDBY,
+            gettext_noop("Sets the number of threads decompressing shipped WAL on the standby."),
+            gettext_noop("Zero decompresses in the walreceiver thread itself.")},
+            &u_sess->attr.attr_storage.wal_receiver_decompress_workers,
+            0,
+            0,
+            MAX_WALRCV_DECOMPRESS_WORKERS,
+            NULL,
+            NULL,
+            NULL},
+
         {{"wal_receiver_timeout",
             PGC_SIGHUP,
             NODE_ALL,
@@ -2437,6 +2500,20 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL},
 
+        {{"max_parallel_apply_workers_per_subscription",
+            PGC_SIGHUP,
+            NODE_SINGLENODE,
+            REPLICATION,
+            gettext_noop("Maximum number of parallel apply workers per subscription."),
+            NULL},
+            &u_sess->attr.attr_storage.max_parallel_apply_workers_per_subscription,
+            0,
+            0,
+            MAX_BACKENDS,
+            NULL,
+            NULL,
+            NULL},
+
         {{"recovery_time_target",
             PGC_SIGHUP,
             NODE_ALL,
@@ -3108,6 +3185,19 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+        {{"recovery_prefetch_distance",
+            PGC_SIGHUP,
+            NODE_ALL,
+            RESOURCES_RECOVERY,
+            gettext_noop("Sets how many data blocks extreme RTO redo may prefetch ahead of replay."),
+            gettext_noop("Zero disables prefetching.")},
+            &u_sess->attr.attr_storage.recovery_prefetch_distance,
+            0,
+            0,
+            MAX_RECOVERY_PREFETCH_DISTANCE,
+            NULL,
+            NULL,
+            NULL},
         {{"force_promote",
             PGC_POSTMASTER,
             NODE_ALL,
@@ -4142,6 +4232,18 @@ static void InitStorageConfigureNamesString()
             NULL,
             NULL,
             NULL},
+        {{"lwlock_numa_handoff_tranches",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            LOCK_MANAGEMENT,
+            gettext_noop("LWLock tranches whose exclusive waiters are woken NUMA node local first."),
+            NULL,
+            GUC_LIST_INPUT | GUC_LIST_QUOTE | GUC_SUPERUSER_ONLY},
+            &g_instance.attr.attr_storage.lwlock_numa_handoff_tranches,
+            "",
+            NULL,
+            NULL,
+            NULL},
         /* Get the cross_cluster_ReplConnInfo1 from postgresql.conf and assign to cross_cluster_ReplConnArray1. */
         {{"cross_cluster_replconninfo1",
             PGC_SIGHUP,
@@ -324,6 +324,9 @@ static void print_stmt_summary_lock_debug_log(int log_level)
             errmsg("\t lock wait cnt: %ld", CURRENT_STMT_METRIC_HANDLE->lock_summary.lock_wait_cnt)));
         ereport(log_level, (errmodule(MOD_INSTR),
             errmsg("\t lock max cnt: %ld", CURRENT_STMT_METRIC_HANDLE->lock_summary.lock_max_cnt)));
+        ereport(log_level, (errmodule(MOD_INSTR),
+            errmsg("\t lock fastpath overflow cnt: %ld",
+                CURRENT_STMT_METRIC_HANDLE->lock_summary.fastpath_overflow_cnt)));
         ereport(log_level, (errmodule(MOD_INSTR),
             errmsg("\t lwlock cnt: %ld", CURRENT_STMT_METRIC_HANDLE->lock_summary.lwlock_cnt)));
         ereport(log_level, (errmodule(MOD_INSTR),
@@ -75,7 +75,7 @@
 
 #define STATEMENT_DETAILS_HEAD_SIZE (1)     /* [VERSION] */
 #define INSTR_STMT_UNIX_DOMAIN_PORT (-1)
-#define INSTR_STATEMENT_ATTRNUM 52
+#define INSTR_STATEMENT_ATTRNUM 53
 
 /* support different areas in stmt detail column */
 #define STATEMENT_DETAIL_TYPE_LEN (1)
@@ -442,6 +442,7 @@ static void set_stmt_lock_summary(const LockSummaryStat *lock_summary, Datum val
     values[(*i)++] = Int64GetDatum(lock_summary->lock_wait_cnt);
     values[(*i)++] = Int64GetDatum(lock_summary->lock_wait_time);
     values[(*i)++] = Int64GetDatum(lock_summary->lock_max_cnt);
+    values[(*i)++] = Int64GetDatum(lock_summary->fastpath_overflow_cnt);
     values[(*i)++] = Int64GetDatum(lock_summary->lwlock_cnt);
     values[(*i)++] = Int64GetDatum(lock_summary->lwlock_wait_cnt);
     values[(*i)++] = Int64GetDatum(lock_summary->lwlock_time);
@@ -673,7 +674,7 @@ static void CleanStatementByIdx(Relation rel, Oid statementTimeIndexId,
 {
     int index_num = 2;
     AttrNumber Anum_statement_history_indrelid = 11;
-    AttrNumber Anum_statement_history_slow_sql_id = 51;
+    AttrNumber Anum_statement_history_slow_sql_id = 52;
     ScanKeyData key[index_num];
     SysScanDesc indesc = NULL;
     HeapTuple tup = NULL;
@@ -1324,6 +1325,12 @@ void instr_stmt_report_lock(StmtDetailType type, int lockmode, const LOCKTAG *lo
     }
 }
 
+void instr_stmt_report_lock_fastpath_overflow()
+{
+    CHECK_STMT_HANDLE();
+    CURRENT_STMT_METRIC_HANDLE->lock_summary.fastpath_overflow_cnt++;
+}
+
 char *get_lock_mode_name(LOCKMODE mode)
 {
     switch (mode) {
@@ -113,7 +113,7 @@ void TryMotJitCodegenQuery(const char* queryString, CachedPlanSource* psrc, Quer
 
     Assert(psrc->opFusionObj == NULL && psrc->mot_jit_context == NULL);
     u_sess->mot_cxt.jit_codegen_error = 0;
-    psrc->mot_jit_context = JitExec::TryJitCodegenQuery(query, queryString);
+    psrc->mot_jit_context = JitExec::TryJitCodegenQuery(query, queryString, psrc->param_types, psrc->num_params);
     if (psrc->mot_jit_context != NULL) {
         if (JitExec::IsJitContextValid(psrc->mot_jit_context)) {
             psrc->is_checked_opfusion = false;
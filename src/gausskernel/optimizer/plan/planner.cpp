@@ -19,6 +19,7 @@
 #include <limits.h>
 #include <math.h>
 
+#include "access/sysattr.h"
 #include "access/transam.h"
 #include "catalog/indexing.h"
 #include "catalog/pg_cast.h"
@@ -9109,6 +9110,24 @@ static bool CheckWindowsAggExpr(Plan* resultPlan, bool check_rescan, VectorPlanC
     return false;
 }
 
+#ifdef ENABLE_MOT
+/*
+ * @Description: Check whether the target list of a scan fetches the row identifier (ctid),
+ * i.e. the scanned rows are to be updated or deleted.
+ */
+static bool TargetListHasRowId(List* targetList)
+{
+    ListCell* lc = NULL;
+    foreach (lc, targetList) {
+        TargetEntry* tle = (TargetEntry*)lfirst(lc);
+        if (IsA(tle->expr, Var) && ((Var*)tle->expr)->varattno == SelfItemPointerAttributeNumber) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 static bool CheckForeignScanExpr(Plan* resultPlan, VectorPlanContext* planContext)
 {
     ForeignScan* fscan = (ForeignScan*)resultPlan;
@@ -9123,8 +9142,8 @@ static bool CheckForeignScanExpr(Plan* resultPlan, VectorPlanContext* planContex
         resultPlan->vec_output = false;
     }
 #ifdef ENABLE_MOT
-    /* do not support row to vector for mot table */
-    if (IsSpecifiedFDWFromRelid(fscan->scan_relid, MOT_FDW)) {
+    /* mot table can be scanned in batches, but not when its rows are to be updated or deleted */
+    if (IsSpecifiedFDWFromRelid(fscan->scan_relid, MOT_FDW) && TargetListHasRowId(resultPlan->targetlist)) {
         resultPlan->vec_output = false;
         return true;
     }
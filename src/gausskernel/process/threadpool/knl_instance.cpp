@@ -279,6 +279,8 @@ static void knl_g_parallel_redo_init(knl_g_parallel_redo_context* predo_cxt)
     predo_cxt->redoPf.speed_according_seg = 0;
     predo_cxt->redoPf.local_max_lsn = 0;
     predo_cxt->redoPf.oldest_segment = 1;
+    predo_cxt->redoPf.prefetch_issued = 0;
+    predo_cxt->redoPf.prefetch_hit = 0;
     knl_g_set_redo_finish_status(0);
     predo_cxt->redoType = DEFAULT_REDO;
     predo_cxt->pre_enable_switch = 0;
@@ -542,6 +544,8 @@ static void knl_g_stat_init(knl_g_stat_context* stat_cxt)
     rc = memset_s(stat_cxt->fileIOStat, sizeof(FileIOStat), 0, sizeof(FileIOStat));
     securec_check(rc, "\0", "\0");
 
+    stat_cxt->lwlockTrancheStats = NULL;
+
     stat_cxt->tableStat = (UHeapPruneStat *) palloc0(sizeof(UHeapPruneStat));
     rc = memset_s(stat_cxt->tableStat, sizeof(UHeapPruneStat), 0, sizeof(UHeapPruneStat));
     securec_check(rc, "\0", "\0");
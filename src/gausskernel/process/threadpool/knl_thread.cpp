@@ -337,6 +337,7 @@ static void knl_t_xact_init(knl_t_xact_context* xact_cxt)
     xact_cxt->XactPrepareSent = false;
     xact_cxt->AlterCoordinatorStmt = false;
     xact_cxt->forceSyncCommit = false;
+    xact_cxt->elrWaitLSN = InvalidXLogRecPtr;
     /* alloc in TopMemory Context, initialization is NULL when create new thread */
     xact_cxt->TransactionAbortContext = NULL;
     xact_cxt->Seq_callbacks = NULL;
@@ -712,6 +713,9 @@ static void knl_t_basebackup_init(knl_t_basebackup_context* basebackup_cxt)
     int rc = memset_s(basebackup_cxt->g_xlog_location, MAXPGPATH, 0, MAXPGPATH);
     securec_check(rc, "\0", "\0");
     basebackup_cxt->buf_block = NULL;
+    basebackup_cxt->changedBlocks = NULL;
+    basebackup_cxt->sendingTablespace = InvalidOid;
+    basebackup_cxt->readAheadStreams = 0;
 }
 
 static void knl_t_datarcvwriter_init(knl_t_datarcvwriter_context* datarcvwriter_cxt)
@@ -972,6 +976,7 @@ static void knl_t_parallel_decode_reader_init(knl_t_logical_read_worker_context*
 {
     parallel_decode_reader_cxt->got_SIGHUP = false;
     parallel_decode_reader_cxt->sleep_long = false;
+    parallel_decode_reader_cxt->readAheadPool = NULL;
 }
 
 static void knl_t_startup_init(knl_t_startup_context* startup_cxt)
@@ -1019,6 +1024,13 @@ static void knl_t_poolcleaner_init(knl_t_poolcleaner_context* poolcleaner_cxt)
 static void knl_t_catchup_init(knl_t_catchup_context* catchup_cxt)
 {
     catchup_cxt->catchup_shutdown_requested = false;
+    catchup_cxt->pending_rels = NIL;
+    catchup_cxt->files_total = 0;
+    catchup_cxt->files_done = 0;
+    catchup_cxt->blocks_sent = 0;
+    catchup_cxt->bytes_sent = 0;
+    catchup_cxt->start_time = 0;
+    catchup_cxt->last_report_time = 0;
 }
 
 /* interval for calling AbsorbFsyncRequests in CheckpointWriteDelay */
@@ -1077,6 +1089,17 @@ static void KnlTApplyWorkerInit(knl_t_apply_worker_context* applyWorkerCxt)
     applyWorkerCxt->messageContext = NULL;
     applyWorkerCxt->logicalRepRelMapContext = NULL;
     applyWorkerCxt->applyContext = NULL;
+    applyWorkerCxt->paGroup = NULL;
+    applyWorkerCxt->paCurTxn = NULL;
+    applyWorkerCxt->paTxnContext = NULL;
+    applyWorkerCxt->paDispatched = NIL;
+    applyWorkerCxt->paKeyTab = NULL;
+    applyWorkerCxt->paRelMsgTab = NULL;
+    applyWorkerCxt->paLastSeq = 0;
+    applyWorkerCxt->paLastProgress = InvalidXLogRecPtr;
+    applyWorkerCxt->streamingRequested = false;
+    applyWorkerCxt->streamTxns = NULL;
+    applyWorkerCxt->streamTxn = NULL;
 }
 
 static void KnlTPublicationInit(knl_t_publication_context* publicationCxt)
@@ -1297,6 +1320,8 @@ static void knl_t_walreceiver_init(knl_t_walreceiver_context* walreceiver_cxt)
     walreceiver_cxt->checkConsistencyOK = false;
     walreceiver_cxt->hasReceiveNewData = false;
     walreceiver_cxt->termChanged = false;
+    walreceiver_cxt->writerPendingBytes = 0;
+    walreceiver_cxt->decompressPool = NULL;
 }
 
 static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
@@ -1370,6 +1395,7 @@ static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
     storage_cxt->conflicting_lock_thread_id = 0;
     storage_cxt->conflicting_lock_by_holdlock = true;
     storage_cxt->FastPathLocalUseCount = 0;
+    storage_cxt->FastPathLocalUseCounts = NULL;
     storage_cxt->FastPathStrongRelationLocks = NULL;
     storage_cxt->LockMethodLockHash = NULL;
     storage_cxt->LockMethodProcLockHash = NULL;
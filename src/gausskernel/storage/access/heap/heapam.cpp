@@ -4392,6 +4392,41 @@ static inline bool xmax_infomask_changed(uint16 new_infomask, uint16 new_infomas
     return false;
 }
 
+/*
+ * HeapLockHotRowQueue - line up behind earlier writers of a contended row
+ *
+ * With enable_hot_row_queue, every writer of a row first takes a heavyweight
+ * lock that is held until end of transaction, the same way the uid lock works
+ * for tables with uids.  The row is identified by the root of its HOT chain,
+ * which stays put as long as the row is updated in place on its page, so all
+ * writers of a hot row wait in arrival order on a single lock.  Without it
+ * each new version gets its own short-lived tuple lock, a newcomer that finds
+ * the latest version unlocked goes ahead of sessions already waiting, and the
+ * waiters redo EvalPlanQual for every race they lose.
+ *
+ * Called and returns with the buffer exclusively locked; the caller must
+ * recheck the tuple afterwards.
+ */
+static void HeapLockHotRowQueue(Relation relation, Buffer buffer, HeapTuple tuple, LOCKMODE lockmode)
+{
+    ItemPointerData rowid = tuple->t_self;
+
+    if (HeapTupleHeaderIsHeapOnly(tuple->t_data)) {
+        OffsetNumber rootOffsets[MaxHeapTuplesPerPage];
+        OffsetNumber root;
+
+        heap_get_root_tuples(BufferGetPage(buffer), rootOffsets);
+        root = rootOffsets[ItemPointerGetOffsetNumber(&tuple->t_self) - 1];
+        if (OffsetNumberIsValid(root)) {
+            ItemPointerSetOffsetNumber(&rowid, root);
+        }
+    }
+
+    LockBuffer(buffer, BUFFER_LOCK_UNLOCK);
+    LockTuple(relation, &rowid, lockmode, u_sess->attr.attr_common.allow_concurrent_tuple_update);
+    LockBuffer(buffer, BUFFER_LOCK_EXCLUSIVE);
+}
+
 /*
  *	heap_delete - delete a tuple
  *
@@ -4511,6 +4546,10 @@ TM_Result heap_delete(Relation relation, ItemPointer tid, CommandId cid,
 	/* need to recompute xid base after release buffer lock */
         HeapTupleCopyBaseFromPage(&tp, page);
         tmfd->xmin = HeapTupleHeaderGetXmin(page, tp.t_data);
+    } else if (u_sess->attr.attr_storage.enable_hot_row_queue) {
+        HeapLockHotRowQueue(relation, buffer, &tp, ExclusiveLock);
+        HeapTupleCopyBaseFromPage(&tp, page);
+        tmfd->xmin = HeapTupleHeaderGetXmin(page, tp.t_data);
     }
 
 l1:
@@ -5116,6 +5155,8 @@ TM_Result heap_update(Relation relation, Relation parentRelation, ItemPointer ot
         LockTupleUid(relation, tupleUid, ExclusiveLock,
             u_sess->attr.attr_common.allow_concurrent_tuple_update, false);
         LockBuffer(buffer, BUFFER_LOCK_EXCLUSIVE);
+    } else if (u_sess->attr.attr_storage.enable_hot_row_queue) {
+        HeapLockHotRowQueue(relation, buffer, &oldtup, ExclusiveLock);
     }
 
 l2:
@@ -6276,6 +6317,9 @@ TM_Result heap_lock_tuple(Relation relation, HeapTuple tuple, Buffer* buffer,
         LockBuffer(*buffer, BUFFER_LOCK_UNLOCK);
         LockTupleUid(relation, tupleUid, TupleLockExtraInfo[mode].hwlock, waitPolicy == LockWaitBlock, true);
         LockBuffer(*buffer, BUFFER_LOCK_EXCLUSIVE);
+    } else if (u_sess->attr.attr_storage.enable_hot_row_queue && waitPolicy == LockWaitBlock) {
+        /* NOWAIT and SKIP LOCKED keep deciding on the tuple itself */
+        HeapLockHotRowQueue(relation, *buffer, tuple, TupleLockExtraInfo[mode].hwlock);
     }
 l3:
     HeapTupleCopyBaseFromPage(tuple, page);
@@ -44,6 +44,8 @@
 
 #include "catalog/storage_xlog.h"
 #include "storage/buf/buf_internals.h"
+#include "storage/buf/bufmgr.h"
+#include "storage/smgr/smgr.h"
 #include "storage/ipc.h"
 #include "storage/standby.h"
 #include "utils/hsearch.h"
@@ -164,6 +166,9 @@ static bool DispatchUHeapUndoRecord(XLogReaderState* record, List* expectedTLIs,
 static bool DispatchUndoActionRecord(XLogReaderState* record, List* expectedTLIs, TimestampTz recordXTime);
 static bool DispatchRollbackFinishRecord(XLogReaderState* record, List* expectedTLIs, TimestampTz recordXTime);
 static inline uint32 GetUndoSpaceWorkerId(int zid);
+static void RedoPrefetchRecord(XLogReaderState *record);
+static void RedoPrefetchReset();
+static void RedoPrefetchForgetTruncated(const RelFileNode &rnode, BlockNumber nblocks);
 
 static XLogReaderState *GetXlogReader(XLogReaderState *readerState);
 void CopyDataFromOldReader(XLogReaderState *newReaderState, const XLogReaderState *oldReaderState);
@@ -757,6 +762,7 @@ void DispatchRedoRecordToFile(XLogReaderState *record, List *expectedTLIs, Times
 #ifdef ENABLE_UT
             TestXLogReaderProbe(UTEST_EVENT_RTO_DISPATCH_REDO_RECORD_TO_FILE, __FUNCTION__, record);
 #endif
+            RedoPrefetchRecord(record);
             g_dispatchTable[rmid].rm_dispatch(record, expectedTLIs, recordXTime);
         } else {
             DispatchDefaultRecord(record, expectedTLIs, recordXTime);
@@ -775,6 +781,46 @@ void DispatchRedoRecordToFile(XLogReaderState *record, List *expectedTLIs, Times
     }
 }
 
+/*
+ * Hand the item to every page line chosen by GetSlotIds.  All references are
+ * taken with one atomic add before the first worker can see the item, so
+ * no extra guard reference is needed.
+ *
+ * Run from the dispatcher thread.
+ */
+static void AddItemToChosenPageLines(RedoItem *item)
+{
+    uint32 refCount = 0;
+    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
+        if (g_dispatcher->chosedPageLineIds[i] > 0) {
+            refCount++;
+        }
+    }
+
+    if (refCount == 0) {
+        /* nobody wants it, release it the usual way */
+        ReferenceRedoItem(item);
+        DereferenceRedoItem(item);
+        return;
+    }
+
+    ReferenceRedoItemN(item, refCount);
+    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
+        if (g_dispatcher->chosedPageLineIds[i] > 0) {
+            AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
+        }
+    }
+}
+
+/* Run from the dispatcher thread. */
+static void AddItemToAllPageLines(RedoItem *item)
+{
+    ReferenceRedoItemN(item, g_dispatcher->pageLineNum);
+    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
+        AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
+    }
+}
+
 /**
  * process record need sync with page worker and trxn thread
  * trxnthreadexe is true when the record need execute on trxn thread
@@ -839,12 +885,12 @@ static bool DispatchBarrierRecord(XLogReaderState *record, List *expectedTLIs, T
 {
     RedoItem *item = GetRedoItemPtr(record);
     uint8 info = (XLogRecGetInfo(record) & (~XLR_INFO_MASK));
-    ReferenceRedoItem(item);
     if (info != XLOG_BARRIER_COMMIT) {
         item->record.isFullSync = true;
     }
+    /* one reference per page line, plus the one the txn line takes over */
+    ReferenceRedoItemN(item, g_dispatcher->pageLineNum + 1);
     for (uint32 i = 0; i < g_dispatcher->pageLineNum; ++i) {
-        ReferenceRedoItem(item);
         AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
     }
 
@@ -899,13 +945,12 @@ static bool DispatchXLogRecord(XLogReaderState *record, List *expectedTLIs, Time
         item->record.isFullSync = g_dispatcher->needFullSyncCheckpoint;
         g_dispatcher->needImmediateCheckpoint = false;
         g_dispatcher->needFullSyncCheckpoint = false;
-        ReferenceRedoItem(item);
+        ReferenceRedoItemN(item, g_dispatcher->pageLineNum + 1);
         for (uint32 i = 0; i < g_dispatcher->pageLineNum; ++i) {
             /*
              * A check point record may save a recovery restart point or
              * update the timeline.
              */
-            ReferenceRedoItem(item);
             AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
         }
         /* ensure eyery pageworker is receive recored to update pageworker Lsn
@@ -937,6 +982,8 @@ static bool DispatchXactRecord(XLogReaderState *record, List *expectedTLIs, Time
     if (XactWillRemoveRelFiles(record)) {
         bool hasSegpageRelFile = XactHasSegpageRelFiles(record);
         uint32 doneFlag = 0;
+
+        RedoPrefetchReset();
         
         for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
             AddSlotToPLSet(i);
@@ -993,12 +1040,7 @@ static bool DispatchMultiXactRecord(XLogReaderState *record, List *expectedTLIs,
 static void DispatchRecordWithoutPage(XLogReaderState *record, List *expectedTLIs)
 {
     RedoItem *item = GetRedoItemPtr(record);
-    ReferenceRedoItem(item);
-    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
-        ReferenceRedoItem(item);
-        AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
-    }
-    DereferenceRedoItem(item);
+    AddItemToAllPageLines(item);
 }
 
 /* Run from the dispatcher thread. */
@@ -1007,14 +1049,7 @@ static void DispatchRecordWithPages(XLogReaderState *record, List *expectedTLIs)
     GetSlotIds(record);
 
     RedoItem *item = GetRedoItemPtr(record);
-    ReferenceRedoItem(item);
-    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
-        if (g_dispatcher->chosedPageLineIds[i] > 0) {
-            ReferenceRedoItem(item);
-            AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
-        }
-    }
-    DereferenceRedoItem(item);
+    AddItemToChosenPageLines(item);
 }
 
 static bool DispatchHeapRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime)
@@ -1040,14 +1075,10 @@ static bool DispatchDataBaseRecord(XLogReaderState *record, List *expectedTLIs,
 
     if (IsDataBaseDrop(record)) {
         isNeedFullSync = true;
+        RedoPrefetchReset();
         RedoItem *item = GetRedoItemPtr(record);
 
-        ReferenceRedoItem(item);
-        for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
-            ReferenceRedoItem(item);
-            AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
-        }
-        DereferenceRedoItem(item);
+        AddItemToAllPageLines(item);
     } else {
         /* database dir may impact many rel so need to sync to all pageworks */
         DispatchRecordWithoutPage(record, expectedTLIs);
@@ -1064,10 +1095,11 @@ static bool DispatchTableSpaceRecord(XLogReaderState *record, List *expectedTLIs
     uint8 info = (XLogRecGetInfo(record) & (~XLR_INFO_MASK));
     if (info == XLOG_TBLSPC_CREATE || info == XLOG_TBLSPC_RELATIVE_CREATE) {
         item->record.isFullSync = true;
+    } else {
+        RedoPrefetchReset();
     }
-    ReferenceRedoItem(item);    
+    ReferenceRedoItemN(item, g_dispatcher->pageLineNum + 1);
     for (uint32 i = 0; i < g_dispatcher->pageLineNum; ++i) {
-        ReferenceRedoItem(item);
         AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
     }
     AddTxnRedoItem(g_dispatcher->trxnLine.managerThd, item);
@@ -1093,6 +1125,7 @@ static bool DispatchSmgrRecord(XLogReaderState *record, List *expectedTLIs, Time
         RelFileNode rnode;
         RelFileNodeCopy(rnode, xlrec->rnode, XLogRecGetBucketId(record));
         rnode.opt = GetTruncateXlogFileNodeOpt(record);
+        RedoPrefetchForgetTruncated(rnode, xlrec->blkno);
         uint32 id = GetSlotId(rnode, 0, 0, GetBatchCount());
         AddSlotToPLSet(id);
 
@@ -1278,7 +1311,6 @@ static bool DispatchSpgistRecord(XLogReaderState *record, List *expectedTLIs, Ti
 static void DispatchToSpecPageWorker(XLogReaderState *record, List *expectedTLIs)
 {
     RedoItem *item = GetRedoItemPtr(record);
-    ReferenceRedoItem(item);
 
     if (g_dispatcher->chosedPLCnt != 1) {
         ereport(WARNING,
@@ -1287,14 +1319,7 @@ static void DispatchToSpecPageWorker(XLogReaderState *record, List *expectedTLIs
                         XLogRecGetRmid(&item->record), XLogRecGetInfo(&item->record), g_dispatcher->chosedPLCnt)));
     }
 
-    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
-        if (g_dispatcher->chosedPageLineIds[i] > 0) {
-            ReferenceRedoItem(item);
-            AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
-        }
-    }
-
-    DereferenceRedoItem(item);
+    AddItemToChosenPageLines(item);
 }
 
 static bool DispatchHeap2VacuumRecord(XLogReaderState *record, List *expectedTLIs, TimestampTz recordXTime)
@@ -1392,6 +1417,142 @@ static void GetSlotIds(XLogReaderState *record)
     }
 }
 
+/*
+ * Redo prefetch.
+ *
+ * The dispatcher sees each record before the page redo workers do. For every block a worker will
+ * have to read (no full-page image, page not re-initialized) that is not in shared buffers yet, we
+ * ask the kernel to start reading it now. No more than recovery_prefetch_distance prefetches may be
+ * outstanding for records that have not been replayed. Blocks at or past the known end of their
+ * relation fork are skipped: redo is about to create them, and touching missing segments during
+ * recovery would create them.
+ */
+static inline RedoPrefetchRelSize *RedoPrefetchRelSizeSlot(const RelFileNode &rnode, ForkNumber forknum)
+{
+    uint32 hash = tag_hash((const void *)&rnode.relNode, sizeof(rnode.relNode)) ^ (uint32)forknum;
+    return &g_dispatcher->prefetchRelSizes[hash % REDO_PREFETCH_RELSIZE_SLOTS];
+}
+
+/* Run from the dispatcher thread. */
+static BlockNumber RedoPrefetchGetRelSize(SMgrRelation reln, ForkNumber forknum, BlockNumber blkno)
+{
+    RedoPrefetchRelSize *slot = RedoPrefetchRelSizeSlot(reln->smgr_rnode.node, forknum);
+    if (slot->valid && RelFileNodeEquals(slot->rnode, reln->smgr_rnode.node) && slot->forknum == forknum &&
+        (blkno < slot->nblocks || slot->truncated)) {
+        return slot->nblocks;
+    }
+
+    /* not cached, or the fork may have grown since we last looked */
+    slot->rnode = reln->smgr_rnode.node;
+    slot->forknum = forknum;
+    slot->truncated = false;
+    slot->nblocks = smgrexists(reln, forknum) ? smgrnblocks(reln, forknum) : 0;
+    slot->valid = true;
+    return slot->nblocks;
+}
+
+/* Run from the dispatcher thread. */
+static bool RedoPrefetchHasRoom(uint32 distance)
+{
+    if (g_dispatcher->prefetchCount > 0) {
+        XLogRecPtr replayed = GetXLogReplayRecPtr(NULL);
+        while (g_dispatcher->prefetchCount > 0 &&
+               XLByteLE(g_dispatcher->prefetchLsns[g_dispatcher->prefetchHead], replayed)) {
+            g_dispatcher->prefetchHead = (g_dispatcher->prefetchHead + 1) % MAX_RECOVERY_PREFETCH_DISTANCE;
+            g_dispatcher->prefetchCount--;
+        }
+    }
+    return g_dispatcher->prefetchCount < distance;
+}
+
+/* Run from the dispatcher thread. */
+static void RedoPrefetchRecord(XLogReaderState *record)
+{
+#if !defined(USE_PREFETCH) || !defined(USE_POSIX_FADVISE)
+    /* PrefetchSharedBuffer() issues no I/O, so there is nothing to prefetch or count */
+    return;
+#endif /* !USE_PREFETCH || !USE_POSIX_FADVISE */
+    int distance = u_sess->attr.attr_storage.recovery_prefetch_distance;
+    if (distance <= 0) {
+        return;
+    }
+
+    for (int i = 0; i <= record->max_block_id; i++) {
+        DecodedBkpBlock *block = &record->blocks[i];
+        if (!block->in_use || block->has_image || (block->flags & BKPBLOCK_WILL_INIT) ||
+            IsSegmentFileNode(block->rnode)) {
+            continue;
+        }
+
+        /* consecutive records often touch the same page */
+        BufferTag tag;
+        INIT_BUFFERTAG(tag, block->rnode, block->forknum, block->blkno);
+        if (BUFFERTAGS_EQUAL(tag, g_dispatcher->prefetchLastTag)) {
+            continue;
+        }
+        if (!RedoPrefetchHasRoom((uint32)distance)) {
+            return;
+        }
+
+        g_dispatcher->prefetchUsed = true;
+        SMgrRelation reln = smgropen(block->rnode, InvalidBackendId);
+        if (block->blkno >= RedoPrefetchGetRelSize(reln, block->forknum, block->blkno)) {
+            continue;
+        }
+        g_dispatcher->prefetchLastTag = tag;
+
+        if (PrefetchSharedBuffer(reln, block->forknum, block->blkno)) {
+            g_instance.comm_cxt.predo_cxt.redoPf.prefetch_hit++;
+        } else {
+            g_instance.comm_cxt.predo_cxt.redoPf.prefetch_issued++;
+            uint32 tail = (g_dispatcher->prefetchHead + g_dispatcher->prefetchCount) % MAX_RECOVERY_PREFETCH_DISTANCE;
+            g_dispatcher->prefetchLsns[tail] = record->EndRecPtr;
+            g_dispatcher->prefetchCount++;
+        }
+    }
+}
+
+/*
+ * Relation files are about to be removed: close everything the prefetcher opened so no descriptor
+ * keeps a dropped file alive, and forget the cached sizes. Run from the dispatcher thread.
+ */
+static void RedoPrefetchReset()
+{
+    if (!g_dispatcher->prefetchUsed) {
+        return;
+    }
+    smgrcloseall();
+    errno_t rc = memset_s(g_dispatcher->prefetchRelSizes, sizeof(g_dispatcher->prefetchRelSizes), 0,
+                          sizeof(g_dispatcher->prefetchRelSizes));
+    securec_check(rc, "", "");
+    rc = memset_s(&g_dispatcher->prefetchLastTag, sizeof(BufferTag), 0, sizeof(BufferTag));
+    securec_check(rc, "", "");
+    g_dispatcher->prefetchUsed = false;
+}
+
+/*
+ * A truncation of rnode is going to be replayed. Its workers may not have done so yet, so the size
+ * on disk cannot be trusted: pin the cached sizes to what is left after the truncation. Run from the
+ * dispatcher thread.
+ */
+static void RedoPrefetchForgetTruncated(const RelFileNode &rnode, BlockNumber nblocks)
+{
+    if (!g_dispatcher->prefetchUsed) {
+        return;
+    }
+    for (int fork = 0; fork <= MAX_FORKNUM; fork++) {
+        RedoPrefetchRelSize *slot = RedoPrefetchRelSizeSlot(rnode, (ForkNumber)fork);
+        slot->rnode = rnode;
+        slot->forknum = (ForkNumber)fork;
+        slot->nblocks = (fork == MAIN_FORKNUM) ? nblocks : 0;
+        slot->truncated = true;
+        slot->valid = true;
+    }
+    smgrclose(smgropen(rnode, InvalidBackendId));
+    errno_t rc = memset_s(&g_dispatcher->prefetchLastTag, sizeof(BufferTag), 0, sizeof(BufferTag));
+    securec_check(rc, "", "");
+}
+
 /**
  * count slot id  by hash
  */
@@ -2127,15 +2288,7 @@ static bool DispatchUHeapRecord(XLogReaderState* record, List* expectedTLIs, Tim
     GetUndoSlotIds(record);
 
     RedoItem *item = GetRedoItemPtr(record);
-    ReferenceRedoItem(item);
-    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
-        if (g_dispatcher->chosedPageLineIds[i] > 0) {
-            ReferenceRedoItem(item);
-            AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
-            elog(DEBUG1, "Dispatch page worker %d", i);
-        }
-    }
-    DereferenceRedoItem(item);
+    AddItemToChosenPageLines(item);
 
     return false;
 }
@@ -2145,15 +2298,7 @@ static bool DispatchUHeap2Record(XLogReaderState* record, List* expectedTLIs, Ti
     GetSlotIds(record);
 
     RedoItem *item = GetRedoItemPtr(record);
-    ReferenceRedoItem(item);
-    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
-        if (g_dispatcher->chosedPageLineIds[i] > 0) {
-            ReferenceRedoItem(item);
-            AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
-            elog(DEBUG1, "Dispatch page worker %d", i);
-        }
-    }
-    DereferenceRedoItem(item);
+    AddItemToChosenPageLines(item);
 
     return false;
 }
@@ -2197,15 +2342,7 @@ static bool DispatchUHeapUndoRecord(XLogReaderState* record, List* expectedTLIs,
         opName, XLogRecGetXid(record), record->EndRecPtr, zoneId, undoWorkerId);
 
     RedoItem *item = GetRedoItemPtr(record);
-    ReferenceRedoItem(item);
-    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
-        if (g_dispatcher->chosedPageLineIds[i] > 0) {
-            ReferenceRedoItem(item);
-            AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
-            elog(DEBUG1, "Dispatch page worker %d", i);
-        }
-    }
-    DereferenceRedoItem(item);
+    AddItemToChosenPageLines(item);
 
     return false;
 }
@@ -2239,15 +2376,7 @@ static bool DispatchUndoActionRecord(XLogReaderState* record, List* expectedTLIs
     GetSlotIds(record);
 
     RedoItem *item = GetRedoItemPtr(record);
-    ReferenceRedoItem(item);
-    for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
-        if (g_dispatcher->chosedPageLineIds[i] > 0) {
-            ReferenceRedoItem(item);
-            AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
-            elog(DEBUG1, "Dispatch page worker %d", i);
-        }
-    }
-    DereferenceRedoItem(item);
+    AddItemToChosenPageLines(item);
 
     return false;
 }
@@ -2268,15 +2397,7 @@ static bool DispatchRollbackFinishRecord(XLogReaderState* record, List* expected
                 XLogRecGetXid(record), record->EndRecPtr, (int)UNDO_PTR_GET_ZONE_ID(xlrec->slotPtr), undoWorkerId);
 
             RedoItem *item = GetRedoItemPtr(record);
-            ReferenceRedoItem(item);
-            for (uint32 i = 0; i < g_dispatcher->pageLineNum; i++) {
-                if (g_dispatcher->chosedPageLineIds[i] > 0) {
-                    ReferenceRedoItem(item);
-                    AddPageRedoItem(g_dispatcher->pageLines[i].batchThd, item);
-                    elog(DEBUG1, "Dispatch page worker %d", i);
-                }
-            }
-            DereferenceRedoItem(item);
+            AddItemToChosenPageLines(item);
             break;
         }
         default: {
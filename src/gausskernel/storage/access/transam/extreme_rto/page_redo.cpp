@@ -379,6 +379,20 @@ void DereferenceRedoItem(void *item)
     SubRefRecord(&redoItem->record);
 }
 
+/* Take n references with one atomic add, for an item handed to n workers. */
+void ReferenceRedoItemN(void *item, uint32 n)
+{
+    RedoItem *redoItem = (RedoItem *)item;
+#ifndef EXTREME_RTO_DEBUG
+    pg_memory_barrier();
+    (void)pg_atomic_fetch_add_u32(&redoItem->record.refcount, n);
+#else
+    for (uint32 i = 0; i < n; i++) {
+        AddRefRecord(&redoItem->record);
+    }
+#endif
+}
+
 #define STRUCT_CONTAINER(type, membername, ptr) ((type *)((char *)(ptr)-offsetof(type, membername)))
 
 #ifdef USE_ASSERT_CHECKING
@@ -638,6 +652,14 @@ void RedoPageManagerDistributeToAllOneBlock(XLogRecParseState *ddlParseState)
     }
 }
 
+static void RedoPageManagerFlushBatch(PageRedoWorker *worker, RedoItemBatch *batch)
+{
+    if (batch->count > 0) {
+        AddPageRedoItems(worker, batch->items, batch->count);
+        batch->count = 0;
+    }
+}
+
 void RedoPageManagerDistributeBlockRecord(HTAB *redoItemHash, XLogRecParseState *parsestate)
 {
     PageRedoPipeline *myRedoLine = &g_dispatcher->pageLines[g_redoWorker->slotId];
@@ -645,16 +667,25 @@ void RedoPageManagerDistributeBlockRecord(HTAB *redoItemHash, XLogRecParseState
     HASH_SEQ_STATUS status;
     RedoItemHashEntry *redoItemEntry = NULL;
     HTAB *curMap = redoItemHash;
+    RedoItemBatch *batches = g_redoWorker->distributeBatches;
     hash_seq_init(&status, curMap);
 
+    /* collect the block chains per worker, and hand them over a batch at a time */
     while ((redoItemEntry = (RedoItemHashEntry *)hash_seq_search(&status)) != NULL) {
         uint32 workId = GetWorkerId(&redoItemEntry->redoItemTag, WorkerNumPerMng);
-        AddPageRedoItem(myRedoLine->redoThd[workId], redoItemEntry->head);
+        batches[workId].items[batches[workId].count++] = redoItemEntry->head;
+        if (batches[workId].count == PAGE_WORK_QUEUE_BATCH_SIZE) {
+            RedoPageManagerFlushBatch(myRedoLine->redoThd[workId], &batches[workId]);
+        }
 
         if (hash_search(curMap, (void *)&redoItemEntry->redoItemTag, HASH_REMOVE, NULL) == NULL)
             ereport(ERROR, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("hash table corrupted")));
     }
 
+    for (uint32 i = 0; i < WorkerNumPerMng; ++i) {
+        RedoPageManagerFlushBatch(myRedoLine->redoThd[i], &batches[i]);
+    }
+
     if (parsestate != NULL) {
         RedoPageManagerDistributeToAllOneBlock(parsestate);
     }
@@ -1044,6 +1075,8 @@ void RedoPageManagerMain()
 
     (void)RegisterRedoInterruptCallBack(HandlePageRedoInterrupts);
     g_redoWorker->redoItemHash = PRRedoItemHashInitialize(g_redoWorker->oldCtx);
+    g_redoWorker->distributeBatches = (RedoItemBatch *)MemoryContextAllocZero(g_redoWorker->oldCtx,
+        sizeof(RedoItemBatch) * g_dispatcher->pageLines[g_redoWorker->slotId].redoThdNum);
     XLogParseBufferInitFunc(&(g_redoWorker->parseManager), MAX_PARSE_BUFF_NUM, &recordRefOperate,
                             RedoInterruptCallBack);
 
@@ -2661,6 +2694,12 @@ void AddPageRedoItem(PageRedoWorker *worker, void *item)
     SPSCBlockingQueuePut(worker->queue, item);
 }
 
+/* Run from the dispatcher or page manager thread. */
+void AddPageRedoItems(PageRedoWorker *worker, void **items, uint32 count)
+{
+    (void)SPSCBlockingQueuePutN(worker->queue, items, count);
+}
+
 /* Run from the dispatcher thread. */
 bool SendPageRedoEndMark(PageRedoWorker *worker)
 {
@@ -47,6 +47,7 @@ namespace extreme_rto {
 #define COUNT(head, tail, mask) ((uint32)(((head) - (tail)) & (mask)))
 #define SPACE(head, tail, mask) ((uint32)(((tail) - ((head) + 1)) & (mask)))
 
+const uint32 MIN_REDO_QUE_TAKE_DELAY = 20;
 const uint32 MAX_REDO_QUE_TAKE_DELAY = 200; /* 100 us */
 const uint32 MAX_REDO_QUE_IDEL_TAKE_DELAY = 1000;
 const uint32 SLEEP_COUNT_QUE_TAKE = 0xFFF;
@@ -81,36 +82,96 @@ void SPSCBlockingQueueDestroy(SPSCBlockingQueue *queue)
     pfree(queue);
 }
 
-bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element)
+/*
+ * Spin on the queue index written by the other side, then park with a
+ * growing sleep while it stays idle.  A queue that gets busy again is
+ * noticed within one short sleep; one that stays idle costs at most one
+ * wakeup per maxDelay.
+ */
+static inline void SPSCBackoff(SPSCBlockingQueue *queue, uint32 *count, long *sleeptime, long maxDelay)
+{
+    ++(*count);
+    /* here we sleep, let the cpu to do other important work */
+    if (((*count) & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
+        pg_usleep(Min(*sleeptime, maxDelay));
+        *sleeptime = Min((*sleeptime) * 2, maxDelay);
+    }
+    if (queue->callBackFunc != NULL) {
+        queue->callBackFunc();
+    }
+}
+
+/* Consumer side: wait until the queue is not empty, return the write index. */
+static uint32 SPSCWaitForElements(SPSCBlockingQueue *queue, uint32 tail)
 {
+    uint32 count = 0;
+    long sleeptime = MIN_REDO_QUE_TAKE_DELAY;
     uint32 head = pg_atomic_read_u32(&queue->writeHead);
+    while (COUNT(head, tail, queue->mask) == 0) {
+        long maxDelay = t_thrd.page_redo_cxt.sleep_long ? MAX_REDO_QUE_IDEL_TAKE_DELAY : MAX_REDO_QUE_TAKE_DELAY;
+        SPSCBackoff(queue, &count, &sleeptime, maxDelay);
+        head = pg_atomic_read_u32(&queue->writeHead);
+    }
+    t_thrd.page_redo_cxt.sleep_long = false;
+    return head;
+}
+
+/* Producer side: wait until the queue has a free slot, return the read index. */
+static uint32 SPSCWaitForSpace(SPSCBlockingQueue *queue, uint32 head)
+{
+    uint32 count = 0;
+    long sleeptime = MIN_REDO_QUE_TAKE_DELAY;
     uint32 tail = pg_atomic_read_u32(&queue->readTail);
     while (SPACE(head, tail, queue->mask) == 0) {
-        if (queue->callBackFunc != NULL) {
-            queue->callBackFunc();
-        }
+        SPSCBackoff(queue, &count, &sleeptime, MAX_REDO_QUE_TAKE_DELAY);
         tail = pg_atomic_read_u32(&queue->readTail);
     }
+    return tail;
+}
 
-    /*
-     * Make sure the following write to the buffer happens after the read
-     * of the tail.  Combining this with the corresponding barrier in Take()
-     * which guarantees that the tail is updated after reading the buffer,
-     * we can be sure that we cannot update a slot's value before it has
-     * been read.
-     */
-    pg_memory_barrier();
-    uint32 tmpCnt = COUNT(head, tail, queue->mask);
-    if (tmpCnt > queue->maxUsage) {
-        pg_atomic_write_u32(&queue->maxUsage, tmpCnt);
-    }
+bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element)
+{
+    return SPSCBlockingQueuePutN(queue, &element, 1);
+}
 
-    queue->buffer[head] = element;
+/*
+ * Append n elements in order.  Each run of elements that fits in the free
+ * space is published with one barrier and one index update, so the
+ * consumer sees the whole run at once.
+ */
+bool SPSCBlockingQueuePutN(SPSCBlockingQueue *queue, void **elements, uint32 n)
+{
+    uint32 head = pg_atomic_read_u32(&queue->writeHead);
+    uint32 done = 0;
+
+    while (done < n) {
+        uint32 tail = SPSCWaitForSpace(queue, head);
+
+        /*
+         * Make sure the following write to the buffer happens after the read
+         * of the tail.  Combining this with the corresponding barrier in Take()
+         * which guarantees that the tail is updated after reading the buffer,
+         * we can be sure that we cannot update a slot's value before it has
+         * been read.
+         */
+        pg_memory_barrier();
+        uint32 batch = Min(SPACE(head, tail, queue->mask), n - done);
+        uint32 tmpCnt = COUNT(head, tail, queue->mask) + batch;
+        if (tmpCnt > queue->maxUsage) {
+            pg_atomic_write_u32(&queue->maxUsage, tmpCnt);
+        }
+
+        for (uint32 i = 0; i < batch; i++) {
+            queue->buffer[(head + i) & queue->mask] = elements[done + i];
+        }
 
-    /* Make sure the index is updated after the buffer has been written. */
-    pg_write_barrier();
+        /* Make sure the index is updated after the buffer has been written. */
+        pg_write_barrier();
 
-    pg_atomic_write_u32(&queue->writeHead, (head + 1) & queue->mask);
+        head = (head + batch) & queue->mask;
+        pg_atomic_write_u32(&queue->writeHead, head);
+        done += batch;
+    }
     return true;
 }
 
@@ -125,27 +186,8 @@ void *SPSCBlockingQueueTake(SPSCBlockingQueue *queue)
 {
     uint32 head;
     uint32 tail;
-    uint32 count = 0;
-    long sleeptime;
     tail = pg_atomic_read_u32(&queue->readTail);
-    head = pg_atomic_read_u32(&queue->writeHead);
-    while (COUNT(head, tail, queue->mask) == 0) {
-        ++count;
-        /* here we sleep, let the cpu to do other important work */
-        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
-            if (t_thrd.page_redo_cxt.sleep_long)
-                sleeptime = MAX_REDO_QUE_IDEL_TAKE_DELAY;
-            else
-                sleeptime = MAX_REDO_QUE_TAKE_DELAY;
-            pg_usleep(sleeptime);
-        }
-        if (queue->callBackFunc != NULL) {
-            queue->callBackFunc();
-        }
-        head = pg_atomic_read_u32(&queue->writeHead);
-    }
-
-    t_thrd.page_redo_cxt.sleep_long = false;
+    head = SPSCWaitForElements(queue, tail);
     /* Make sure the buffer is read after the index. */
     pg_read_barrier();
 
@@ -162,27 +204,9 @@ bool SPSCBlockingQueueGetAll(SPSCBlockingQueue *queue, void ***eleArry, uint32 *
 {
     uint32 head;
     uint32 tail;
-    uint32 count = 0;
-    long sleeptime;
 
     tail = pg_atomic_read_u32(&queue->readTail);
-    head = pg_atomic_read_u32(&queue->writeHead);
-    while (COUNT(head, tail, queue->mask) == 0) {
-        ++count;
-        /* here we sleep, let the cpu to do other important work */
-        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
-            if (t_thrd.page_redo_cxt.sleep_long)
-                sleeptime = MAX_REDO_QUE_IDEL_TAKE_DELAY;
-            else
-                sleeptime = MAX_REDO_QUE_TAKE_DELAY;
-            pg_usleep(sleeptime);
-        }
-        if (queue->callBackFunc != NULL) {
-            queue->callBackFunc();
-        }
-        head = pg_atomic_read_u32(&queue->writeHead);
-    }
-    t_thrd.page_redo_cxt.sleep_long = false;
+    head = SPSCWaitForElements(queue, tail);
     /* Make sure the buffer is read after the index. */
     pg_read_barrier();
     head = head & (queue->mask);
@@ -233,26 +257,8 @@ void *SPSCBlockingQueueTop(SPSCBlockingQueue *queue)
 {
     uint32 head;
     uint32 tail;
-    uint32 count = 0;
-    long sleeptime;
     tail = pg_atomic_read_u32(&queue->readTail);
-    head = pg_atomic_read_u32(&queue->writeHead);
-    while (COUNT(head, tail, queue->mask) == 0) {
-        ++count;
-        /* here we sleep, let the cpu to do other important work */
-        if ((count & SLEEP_COUNT_QUE_TAKE) == SLEEP_COUNT_QUE_TAKE) {
-            if (t_thrd.page_redo_cxt.sleep_long)
-                sleeptime = MAX_REDO_QUE_IDEL_TAKE_DELAY;
-            else
-                sleeptime = MAX_REDO_QUE_TAKE_DELAY;
-            pg_usleep(sleeptime);
-        }
-        if (queue->callBackFunc != NULL) {
-            queue->callBackFunc();
-        }
-        head = pg_atomic_read_u32(&queue->writeHead);
-    }
-    t_thrd.page_redo_cxt.sleep_long = false;
+    head = SPSCWaitForElements(queue, tail);
     pg_read_barrier();
     void *elem = queue->buffer[tail];
     return elem;
@@ -212,6 +212,14 @@ void redo_get_worker_info_text(char *info, uint32 max_info_len)
                              worker[i].redo_rec_count);
         securec_check_ss(errorno, "\0", "\0");
     }
+
+    /* one extra line for the redo prefetcher, REDO_WORKER_INFO_BUFFER_SIZE leaves room for it */
+    if (g_instance.comm_cxt.predo_cxt.redoPf.prefetch_issued + g_instance.comm_cxt.predo_cxt.redoPf.prefetch_hit > 0) {
+        errorno = snprintf_s(info + strlen(info), max_info_len - strlen(info), max_info_len - strlen(info) - 1,
+                             "\nprefetch issued:%lu hit:%lu", g_instance.comm_cxt.predo_cxt.redoPf.prefetch_issued,
+                             g_instance.comm_cxt.predo_cxt.redoPf.prefetch_hit);
+        securec_check_ss(errorno, "\0", "\0");
+    }
 }
 
 Datum redo_get_worker_info()
@@ -267,10 +275,11 @@ void print_stats_file(RedoStatsData *stats)
          errmsg("[REDO_STATS]print_stats_file: the basic statistic during redo are as follows : "
                 "redo_start_ptr:%lu, redo_start_time:%ld, redo_done_time:%ld, curr_time:%ld, min_recovery_point:%lu, "
                 "read_ptr:%lu, last_replayed_read_Ptr:%lu, recovery_done_ptr:%lu, speed:%u KB/s, local_max_lsn:%lu, "
-                "worker_info_len:%u",
+                "prefetch_issued:%lu, prefetch_hit:%lu, worker_info_len:%u",
                 stats->redo_start_ptr, stats->redo_start_time, stats->redo_done_time, stats->curr_time,
                 stats->min_recovery_point, stats->read_ptr, stats->last_replayed_read_ptr, stats->recovery_done_ptr,
-                stats->speed_according_seg, stats->local_max_lsn, stats->worker_info_len)));
+                stats->speed_according_seg, stats->local_max_lsn, stats->prefetch_issued, stats->prefetch_hit,
+                stats->worker_info_len)));
 
     for (type = 0; type < WAIT_REDO_NUM; type++) {
         ereport(LOG, (errmodule(MOD_REDO), errcode(ERRCODE_LOG),
@@ -344,6 +353,8 @@ void redo_get_statistic(RedoStatsData *stat, uint64 speed)
     stat->recovery_done_ptr = g_instance.comm_cxt.predo_cxt.redoPf.recovery_done_ptr;
     stat->speed_according_seg = speed;
     stat->local_max_lsn = g_instance.comm_cxt.predo_cxt.redoPf.local_max_lsn;
+    stat->prefetch_issued = g_instance.comm_cxt.predo_cxt.redoPf.prefetch_issued;
+    stat->prefetch_hit = g_instance.comm_cxt.predo_cxt.redoPf.prefetch_hit;
 
     for (type = 0; type < WAIT_REDO_NUM; type++) {
         stat->wait_info[type] = GetRedoIoEvent(redo_get_event_type_by_wait_type(type));
@@ -75,6 +75,7 @@
 #include "replication/logical.h"
 #include "replication/logicallauncher.h"
 #include "replication/walsender.h"
+#include "replication/walsender_private.h"
 #include "replication/syncrep.h"
 #include "replication/origin.h"
 #include "storage/lmgr.h"
@@ -849,8 +850,16 @@ static void AssignTransactionId(TransactionState s)
 
         /*
          * ensure this test matches similar one in RecoverPreparedTransactions()
+         *
+         * With wal_level = logical and streaming enabled the assignment is
+         * logged right away, so that logical decoding knows the toplevel
+         * transaction of a subxact before its first change and can stream it
+         * while still in progress. That costs one small record per
+         * subtransaction, which is why the decoder only streams when the
+         * same setting is on.
          */
-        if (t_thrd.xact_cxt.nUnreportedXids >= PGPROC_MAX_CACHED_SUBXIDS || log_unknown_top) {
+        if (t_thrd.xact_cxt.nUnreportedXids >= PGPROC_MAX_CACHED_SUBXIDS || log_unknown_top ||
+            (XLogLogicalInfoActive() && u_sess->attr.attr_storage.enable_logical_replication_streaming)) {
             xl_xact_assignment xlrec;
 
             /*
@@ -1406,6 +1415,78 @@ void XLogInsertStandbyCSNCommitting(TransactionId xid, CommitSeqNo csn, Transact
  *						CommitTransaction stuff
  * ----------------------------------------------------------------
  */
+/*
+ * Can the current commit release its locks before its commit record is
+ * flushed and replicated?  Commits that drop relations or that some command
+ * asked to be synchronous keep the old protocol, as does DCF.
+ */
+static bool XactEarlyLockReleaseAllowed(int nrels)
+{
+    return u_sess->attr.attr_storage.enable_early_lock_release &&
+        u_sess->attr.attr_storage.guc_synchronous_commit > SYNCHRONOUS_COMMIT_OFF &&
+        !t_thrd.xact_cxt.forceSyncCommit && nrels == 0 && !IsInitdb &&
+        !g_instance.attr.attr_storage.dcf_attr.enable_dcf;
+}
+
+/*
+ * Advertise an early-released commit record, see elrCommitLSN.
+ */
+static void XactAdvanceEarlyReleaseLSN(XLogRecPtr commitLSN)
+{
+    pg_atomic_uint64* elrLSN = &t_thrd.walsender_cxt.WalSndCtl->elrCommitLSN;
+    uint64 cur = pg_atomic_read_u64(elrLSN);
+
+    while (cur < commitLSN) {
+        if (pg_atomic_compare_exchange_u64(elrLSN, &cur, commitLSN)) {
+            break;
+        }
+    }
+}
+
+/*
+ * Finish a commit whose WAL flush and synchronous replication wait were
+ * postponed by early lock release.  Called at the end of CommitTransaction,
+ * after our locks are gone but before the client learns about the commit.
+ *
+ * A transaction that wrote no WAL of its own may still have read rows of an
+ * early-released commit, so it waits for the newest such commit instead.
+ */
+static void XactFinishEarlyLockRelease(void)
+{
+    XLogRecPtr waitLSN = t_thrd.xact_cxt.elrWaitLSN;
+
+    if (XLogRecPtrIsInvalid(waitLSN)) {
+        if (!u_sess->attr.attr_storage.enable_early_lock_release ||
+            u_sess->attr.attr_storage.guc_synchronous_commit <= SYNCHRONOUS_COMMIT_OFF ||
+            t_thrd.walsender_cxt.WalSndCtl == NULL) {
+            return;
+        }
+
+        waitLSN = pg_atomic_read_u64(&t_thrd.walsender_cxt.WalSndCtl->elrCommitLSN);
+        if (XLogRecPtrIsInvalid(waitLSN)) {
+            return;
+        }
+    }
+    t_thrd.xact_cxt.elrWaitLSN = InvalidXLogRecPtr;
+
+    XLogWaitFlush(waitLSN);
+
+    if (u_sess->attr.attr_storage.guc_synchronous_commit > SYNCHRONOUS_COMMIT_LOCAL_FLUSH) {
+        /* unlocked peek; SyncRepWaitForLSN rechecks under SyncRepLock */
+        int mode = u_sess->attr.attr_storage.sync_rep_wait_mode;
+        if (XLByteLE(waitLSN, t_thrd.walsender_cxt.WalSndCtl->lsn[mode])) {
+            return;
+        }
+#ifndef ENABLE_MULTIPLE_NODES
+        if (g_instance.attr.attr_storage.enable_save_confirmed_lsn) {
+            t_thrd.proc->syncSetConfirmedLSN = waitLSN;
+        }
+#endif
+        (void)SyncRepWaitForLSN(waitLSN, false);
+        g_instance.comm_cxt.localinfo_cxt.set_term = true;
+    }
+}
+
 /*
  *	RecordTransactionCommit
  *
@@ -1740,8 +1821,21 @@ static TransactionId RecordTransactionCommit(void)
      * the COMMIT record is flushed to disk.  We do allow asynchronous commit
      * if all to-be-deleted tables are temporary though, since they are lost
      * anyway if we crash.)
-     */
-    if ((wrote_xlog && u_sess->attr.attr_storage.guc_synchronous_commit > SYNCHRONOUS_COMMIT_OFF) ||
+     *
+     * With enable_early_lock_release, an ordinary synchronous commit is
+     * recorded like an asynchronous one, so that our locks and our place in
+     * the procarray are given up right away; CommitTransaction then waits for
+     * the flush and the standbys once the locks are gone, before the client
+     * is told that we committed.  A transaction that goes on to modify what
+     * we wrote writes a later commit record, so its own wait covers ours.
+     */
+    if (markXidCommitted && wrote_xlog && XactEarlyLockReleaseAllowed(nrels)) {
+        t_thrd.xact_cxt.elrWaitLSN = t_thrd.xlog_cxt.XactLastRecEnd;
+        XactAdvanceEarlyReleaseLSN(t_thrd.xlog_cxt.XactLastRecEnd);
+
+        t_thrd.pgxact->needToSyncXid |= SNAPSHOT_UPDATE_NEED_SYNC;
+        TransactionIdAsyncCommitTree(xid, nchildren, children, t_thrd.xlog_cxt.XactLastRecEnd, GetCommitCsn());
+    } else if ((wrote_xlog && u_sess->attr.attr_storage.guc_synchronous_commit > SYNCHRONOUS_COMMIT_OFF) ||
         t_thrd.xact_cxt.forceSyncCommit || nrels > 0) {
         /*
          * Synchronous commit case:
@@ -3136,6 +3230,9 @@ static void CommitTransaction(bool STP_commit)
 
     RESUME_INTERRUPTS();
 
+    /* Locks are released, now wait for the commit record if we deferred that */
+    XactFinishEarlyLockRelease();
+
     AtEOXact_Proceed_PatchSeq();
     AtEOXact_Remote();
     /* flush all profile log about this worker thread */
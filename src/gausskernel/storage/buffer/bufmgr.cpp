@@ -401,13 +401,43 @@ void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum)
         }
     }
 
+    (void)PrefetchSharedBuffer(reln->rd_smgr, forkNum, blockNum);
+
+    /*
+     * If the block *is* in buffers, we do nothing.  This is not really
+     * ideal: the block might be just about to be evicted, which would be
+     * stupid since we know we are going to need it soon.  But the only
+     * easy answer is to bump the usage_count, which does not seem like a
+     * great solution: when the caller does ultimately touch the block,
+     * usage_count would get bumped again, resulting in too much
+     * favoritism for blocks that are involved in a prefetch sequence. A
+     * real fix would involve some additional per-buffer state, and it's
+     * not clear that there's enough of a problem to justify that.
+     */
+#endif /* USE_PREFETCH && USE_POSIX_FADVISE */
+}
+
+/*
+ * PrefetchSharedBuffer -- initiate asynchronous read of a block unless it is
+ * already in shared buffers
+ *
+ * Works on the smgr level, so it can be used without a relcache entry, e.g.
+ * by the redo prefetcher. Returns true if the block was found in shared
+ * buffers and nothing had to be done. No-op returning true if prefetching
+ * isn't compiled in.
+ */
+bool PrefetchSharedBuffer(SMgrRelation smgr, ForkNumber forkNum, BlockNumber blockNum)
+{
+#if defined(USE_PREFETCH) && defined(USE_POSIX_FADVISE)
     BufferTag new_tag;          /* identity of requested block */
     uint32 new_hash;            /* hash value for newTag */
     LWLock *new_partition_lock; /* buffer partition lock for it */
     int buf_id;
 
+    Assert(BlockNumberIsValid(blockNum));
+
     /* create a tag so we can lookup the buffer */
-    INIT_BUFFERTAG(new_tag, reln->rd_smgr->smgr_rnode.node, forkNum, blockNum);
+    INIT_BUFFERTAG(new_tag, smgr->smgr_rnode.node, forkNum, blockNum);
 
     /* determine its hash code and partition lock ID */
     new_hash = BufTableHashCode(&new_tag);
@@ -420,21 +450,11 @@ void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum)
 
     /* If not in buffers, initiate prefetch */
     if (buf_id < 0) {
-        smgrprefetch(reln->rd_smgr, forkNum, blockNum);
+        smgrprefetch(smgr, forkNum, blockNum);
+        return false;
     }
-
-    /*
-     * If the block *is* in buffers, we do nothing.  This is not really
-     * ideal: the block might be just about to be evicted, which would be
-     * stupid since we know we are going to need it soon.  But the only
-     * easy answer is to bump the usage_count, which does not seem like a
-     * great solution: when the caller does ultimately touch the block,
-     * usage_count would get bumped again, resulting in too much
-     * favoritism for blocks that are involved in a prefetch sequence. A
-     * real fix would involve some additional per-buffer state, and it's
-     * not clear that there's enough of a problem to justify that.
-     */
 #endif /* USE_PREFETCH && USE_POSIX_FADVISE */
+    return true;
 }
 
 /*
@@ -5530,6 +5550,67 @@ void FlushRelationBuffers(Relation rel, HTAB *hashtbl)
     gstrace_exit(GS_TRC_ID_FlushRelationBuffers);
 }
 
+/*
+ * FlushRelFileNodeAllBuffersUsingHash - This function writes out all dirty
+ * pages of every relation in relfilenode_hashtbl with a single pass over the
+ * buffer pool.  It's equivalent to calling FlushRelationBuffers for each of
+ * them.  Keys must have bucketNode set to InvalidBktId and opt cleared, so
+ * that bucket buffers are matched by their relation.
+ */
+void FlushRelFileNodeAllBuffersUsingHash(HTAB *relfilenode_hashtbl)
+{
+    int i;
+    BufferDesc *buf_desc = NULL;
+    uint32 buf_state;
+
+    /* Make sure we can handle the pin inside the loop */
+    ResourceOwnerEnlargeBuffers(t_thrd.utils_cxt.CurrentResourceOwner);
+    for (i = 0; i < SegmentBufferStartID; i++) {
+        bool found = false;
+        buf_desc = GetBufferDescriptor(i);
+
+        /*
+         * As in DropRelFileNodeAllBuffersUsingHash, an unlocked precheck
+         * should be safe and saves some cycles.
+         */
+        RelFileNode rd_node_snapshot = buf_desc->tag.rnode;
+        rd_node_snapshot.bucketNode = InvalidBktId;
+        rd_node_snapshot.opt = 0;
+        (void)hash_search(relfilenode_hashtbl, &rd_node_snapshot, HASH_FIND, &found);
+        if (!found) {
+            continue;
+        }
+
+        /* If page_writer is enabled, we just wait for the page_writer to flush the buffer. */
+        if (dw_page_writer_running()) {
+            for (;;) {
+                buf_state = LockBufHdr(buf_desc);
+                if (RelFileNodeRelEquals(buf_desc->tag.rnode, rd_node_snapshot) &&
+                    dw_buf_valid_aio_finished(buf_desc, buf_state) && dw_buf_valid_dirty(buf_state)) {
+                    UnlockBufHdr(buf_desc, buf_state);
+                    pg_usleep(MILLISECOND_TO_MICROSECOND);
+                } else {
+                    UnlockBufHdr(buf_desc, buf_state);
+                    break;
+                }
+            }
+            continue;
+        }
+
+        buf_state = LockBufHdr(buf_desc);
+        if (!RelFileNodeRelEquals(buf_desc->tag.rnode, rd_node_snapshot) || !dw_buf_valid_dirty(buf_state)) {
+            UnlockBufHdr(buf_desc, buf_state);
+            continue;
+        }
+
+        PinBuffer_Locked(buf_desc);
+        (void)LWLockAcquire(buf_desc->content_lock, LW_SHARED);
+        FlushBuffer(buf_desc, NULL);
+        LWLockRelease(buf_desc->content_lock);
+        UnpinBuffer(buf_desc, true);
+    }
+}
+
 /* ---------------------------------------------------------------------
  *		FlushDatabaseBuffers
  *
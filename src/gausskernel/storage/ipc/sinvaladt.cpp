@@ -29,6 +29,7 @@
 #include "storage/spin.h"
 #include "gs_thread.h"
 #include "threadpool/threadpool.h"
+#include "utils/globalplancore.h"
 
 /*
  * Conceptually, the shared cache invalidation messages are stored in an
@@ -96,6 +97,20 @@
  * read maxMsgNum if you are not holding SInvalWriteLock, and you need the
  * spinlock to write maxMsgNum unless you are holding both locks.)
  *
+ * Each ProcState also records the database its owner is interested in.
+ * Catalog, relcache, partcache, relmap and function messages carry the OID
+ * of the database they concern (or InvalidOid for shared objects), so a
+ * writer only sets hasMessages for backends of that database; smgr messages
+ * still go to everyone because any backend may hold smgr entries of other
+ * databases.  A backend whose hasMessages flag is clear therefore has nothing
+ * relevant between its nextMsgNum and maxMsgNum, and SICleanupQueue simply
+ * advances it instead of counting it as "behind".  This keeps a burst of DDL
+ * in one database (say a partition rotation) from signaling or resetting
+ * sessions connected to the other databases.  A dbId of InvalidOid means the
+ * slot wants every message; that is the case until the backend has chosen
+ * its database, and always for the thread-level slots of pool workers, which
+ * serve sessions of any database.
+ *
  * Note: since maxMsgNum is an int and hence presumably atomically readable/
  * writable, the spinlock might seem unnecessary.  The reason it is needed
  * is to provide a memory barrier: we need to be sure that messages written
@@ -153,6 +168,12 @@ typedef struct ProcState {
      */
     bool sendOnly; /* backend only sends, never receives */
 
+    /*
+     * Database whose messages this backend wants, or InvalidOid for all of
+     * them.  Only changed while holding SInvalWriteLock.
+     */
+    Oid dbId;
+
     /*
      * Next LocalTransactionId to use for each idle backend slot.  We keep
      * this here because it is indexed by BackendId and it is convenient to
@@ -259,6 +280,7 @@ void CreateSharedInvalidationState(void)
         t_thrd.shemem_ptr_cxt.shmInvalBuffer->procState[i].resetState = false;
         t_thrd.shemem_ptr_cxt.shmInvalBuffer->procState[i].signaled = false;
         t_thrd.shemem_ptr_cxt.shmInvalBuffer->procState[i].hasMessages = false;
+        t_thrd.shemem_ptr_cxt.shmInvalBuffer->procState[i].dbId = InvalidOid;
         t_thrd.shemem_ptr_cxt.shmInvalBuffer->procState[i].nextLXID = InvalidLocalTransactionId;
     }
 }
@@ -328,6 +350,7 @@ static void SharedInvalReserveBackendInit(bool sendOnly)
     stateP->signaled = false;
     stateP->hasMessages = false;
     stateP->sendOnly = sendOnly;
+    stateP->dbId = InvalidOid;
 
     LWLockRelease(SInvalWriteLock);
 }
@@ -394,6 +417,7 @@ static void SharedInvalWorkSessionInit(bool sendOnly)
     stateP->signaled = false;
     stateP->hasMessages = false;
     stateP->sendOnly = sendOnly;
+    stateP->dbId = InvalidOid;
 
     LWLockRelease(SInvalWriteLock);
 }
@@ -457,6 +481,7 @@ static void CleanupInvalidationState(int status, Datum arg)
     stateP->nextMsgNum = 0;
     stateP->resetState = false;
     stateP->signaled = false;
+    stateP->dbId = InvalidOid;
 
     /* Recompute index of last active backend */
     for (i = segP->lastBackend; i > 0; i--) {
@@ -498,6 +523,7 @@ void CleanupWorkSessionInvalidation(void)
     stateP->nextMsgNum = 0;
     stateP->resetState = false;
     stateP->signaled = false;
+    stateP->dbId = InvalidOid;
 
     /* Recompute index of last active backend */
     for (i = segP->lastBackend; i > 0; i--) {
@@ -510,6 +536,68 @@ void CleanupWorkSessionInvalidation(void)
     LWLockRelease(SInvalWriteLock);
 }
 
+/*
+ * SharedInvalSetDatabase
+ *		Restrict the current backend's sinval slot to messages of dbId
+ *
+ * Called once the backend has locked its database.  The thread-level slot of
+ * a pool worker is left alone because the worker serves sessions of every
+ * database.  The global plan cache looks at messages of all databases, so no
+ * filtering is done while it is enabled.
+ */
+void SharedInvalSetDatabase(Oid dbId)
+{
+    SISeg* segP = t_thrd.shemem_ptr_cxt.shmInvalBuffer;
+    ProcState* stateP = NULL;
+
+    if (ENABLE_GPC) {
+        return;
+    }
+
+    if (IS_THREAD_POOL_WORKER) {
+        if (u_sess->session_ctr_index < GLOBAL_RESERVE_SESSION_NUM) {
+            return;
+        }
+        stateP = &segP->procState[u_sess->session_ctr_index];
+    } else {
+        if (t_thrd.proc_cxt.MyBackendId == InvalidBackendId) {
+            return;
+        }
+        stateP = &segP->procState[t_thrd.proc_cxt.MyBackendId - 1];
+    }
+
+    LWLockAcquire(SInvalWriteLock, LW_EXCLUSIVE);
+    stateP->dbId = dbId;
+    LWLockRelease(SInvalWriteLock);
+}
+
+/*
+ * SIMessageDatabase
+ *		Database a message is relevant to, or InvalidOid if it concerns all
+ */
+static inline Oid SIMessageDatabase(const SharedInvalidationMessage* msg)
+{
+    if (msg->id >= 0) {
+        return msg->cc.dbId;
+    }
+
+    switch (msg->id) {
+        case SHAREDINVALCATALOG_ID:
+            return msg->cat.dbId;
+        case SHAREDINVALRELCACHE_ID:
+            return msg->rc.dbId;
+        case SHAREDINVALPARTCACHE_ID:
+            return msg->pc.dbId;
+        case SHAREDINVALRELMAP_ID:
+            return msg->rm.dbId;
+        case SHAREDINVALFUNC_ID:
+            return msg->fm.dbId;
+        default:
+            /* smgr entries may be open for relations of any database */
+            return InvalidOid;
+    }
+}
+
 /*
  * BackendIdGetProc
  *		Get the PGPROC structure for a backend, given the backend ID.
@@ -558,6 +646,9 @@ void SIInsertDataEntries(const SharedInvalidationMessage* data, int n)
         int numMsgs;
         int max;
         int i;
+        Oid msgDbs[WRITE_QUANTUM];
+        int nMsgDbs = 0;
+        bool wakeAll = false;
 
         n -= nthistime;
 
@@ -586,6 +677,22 @@ void SIInsertDataEntries(const SharedInvalidationMessage* data, int n)
         max = segP->maxMsgNum;
 
         while (nthistime-- > 0) {
+            Oid msgDb = SIMessageDatabase(data);
+
+            /* remember which databases this batch touches */
+            if (msgDb == InvalidOid) {
+                wakeAll = true;
+            } else if (!wakeAll) {
+                for (i = 0; i < nMsgDbs; i++) {
+                    if (msgDbs[i] == msgDb) {
+                        break;
+                    }
+                }
+                if (i == nMsgDbs) {
+                    msgDbs[nMsgDbs++] = msgDb;
+                }
+            }
+
             segP->buffer[max % MAXNUMMESSAGES] = *data++;
             max++;
         }
@@ -602,17 +709,32 @@ void SIInsertDataEntries(const SharedInvalidationMessage* data, int n)
 
         /*
          * Now that the maxMsgNum change is globally visible, we give everyone
-         * a swift kick to make sure they read the newly added messages.
-         * Releasing SInvalWriteLock will enforce a full memory barrier, so
-         * these (unlocked) changes will be committed to memory before we exit
-         * the function.
+         * interested a swift kick to make sure they read the newly added
+         * messages.  Releasing SInvalWriteLock will enforce a full memory
+         * barrier, so these (unlocked) changes will be committed to memory
+         * before we exit the function.
          */
         for (i = 0; i < segP->lastBackend; i++) {
             ProcState* stateP = &segP->procState[i];
 
-            if (stateP->procPid != 0) {
-                stateP->hasMessages = true;
+            if (stateP->procPid == 0) {
+                continue;
             }
+
+            if (!wakeAll && stateP->dbId != InvalidOid) {
+                int j;
+
+                for (j = 0; j < nMsgDbs; j++) {
+                    if (msgDbs[j] == stateP->dbId) {
+                        break;
+                    }
+                }
+                if (j == nMsgDbs) {
+                    continue;
+                }
+            }
+
+            stateP->hasMessages = true;
         }
 
         LWLockRelease(SInvalWriteLock);
@@ -801,6 +923,17 @@ void SICleanupQueue(bool callerHasWriteLock, int minFree)
             continue;
         }
 
+        /*
+         * Nothing since nextMsgNum was relevant to this backend, so it can be
+         * moved to the end of the queue without reading anything.  No reader
+         * is running concurrently since we hold SInvalReadLock exclusively.
+         */
+        if (!stateP->hasMessages) {
+            stateP->nextMsgNum = segP->maxMsgNum;
+            stateP->signaled = false;
+            continue;
+        }
+
         /*
          * If we must free some space and this backend is preventing it, force
          * him into reset state and then ignore until he catches up.
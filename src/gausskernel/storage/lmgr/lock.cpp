@@ -132,6 +132,7 @@ static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
 static bool FastPathUnGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode);
 static bool FastPathTransferRelationLocks(LockMethod lockMethodTable, const LOCKTAG *locktag, uint32 hashcode);
 static PROCLOCK *FastPathGetRelationLockEntry(LOCALLOCK *locallock);
+static inline void FastPathLocalUseCountsInit(void);
 static LockAcquireResult LockAcquireExtendedXC(const LOCKTAG *locktag, LOCKMODE lockmode, bool sessionLock,
                                                bool dontWait, bool reportMemoryError, bool only_increment,
                                                bool allow_con_update = false, int waitSec = 0);
@@ -773,45 +774,56 @@ static LockAcquireResult LockAcquireExtendedXC(const LOCKTAG *locktag, LOCKMODE
     }
     /*
      * Attempt to take lock via fast path, if eligible.  But if we remember
-     * having filled up the fast path array, we don't attempt to make any
-     * further use of it until we release some locks.  It's possible that some
-     * other backend has transferred some of those locks to the shared hash
-     * table, leaving space free, but it's not worth acquiring the LWLock just
-     * to check.  It's also possible that we're acquiring a second or third
-     * lock type on a relation we have already locked using the fast-path, but
-     * for now we don't worry about that case either.
+     * having filled up the slot group this relation maps to, we don't attempt
+     * to make any further use of it until we release some locks.  It's
+     * possible that some other backend has transferred some of those locks to
+     * the shared hash table, leaving space free, but it's not worth acquiring
+     * the LWLock just to check.  It's also possible that we're acquiring a
+     * second or third lock type on a relation we have already locked using the
+     * fast-path, but for now we don't worry about that case either.
      */
-    if (EligibleForRelationFastPath(locktag, lockmode) &&
-        (uint32)t_thrd.storage_cxt.FastPathLocalUseCount < FP_LOCK_SLOTS_PER_BACKEND) {
-        uint32 fasthashcode = FastPathStrongLockHashPartition(hashcode);
-        bool acquired = false;
+    if (EligibleForRelationFastPath(locktag, lockmode)) {
+        FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
+        uint32 group = FAST_PATH_REL_GROUP(tag);
+        bool overflow = true;
 
-        /*
-         * LWLockAcquire acts as a memory sequencing point, so it's safe to
-         * assume that any strong locker whose increment to
-         * FastPathStrongRelationLocks->counts becomes visible after we test
-         * it has yet to begin to transfer fast-path locks.
-         */
-        LWLockAcquire(t_thrd.proc->backendLock, LW_EXCLUSIVE);
-        if (t_thrd.storage_cxt.FastPathStrongRelationLocks->count[fasthashcode] != 0)
-            acquired = false;
-        else {
-            FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
-            acquired = FastPathGrantRelationLock(tag, lockmode);
-        }
+        FastPathLocalUseCountsInit();
+        if (t_thrd.storage_cxt.FastPathLocalUseCounts[group] < FP_LOCK_SLOTS_PER_GROUP) {
+            uint32 fasthashcode = FastPathStrongLockHashPartition(hashcode);
+            bool acquired = false;
 
-        LWLockRelease(t_thrd.proc->backendLock);
-        if (acquired) {
             /*
-             * The locallock might contain stale pointers to some old shared
-             * objects; we MUST reset these to null before considering the
-             * lock to be acquired via fast-path.
+             * LWLockAcquire acts as a memory sequencing point, so it's safe to
+             * assume that any strong locker whose increment to
+             * FastPathStrongRelationLocks->counts becomes visible after we test
+             * it has yet to begin to transfer fast-path locks.
              */
-            locallock->lock = NULL;
-            locallock->proclock = NULL;
-            GrantLockLocal(locallock, owner);
-            instr_stmt_report_lock(LOCK_END, lockmode);
-            return LOCKACQUIRE_OK;
+            LWLockAcquire(t_thrd.proc->backendLock, LW_EXCLUSIVE);
+            if (t_thrd.storage_cxt.FastPathStrongRelationLocks->count[fasthashcode] != 0) {
+                acquired = false;
+                overflow = false;
+            } else {
+                acquired = FastPathGrantRelationLock(tag, lockmode);
+            }
+
+            LWLockRelease(t_thrd.proc->backendLock);
+            if (acquired) {
+                /*
+                 * The locallock might contain stale pointers to some old shared
+                 * objects; we MUST reset these to null before considering the
+                 * lock to be acquired via fast-path.
+                 */
+                locallock->lock = NULL;
+                locallock->proclock = NULL;
+                GrantLockLocal(locallock, owner);
+                instr_stmt_report_lock(LOCK_END, lockmode);
+                return LOCKACQUIRE_OK;
+            }
+        }
+
+        /* The slot group is full, so this weak lock goes to the shared table. */
+        if (overflow) {
+            instr_stmt_report_lock_fastpath_overflow();
         }
     }
 
@@ -2259,6 +2271,12 @@ void Check_FastpathBit()
     }
     /* reset fastpath bit num and use count, also report leak */
     t_thrd.storage_cxt.FastPathLocalUseCount = 0;
+    if (t_thrd.storage_cxt.FastPathLocalUseCounts != NULL) {
+        errno_t rc = memset_s(t_thrd.storage_cxt.FastPathLocalUseCounts,
+                              FP_LOCK_GROUPS_PER_BACKEND * sizeof(uint16), 0,
+                              FP_LOCK_GROUPS_PER_BACKEND * sizeof(uint16));
+        securec_check(rc, "\0", "\0");
+    }
     FAST_PATH_SET_LOCKBITS_ZERO(t_thrd.proc);
     if (leaked == true)
         ereport(WARNING, (errmsg("Fast path bit num leak.")));
@@ -2440,17 +2458,34 @@ void LockReassignCurrentOwner(void)
     }
 }
 
+/*
+ * FastPathLocalUseCountsInit
+ *		Set up the backend-private per-group use counts on first use.
+ */
+static inline void FastPathLocalUseCountsInit(void)
+{
+    if (likely(t_thrd.storage_cxt.FastPathLocalUseCounts != NULL))
+        return;
+
+    t_thrd.storage_cxt.FastPathLocalUseCounts = (uint16 *)MemoryContextAllocZero(
+        THREAD_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_STORAGE), FP_LOCK_GROUPS_PER_BACKEND * sizeof(uint16));
+}
+
 /*
  * FastPathGrantRelationLock
- *		Grant lock using per-backend fast-path array, if there is space.
+ *		Grant lock using per-backend fast-path array, if there is space in
+ *		the slot group the relation maps to.
  */
 static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
 {
-    uint32 f;
+    uint32 group = FAST_PATH_REL_GROUP(tag);
+    uint32 i;
     uint32 unused_slot = FP_LOCK_SLOTS_PER_BACKEND;
 
-    /* Scan for existing entry for this relid, remembering empty slot. */
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    /* Scan the group for existing entry for this relid, remembering empty slot. */
+    for (i = 0; i < FP_LOCK_SLOTS_PER_GROUP; i++) {
+        uint32 f = FAST_PATH_SLOT(group, i);
+
         if (FAST_PATH_GET_BITS(t_thrd.proc, f) == 0)
             unused_slot = f;
         else if (FAST_PATH_TAG_EQUALS(t_thrd.proc->fpRelId[f], tag)) {
@@ -2464,6 +2499,7 @@ static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
     if (unused_slot < FP_LOCK_SLOTS_PER_BACKEND) {
         t_thrd.proc->fpRelId[unused_slot] = tag;
         FAST_PATH_SET_LOCKMODE(t_thrd.proc, unused_slot, lockmode);
+        ++t_thrd.storage_cxt.FastPathLocalUseCounts[group];
         ++t_thrd.storage_cxt.FastPathLocalUseCount;
         return true;
     }
@@ -2475,24 +2511,30 @@ static bool FastPathGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
 /*
  * FastPathUnGrantRelationLock
  *		Release fast-path lock, if present.  Update backend-private local
- *		use count, while we're at it.
+ *		use counts of the relation's slot group, while we're at it.
  */
 static bool FastPathUnGrantRelationLock(const FastPathTag &tag, LOCKMODE lockmode)
 {
-    uint32 f;
+    uint32 group = FAST_PATH_REL_GROUP(tag);
+    uint32 i;
+    uint16 used = 0;
     bool result = false;
 
-    t_thrd.storage_cxt.FastPathLocalUseCount = 0;
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    Assert(t_thrd.storage_cxt.FastPathLocalUseCounts != NULL);
+    for (i = 0; i < FP_LOCK_SLOTS_PER_GROUP; i++) {
+        uint32 f = FAST_PATH_SLOT(group, i);
+
         if (FAST_PATH_TAG_EQUALS(t_thrd.proc->fpRelId[f], tag) && FAST_PATH_CHECK_LOCKMODE(t_thrd.proc, f, lockmode)) {
             Assert(!result);
             FAST_PATH_CLEAR_LOCKMODE(t_thrd.proc, f, lockmode);
             result = true;
-            /* we continue iterating so as to update FastPathLocalUseCount */
+            /* we continue iterating so as to update the group's use count */
         }
         if (FAST_PATH_GET_BITS(t_thrd.proc, f) != 0)
-            ++t_thrd.storage_cxt.FastPathLocalUseCount;
+            ++used;
     }
+    t_thrd.storage_cxt.FastPathLocalUseCount -= t_thrd.storage_cxt.FastPathLocalUseCounts[group] - used;
+    t_thrd.storage_cxt.FastPathLocalUseCounts[group] = used;
     return result;
 }
 
@@ -2507,21 +2549,24 @@ static bool FastPathTransferRelationLocks(LockMethod lockMethodTable, const LOCK
 {
     LWLock *partitionLock = LockHashPartitionLock(hashcode);
     FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
+    uint32 group = FAST_PATH_REL_GROUP(tag);
     uint32 i;
 
     /*
      * Every PGPROC that can potentially hold a fast-path lock is present in
      * g_instance.proc_base->allProcs.  Prepared transactions are not, but any
      * outstanding fast-path locks held by prepared transactions are
-     * transferred to the main lock table.
+     * transferred to the main lock table.  Only the slot group the relation
+     * maps to can contain it, so that is all we have to look at.
      */
     for (i = 0; i < g_instance.proc_base->allNonPreparedProcCount; i++) {
         PGPROC *proc = g_instance.proc_base_all_procs[i];
-        uint32 f;
+        uint32 j;
 
         LWLockAcquire(proc->backendLock, LW_EXCLUSIVE);
 
-        for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+        for (j = 0; j < FP_LOCK_SLOTS_PER_GROUP; j++) {
+            uint32 f = FAST_PATH_SLOT(group, j);
             uint32 lockmode;
 
             /* Look for an allocated slot matching the given relid. */
@@ -2566,11 +2611,13 @@ static PROCLOCK *FastPathGetRelationLockEntry(LOCALLOCK *locallock)
     PROCLOCK *proclock = NULL;
     LWLock *partitionLock = LockHashPartitionLock(locallock->hashcode);
     FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
-    uint32 f;
+    uint32 group = FAST_PATH_REL_GROUP(tag);
+    uint32 i;
 
     LWLockAcquire(t_thrd.proc->backendLock, LW_EXCLUSIVE);
 
-    for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+    for (i = 0; i < FP_LOCK_SLOTS_PER_GROUP; i++) {
+        uint32 f = FAST_PATH_SLOT(group, i);
         uint32 lockmode;
 
         /* Look for an allocated slot matching the given relid. */
@@ -2689,6 +2736,7 @@ VirtualTransactionId *GetLockConflicts(const LOCKTAG *locktag, LOCKMODE lockmode
     if (ConflictsWithRelationFastPath(locktag, lockmode)) {
         int i;
         FastPathTag tag = { locktag->locktag_field1, locktag->locktag_field2, locktag->locktag_field3 };
+        uint32 group = FAST_PATH_REL_GROUP(tag);
         VirtualTransactionId vxid;
 
         /*
@@ -2703,7 +2751,7 @@ VirtualTransactionId *GetLockConflicts(const LOCKTAG *locktag, LOCKMODE lockmode
          */
         for (i = 0; (unsigned int)(i) < g_instance.proc_base->allNonPreparedProcCount; i++) {
             PGPROC *proc = g_instance.proc_base_all_procs[i];
-            uint32 f;
+            uint32 j;
 
             /* A backend never blocks itself */
             if (proc == t_thrd.proc)
@@ -2711,7 +2759,8 @@ VirtualTransactionId *GetLockConflicts(const LOCKTAG *locktag, LOCKMODE lockmode
 
             LWLockAcquire(proc->backendLock, LW_SHARED);
 
-            for (f = 0; f < FP_LOCK_SLOTS_PER_BACKEND; f++) {
+            for (j = 0; j < FP_LOCK_SLOTS_PER_GROUP; j++) {
+                uint32 f = FAST_PATH_SLOT(group, j);
                 uint32 lockmask;
 
                 /* Look for an allocated slot matching the given relid. */
@@ -201,6 +201,7 @@ static const char *BuiltinTrancheNames[] = {
 
 static void RegisterLWLockTranches(void);
 static void InitializeLWLocks(int numLocks);
+static void InitializeLWLockTrancheStats(LWLockTrancheStat *stats);
 
 #ifdef LWLOCK_STATS
 typedef struct lwlock_stats_key {
@@ -483,6 +484,9 @@ Size LWLockShmemSize(void)
     /* Space for dynamic allocation counter, plus room for alignment. */
     size = add_size(size, 3 * sizeof(int) + LWLOCK_PADDED_SIZE);
 
+    /* Space for the per-tranche statistics. */
+    size = add_size(size, mul_size(LWTRANCHE_NATIVE_TRANCHE_NUM, sizeof(LWLockTrancheStat)));
+
     return size;
 }
 
@@ -492,13 +496,15 @@ Size LWLockShmemSize(void)
 void CreateLWLocks(void)
 {
     int numLocks = NumLWLocks();
-    Size spaceLocks = LWLockShmemSize();
+    Size spaceStats = mul_size(LWTRANCHE_NATIVE_TRANCHE_NUM, sizeof(LWLockTrancheStat));
+    Size spaceLocks = LWLockShmemSize() - spaceStats;
     int *LWLockCounter = NULL;
     char *ptr = NULL;
 
     StaticAssertExpr(LW_VAL_EXCLUSIVE > (uint32)MAX_BACKENDS, "MAX_BACKENDS too big for lwlock.cpp");
     /* Allocate space */
     ptr = (char *)ShmemAlloc(spaceLocks);
+    g_instance.stat_cxt.lwlockTrancheStats = (LWLockTrancheStat *)ShmemAlloc(spaceStats);
 
     /* Leave room for dynamic allocation counter */
     ptr += 2 * sizeof(int);
@@ -517,6 +523,79 @@ void CreateLWLocks(void)
 
     InitializeLWLocks(numLocks);
     RegisterLWLockTranches();
+    InitializeLWLockTrancheStats(g_instance.stat_cxt.lwlockTrancheStats);
+}
+
+/*
+ * Reset the per-tranche wait histograms and mark the tranches listed in
+ * lwlock_numa_handoff_tranches.  Must run after the tranche names are
+ * registered.
+ */
+static void InitializeLWLockTrancheStats(LWLockTrancheStat *stats)
+{
+    char *rawstring = NULL;
+    List *elemlist = NIL;
+    ListCell *l = NULL;
+
+    for (int i = 0; i < LWTRANCHE_NATIVE_TRANCHE_NUM; i++) {
+        stats[i].numaHandoff = false;
+        for (int j = 0; j < LWLOCK_WAIT_HIST_BUCKETS; j++) {
+            pg_atomic_init_u64(&stats[i].waitHist[j], 0);
+        }
+    }
+
+    if (g_instance.attr.attr_storage.lwlock_numa_handoff_tranches == NULL ||
+        g_instance.attr.attr_storage.lwlock_numa_handoff_tranches[0] == '\0') {
+        return;
+    }
+
+    rawstring = pstrdup(g_instance.attr.attr_storage.lwlock_numa_handoff_tranches);
+    if (!SplitIdentifierString(rawstring, ',', &elemlist, false, false)) {
+        ereport(WARNING, (errmsg("invalid list syntax in parameter \"lwlock_numa_handoff_tranches\"")));
+        pfree(rawstring);
+        return;
+    }
+
+    foreach (l, elemlist) {
+        const char *name = (const char *)lfirst(l);
+        bool found = false;
+
+        for (int i = 0; i < LWTRANCHE_NATIVE_TRANCHE_NUM; i++) {
+            if (LWLockTrancheArray[i] != NULL && pg_strcasecmp(LWLockTrancheArray[i], name) == 0) {
+                stats[i].numaHandoff = true;
+                found = true;
+            }
+        }
+        if (!found) {
+            ereport(WARNING, (errmsg("unrecognized LWLock tranche \"%s\" in lwlock_numa_handoff_tranches", name)));
+        }
+    }
+
+    list_free(elemlist);
+    pfree(rawstring);
+}
+
+/*
+ * Record how long an acquisition of the lock had to wait in total.
+ */
+static void LWLockReportWaitTime(const LWLock *lock, instr_time waitStart)
+{
+    instr_time waitTime;
+    uint64 us;
+    int bucket;
+
+    if (g_instance.stat_cxt.lwlockTrancheStats == NULL || lock->tranche >= LWTRANCHE_NATIVE_TRANCHE_NUM) {
+        return;
+    }
+
+    INSTR_TIME_SET_CURRENT(waitTime);
+    INSTR_TIME_SUBTRACT(waitTime, waitStart);
+    us = INSTR_TIME_GET_MICROSEC(waitTime);
+
+    /* bucket i holds waits in [2^i, 2^(i+1)) us, the first one also holds 0 */
+    bucket = (us < 2) ? 0 : pg_leftmost_one_pos32((uint32)Min(us, (uint64)PG_UINT32_MAX));
+    bucket = Min(bucket, LWLOCK_WAIT_HIST_BUCKETS - 1);
+    (void)pg_atomic_fetch_add_u64(&g_instance.stat_cxt.lwlockTrancheStats[lock->tranche].waitHist[bucket], 1);
 }
 
 /*
@@ -795,6 +874,7 @@ void LWLockInitialize(LWLock *lock, int tranche_id)
     pg_atomic_init_u32(&lock->nwaiters, 0);
 #endif
     lock->tranche = tranche_id;
+    lock->numaHandoffs = 0;
     dlist_init(&lock->waiters);
 }
 
@@ -968,6 +1048,56 @@ static void LWLockWaitListUnlock(LWLock *lock)
     Assert(old_state & LW_FLAG_LOCKED);
 }
 
+/*
+ * For tranches with numaHandoff set, move the first exclusive waiter running
+ * on the releaser's NUMA node to the head of the wait queue, so the lock and
+ * the data it protects stay in that node's caches.  This is what cohort locks
+ * do; to keep remote waiters from starving, at most LWLOCK_NUMA_HANDOFF_LIMIT
+ * handoffs in a row go to the local node before the queue head is served.
+ * Shared waiters at the head are already woken as one batch by LWLockWakeup,
+ * so they are left alone.
+ *
+ * Caller must hold the wait list lock.
+ */
+static void LWLockNumaHandoff(LWLock *lock)
+{
+    PGPROC *head = NULL;
+    dlist_iter iter;
+
+    if (t_thrd.proc == NULL || dlist_is_empty(&lock->waiters)) {
+        return;
+    }
+
+    head = dlist_container(PGPROC, lwWaitLink, dlist_head_node(&lock->waiters));
+    if (head->lwWaitMode != LW_EXCLUSIVE) {
+        return;
+    }
+    if (head->nodeno == t_thrd.proc->nodeno) {
+        lock->numaHandoffs = Min(lock->numaHandoffs + 1, LWLOCK_NUMA_HANDOFF_LIMIT);
+        return;
+    }
+    if (lock->numaHandoffs >= LWLOCK_NUMA_HANDOFF_LIMIT) {
+        /* give the remote head its turn */
+        lock->numaHandoffs = 0;
+        return;
+    }
+
+    dlist_foreach(iter, &lock->waiters)
+    {
+        PGPROC *waiter = dlist_container(PGPROC, lwWaitLink, iter.cur);
+
+        if (waiter->lwWaitMode == LW_EXCLUSIVE && waiter->nodeno == t_thrd.proc->nodeno) {
+            dlist_delete(&waiter->lwWaitLink);
+            dlist_push_head(&lock->waiters, &waiter->lwWaitLink);
+            lock->numaHandoffs++;
+            return;
+        }
+    }
+
+    /* nobody local is waiting, so the lock moves to the head's node */
+    lock->numaHandoffs = 0;
+}
+
 /*
  * Wakeup all the lockers that currently have a chance to acquire the lock.
  */
@@ -983,6 +1113,11 @@ static void LWLockWakeup(LWLock *lock)
     /* lock wait list while collecting backends to wake up */
     LWLockWaitListLock(lock);
 
+    if (lock->tranche < LWTRANCHE_NATIVE_TRANCHE_NUM && g_instance.stat_cxt.lwlockTrancheStats != NULL &&
+        g_instance.stat_cxt.lwlockTrancheStats[lock->tranche].numaHandoff) {
+        LWLockNumaHandoff(lock);
+    }
+
     dlist_foreach_modify(iter, &lock->waiters)
     {
         PGPROC *waiter = dlist_container(PGPROC, lwWaitLink, iter.cur);
@@ -1265,6 +1400,7 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
     PGPROC *proc = t_thrd.proc;
     bool result = true;
     int extraWaits = 0;
+    instr_time waitStart;
 #ifdef LWLOCK_STATS
     lwlock_stats *lwstats = NULL;
 
@@ -1274,6 +1410,7 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
     AssertArg(mode == LW_SHARED || mode == LW_EXCLUSIVE);
 
     PRINT_LWDEBUG("LWLockAcquire", lock, mode);
+    INSTR_TIME_SET_ZERO(waitStart);
 
 #ifdef LWLOCK_STATS
     /* Count lock acquisition attempts */
@@ -1383,6 +1520,9 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
         lwstats->block_count++;
 #endif
         TRACE_POSTGRESQL_LWLOCK_WAIT_START(T_NAME(lock), mode);
+        if (result) {
+            INSTR_TIME_SET_CURRENT(waitStart);
+        }
         for (;;) {
             /* "false" means cannot accept cancel/die interrupt here. */
             PGSemaphoreLock(&proc->sem, false);
@@ -1419,6 +1559,11 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
 
     TRACE_POSTGRESQL_LWLOCK_ACQUIRE(T_NAME(lock), mode);
 
+    /* result is false only if we slept at least once */
+    if (!result) {
+        LWLockReportWaitTime(lock, waitStart);
+    }
+
     forget_lwlock_acquire();
 
     /* Add lock to list of locks held by this backend */
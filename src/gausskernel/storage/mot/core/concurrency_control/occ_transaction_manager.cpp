@@ -32,7 +32,9 @@
 #include "checkpoint_manager.h"
 #include "mm_session_api.h"
 #include "mot_error.h"
+#include "db_session_statistics.h"
 #include <pthread.h>
+#include <algorithm>
 
 namespace MOT {
 DECLARE_LOGGER(OccTransactionManager, ConcurrenyControl);
@@ -46,12 +48,20 @@ OccTransactionManager::OccTransactionManager()
       m_rowsLocked(false),
       m_preAbort(true),
       m_validationNoWait(true),
+      m_adaptiveValidation(false),
+      m_waitForLocks(false),
+      m_abortTable(nullptr),
       m_isTransactionCommited(false)
 {}
 
 OccTransactionManager::~OccTransactionManager()
 {}
 
+static inline Table* GetAccessTable(const Access* access)
+{
+    return access->m_origSentinel->GetIndex()->GetTable();
+}
+
 bool OccTransactionManager::PreAbortCheck(TxnManager* txMan, GcMaintenanceInfo& gcMemoryReserve)
 {
     TxnAccess* tx = txMan->m_accessMgr;
@@ -91,12 +101,17 @@ bool OccTransactionManager::PreAbortCheck(TxnManager* txMan, GcMaintenanceInfo&
                 break;
         }
 
+        if (m_adaptiveValidation && !m_waitForLocks && GetAccessTable(ac)->IsContended()) {
+            m_waitForLocks = true;
+        }
+
         if (m_preAbort) {
             if (!QuickHeaderValidation(ac)) {
                 if (MOTEngine::GetInstance()->IsRecovering() && ResolveRecoveryOccConflict(txMan, ac) == RC_OK) {
                     (void)++itr;
                     continue;
                 }
+                m_abortTable = GetAccessTable(ac);
                 return false;
             }
         }
@@ -114,7 +129,13 @@ bool OccTransactionManager::QuickVersionCheck(const Access* access)
             return false;
         }
         MOT_ASSERT(access->m_csn == access->m_globalRow->GetCommitSequenceNumber());
-        return (access->m_csn == access->m_origSentinel->GetData()->GetCommitSequenceNumber());
+        // the row might have been evicted (and faulted in as a new row) since it was read, the changes must not
+        // be chained to the retired row
+        Row* row = static_cast<PrimarySentinel*>(access->m_origSentinel)->GetResidentData();
+        if (row != access->m_globalRow) {
+            return false;
+        }
+        return (access->m_csn == row->GetCommitSequenceNumber());
     } else {
         if (access->m_params.IsSecondaryUniqueSentinel()) {
             PrimarySentinelNode* node = static_cast<SecondarySentinelUnique*>(access->m_origSentinel)->GetTopNode();
@@ -142,12 +163,17 @@ bool OccTransactionManager::QuickInsertCheck(const Access* access)
     } else {
         if (access->m_params.IsPrimarySentinel()) {
             // For Upgrade IOD - Verify the sentinel snapshot is still valid
+            // An evicted row cannot be faulted in while the sentinel is locked, so the transaction aborts
+            Row* row = static_cast<PrimarySentinel*>(access->m_origSentinel)->GetResidentData();
+            if (row == nullptr) {
+                return false;
+            }
             if (access->m_params.IsInsertOnDeletedRow()) {
-                if (access->m_origSentinel->GetData()->IsRowDeleted() == false) {
+                if (row->IsRowDeleted() == false) {
                     return false;
                 }
             }
-            return (access->m_csn == access->m_origSentinel->GetData()->GetCommitSequenceNumber());
+            return (access->m_csn == row->GetCommitSequenceNumber());
         } else {
             if (access->m_params.IsSecondaryUniqueSentinel()) {
                 PrimarySentinelNode* node = static_cast<SecondarySentinelUnique*>(access->m_origSentinel)->GetTopNode();
@@ -194,6 +220,7 @@ bool OccTransactionManager::ValidateWriteSet(TxnManager* txMan)
     for (const auto& raPair : orderedSet) {
         const Access* ac = raPair.second;
         if (!QuickHeaderValidation(ac)) {
+            m_abortTable = GetAccessTable(ac);
             return false;
         }
     }
@@ -207,18 +234,21 @@ RC OccTransactionManager::LockHeaders(TxnManager* txMan, uint32_t& numSentinelsL
     uint64_t thdId = txMan->GetThdId();
     TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
     numSentinelsLock = 0;
-    if (m_validationNoWait) {
+    if (m_validationNoWait && !m_waitForLocks) {
+        const Access* blockedAccess = nullptr;
         while (numSentinelsLock != m_writeSetSize) {
             for (const auto& raPair : orderedSet) {
                 const Access* ac = raPair.second;
                 Sentinel* sent = ac->m_origSentinel;
                 if (!sent->TryLock(thdId)) {
+                    blockedAccess = ac;
                     break;
                 }
                 numSentinelsLock++;
                 // New insert row is already committed!
                 // Check if row has changed in sentinel
                 if (!QuickHeaderValidation(ac)) {
+                    m_abortTable = GetAccessTable(ac);
                     rc = RC_ABORT;
                     goto final;
                 }
@@ -231,12 +261,14 @@ RC OccTransactionManager::LockHeaders(TxnManager* txMan, uint32_t& numSentinelsL
                     for (const auto& acPair : orderedSet) {
                         const Access* ac = acPair.second;
                         if (!QuickHeaderValidation(ac)) {
+                            m_abortTable = GetAccessTable(ac);
                             return RC_ABORT;
                         }
                     }
                 }
                 if (!MOTEngine::GetInstance()->IsRecovering()) {
                     if (sleepTime > LOCK_TIME_OUT) {
+                        m_abortTable = (blockedAccess != nullptr) ? GetAccessTable(blockedAccess) : nullptr;
                         return RC_ABORT;
                     } else {
                         if (!IsHighContention()) {
@@ -260,6 +292,7 @@ RC OccTransactionManager::LockHeaders(TxnManager* txMan, uint32_t& numSentinelsL
             // New insert row is already committed!
             // Check if row has changed in sentinel
             if (!QuickHeaderValidation(ac)) {
+                m_abortTable = GetAccessTable(ac);
                 rc = RC_ABORT;
                 goto final;
             }
@@ -326,6 +359,10 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
     m_writeSetSize = 0;
     m_insertSetSize = 0;
     m_txnCounter++;
+    m_adaptiveValidation =
+        GetGlobalConfiguration().m_enableAdaptiveValidation && !MOTEngine::GetInstance()->IsRecovering();
+    m_waitForLocks = false;
+    m_abortTable = nullptr;
 
     if (rowCount == 0) {
         // READONLY
@@ -343,6 +380,12 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
             break;
         }
 
+        if (m_waitForLocks && m_validationNoWait) {
+            // commits on contended tables wait on the row locks instead of timing out; a row changed by the
+            // lock holder still fails the validation after the wait, only unchanged rows are saved
+            MOT::DbSessionStatisticsProvider::GetInstance().AddValidationWaitTxn();
+        }
+
         rc = LockHeaders(txMan, numSentinelLock);
         if (rc != RC_OK) {
             break;
@@ -375,9 +418,46 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
         }
     }
 
+    if (m_adaptiveValidation && (rc == RC_OK || rc == RC_ABORT) && (m_txnCounter % CONTENTION_SAMPLE_RATE) == 0) {
+        RecordContention(txMan, (rc == RC_ABORT));
+    }
+
     return rc;
 }
 
+void OccTransactionManager::RecordContention(TxnManager* txMan, bool aborted)
+{
+    // each modified table gets one sample, and the abort is charged only to the table of the conflicting row
+    constexpr uint32_t maxSampledTables = 8;
+    Table* tables[maxSampledTables];
+    uint32_t numTables = 0;
+    bool abortRecorded = false;
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        const Access* ac = raPair.second;
+        if (ac->m_type == RD || ac->m_type == RD_FOR_UPDATE) {
+            continue;
+        }
+
+        Table* table = GetAccessTable(ac);
+        if (std::find(tables, tables + numTables, table) != tables + numTables) {
+            continue;
+        }
+
+        bool tableAborted = (aborted && table == m_abortTable);
+        table->RecordValidation(tableAborted);
+        abortRecorded = abortRecorded || tableAborted;
+        tables[numTables++] = table;
+        if (numTables == maxSampledTables) {
+            break;
+        }
+    }
+
+    if (aborted && !abortRecorded && m_abortTable != nullptr) {
+        m_abortTable->RecordValidation(true);
+    }
+}
+
 RC OccTransactionManager::ResolveRecoveryOccConflict(TxnManager* txMan, Access* access)
 {
     Row* row = nullptr;
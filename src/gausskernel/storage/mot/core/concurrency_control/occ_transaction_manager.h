@@ -31,9 +31,13 @@ namespace MOT {
 // forward declaration
 class Access;
 class TxnManager;
+class Table;
 
 constexpr uint64_t LOCK_TIME_OUT = 1 << 16;
 
+/** @brief One out of this many validations is sampled for the per-table contention statistics. */
+constexpr uint64_t CONTENTION_SAMPLE_RATE = 8;
+
 struct GcMaintenanceInfo {
     GcMaintenanceInfo() = default;
     uint32_t m_version_queue = 0;
@@ -179,6 +183,9 @@ private:
     /** @brief Pre-allocates GC memory for reclamation. */
     bool ReserveGcMemory(TxnManager* txMan, const GcMaintenanceInfo& gcMemoryReserve);
 
+    /** @brief Samples the validation outcome in the tables modified by the transaction. */
+    void RecordContention(TxnManager* txMan, bool aborted);
+
     /** @var transaction counter   */
     uint64_t m_txnCounter;
 
@@ -202,6 +209,15 @@ private:
     /** @var Validate-no-wait configuration. */
     bool m_validationNoWait;
 
+    /** @var Adaptive validation is used by the current transaction. */
+    bool m_adaptiveValidation;
+
+    /** @var The current transaction waits for the row locks, as it modifies a contended table. */
+    bool m_waitForLocks;
+
+    /** @var The table of the row that failed the validation of the current transaction. */
+    Table* m_abortTable;
+
     /** @var flag indicating whether transaction committed */
     bool m_isTransactionCommited;
 };
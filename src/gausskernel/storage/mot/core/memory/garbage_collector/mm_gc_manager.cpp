@@ -25,6 +25,8 @@
 #include "mm_gc_manager.h"
 #include "mot_configuration.h"
 #include "mot_engine.h"
+#include "cycles.h"
+#include <algorithm>
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(GcManager, GC);
@@ -59,7 +61,8 @@ inline GcManager::GcManager(GC_TYPE purpose, int threadId, bool global /* = fals
       m_limboGroupAllocations(0),
       m_tid((uint16_t)threadId),
       m_purpose(purpose),
-      m_global(global)
+      m_global(global),
+      m_numaNode(MOTCurrentNumaNodeId < 0 ? 0 : MOTCurrentNumaNodeId)
 {}
 
 bool GcManager::Initialize()
@@ -228,11 +231,15 @@ void GcManager::RunQuicese()
 {
     bool isBarrierReached = false;
     GcEpochType performGCEpoch = 0;
+    uint64_t startTime = 0;
     for (uint32_t queue = 0; queue < m_GcQueues.size(); ++queue) {
         isBarrierReached = false;
         m_gcEpoch = GetGlobalEpoch();
         bool isThresholdReached = m_GcQueues[queue].IsThresholdReached();
         if (isThresholdReached) {
+            if (startTime == 0) {
+                startTime = GetSysClock();
+            }
             if (!m_isThresholdReached) {
                 m_GcQueues[queue].SetPerformGcEpoch(g_gcActiveEpoch);
             } else {
@@ -255,6 +262,82 @@ void GcManager::RunQuicese()
     GcMaintenance();
     m_isThresholdReached = false;
     m_gcEpoch = 0;
+    if (startTime != 0) {
+        MemoryStatisticsProvider::GetInstance().AddGCReclaimTime(
+            CpuCyclesLevelTime::CyclesToNanoseconds(GetSysClock() - startTime));
+    }
+}
+
+uint64_t GcManager::ReclaimIdle(GcEpochType performEpoch, uint64_t budget)
+{
+    // sessions in a transaction reclaim their own limbo when the transaction ends
+    if (m_purpose != GC_TYPE::GC_MAIN || m_isGcSessionStarted || GetTotalLimboInuseElements() == 0) {
+        return 0;
+    }
+    if (!m_managerLock.try_lock()) {
+        return 0;
+    }
+
+    // a transaction starting in the owner session waits for the lock after raising the flag, so check it again
+    uint64_t reclaimed = 0;
+    if (!m_isGcSessionStarted) {
+        GcQueue& genericQueue = m_GcQueues[static_cast<uint8_t>(GC_QUEUE_TYPE::GENERIC_QUEUE)];
+        for (uint32_t queue = 0; queue < m_GcQueues.size() && reclaimed < budget; ++queue) {
+            GcQueue& gcQueue = m_GcQueues[queue];
+            uint64_t inuseElements = gcQueue.m_stats.m_totalLimboInuseElements;
+            if (inuseElements == 0) {
+                continue;
+            }
+            gcQueue.SetPerformGcEpoch(performEpoch);
+            gcQueue.HardQuiesce(std::min(static_cast<uint64_t>(gcQueue.m_stats.m_rcuFreeCount), budget - reclaimed));
+            reclaimed += inuseElements - gcQueue.m_stats.m_totalLimboInuseElements;
+            // limbo groups belong to the owner thread pool, so removed sentinels are retired here only if the
+            // generic queue has room for them, otherwise the owner retires them on its next reclamation
+            uint64_t deletedSentinels = gcQueue.GetDeleteVector()->size();
+            if (deletedSentinels > 0 && genericQueue.GetFreeAllocations() > 2 * (deletedSentinels + 1)) {
+                gcQueue.RegisterDeletedSentinels();
+            }
+        }
+    }
+    m_managerLock.unlock();
+    return reclaimed;
+}
+
+void GcManager::ReclaimIdleSessions(int numaNode, uint64_t budget, uint32_t& cursor, GcIdleReclaimInfo& info)
+{
+    uint32_t activeConnections = 0;
+    uint16_t latestActiveTid = static_cast<uint16_t>(-1);
+    uint32_t position = 0;
+    uint32_t nextCursor = 0;
+    info.m_reclaimedElements = 0;
+    info.m_limboSizeInBytes = 0;
+    info.m_oldestEpoch = 0;
+    info.m_oldestTid = static_cast<uint16_t>(-1);
+
+    g_gcGlobalEpochLock.lock();
+    g_gcActiveEpoch = MinActiveEpoch(activeConnections, latestActiveTid);
+    GcEpochType performEpoch = g_gcActiveEpoch;
+    for (GcManager* ti = allGcManagers; ti; ti = ti->Next(), ++position) {
+        Prefetch((const void*)ti->Next());
+        GcEpochType currentEpoch = ti->m_gcEpoch;
+        if (currentEpoch > 0 && (info.m_oldestEpoch == 0 || currentEpoch < info.m_oldestEpoch)) {
+            info.m_oldestEpoch = currentEpoch;
+            info.m_oldestTid = ti->GetThreadId();
+        }
+        if (numaNode >= 0 && ti->m_numaNode != numaNode) {
+            continue;
+        }
+        if (position >= cursor && info.m_reclaimedElements < budget) {
+            info.m_reclaimedElements += ti->ReclaimIdle(performEpoch, budget - info.m_reclaimedElements);
+            if (info.m_reclaimedElements >= budget) {
+                nextCursor = position + 1;
+            }
+        }
+        info.m_limboSizeInBytes += ti->GetTotalLimboSizeInBytes();
+    }
+    g_gcGlobalEpochLock.unlock();
+    // start over when the budget ran out on the last session
+    cursor = (nextCursor < position) ? nextCursor : 0;
 }
 
 void GcManager::GcCleanAll()
@@ -47,6 +47,24 @@ uint64_t GetCurrentSnapshotCSN();
 static const char* const enGcTypes[] = {
     stringify(GC_MAIN), stringify(GC_INDEX), stringify(GC_LOG), stringify(GC_CHECKPOINT)};
 
+/**
+ * @struct GcIdleReclaimInfo
+ * @brief Outcome of a reclamation pass over the idle sessions.
+ */
+struct GcIdleReclaimInfo {
+    /** @var Number of reclaimed elements. */
+    uint64_t m_reclaimedElements;
+
+    /** @var Limbo size of the sessions of the pass NUMA node after reclamation. */
+    uint64_t m_limboSizeInBytes;
+
+    /** @var The oldest snapshot among all sessions in a transaction, or zero if there is none. */
+    GcEpochType m_oldestEpoch;
+
+    /** @var The thread holding the oldest snapshot. */
+    uint16_t m_oldestTid;
+};
+
 /**
  * @class GcManager
  * @brief Garbage-collector manager per-session
@@ -154,6 +172,21 @@ public:
     /** @brief Print report of all threads   */
     static void ReportGcAll();
 
+    /**
+     * @brief Reclaims the limbo of sessions that are not in a transaction on behalf of their owners, and advances
+     * the active epoch, so limbo neither waits for idle sessions nor for a session to reach its reclaim threshold.
+     * @param numaNode Only sessions created on this NUMA node are reclaimed, or all sessions if negative.
+     * @param budget The maximum number of elements to reclaim, bounding the time the global GC lock is held.
+     * @param[in,out] cursor Number of sessions to skip, so a pass that exhausts its budget is resumed by the next.
+     * @param[out] info The pass outcome.
+     */
+    static void ReclaimIdleSessions(int numaNode, uint64_t budget, uint32_t& cursor, GcIdleReclaimInfo& info);
+
+    int GetNumaNode() const
+    {
+        return m_numaNode;
+    }
+
     void SetThreadId(uint16_t threadId)
     {
         m_tid = threadId;
@@ -379,6 +412,15 @@ public:
         return totalLimboInuseElements;
     }
 
+    uint64_t inline GetTotalLimboSizeInBytes() const
+    {
+        uint64_t totalLimboSizeInBytes = 0;
+        for (uint32_t queue = 0; queue < m_GcQueues.size(); ++queue) {
+            totalLimboSizeInBytes += m_GcQueues[queue].m_stats.m_totalLimboSizeInBytes;
+        }
+        return totalLimboSizeInBytes;
+    }
+
     uint64_t inline GetLimboInuseElementsByQueue(GC_QUEUE_TYPE queue) const
     {
         return m_GcQueues[static_cast<uint8_t>(queue)].m_stats.m_totalLimboInuseElements;
@@ -496,6 +538,9 @@ private:
 
     bool m_global;
 
+    /** @var NUMA node of the thread that created the manager   */
+    int m_numaNode;
+
     /** @brief Calculate the minimum epoch among all active GC Managers.
      *  @return The minimum epoch among all active GC Managers.
      */
@@ -509,6 +554,14 @@ private:
      */
     bool Initialize();
 
+    /**
+     * @brief Reclaims elements below the given epoch if the session is not in a transaction.
+     * @param performEpoch The epoch bound for reclamation.
+     * @param budget The maximum number of elements to reclaim.
+     * @return The number of reclaimed elements.
+     */
+    uint64_t ReclaimIdle(GcEpochType performEpoch, uint64_t budget);
+
     /** @brief Remove all elements of elements of a specific index from all Limbo groups and reclaim them */
     void CleanIndexItems(uint32_t indexId, GC_OPERATION_TYPE oper);
 
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * mm_gc_reclaimer.cpp
+ *    Background garbage-collector reclaiming the limbo of idle sessions, one thread per NUMA node.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/memory/garbage_collector/mm_gc_reclaimer.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <chrono>
+#include <system_error>
+#include <pthread.h>
+#include "mm_gc_reclaimer.h"
+#include "mot_engine.h"
+#include "cycles.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(GcReclaimer, GC);
+
+bool GcReclaimer::Start()
+{
+    const MOTConfiguration& cfg = GetGlobalConfiguration();
+    int nodeCount = (cfg.m_enableNuma && cfg.m_numaNodes > 1) ? cfg.m_numaNodes : 1;
+    m_stop = false;
+    for (int node = 0; node < nodeCount; ++node) {
+        try {
+            m_threads.push_back(std::thread(&GcReclaimer::ReclaimerFunc, this, (nodeCount > 1) ? node : -1));
+        } catch (const std::system_error& e) {
+            MOT_REPORT_ERROR(
+                MOT_ERROR_SYSTEM_FAILURE, "GC Reclaimer", "Failed to start reclamation thread: %s", e.what());
+            Stop();
+            return false;
+        }
+    }
+    return true;
+}
+
+void GcReclaimer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (std::thread& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+}
+
+void GcReclaimer::ReclaimerFunc(int numaNode)
+{
+    MOT_DECLARE_NON_KERNEL_THREAD();
+    (void)pthread_setname_np(pthread_self(), "GcReclaimer");
+    MOT_LOG_INFO("GcReclaimer - Starting on NUMA node %d", numaNode);
+
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        MOT_LOG_ERROR("GcReclaimer::ReclaimerFunc: Failed to initialize Session Context");
+        MOTEngine::GetInstance()->OnCurrentThreadEnding();
+        return;
+    }
+    if (numaNode >= 0 && !GetTaskAffinity().SetNodeAffinity(numaNode)) {
+        MOT_LOG_WARN("Failed to set GC reclaimer affinity to NUMA node %d, objects may be released remotely", numaNode);
+    }
+    // the reclamation thread has no kernel snapshot, so its GC transactions use the global epoch
+    GcManager* gcSession = sessionContext->GetTxnManager()->GetGcSession();
+    gcSession->SetGcType(GcManager::GC_TYPE::GC_CHECKPOINT);
+
+    uint32_t cursor = 0;
+    std::chrono::milliseconds period(GetGlobalConfiguration().m_gcReclaimerPeriodMillis);
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (!m_stop) {
+        (void)m_cv.wait_for(lock, period, [this] { return m_stop.load(); });
+        if (m_stop) {
+            break;
+        }
+        lock.unlock();
+        if (!MOTEngine::GetInstance()->IsRecovering()) {
+            ReclaimPass(gcSession, numaNode, cursor);
+        }
+        lock.lock();
+    }
+    lock.unlock();
+
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    MOTEngine::GetInstance()->OnCurrentThreadEnding();
+    MOT_LOG_INFO("GcReclaimer - Exiting");
+}
+
+void GcReclaimer::ReclaimPass(GcManager* gcSession, int numaNode, uint32_t& cursor)
+{
+    GcIdleReclaimInfo info;
+
+    // index nodes released by the reclaimed objects are retired to the GC session of this thread
+    if (gcSession->GcStartTxn() != RC_OK) {
+        MOT_LOG_ERROR("GcReclaimer::ReclaimPass: Failed to start GC transaction");
+        return;
+    }
+    uint64_t startTime = GetSysClock();
+    GcManager::ReclaimIdleSessions(numaNode, GetGlobalConfiguration().m_gcReclaimBatchSize, cursor, info);
+    uint64_t endTime = GetSysClock();
+    gcSession->GcEndTxn();
+
+    MemoryStatisticsProvider::GetInstance().AddGCReclaimTime(
+        CpuCyclesLevelTime::CyclesToNanoseconds(endTime - startTime));
+    MemoryStatisticsProvider::GetInstance().AddGCLimboSize(info.m_limboSizeInBytes);
+    if (info.m_reclaimedElements > 0) {
+        MOT_LOG_DEBUG("GcReclaimer::ReclaimPass: Reclaimed %" PRIu64 " elements on NUMA node %d, %" PRIu64
+                      " bytes left in limbo",
+            info.m_reclaimedElements,
+            numaNode,
+            info.m_limboSizeInBytes);
+    }
+
+    if (numaNode <= 0) {
+        CheckStall(info, endTime);
+    }
+}
+
+void GcReclaimer::CheckStall(const GcIdleReclaimInfo& info, uint64_t now)
+{
+    if (info.m_oldestEpoch == 0 || info.m_oldestEpoch != m_stallEpoch || info.m_oldestTid != m_stallTid) {
+        m_stallEpoch = info.m_oldestEpoch;
+        m_stallTid = info.m_oldestTid;
+        m_stallStartTime = now;
+        m_stallReported = false;
+        return;
+    }
+
+    uint64_t stallSeconds = static_cast<uint64_t>(CpuCyclesLevelTime::CyclesToSeconds(now - m_stallStartTime));
+    if (!m_stallReported && stallSeconds >= GetGlobalConfiguration().m_gcStallReportPeriodSeconds) {
+        MOT_LOG_WARN("GC reclamation is held back by the snapshot %" PRIu64 " of the transaction in thread %" PRIu16
+                     " for %" PRIu64 " seconds, %" PRIu64 " MB are waiting in limbo",
+            m_stallEpoch,
+            m_stallTid,
+            stallSeconds,
+            info.m_limboSizeInBytes / MEGA_BYTE);
+        m_stallReported = true;
+    }
+}
+}  // namespace MOT
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * mm_gc_reclaimer.h
+ *    Background garbage-collector reclaiming the limbo of idle sessions, one thread per NUMA node.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/memory/garbage_collector/mm_gc_reclaimer.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef MM_GC_RECLAIMER_H
+#define MM_GC_RECLAIMER_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include "mm_gc_manager.h"
+
+namespace MOT {
+/**
+ * @class GcReclaimer
+ * @brief Periodically advances the active epoch and reclaims the limbo of sessions that are not in a transaction.
+ * Each NUMA node has its own reclamation thread, affined to the node, which reclaims only the sessions created on
+ * that node, so objects are released by a thread local to their memory. The first thread also reports snapshots that
+ * hold back reclamation for too long.
+ */
+class GcReclaimer {
+public:
+    GcReclaimer() : m_stop(false), m_stallEpoch(0), m_stallTid(0), m_stallStartTime(0), m_stallReported(false)
+    {}
+
+    ~GcReclaimer()
+    {}
+
+    /**
+     * @brief Starts the reclamation threads.
+     * @return True on success.
+     */
+    bool Start();
+
+    /** @brief Stops the reclamation threads and waits for them to end. */
+    void Stop();
+
+    GcReclaimer(const GcReclaimer& orig) = delete;
+
+    GcReclaimer& operator=(const GcReclaimer&) = delete;
+
+private:
+    /**
+     * @brief The reclamation thread function.
+     * @param numaNode The NUMA node of the thread, or negative if a single thread serves all nodes.
+     */
+    void ReclaimerFunc(int numaNode);
+
+    /**
+     * @brief Runs a reclamation pass over the idle sessions of a NUMA node.
+     * @param gcSession The GC session of the reclamation thread.
+     * @param numaNode The NUMA node of the thread, or negative if a single thread serves all nodes.
+     * @param[in,out] cursor The session to resume from if the previous pass exhausted its budget.
+     */
+    void ReclaimPass(GcManager* gcSession, int numaNode, uint32_t& cursor);
+
+    /**
+     * @brief Reports the oldest snapshot if it held back reclamation longer than the configured period.
+     * @param info The outcome of the last pass.
+     * @param now The time of the last pass in CPU cycles.
+     */
+    void CheckStall(const GcIdleReclaimInfo& info, uint64_t now);
+
+    /** @var The reclamation threads. */
+    std::vector<std::thread> m_threads;
+
+    /** @var Guards the stop flag. */
+    std::mutex m_lock;
+
+    /** @var Wakes up the reclamation threads when stopping. */
+    std::condition_variable m_cv;
+
+    /** @var Specifies whether the reclamation threads should stop. */
+    std::atomic<bool> m_stop;
+
+    /** @var The oldest snapshot seen by the previous pass. */
+    GcEpochType m_stallEpoch;
+
+    /** @var The thread holding the oldest snapshot. */
+    uint16_t m_stallTid;
+
+    /** @var The time the oldest snapshot was first seen, in CPU cycles. */
+    uint64_t m_stallStartTime;
+
+    /** @var Specifies whether the oldest snapshot was already reported. */
+    bool m_stallReported;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* MM_GC_RECLAIMER_H */
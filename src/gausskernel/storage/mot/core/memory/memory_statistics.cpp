@@ -141,6 +141,8 @@ MemoryThreadStatistics::MemoryThreadStatistics(uint64_t threadId, void* inplaceB
       m_freeTime(MakeName("free-time", threadId).c_str(), 1, "nanos"),
       m_gcRetiredBytes(MakeName("gc-retired-bytes", threadId).c_str(), MEGA_BYTE, "MB"),
       m_gcReclaimedBytes(MakeName("gc-reclaimed-bytes", threadId).c_str(), MEGA_BYTE, "MB"),
+      m_gcReclaimTime(MakeName("gc-reclaim-time", threadId).c_str(), 1, "nanos"),
+      m_gcLimboSize(MakeName("gc-limbo-size", threadId).c_str(), MEGA_BYTE, "MB"),
       m_masstreeBytesUsed(MakeName("masstree-bytes-used", threadId).c_str(), MEGA_BYTE, "MB")
 {
     // register all statistic variables
@@ -154,6 +156,8 @@ MemoryThreadStatistics::MemoryThreadStatistics(uint64_t threadId, void* inplaceB
     RegisterStatistics(&m_freeTime);
     RegisterStatistics(&m_gcRetiredBytes);
     RegisterStatistics(&m_gcReclaimedBytes);
+    RegisterStatistics(&m_gcReclaimTime);
+    RegisterStatistics(&m_gcLimboSize);
     RegisterStatistics(&m_masstreeBytesUsed);
 }
 
@@ -217,6 +217,18 @@ public:
         m_gcReclaimedBytes.AddSample(bytes);
     }
 
+    /** @brief Updates the statistics for time spent in a single garbage collection pass. */
+    inline void AddGCReclaimTime(uint64_t nanos)
+    {
+        m_gcReclaimTime.AddSample(nanos);
+    }
+
+    /** @brief Updates the statistics for the amount of bytes waiting for reclamation in the garbage collector. */
+    inline void AddGCLimboSize(uint64_t bytes)
+    {
+        m_gcLimboSize.AddSample(bytes);
+    }
+
     /** @brief Updates the statistics for the amount of bytes used by masstree index structures. */
     inline void AddMasstreeBytesUsed(uint64_t bytes)
     {
@@ -245,6 +257,8 @@ private:
     // GC statistics
     MemoryStatisticVariable m_gcRetiredBytes;
     MemoryStatisticVariable m_gcReclaimedBytes;
+    NumericStatisticVariable m_gcReclaimTime;
+    NumericStatisticVariable m_gcLimboSize;
 
     // masstree statistics
     MemoryStatisticVariable m_masstreeBytesUsed;
@@ -609,6 +623,24 @@ public:
         }
     }
 
+    /** @brief Updates the statistics for time spent in a single garbage collection pass. */
+    inline void AddGCReclaimTime(uint64_t nanos)
+    {
+        MemoryThreadStatistics* mts = GetCurrentThreadStatistics<MemoryThreadStatistics>();
+        if (mts) {
+            mts->AddGCReclaimTime(nanos);
+        }
+    }
+
+    /** @brief Updates the statistics for the amount of bytes waiting for reclamation in the garbage collector. */
+    inline void AddGCLimboSize(uint64_t bytes)
+    {
+        MemoryThreadStatistics* mts = GetCurrentThreadStatistics<MemoryThreadStatistics>();
+        if (mts) {
+            mts->AddGCLimboSize(bytes);
+        }
+    }
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
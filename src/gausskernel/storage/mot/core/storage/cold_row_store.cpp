@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * cold_row_store.cpp
+ *    Disk-backed store of the rows evicted from a table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/cold_row_store.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "cold_row_store.h"
+#include "row.h"
+#include "table.h"
+#include "sentinel.h"
+#include "mot_configuration.h"
+#include "mot_error.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(ColdRowStore, Storage);
+
+ColdRowStore::~ColdRowStore()
+{
+    if (m_fd != -1) {
+        if (close(m_fd) != 0) {
+            MOT_REPORT_SYSTEM_ERROR(close, "Cold Row Store", "Failed to close file %s", m_fileName.c_str());
+        }
+        m_fd = -1;
+        (void)unlink(m_fileName.c_str());
+    }
+}
+
+bool ColdRowStore::Open()
+{
+    char cwd[PATH_MAX] = {0};
+    const std::string& storeDir = GetGlobalConfiguration().m_coldRowStoreDir;
+    if (!storeDir.empty()) {
+        (void)m_fileName.assign(storeDir);
+    } else if (getcwd(cwd, sizeof(cwd)) != nullptr) {
+        (void)m_fileName.assign(cwd);
+    } else {
+        MOT_REPORT_SYSTEM_ERROR(getcwd, "Cold Row Store", "Failed to get current working directory");
+        return false;
+    }
+    (void)m_fileName.append("/mot_cold_rows_").append(std::to_string(m_tableId));
+
+    m_fd = open(m_fileName.c_str(), O_CREAT | O_TRUNC | O_RDWR, S_IRUSR | S_IWUSR); /* 0600 */
+    if (m_fd == -1) {
+        MOT_REPORT_SYSTEM_ERROR(open, "Cold Row Store", "Failed to create file %s", m_fileName.c_str());
+        return false;
+    }
+    MOT_LOG_TRACE("Created cold row store %s", m_fileName.c_str());
+    return true;
+}
+
+bool ColdRowStore::Store(const PrimarySentinel* sentinel, const Row* row, uint64_t& offset)
+{
+    RecordHeader header;
+    header.m_sentinel = (uint64_t)sentinel;
+    header.m_csn = row->GetCommitSequenceNumber();
+    header.m_rowId = row->GetRowId();
+    header.m_dataLen = row->GetTupleSize();
+    header.m_keyType = static_cast<uint32_t>(row->GetKeyType());
+
+    struct iovec iov[2];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(RecordHeader);
+    iov[1].iov_base = const_cast<uint8_t*>(row->GetData());
+    iov[1].iov_len = header.m_dataLen;
+    size_t recordLen = sizeof(RecordHeader) + header.m_dataLen;
+
+    std::lock_guard<std::mutex> lock(m_appendLock);
+    if (m_tail + recordLen > S_OBJ_ADDRESS_MASK) {
+        MOT_LOG_WARN("Cold row store %s is full", m_fileName.c_str());
+        return false;
+    }
+    ssize_t wrote = pwritev(m_fd, iov, 2, (off_t)m_tail);
+    if (wrote != (ssize_t)recordLen) {
+        MOT_REPORT_SYSTEM_ERROR(
+            pwritev, "Cold Row Store", "Failed to write %zu bytes to %s", recordLen, m_fileName.c_str());
+        return false;
+    }
+    offset = m_tail;
+    m_tail += recordLen;
+    (void)m_liveRecords.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ColdRowStore::ReadHeader(uint64_t offset, RecordHeader& header) const
+{
+    ssize_t bytesRead = pread(m_fd, &header, sizeof(RecordHeader), (off_t)offset);
+    if (bytesRead != (ssize_t)sizeof(RecordHeader)) {
+        MOT_REPORT_SYSTEM_ERROR(pread, "Cold Row Store", "Failed to read record header from %s", m_fileName.c_str());
+        return false;
+    }
+    return true;
+}
+
+Row* ColdRowStore::LoadRow(Table* table, const PrimarySentinel* sentinel, uint64_t offset) const
+{
+    Row* row = table->CreateNewRow();
+    if (row == nullptr) {
+        return nullptr;
+    }
+
+    RecordHeader header;
+    struct iovec iov[2];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(RecordHeader);
+    iov[1].iov_base = const_cast<uint8_t*>(row->GetData());
+    iov[1].iov_len = row->GetTupleSize();
+    size_t recordLen = sizeof(RecordHeader) + row->GetTupleSize();
+
+    ssize_t bytesRead = preadv(m_fd, iov, 2, (off_t)offset);
+    if (bytesRead != (ssize_t)recordLen) {
+        MOT_REPORT_SYSTEM_ERROR(
+            preadv, "Cold Row Store", "Failed to read %zu bytes from %s", recordLen, m_fileName.c_str());
+        table->DestroyRow(row);
+        return nullptr;
+    }
+
+    // the record was released and its offset re-used, the caller re-reads the sentinel
+    if (header.m_sentinel != (uint64_t)sentinel || header.m_dataLen != row->GetTupleSize()) {
+        table->DestroyRow(row);
+        return nullptr;
+    }
+
+    row->SetCommitSequenceNumber(header.m_csn);
+    row->SetRowId(header.m_rowId);
+    row->SetKeytype(static_cast<KeyType>(header.m_keyType));
+    row->SetPrimarySentinel(const_cast<PrimarySentinel*>(sentinel));
+    return row;
+}
+
+void ColdRowStore::Release(uint64_t offset, uint32_t dataLen)
+{
+    (void)m_liveRecords.fetch_sub(1, std::memory_order_relaxed);
+
+    // give the disk blocks of the record back, the file size (and all other offsets) is kept
+    size_t recordLen = sizeof(RecordHeader) + dataLen;
+    if (fallocate(m_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, (off_t)offset, (off_t)recordLen) != 0) {
+        MOT_LOG_DEBUG("Failed to release %zu bytes at offset %" PRIu64 " of %s (errno %d)",
+            recordLen,
+            offset,
+            m_fileName.c_str(),
+            errno);
+    }
+}
+
+void ColdRowStore::Compact()
+{
+    std::lock_guard<std::mutex> lock(m_appendLock);
+    if (m_tail == 0 || m_liveRecords.load(std::memory_order_relaxed) != 0) {
+        return;
+    }
+    if (ftruncate(m_fd, 0) != 0) {
+        MOT_REPORT_SYSTEM_ERROR(ftruncate, "Cold Row Store", "Failed to truncate %s", m_fileName.c_str());
+        return;
+    }
+    m_tail = 0;
+}
+}  // namespace MOT
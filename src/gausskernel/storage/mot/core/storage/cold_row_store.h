@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * cold_row_store.h
+ *    Disk-backed store of the rows evicted from a table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/cold_row_store.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef MOT_COLD_ROW_STORE_H
+#define MOT_COLD_ROW_STORE_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include "global.h"
+#include "utilities.h"
+
+namespace MOT {
+class Row;
+class Table;
+class PrimarySentinel;
+
+/**
+ * @class ColdRowStore
+ * @brief An append-only scratch file holding the rows evicted from a table. A record is referenced only by the
+ * sentinel of its row, so the store is not durable: checkpoints read evicted rows from it, and recovery evicts
+ * the checkpoint rows again once memory runs short. The disk blocks of faulted-in records are released, and the file is truncated once
+ * it holds no live record.
+ */
+class ColdRowStore {
+public:
+    /**
+     * @struct RecordHeader
+     * @brief The header of an evicted row. The row data follows the header.
+     */
+    struct RecordHeader {
+        /** @var The address of the owning sentinel, used to detect stale reads of a re-used offset. */
+        uint64_t m_sentinel;
+
+        /** @var The commit sequence number of the row. */
+        uint64_t m_csn;
+
+        /** @var The row id. */
+        uint64_t m_rowId;
+
+        /** @var The row data length. */
+        uint32_t m_dataLen;
+
+        /** @var The row key type. */
+        uint32_t m_keyType;
+    };
+
+    explicit ColdRowStore(uint32_t tableId) : m_tableId(tableId), m_fd(-1), m_tail(0), m_liveRecords(0)
+    {}
+
+    /** @brief Closes and removes the store file. */
+    ~ColdRowStore();
+
+    /**
+     * @brief Creates the store file. A file left over by a previous run is truncated.
+     * @return True on success.
+     */
+    bool Open();
+
+    /**
+     * @brief Appends a row to the store.
+     * @param sentinel The primary sentinel of the row.
+     * @param row The row.
+     * @param[out] offset The offset of the record.
+     * @return True on success.
+     */
+    bool Store(const PrimarySentinel* sentinel, const Row* row, uint64_t& offset);
+
+    /**
+     * @brief Reads the header of a record.
+     * @param offset The offset of the record.
+     * @param[out] header The record header.
+     * @return True on success.
+     */
+    bool ReadHeader(uint64_t offset, RecordHeader& header) const;
+
+    /**
+     * @brief Loads a row from the store into a new row of the table.
+     * @param table The table owning the row.
+     * @param sentinel The primary sentinel of the row.
+     * @param offset The offset of the record.
+     * @return The new row, or null if the record could not be read or does not belong to the sentinel.
+     */
+    Row* LoadRow(Table* table, const PrimarySentinel* sentinel, uint64_t offset) const;
+
+    /**
+     * @brief Releases a record that is no longer referenced by its sentinel.
+     * @param offset The offset of the record.
+     * @param dataLen The row data length.
+     */
+    void Release(uint64_t offset, uint32_t dataLen);
+
+    /** @brief Truncates the store file if it holds no live record. Called only by the evicting thread. */
+    void Compact();
+
+    inline uint64_t GetLiveRecords() const
+    {
+        return m_liveRecords.load(std::memory_order_relaxed);
+    }
+
+    inline uint64_t GetSize() const
+    {
+        return m_tail;
+    }
+
+    ColdRowStore(const ColdRowStore& orig) = delete;
+
+    ColdRowStore& operator=(const ColdRowStore&) = delete;
+
+private:
+    /** @var The id of the owning table. */
+    uint32_t m_tableId;
+
+    /** @var The store file descriptor. */
+    int m_fd;
+
+    /** @var The store file name. */
+    std::string m_fileName;
+
+    /** @var Serializes appends and truncation. */
+    std::mutex m_appendLock;
+
+    /** @var The offset of the next record. */
+    uint64_t m_tail;
+
+    /** @var The number of records referenced by sentinels. */
+    std::atomic<uint64_t> m_liveRecords;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* MOT_COLD_ROW_STORE_H */
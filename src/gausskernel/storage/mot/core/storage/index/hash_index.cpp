@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Primary index implementation using a lock-free split-ordered hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "hash_index.h"
+#include "mot_engine.h"
+#include "object_pool_compact.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashPrimaryIndex, Storage);
+
+static inline uint64_t HashMix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+uint64_t HashPrimaryIndex::HashKey(const uint8_t* buf, uint32_t len)
+{
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ len;
+    uint32_t pos = 0;
+    uint64_t word = 0;
+
+    for (; pos + sizeof(uint64_t) <= len; pos += sizeof(uint64_t)) {
+        errno_t erc = memcpy_s(&word, sizeof(word), buf + pos, sizeof(uint64_t));
+        securec_check(erc, "\0", "\0");
+        hash = HashMix(hash ^ word);
+    }
+
+    if (pos < len) {
+        word = 0;
+        errno_t erc = memcpy_s(&word, sizeof(word), buf + pos, len - pos);
+        securec_check(erc, "\0", "\0");
+        hash = HashMix(hash ^ word);
+    }
+
+    return hash;
+}
+
+int HashPrimaryIndex::CompareNode(const HashNode* node, uint64_t orderKey, const uint8_t* key, uint32_t keyLength)
+{
+    if (node->m_orderKey != orderKey) {
+        return (node->m_orderKey < orderKey) ? -1 : 1;
+    }
+
+    // dummy nodes are unique per bucket, items with the same hash are ordered by key
+    if (node->IsDummy()) {
+        return 0;
+    }
+
+    uint32_t len = (node->m_keyLength < keyLength) ? node->m_keyLength : keyLength;
+    int res = memcmp(node->GetKeyBuf(), key, len);
+    if (res != 0) {
+        return res;
+    }
+    return (node->m_keyLength == keyLength) ? 0 : ((node->m_keyLength < keyLength) ? -1 : 1);
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::AllocNode(
+    uint64_t orderKey, const uint8_t* key, uint32_t keyLength, Sentinel* value)
+{
+    HashNode* node = static_cast<HashNode*>(m_nodePool->Alloc());
+    if (node == nullptr) {
+        return nullptr;
+    }
+
+    node->m_orderKey = orderKey;
+    node->m_next.store(0, std::memory_order_relaxed);
+    node->m_value = value;
+    node->m_keyLength = keyLength;
+    if (keyLength > 0) {
+        errno_t erc = memcpy_s(node->GetKeyBuf(), m_nodeSize - sizeof(HashNode), key, keyLength);
+        securec_check(erc, "\0", "\0");
+    }
+    return node;
+}
+
+void HashPrimaryIndex::RetireNode(HashNode* node)
+{
+    // readers may still traverse the node, so it is released only after the current epoch ends
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    MOT_ASSERT(gcSession);
+    if (gcSession != nullptr) {
+        gcSession->GcRecordObject(GC_QUEUE_TYPE::GENERIC_QUEUE,
+            GetIndexId(),
+            (void*)m_nodePool,
+            node,
+            DeallocateNodeCallBack,
+            m_nodePool->m_size);
+    }  // otherwise the node is reclaimed together with the pool
+}
+
+HashPrimaryIndex::BucketSlot* HashPrimaryIndex::GetBucketSlot(uint64_t bucket, bool create)
+{
+    uint32_t segment = 0;
+    uint64_t offset = 0;
+    uint64_t segmentSize = 1;
+    if (bucket != 0) {
+        segment = (uint32_t)(64 - __builtin_clzll(bucket));
+        segmentSize = 1ULL << (segment - 1);
+        offset = bucket - segmentSize;
+    }
+
+    BucketSlot* slots = m_segments[segment].load(std::memory_order_acquire);
+    if (slots == nullptr && create) {
+        BucketSlot* newSlots = new (std::nothrow) BucketSlot[segmentSize];
+        if (newSlots == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                "Hash Index",
+                "Failed to allocate %" PRIu64 " buckets for index %s",
+                segmentSize,
+                m_name.c_str());
+            return nullptr;
+        }
+        for (uint64_t i = 0; i < segmentSize; ++i) {
+            newSlots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        if (m_segments[segment].compare_exchange_strong(slots, newSlots, std::memory_order_acq_rel)) {
+            slots = newSlots;
+        } else {
+            delete[] newSlots;
+        }
+    }
+
+    return (slots != nullptr) ? &slots[offset] : nullptr;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::GetBucketHead(uint64_t bucket)
+{
+    BucketSlot* slot = GetBucketSlot(bucket, true);
+    if (slot == nullptr) {
+        return nullptr;
+    }
+
+    HashNode* head = slot->load(std::memory_order_acquire);
+    if (head != nullptr) {
+        return head;
+    }
+
+    // bucket 0 is always initialized, so the parent of any other bucket exists (recursion depth is bounded by the
+    // number of segments)
+    uint64_t parent = bucket & ~(1ULL << (63 - __builtin_clzll(bucket)));
+    HashNode* parentHead = GetBucketHead(parent);
+    if (parentHead == nullptr) {
+        return nullptr;
+    }
+
+    HashNode* dummy = AllocNode(DummyOrderKey(bucket), nullptr, 0, nullptr);
+    if (dummy == nullptr) {
+        return nullptr;
+    }
+
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* cur = nullptr;
+    while (true) {
+        if (ListFind(parentHead, dummy->m_orderKey, nullptr, 0, prev, cur)) {
+            // another thread initialized the bucket concurrently, our dummy was never published
+            m_nodePool->Release(dummy);
+            dummy = cur;
+            break;
+        }
+        dummy->m_next.store((uint64_t)cur, std::memory_order_relaxed);
+        uint64_t expected = (uint64_t)cur;
+        if (prev->compare_exchange_strong(expected, (uint64_t)dummy, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+
+    slot->store(dummy, std::memory_order_release);
+    return dummy;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::FindBucketHead(uint64_t bucket) const
+{
+    // read-only variant: fall back to the closest initialized parent bucket instead of initializing this one
+    while (true) {
+        BucketSlot* slot = const_cast<HashPrimaryIndex*>(this)->GetBucketSlot(bucket, false);
+        if (slot != nullptr) {
+            HashNode* head = slot->load(std::memory_order_acquire);
+            if (head != nullptr) {
+                return head;
+            }
+        }
+        MOT_ASSERT(bucket != 0);
+        bucket &= ~(1ULL << (63 - __builtin_clzll(bucket)));
+    }
+}
+
+bool HashPrimaryIndex::ListFind(HashNode* head, uint64_t orderKey, const uint8_t* key, uint32_t keyLength,
+    std::atomic<uint64_t>*& prev, HashNode*& cur)
+{
+    bool restart = true;
+    while (restart) {
+        restart = false;
+        prev = &head->m_next;
+        cur = NodePtr(prev->load(std::memory_order_acquire));
+        while (cur != nullptr) {
+            uint64_t next = cur->m_next.load(std::memory_order_acquire);
+            if (prev->load(std::memory_order_acquire) != (uint64_t)cur) {
+                restart = true;
+                break;
+            }
+
+            if (IsMarked(next)) {
+                // help unlinking a logically deleted node, only the thread that unlinks it retires it
+                uint64_t expected = (uint64_t)cur;
+                if (!prev->compare_exchange_strong(expected, (uint64_t)NodePtr(next), std::memory_order_acq_rel)) {
+                    restart = true;
+                    break;
+                }
+                RetireNode(cur);
+                cur = NodePtr(next);
+                continue;
+            }
+
+            int res = CompareNode(cur, orderKey, key, keyLength);
+            if (res >= 0) {
+                return (res == 0);
+            }
+            prev = &cur->m_next;
+            cur = NodePtr(next);
+        }
+    }
+    return false;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::ListLookup(const Key* key) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint32_t keyLength = key->GetKeyLength();
+    uint64_t hash = HashKey(keyBuf, keyLength);
+    uint64_t orderKey = ItemOrderKey(hash);
+
+    HashNode* cur = FindBucketHead(hash & (m_bucketCount.load(std::memory_order_acquire) - 1));
+    while (cur != nullptr) {
+        uint64_t next = cur->m_next.load(std::memory_order_acquire);
+        int res = CompareNode(cur, orderKey, keyBuf, keyLength);
+        if (res > 0) {
+            break;
+        }
+        if (res == 0 && !cur->IsDummy()) {
+            return IsMarked(next) ? nullptr : cur;
+        }
+        cur = NodePtr(next);
+    }
+    return nullptr;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::ListSeek(const Key* key) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint32_t keyLength = key->GetKeyLength();
+    uint64_t hash = HashKey(keyBuf, keyLength);
+    uint64_t orderKey = ItemOrderKey(hash);
+
+    // the bucket head precedes every item of the bucket, the iterator skips dummy and deleted nodes
+    HashNode* cur = FindBucketHead(hash & (m_bucketCount.load(std::memory_order_acquire) - 1));
+    while (cur != nullptr && CompareNode(cur, orderKey, keyBuf, keyLength) < 0) {
+        cur = NodePtr(cur->m_next.load(std::memory_order_acquire));
+    }
+    return cur;
+}
+
+RC HashPrimaryIndex::IndexInitImpl(void** args)
+{
+    m_nodeSize = sizeof(HashNode) + ALIGN8(m_keyLength);
+    m_nodePool = ObjAllocInterface::GetObjPool(m_nodeSize, false);
+    if (m_nodePool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash node pool");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    m_count.store(0, std::memory_order_relaxed);
+    m_bucketCount.store(HASH_INDEX_INITIAL_BUCKETS, std::memory_order_relaxed);
+
+    // bucket 0 starts the list and is never removed
+    BucketSlot* slot = GetBucketSlot(0, true);
+    HashNode* head = (slot != nullptr) ? AllocNode(DummyOrderKey(0), nullptr, 0, nullptr) : nullptr;
+    if (head == nullptr) {
+        DestroyTable();
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to initialize hash index %s", m_name.c_str());
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+    slot->store(head, std::memory_order_release);
+
+    m_initialized = true;
+    return RC_OK;
+}
+
+Sentinel* HashPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint32_t keyLength = key->GetKeyLength();
+    uint64_t hash = HashKey(keyBuf, keyLength);
+    uint64_t orderKey = ItemOrderKey(hash);
+
+    MOT_ASSERT(keyLength <= ALIGN8(m_keyLength));
+    inserted = false;
+
+    // if !inserted and null is returned, insertion failed due to memory issue
+    HashNode* head = GetBucketHead(hash & (m_bucketCount.load(std::memory_order_acquire) - 1));
+    if (head == nullptr) {
+        return nullptr;
+    }
+
+    HashNode* node = AllocNode(orderKey, keyBuf, keyLength, sentinel);
+    if (node == nullptr) {
+        return nullptr;
+    }
+
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* cur = nullptr;
+    while (true) {
+        if (ListFind(head, orderKey, keyBuf, keyLength, prev, cur)) {
+            // key mapping already exists in unique index, our node was never published
+            m_nodePool->Release(node);
+            return cur->m_value;
+        }
+        node->m_next.store((uint64_t)cur, std::memory_order_relaxed);
+        uint64_t expected = (uint64_t)cur;
+        if (prev->compare_exchange_strong(expected, (uint64_t)node, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+
+    inserted = true;
+    uint64_t count = m_count.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t bucketCount = m_bucketCount.load(std::memory_order_relaxed);
+    if (count > bucketCount * HASH_INDEX_LOAD_FACTOR && bucketCount < HASH_INDEX_MAX_BUCKETS) {
+        // no items move, new buckets are initialized lazily on first access
+        (void)m_bucketCount.compare_exchange_strong(bucketCount, bucketCount * 2, std::memory_order_acq_rel);
+    }
+
+    return nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    HashNode* node = ListLookup(key);
+    return (node != nullptr) ? node->m_value : nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint32_t keyLength = key->GetKeyLength();
+    uint64_t hash = HashKey(keyBuf, keyLength);
+    uint64_t orderKey = ItemOrderKey(hash);
+
+    HashNode* head = GetBucketHead(hash & (m_bucketCount.load(std::memory_order_acquire) - 1));
+    if (head == nullptr) {
+        return nullptr;
+    }
+
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* cur = nullptr;
+    while (true) {
+        if (!ListFind(head, orderKey, keyBuf, keyLength, prev, cur)) {
+            return nullptr;
+        }
+
+        // logical deletion first, so concurrent inserts after this node fail and retry
+        uint64_t next = cur->m_next.load(std::memory_order_acquire);
+        if (IsMarked(next) || !cur->m_next.compare_exchange_strong(next, next | 1, std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        Sentinel* sentinel = cur->m_value;
+        uint64_t expected = (uint64_t)cur;
+        if (prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel)) {
+            RetireNode(cur);
+        } else {
+            // someone changed the predecessor, let the search unlink (and retire) the node
+            (void)ListFind(head, orderKey, keyBuf, keyLength, prev, cur);
+        }
+        (void)m_count.fetch_sub(1, std::memory_order_relaxed);
+        return sentinel;
+    }
+}
+
+void HashPrimaryIndex::DestroyTable()
+{
+    for (uint32_t i = 0; i < HASH_INDEX_MAX_SEGMENTS; ++i) {
+        BucketSlot* slots = m_segments[i].exchange(nullptr, std::memory_order_acq_rel);
+        if (slots != nullptr) {
+            delete[] slots;
+        }
+    }
+
+    // all nodes are released with the pool
+    if (m_nodePool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+
+    m_count.store(0, std::memory_order_relaxed);
+    m_bucketCount.store(0, std::memory_order_relaxed);
+}
+
+uint64_t HashPrimaryIndex::GetIndexSize(uint64_t& netTotal)
+{
+    PoolStatsSt stats;
+
+    uint64_t res = Index::GetIndexSize(netTotal);
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    m_nodePool->PrintStats(stats, "Hash Nodes Pool", LogLevel::LL_INFO);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netTotal += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    uint64_t bucketsSize = 0;
+    for (uint32_t i = 0; i < HASH_INDEX_MAX_SEGMENTS; ++i) {
+        if (m_segments[i].load(std::memory_order_acquire) != nullptr) {
+            bucketsSize += ((i == 0) ? 1 : (1ULL << (i - 1))) * sizeof(BucketSlot);
+        }
+    }
+    res += bucketsSize;
+    netTotal += bucketsSize;
+
+    MOT_LOG_INFO("Hash Index %s memory size - Gross: %lu, NetTotal: %lu", m_name.c_str(), res, netTotal);
+    return res;
+}
+
+void HashPrimaryIndex::Compact(Table* table, uint32_t pid)
+{
+    Index::Compact(table, pid);
+
+    char prefix[256];
+    errno_t erc = snprintf_s(prefix, sizeof(prefix), sizeof(prefix) - 1, "%s(hash nodes pool)", m_name.c_str());
+    securec_check_ss(erc, "\0", "\0");
+    prefix[erc] = 0;
+    CompactHandler chNodes(m_nodePool, prefix);
+    chNodes.StartCompaction(CompactTypeT::COMPACT_SIMPLE);
+    chNodes.EndCompaction();
+}
+
+// Iterator API
+IndexIterator* HashPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    HashNode* head = m_segments[0].load(std::memory_order_acquire)[0].load(std::memory_order_acquire);
+    IndexIterator* itr = new (std::nothrow) HashIterator(head, false);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create hash iterator");
+    }
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    HashNode* node = nullptr;
+
+    // the planner uses hash indexes only for exact lookups on the full key
+    MOT_ASSERT(matchKey && forward);
+    if (matchKey && forward) {
+        node = ListLookup(key);
+    }
+    found = (node != nullptr);
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(node, true);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create hash iterator");
+    }
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Seek(const Key* key, uint32_t pid) const
+{
+    IndexIterator* itr = new (std::nothrow) HashIterator(ListSeek(key), false);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Seek", "Failed to create hash iterator");
+    }
+    return itr;
+}
+}  // namespace MOT
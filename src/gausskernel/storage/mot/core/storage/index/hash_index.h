@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Primary index implementation using a lock-free split-ordered hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_PRIMARY_INDEX_H
+#define HASH_PRIMARY_INDEX_H
+
+#include <atomic>
+
+#include "index.h"
+#include "index_base.h"
+#include "utilities.h"
+#include "mot_engine.h"
+
+namespace MOT {
+/**
+ * @class HashPrimaryIndex.
+ * @brief Primary index implementation using a lock-free resizable hash table.
+ * @detail All items are kept in a single lock-free linked list (Harris-Michael), ordered by the bit-reversed hash
+ * of their key (split-ordering). Each bucket points to a dummy node inside that list, so doubling the number of
+ * buckets never moves items: a new bucket is lazily initialized by inserting its dummy node after the dummy node of
+ * its parent bucket. Unlinked nodes are handed to the GC, so concurrent readers never see reclaimed memory.
+ * The index is unordered: it supports exact key lookups and full (unordered) scans only.
+ */
+class HashPrimaryIndex : public Index {
+private:
+    /**
+     * @struct HashNode
+     * @brief A node in the split-ordered list. The key bytes follow the node in memory.
+     */
+    struct HashNode {
+        /** @var The bit-reversed hash (odd for items, even for bucket dummy nodes). */
+        uint64_t m_orderKey;
+
+        /** @var The next node in the list. The lowest bit marks this node as logically deleted. */
+        std::atomic<uint64_t> m_next;
+
+        /** @var The sentinel mapped to the key. */
+        Sentinel* m_value;
+
+        /** @var The length of the key that follows the node. */
+        uint32_t m_keyLength;
+
+        inline uint8_t* GetKeyBuf()
+        {
+            return reinterpret_cast<uint8_t*>(this + 1);
+        }
+
+        inline const uint8_t* GetKeyBuf() const
+        {
+            return reinterpret_cast<const uint8_t*>(this + 1);
+        }
+
+        inline bool IsDummy() const
+        {
+            return (m_orderKey & 1) == 0;
+        }
+    };
+
+    /** @typedef A bucket holds the dummy node that starts it in the list. */
+    typedef std::atomic<HashNode*> BucketSlot;
+
+    /**
+     * @class HashIterator
+     * @brief A forward iterator over a primary hash index. Either a single-item iterator returned by an exact
+     * search, or a full scan in hash order.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        HashIterator(HashNode* node, bool singleItem)
+            : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false), m_node(node), m_singleItem(singleItem)
+        {
+            if (!m_singleItem) {
+                SkipDeleted();
+            }
+        }
+
+        ~HashIterator() override
+        {
+            m_node = nullptr;
+        }
+
+        bool IsValid() const override
+        {
+            return m_node != nullptr;
+        }
+
+        void Invalidate() override
+        {
+            m_node = nullptr;
+        }
+
+        void Destroy() override
+        {}
+
+        /**
+         * @brief Retrieves the key of the currently iterated item.
+         * @return A pointer to a Key copy of the node key, like the tree iterators return.
+         */
+        const void* GetKey() const override
+        {
+            m_key.InitKey(m_node->m_keyLength);
+            m_key.CpKey(m_node->GetKeyBuf(), m_node->m_keyLength);
+            return &m_key;
+        }
+
+        Row* GetRow() const override
+        {
+            return m_node->m_value->GetData();
+        }
+
+        Sentinel* GetPrimarySentinel() const override
+        {
+            return m_node->m_value;
+        }
+
+        void Next() override
+        {
+            if (m_singleItem) {
+                m_node = nullptr;
+            } else if (m_node != nullptr) {
+                m_node = NodePtr(m_node->m_next.load(std::memory_order_acquire));
+                SkipDeleted();
+            }
+        }
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported, hash iterators are forward only.
+         */
+        void Prev() override
+        {
+            MOT_ASSERT(false);
+        }
+
+        bool Equals(const IndexIterator* rhs) const override
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         */
+        void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const override
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         */
+        void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff) override
+        {}
+
+    private:
+        /** @brief Skips bucket dummy nodes and logically deleted nodes. */
+        inline void SkipDeleted()
+        {
+            while (m_node != nullptr) {
+                uint64_t next = m_node->m_next.load(std::memory_order_acquire);
+                if (!m_node->IsDummy() && !IsMarked(next)) {
+                    break;
+                }
+                m_node = NodePtr(next);
+            }
+        }
+
+        /** @var The currently iterated node. */
+        HashNode* m_node;
+
+        /** @var Denotes the iterator stops after the first item. */
+        bool m_singleItem;
+
+        /** @var The key of the currently iterated node, filled by GetKey(). */
+        mutable MaxKey m_key;
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_nodePool(nullptr),
+          m_nodeSize(0),
+          m_bucketCount(0),
+          m_count(0),
+          m_initialized(false)
+    {
+        for (uint32_t i = 0; i < HASH_INDEX_MAX_SEGMENTS; ++i) {
+            m_segments[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    ~HashPrimaryIndex() override
+    {
+        m_initialized = false;
+        DestroyTable();
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    uint64_t GetIndexSize(uint64_t& netTotal) override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index.
+     * @return The number of rows stored in the index.
+     */
+    uint64_t GetSize() const override
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Clears object pool thread level cache
+     */
+    void ClearThreadMemoryCache() override
+    {
+        Index::ClearThreadMemoryCache();
+        if (m_nodePool != nullptr) {
+            m_nodePool->ClearThreadCache();
+        }
+    }
+
+    /**
+     * @brief Clears object pool level cache
+     */
+    void ClearFreeCache() override
+    {
+        Index::ClearFreeCache();
+        if (m_nodePool != nullptr) {
+            m_nodePool->ClearFreeCache();
+        }
+    }
+
+    void Compact(Table* table, uint32_t pid) override;
+
+    /**
+     * @brief Destroy the table and its memory pool and init index again.
+     */
+    RC ReInitIndex(bool isDrop) override
+    {
+        m_initialized = false;
+        DestroyTable();
+
+        if (isDrop) {
+            return RC_OK;
+        } else {
+            return IndexInitImpl(NULL);
+        }
+    }
+
+    // Iterator API
+    IndexIterator* Begin(uint32_t pid, bool passive) const override;
+
+    /**
+     * @brief Searches for an exact key. Hash indexes are unordered, so only an exact forward match is supported,
+     * and the returned iterator stops after the matched item.
+     */
+    IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const override;
+
+    /**
+     * @brief Resumes a full scan in hash order at the given key. Items are ordered by the bit-reversed hash
+     * of their key, which does not depend on the number of buckets, so the position of a removed key is still
+     * well defined.
+     */
+    IndexIterator* Seek(const Key* key, uint32_t pid) const override;
+
+    /**
+     * @brief Static callback function for deallocating unlinked nodes from the node pool.
+     * @param gcElement The limbo element holding the pool and the node.
+     * @param oper Current GC operation.
+     * @param aux Unused.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateNodeCallBack(void* gcElement, void* oper, void* aux)
+    {
+        LimboElement* elem = reinterpret_cast<LimboElement*>(gcElement);
+        GC_OPERATION_TYPE gcOperType = (*(GC_OPERATION_TYPE*)oper);
+        // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+        ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)elem->m_objectPtr;
+
+        if (gcOperType != GC_OPERATION_TYPE::GC_OPER_DROP_INDEX) {
+            localPoolPtr->Release(elem->m_objectPool);
+        }
+        return localPoolPtr->m_size;
+    }
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var Segment s holds buckets [2^(s-1), 2^s), segment 0 holds bucket 0. */
+    static constexpr uint32_t HASH_INDEX_MAX_SEGMENTS = 32;
+
+    /** @var The maximum number of buckets. */
+    static constexpr uint64_t HASH_INDEX_MAX_BUCKETS = 1ULL << (HASH_INDEX_MAX_SEGMENTS - 1);
+
+    /** @var The initial number of buckets (must be a power of two). */
+    static constexpr uint64_t HASH_INDEX_INITIAL_BUCKETS = 1024;
+
+    /** @var The average number of items per bucket before the number of buckets is doubled. */
+    static constexpr uint64_t HASH_INDEX_LOAD_FACTOR = 2;
+
+    static inline bool IsMarked(uint64_t next)
+    {
+        return (next & 1) != 0;
+    }
+
+    static inline HashNode* NodePtr(uint64_t next)
+    {
+        return reinterpret_cast<HashNode*>(next & ~(uint64_t)1);
+    }
+
+    static inline uint64_t DummyOrderKey(uint64_t bucket)
+    {
+        return ReverseBits(bucket);
+    }
+
+    static inline uint64_t ItemOrderKey(uint64_t hash)
+    {
+        return ReverseBits(hash | (1ULL << 63));
+    }
+
+    static inline uint64_t ReverseBits(uint64_t value)
+    {
+        value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+        value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+        value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        return __builtin_bswap64(value);
+    }
+
+    static uint64_t HashKey(const uint8_t* buf, uint32_t len);
+
+    static int CompareNode(const HashNode* node, uint64_t orderKey, const uint8_t* key, uint32_t keyLength);
+
+    HashNode* AllocNode(uint64_t orderKey, const uint8_t* key, uint32_t keyLength, Sentinel* value);
+
+    void RetireNode(HashNode* node);
+
+    BucketSlot* GetBucketSlot(uint64_t bucket, bool create);
+
+    HashNode* GetBucketHead(uint64_t bucket);
+
+    HashNode* FindBucketHead(uint64_t bucket) const;
+
+    bool ListFind(HashNode* head, uint64_t orderKey, const uint8_t* key, uint32_t keyLength,
+        std::atomic<uint64_t>*& prev, HashNode*& cur);
+
+    HashNode* ListLookup(const Key* key) const;
+
+    HashNode* ListSeek(const Key* key) const;
+
+    /** @brief Destroy the bucket directory and the node pool. */
+    void DestroyTable();
+
+    /** @var Memory pool for list nodes (items and bucket dummy nodes). */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var The size of a single node including the key. */
+    uint32_t m_nodeSize;
+
+    /** @var The current number of buckets (a power of two). */
+    std::atomic<uint64_t> m_bucketCount;
+
+    /** @var The number of items in the index. */
+    std::atomic<uint64_t> m_count;
+
+    /** @var The bucket directory. Segments are allocated lazily and never shrink. */
+    std::atomic<BucketSlot*> m_segments[HASH_INDEX_MAX_SEGMENTS];
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_PRIMARY_INDEX_H */
@@ -55,6 +55,13 @@ IndexIterator* Index::Find(const Key* key, uint32_t pid) const
     return itr;
 }
 
+IndexIterator* Index::Seek(const Key* key, uint32_t pid) const
+{
+    // ordered indexes resume at the first key not less than the given one
+    bool found = false;
+    return Search(key, true, true, pid, found);
+}
+
 IndexIterator* Index::FindLast(const Key* key, uint32_t pid) const
 {
     IndexIterator* itr = Find(key, pid);
@@ -470,7 +477,7 @@ void Index::Compact(Table* table, uint32_t pid)
                 // do compaction
                 while (it->IsValid()) {
                     PrimarySentinel* ps = static_cast<PrimarySentinel*>(it->GetPrimarySentinel());
-                    Row* head = ps->GetData();
+                    Row* head = ps->GetResidentData();  // evicted rows are not in the row pool
                     Row* next = nullptr;
                     if (head != nullptr and !head->IsRowDeleted()) {
                         next = head->GetNextVersion();
@@ -662,7 +669,7 @@ void Index::ReclaimSentinel(Sentinel* sentinel)
     Row* r = nullptr;
     switch (GetIndexOrder()) {
         case IndexOrder::INDEX_ORDER_PRIMARY:
-            r = sentinel->GetData();
+            r = PrimarySentinel::ReleaseEvicted(static_cast<PrimarySentinel*>(sentinel), m_table);
             while (r) {
                 Row* reclaimRow = r;
                 r = r->GetNextVersion();
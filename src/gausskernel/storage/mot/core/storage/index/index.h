@@ -422,6 +422,19 @@ public:
     virtual IndexIterator* Search(
         const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const = 0;
 
+    /**
+     * @brief Retrieves a forward iterator over the rest of a full index scan, starting at the given key
+     * or at the item that follows it in scan order if it was removed meanwhile.
+     *
+     * @detail This API is provided to resume a full scan (see Begin()) in a new GC epoch, after the
+     * iterator of the previous epoch was released. The key is the one the released iterator pointed to.
+     *
+     * @param key The key the scan stopped at.
+     * @param pid The logical identifier of the requesting thread.
+     * @return The resulting iterator.
+     */
+    virtual IndexIterator* Seek(const Key* key, uint32_t pid) const;
+
     /**
      * @brief Retrieves a forward iterator to the first item in the index that has the required key,
      * or the end iterator if the key was not found.
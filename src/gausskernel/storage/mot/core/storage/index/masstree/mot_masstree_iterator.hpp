@@ -28,6 +28,7 @@
 #include "masstree.hh"
 #include "masstree_scan.hh"
 #include "key.h"
+#include "primary_sentinel.h"
 
 namespace Masstree {
 using namespace MOT;
@@ -112,6 +113,15 @@ private:
     /** @var Search key (in MOT's key format) instance. */
     MOT::MaxKey m_motKey;
 
+    /** @var The leaf whose entries were last batched for prefetching. */
+    const leaf<P>* m_batchLeaf = nullptr;
+
+    /** @var Sentinels of the batched leaf entries ahead of the iterator. */
+    MOT::Sentinel* m_batch[P::leaf_width];
+
+    /** @var Number of batched sentinels whose rows were not prefetched yet. */
+    int m_batchSize = 0;
+
     /**
      * @brief Initialize iterator's members.
      * @param table A Masstree table pointer which the iterator should scan.
@@ -132,6 +142,8 @@ private:
         m_done = false;
         m_foundInitial = false;
         m_matchKey = matchKey;
+        m_batchLeaf = nullptr;
+        m_batchSize = 0;
         if (key) {
             // the deep copy of the key is done here
             erc = memcpy_s(m_searchKey->GetKeyBuf(), m_searchKey->GetKeyLength(), key, keyLength);
@@ -221,6 +233,51 @@ private:
         return m_state;
     }
 
+    /**
+     * @brief Prefetches ahead of a range scan. When the scan enters a leaf, the values of the entries ahead of the
+     * iterator are read under a single leaf version check, and the sentinels they point to and the next leaf are
+     * prefetched. The rows are prefetched on the following step, once the sentinels are likely to be cached.
+     * @detail Values of entries that are layers are skipped, and the batch is dropped if the leaf changed, so only
+     * stable sentinel pointers are dereferenced. Evicted rows are not faulted in.
+     */
+    void PrefetchAhead(void)
+    {
+        const leaf<P>* n = m_stack.n_;
+        if (n == m_batchLeaf) {
+            for (int i = 0; i < m_batchSize; ++i) {
+                if (m_batch[i]->IsPrimarySentinel()) {
+                    Prefetch(static_cast<MOT::PrimarySentinel*>(m_batch[i])->GetResidentData());
+                }
+            }
+            m_batchSize = 0;
+            return;
+        }
+
+        m_batchLeaf = n;
+        m_batchSize = 0;
+        int size = m_stack.perm_.size();
+        for (int ki = m_helper.next(m_stack.ki_); ki >= 0 && ki < size; ki = m_helper.next(ki)) {
+            int p = m_stack.perm_[ki];
+            if (!leaf<P>::keylenx_is_layer(n->keylenx_[p])) {
+                m_batch[m_batchSize++] = reinterpret_cast<MOT::Sentinel*>(n->lv_[p].value());
+            }
+        }
+        if (n->has_changed(m_stack.v_)) {
+            m_batchSize = 0;
+            return;
+        }
+
+        for (int i = 0; i < m_batchSize; ++i) {
+            Prefetch(m_batch[i]);
+        }
+        const leaf<P>* next = FORWARD ? n->safe_next() : n->prev_;
+        if (next != nullptr) {
+            for (size_t offset = 0; offset < sizeof(leaf<P>); offset += CACHE_LINE_SIZE) {
+                Prefetch(reinterpret_cast<const char*>(next) + offset);
+            }
+        }
+    }
+
 public:
     /**
      * @brief Default constructor.
@@ -255,6 +312,10 @@ public:
             m_stack.ki_ = m_helper.next(m_stack.ki_);
             m_state = m_stack.find_next(m_helper, m_key, m_entry);
             (void)Next();
+            // only scans that step past their first entry prefetch, so point lookups do not pay for it
+            if (!m_done) {
+                PrefetchAhead();
+            }
         } else {
             (void)Begin();
         }
@@ -24,6 +24,9 @@
 
 #include "sentinel.h"
 #include "row.h"
+#include "table.h"
+#include "cold_row_store.h"
+#include "db_session_statistics.h"
 
 namespace MOT {
 
@@ -192,6 +195,42 @@ PrimarySentinel* PrimarySentinel::GetVisiblePrimaryHeader(uint64_t csn)
     return nullptr;
 }
 
+Row* PrimarySentinel::FaultIn()
+{
+    Table* table = GetIndex()->GetTable()->GetOrigTable();
+    ColdRowStore* store = table->GetColdStore();
+    MOT_ASSERT(store != nullptr);
+    uint64_t status = GetStatus();
+    while (status & S_EVICTED_BIT) {
+        if (status & S_LOCK_BIT) {
+            PAUSE
+            status = GetStatus();
+            continue;
+        }
+
+        uint64_t offset = status & S_OBJ_ADDRESS_MASK;
+        Row* row = store->LoadRow(table, this, offset);
+        if (row == nullptr) {
+            if (GetStatus() == status) {
+                MOT_REPORT_ERROR(MOT_ERROR_RESOURCE_UNAVAILABLE,
+                    "Cold Row Fault-In",
+                    "Failed to load evicted row of table %s",
+                    table->GetLongTableName().c_str());
+                return nullptr;
+            }
+        } else if (TryReplaceEvicted(status, row)) {
+            store->Release(offset, row->GetTupleSize());
+            DbSessionStatisticsProvider::GetInstance().AddColdRowFaultIn();
+            return row;
+        } else {
+            // faulted in concurrently
+            table->DestroyRow(row);
+        }
+        status = GetStatus();
+    }
+    return static_cast<Row*>((void*)(status & S_OBJ_ADDRESS_MASK));
+}
+
 void PrimarySentinel::Print()
 {
     MOT_LOG_INFO("PrimarySentinel: Index name: %s startCSN = %lu indexOrder = PRIMARY_INDEX TID=%lu",
@@ -201,7 +240,9 @@ void PrimarySentinel::Print()
     MOT_LOG_INFO("|");
     MOT_LOG_INFO("V");
 
-    if (IsCommited()) {
+    if (IsEvicted()) {
+        MOT_LOG_INFO("EVICTED (offset %" PRIu64 ")", GetEvictedOffset());
+    } else if (IsCommited()) {
         Row* row = GetData();
         row->Print();
     } else {
@@ -210,12 +251,23 @@ void PrimarySentinel::Print()
     MOT_LOG_INFO("---------------------------------------------------------------");
 }
 
+Row* PrimarySentinel::ReleaseEvicted(PrimarySentinel* ps, Table* table)
+{
+    if (!ps->IsEvicted()) {
+        return ps->GetResidentData();
+    }
+    ColdRowStore* store = table->GetOrigTable()->GetColdStore();
+    MOT_ASSERT(store != nullptr);
+    store->Release(ps->GetEvictedOffset(), table->GetTupleSize());
+    return nullptr;
+}
+
 void PrimarySentinel::ReclaimSentinel(Sentinel* s)
 {
     MOT_ASSERT(s != nullptr);
-    Row* row = s->GetData();
     Index* index = s->GetIndex();
     Table* t = index->GetTable();
+    Row* row = ReleaseEvicted(static_cast<PrimarySentinel*>(s), t);
     index->SentinelRelease(s);
     while (row) {
         Row* tmp = row;
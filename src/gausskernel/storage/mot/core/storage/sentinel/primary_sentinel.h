@@ -52,7 +52,68 @@ public:
 
     Row* GetData(void) const override
     {
-        return static_cast<Row*>((void*)(GetStatus() & S_OBJ_ADDRESS_MASK));
+        uint64_t status = GetStatus();
+        if (unlikely(status & S_EVICTED_BIT)) {
+            return const_cast<PrimarySentinel*>(this)->FaultIn();
+        }
+        return static_cast<Row*>((void*)(status & S_OBJ_ADDRESS_MASK));
+    }
+
+    /**
+     * @brief Retrieves the row without faulting it in from the cold row store.
+     * @return The row, or null if the row is evicted.
+     */
+    inline Row* GetResidentData() const
+    {
+        uint64_t status = GetStatus();
+        if (status & S_EVICTED_BIT) {
+            return nullptr;
+        }
+        return static_cast<Row*>((void*)(status & S_OBJ_ADDRESS_MASK));
+    }
+
+    inline bool IsEvicted() const
+    {
+        return (GetStatus() & S_EVICTED_BIT) == S_EVICTED_BIT;
+    }
+
+    /**
+     * @brief Retrieves the cold row store offset of an evicted row.
+     * @return The offset of the row in the table cold row store.
+     */
+    inline uint64_t GetEvictedOffset() const
+    {
+        return (GetStatus() & S_OBJ_ADDRESS_MASK);
+    }
+
+    /**
+     * @brief Loads an evicted row from the cold row store and installs it in the sentinel.
+     * @return The resident row, or null if the row could not be loaded.
+     */
+    Row* FaultIn();
+
+    /**
+     * @brief Marks the row as recently accessed. The bit is written only when clear, so a hot row does not
+     * keep dirtying the sentinel cache line.
+     */
+    inline void MarkAccessed()
+    {
+        if ((m_stable & ACCESSED_BIT) == 0) {
+            (void)__sync_fetch_and_or(&m_stable, ACCESSED_BIT);
+        }
+    }
+
+    /**
+     * @brief Clears the recently accessed mark of the row (cold row eviction second chance).
+     * @return True if the row was accessed since the previous call.
+     */
+    inline bool ClearAccessed()
+    {
+        if ((m_stable & ACCESSED_BIT) == 0) {
+            return false;
+        }
+        (void)__sync_fetch_and_and(&m_stable, ~ACCESSED_BIT);
+        return true;
     }
 
     bool IsSentinelRemovable() const
@@ -110,6 +171,14 @@ public:
 
     void ReclaimSentinel(Sentinel* s);
 
+    /**
+     * @brief Releases the cold row store record of a reclaimed sentinel, if its row is evicted.
+     * @param ps The reclaimed sentinel.
+     * @param table The table of the sentinel.
+     * @return The resident row chain of the sentinel, or null if the row was evicted.
+     */
+    static Row* ReleaseEvicted(PrimarySentinel* ps, Table* table);
+
     GcSharedInfo& GetGcInfo()
     {
         return m_gcInfo;
@@ -45,15 +45,17 @@ namespace MOT {
 // forward declarations
 class Row;
 class Index;
+class Table;
 class PrimarySentinel;
 
 const char* const enIndexOrder[] = {
     stringify(INDEX_ORDER_PRIMARY), stringify(INDEX_ORDER_SECONDARY), stringify(INDEX_ORDER_SECONDARY_UNIQUE)};
 
 enum SentinelFlags : uint64_t {
-    S_DIRTY_BIT = 1UL << 63,  // Dirty bit
-    S_LOCK_BIT = 1UL << 62,   // Lock bit
-    S_WRITE_BIT = 1UL << 61,  // Write bit
+    S_DIRTY_BIT = 1UL << 63,    // Dirty bit
+    S_LOCK_BIT = 1UL << 62,     // Lock bit
+    S_WRITE_BIT = 1UL << 61,    // Write bit
+    S_EVICTED_BIT = 1UL << 60,  // Evicted bit, the object address holds a cold row store offset
     S_LOCK_WRITE_BITS = (S_LOCK_BIT | S_WRITE_BIT),
     S_COUNTER_LOCK_BIT = 1UL << 31,
     S_STATUS_BITS = (S_DIRTY_BIT | S_LOCK_BIT),
@@ -78,7 +80,7 @@ public:
         m_index = nullptr;
     }
 
-    enum StableRowFlags : uint64_t { STABLE_BIT = 1UL << 63, PRE_ALLOC_BIT = 1UL << 62 };
+    enum StableRowFlags : uint64_t { STABLE_BIT = 1UL << 63, PRE_ALLOC_BIT = 1UL << 62, ACCESSED_BIT = 1UL << 61 };
 
     inline bool IsCommited() const
     {
@@ -301,7 +303,34 @@ public:
      */
     void SetNextPtr(void* const& ptr)
     {
-        m_status = (m_status & ~S_OBJ_ADDRESS_MASK) | ((uint64_t)(ptr) & S_OBJ_ADDRESS_MASK);
+        m_status = (m_status & ~(S_OBJ_ADDRESS_MASK | S_EVICTED_BIT)) | ((uint64_t)(ptr) & S_OBJ_ADDRESS_MASK);
+    }
+
+    /**
+     * @brief Replaces the object pointer with the offset of its copy in the cold row store.
+     * @param offset The cold row store offset.
+     */
+    void SetEvictedOffset(uint64_t offset)
+    {
+        MOT_ASSERT(IsLocked());
+        m_status = (m_status & ~S_OBJ_ADDRESS_MASK) | S_EVICTED_BIT | (offset & S_OBJ_ADDRESS_MASK);
+    }
+
+    /**
+     * @brief Installs a faulted-in object in place of the evicted one. The lock owner updates the status with
+     * plain stores, so the exchange is done only on an unlocked sentinel.
+     * @param status The evicted status observed by the caller.
+     * @param ptr The object pointer.
+     * @return True if the object was installed.
+     */
+    bool TryReplaceEvicted(uint64_t status, void* const& ptr)
+    {
+        if ((status & (S_EVICTED_BIT | S_LOCK_BIT)) != S_EVICTED_BIT) {
+            return false;
+        }
+        uint64_t newStatus =
+            (status & ~(S_OBJ_ADDRESS_MASK | S_EVICTED_BIT)) | ((uint64_t)(ptr) & S_OBJ_ADDRESS_MASK);
+        return __sync_bool_compare_and_swap(&m_status, status, newStatus);
     }
 
     /**
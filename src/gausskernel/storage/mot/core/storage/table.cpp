@@ -33,6 +33,7 @@
 #include "txn_access.h"
 #include "txn_insert_action.h"
 #include "redo_log_writer.h"
+#include "cold_row_store.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(Table, Storage);
@@ -75,6 +76,11 @@ Table::~Table()
         ObjAllocInterface::FreeObjPool(&m_tombStonePool);
     }
 
+    if (m_coldStore != nullptr) {
+        delete m_coldStore;
+        m_coldStore = nullptr;
+    }
+
     int destroyRc = pthread_rwlock_destroy(&m_rwLock);
     if (destroyRc != 0) {
         MOT_LOG_ERROR("~Table: rwlock destroy failed (%d)", destroyRc);
@@ -522,6 +528,87 @@ RC Table::InsertRow(Row* row, TxnManager* txn)
     return txn->InsertRow(row);
 }
 
+void Table::RecordValidation(bool aborted)
+{
+    if (aborted) {
+        (void)m_windowValidationAborts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // only the transaction completing the window computes its abort rate
+    uint32_t validations = m_windowValidations.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (validations != CONTENTION_WINDOW_SIZE) {
+        return;
+    }
+
+    uint32_t aborts = m_windowValidationAborts.exchange(0, std::memory_order_relaxed);
+    m_windowValidations.store(0, std::memory_order_relaxed);
+    uint32_t abortRate = std::min(aborts, validations) * 100 / validations;
+    m_validationAbortRate.store(abortRate, std::memory_order_relaxed);
+
+    // use half the threshold when leaving the contended state, so tables do not flip on every window
+    uint32_t threshold = GetGlobalConfiguration().m_adaptiveValidationAbortRate;
+    bool isContended = m_isContended.load(std::memory_order_relaxed);
+    if (!isContended && abortRate >= threshold) {
+        MOT_LOG_DEBUG("Table %s is contended (abort rate %u%%)", m_longTableName.c_str(), abortRate);
+        m_isContended.store(true, std::memory_order_relaxed);
+    } else if (isContended && abortRate < threshold / 2) {
+        MOT_LOG_DEBUG("Table %s is no longer contended (abort rate %u%%)", m_longTableName.c_str(), abortRate);
+        m_isContended.store(false, std::memory_order_relaxed);
+    }
+}
+
+ColdRowStore* Table::CreateColdStore()
+{
+    std::lock_guard<std::mutex> lock(m_coldStoreLock);
+    if (m_coldStore != nullptr) {
+        return m_coldStore;
+    }
+
+    ColdRowStore* coldStore = new (std::nothrow) ColdRowStore(m_tableId);
+    if (coldStore == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Cold Row Eviction",
+            "Failed to allocate cold row store for table %s",
+            m_longTableName.c_str());
+        return nullptr;
+    }
+    if (!coldStore->Open()) {
+        delete coldStore;
+        return nullptr;
+    }
+    m_coldStore = coldStore;
+    return m_coldStore;
+}
+
+RC Table::FaultInEvictedRows(uint32_t tid)
+{
+    MOT_ASSERT(IsEvictionBlocked());
+    // the evictor checks the block under the table read lock, so wait for a batch it may still be evicting
+    WrLock();
+    Unlock();
+    if (m_coldStore == nullptr || m_coldStore->GetLiveRecords() == 0) {
+        return RC_OK;
+    }
+
+    IndexIterator* it = m_primaryIndex->Begin(tid);
+    if (it == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Cold Row Fault-In", "Failed to begin iterating over primary index");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    RC rc = RC_OK;
+    while (it->IsValid()) {
+        PrimarySentinel* ps = static_cast<PrimarySentinel*>(it->GetPrimarySentinel());
+        if (ps->IsEvicted() && ps->GetData() == nullptr) {
+            rc = RC_MEMORY_ALLOCATION_ERROR;
+            break;
+        }
+        it->Next();
+    }
+    delete it;
+    return rc;
+}
+
 PrimarySentinel* Table::GCRemoveRow(GcQueue::DeleteVector* deletes, Row* tombstone, GC_OPERATION_TYPE gcOper)
 {
     MaxKey key;
@@ -1530,7 +1617,7 @@ bool Table::IsTableSingleVersion()
     IndexIterator* it = index->Begin(0);
     while (it->IsValid()) {
         PrimarySentinel* ps = static_cast<PrimarySentinel*>(it->GetPrimarySentinel());
-        Row* r = ps->GetData();
+        Row* r = ps->GetResidentData();
         if (r and r->GetNextVersion()) {
             r->Print();
             return false;
@@ -27,6 +27,7 @@
 
 #include <atomic>
 #include <map>
+#include <mutex>
 #include <string>
 #include <iostream>
 #include <memory>
@@ -50,6 +51,7 @@ class TxnInsertAction;
 class RecoveryManager;
 class Access;
 class TxnTable;
+class ColdRowStore;
 
 struct rowhashing_func {
     uint64_t operator()(const Row* key) const
@@ -448,6 +450,78 @@ public:
         return m_tableExId;
     }
 
+    /**
+     * @brief Retrieves the table metadata version, which changes on every committed DDL (including truncate).
+     * @return The metadata version.
+     */
+    inline uint64_t GetMetadataVer() const
+    {
+        return m_metadataVer;
+    }
+
+    /**
+     * @brief Records a sampled commit validation of a transaction that modified this table.
+     * @param aborted Specifies whether the validation failed on a row of this table.
+     */
+    void RecordValidation(bool aborted);
+
+    /**
+     * @brief Queries whether the recent commit validation abort rate of this table is high.
+     * @return True if the table is contended.
+     */
+    inline bool IsContended() const
+    {
+        return m_isContended.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Retrieves the cold row store of the table.
+     * @return The cold row store, or null if no row of the table was ever evicted.
+     */
+    inline ColdRowStore* GetColdStore() const
+    {
+        return m_coldStore;
+    }
+
+    /**
+     * @brief Creates the cold row store of the table. Called by the cold row evictor, and by the checkpoint
+     * recovery workers when evicting recovered rows.
+     * @return The cold row store, or null on failure.
+     */
+    ColdRowStore* CreateColdStore();
+
+    /** @brief Stops the eviction of rows of this table (e.g. while a DDL converts the table rows). */
+    inline void BlockEviction()
+    {
+        (void)m_evictionBlocked.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    inline void UnblockEviction()
+    {
+        (void)m_evictionBlocked.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    inline bool IsEvictionBlocked() const
+    {
+        return m_evictionBlocked.load(std::memory_order_acquire) != 0;
+    }
+
+    /**
+     * @brief Loads all the evicted rows of the table back to memory. Eviction must be blocked by the caller.
+     * @param tid The thread identifier.
+     * @return Return code denoting the execution result.
+     */
+    RC FaultInEvictedRows(uint32_t tid);
+
+    /**
+     * @brief Retrieves the commit validation abort rate of this table in the last sampling window.
+     * @return The abort rate percentage.
+     */
+    inline uint32_t GetValidationAbortRate() const
+    {
+        return m_validationAbortRate.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Retrieves the length of the key in the primary index.
      * @return The primary index key length.
@@ -1045,6 +1119,30 @@ private:
 
     uint32_t m_rowCount = 0;
 
+    /** @var Number of sampled validations in a contention window. */
+    static constexpr uint32_t CONTENTION_WINDOW_SIZE = 64;
+
+    /** @var Sampled commit validations in the current contention window. */
+    std::atomic<uint32_t> m_windowValidations{0};
+
+    /** @var Sampled commit validations in the current window that failed on a row of this table. */
+    std::atomic<uint32_t> m_windowValidationAborts{0};
+
+    /** @var Validation abort rate percentage of the last completed window. */
+    std::atomic<uint32_t> m_validationAbortRate{0};
+
+    /** @var Specifies whether committing transactions should wait for row locks of this table. */
+    std::atomic<bool> m_isContended{false};
+
+    /** @var The disk-backed store of the evicted rows of the table. */
+    ColdRowStore* m_coldStore = nullptr;
+
+    /** @var Serializes the creation of the cold row store. */
+    std::mutex m_coldStoreLock;
+
+    /** @var Number of operations that stopped the eviction of rows of this table. */
+    std::atomic<uint32_t> m_evictionBlocked{0};
+
     DECLARE_CLASS_LOGGER();
 };
 
@@ -157,6 +157,7 @@ RC TxnTable::ValidateDDLChanges(TxnManager* txn)
 void TxnTable::ApplyDDLChanges(TxnManager* txn)
 {
     if (m_isDropped) {
+        ReleaseEvictionBlock();
         return;
     }
     // Need to guard critical section
@@ -213,6 +214,7 @@ void TxnTable::ApplyDDLChanges(TxnManager* txn)
         m_isLocked = false;
     }
     m_origTab->Unlock();
+    ReleaseEvictionBlock();
 }
 
 void TxnTable::ApplyDDLIndexChanges(TxnManager* txn)
@@ -311,6 +313,7 @@ void TxnTable::RollbackDDLChanges(TxnManager* txn)
         m_isLocked = false;
     }
     m_origTab->Unlock();
+    ReleaseEvictionBlock();
 }
 
 RC TxnTable::AlterAddColumn(TxnManager* txn, Column* newColumn)
@@ -323,7 +326,12 @@ RC TxnTable::AlterAddColumn(TxnManager* txn, Column* newColumn)
     Column** newColumns = nullptr;
     ObjAllocInterface* newRowPool = nullptr;
 
-    RC rc = AlterReserveMem(txn, newTupleSize, newColumn);
+    RC rc = AlterFaultInEvictedRows(txn);
+    if (rc != RC_OK) {
+        return rc;
+    }
+
+    rc = AlterReserveMem(txn, newTupleSize, newColumn);
     if (rc != RC_OK) {
         return rc;
     }
@@ -403,6 +411,29 @@ RC TxnTable::AlterAddColumn(TxnManager* txn, Column* newColumn)
     return rc;
 }
 
+RC TxnTable::AlterFaultInEvictedRows(TxnManager* txn)
+{
+    // rows are converted from the row pool, so the evicted ones are loaded first and kept in memory until the
+    // transaction ends
+    if (!m_evictionBlocked) {
+        m_origTab->BlockEviction();
+        m_evictionBlocked = true;
+    }
+    RC rc = m_origTab->FaultInEvictedRows(txn->GetThdId());
+    if (rc != RC_OK) {
+        MOT_LOG_ERROR("Failed to load evicted rows of table %s", m_longTableName.c_str());
+    }
+    return rc;
+}
+
+void TxnTable::ReleaseEvictionBlock()
+{
+    if (m_evictionBlocked) {
+        m_origTab->UnblockEviction();
+        m_evictionBlocked = false;
+    }
+}
+
 RC TxnTable::AlterReserveMem(TxnManager* txn, uint32_t newTupleSize, Column* newColumn)
 {
     PoolStatsSt stats;
@@ -538,7 +569,12 @@ RC TxnTable::AlterDropColumn(TxnManager* txn, Column* col)
     uint32_t newTupleSize = m_tupleSize - col->m_size;
     ObjAllocInterface* newRowPool = nullptr;
 
-    RC rc = AlterReserveMem(txn, newTupleSize, nullptr);
+    RC rc = AlterFaultInEvictedRows(txn);
+    if (rc != RC_OK) {
+        return rc;
+    }
+
+    rc = AlterReserveMem(txn, newTupleSize, nullptr);
     if (rc != RC_OK) {
         return rc;
     }
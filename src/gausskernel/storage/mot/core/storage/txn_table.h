@@ -73,6 +73,7 @@ public:
           m_isDropped(false),
           m_isNew(false),
           m_isLocked(false),
+          m_evictionBlocked(false),
           m_reservedChunks(0)
     {
         m_deserialized = table->m_deserialized;
@@ -204,6 +205,8 @@ private:
     void AlterConvertGlobalData(TxnManager* txn);
     RC AlterConvertGlobalRow(Row* oldRow, acRowAddrMap_t& oldToNewMap);
     RC AlterReserveMem(TxnManager* txn, uint32_t newTupleSize, Column* newColumn);
+    RC AlterFaultInEvictedRows(TxnManager* txn);
+    void ReleaseEvictionBlock();
 
     Table* m_origTab;
     uint64_t m_origMetadataVer;
@@ -216,6 +219,7 @@ private:
     bool m_isDropped;
     bool m_isNew;
     bool m_isLocked;
+    bool m_evictionBlocked;
     size_t m_reservedChunks;
 };
 }  // namespace MOT
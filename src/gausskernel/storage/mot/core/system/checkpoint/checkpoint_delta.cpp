@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * checkpoint_delta.cpp
+ *    Delta checkpoint chain and deleted keys tracking.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/system/checkpoint/checkpoint_delta.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "checkpoint_delta.h"
+#include "utilities.h"
+
+namespace MOT {
+DECLARE_LOGGER(CheckpointDeleteLog, Checkpoint);
+
+CheckpointDeleteLog::~CheckpointDeleteLog()
+{
+    for (uint32_t i = 0; i < NUM_BUCKETS; i++) {
+        ReleaseList(m_buckets[i].m_head);
+        m_buckets[i].m_head = nullptr;
+    }
+}
+
+void CheckpointDeleteLog::Record(uint32_t tableId, const uint8_t* key, uint16_t keyLen, uint64_t csn)
+{
+    DeletedKey* deletedKey = static_cast<DeletedKey*>(malloc(sizeof(DeletedKey) + keyLen));
+    if (deletedKey == nullptr) {
+        // the next checkpoint cannot be a delta, as this delete would be lost
+        MOT_LOG_WARN("CheckpointDeleteLog: failed to allocate deleted key, next checkpoint will be a full image");
+        m_overflow = true;
+        return;
+    }
+
+    deletedKey->m_csn = csn;
+    deletedKey->m_tableId = tableId;
+    deletedKey->m_keyLen = keyLen;
+    errno_t erc = memcpy_s(deletedKey + 1, keyLen, key, keyLen);
+    securec_check(erc, "\0", "\0");
+
+    Bucket& bucket = m_buckets[tableId % NUM_BUCKETS];
+    std::lock_guard<spin_lock> lock(bucket.m_lock);
+    deletedKey->m_next = bucket.m_head;
+    bucket.m_head = deletedKey;
+}
+
+bool CheckpointDeleteLog::Drain(DeletedKeysMap& deletedKeys)
+{
+    for (uint32_t i = 0; i < NUM_BUCKETS; i++) {
+        DeletedKey* head = nullptr;
+        {
+            std::lock_guard<spin_lock> lock(m_buckets[i].m_lock);
+            head = m_buckets[i].m_head;
+            m_buckets[i].m_head = nullptr;
+        }
+
+        while (head != nullptr) {
+            DeletedKey* next = head->m_next;
+            DeletedKey*& tableHead = deletedKeys[head->m_tableId];
+            head->m_next = tableHead;
+            tableHead = head;
+            head = next;
+        }
+    }
+
+    return !m_overflow.exchange(false);
+}
+
+void CheckpointDeleteLog::Release(DeletedKeysMap& deletedKeys)
+{
+    for (auto it = deletedKeys.begin(); it != deletedKeys.end(); (void)++it) {
+        ReleaseList(it->second);
+    }
+    deletedKeys.clear();
+}
+
+void CheckpointDeleteLog::ReleaseList(DeletedKey* head)
+{
+    while (head != nullptr) {
+        DeletedKey* next = head->m_next;
+        free(head);
+        head = next;
+    }
+}
+}  // namespace MOT
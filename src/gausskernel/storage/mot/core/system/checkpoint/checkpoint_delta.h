@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * checkpoint_delta.h
+ *    Delta checkpoint chain and deleted keys tracking.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/system/checkpoint/checkpoint_delta.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef CHECKPOINT_DELTA_H
+#define CHECKPOINT_DELTA_H
+
+#include <map>
+#include <atomic>
+#include <vector>
+#include "global.h"
+#include "spin_lock.h"
+#include "checkpoint_utils.h"
+
+namespace MOT {
+/**
+ * @struct TableDeltaChain
+ * @brief The ordered list of checkpoints holding a table's data. The first link is a full image and every
+ * following link holds only the rows that changed since the previous one, together with the deleted keys.
+ */
+struct TableDeltaChain {
+    /** @var The external id of the table when the chain was started. */
+    uint64_t m_exId = 0;
+
+    /** @var The metadata version of the table when the last link was written. */
+    uint64_t m_metadataVer = 0;
+
+    /** @var The chain links, oldest first. */
+    std::vector<CheckpointUtils::ChainLink> m_links;
+};
+
+using DeltaChainMap = std::map<uint32_t, TableDeltaChain>;
+
+/**
+ * @class CheckpointDeleteLog
+ * @brief Collects the primary keys deleted between two checkpoints, so that a delta checkpoint can persist
+ * them. Deleted sentinels are reclaimed by the GC long before the next checkpoint scans the table.
+ */
+class CheckpointDeleteLog {
+public:
+    /**
+     * @struct DeletedKey
+     * @brief A deleted primary key. The key bytes are allocated right after the header.
+     */
+    struct DeletedKey {
+        DeletedKey* m_next;
+        uint64_t m_csn;
+        uint32_t m_tableId;
+        uint16_t m_keyLen;
+
+        inline const uint8_t* GetKeyBuf() const
+        {
+            return reinterpret_cast<const uint8_t*>(this + 1);
+        }
+    };
+
+    using DeletedKeysMap = std::map<uint32_t, DeletedKey*>;
+
+    CheckpointDeleteLog() : m_overflow(false)
+    {}
+
+    ~CheckpointDeleteLog();
+
+    /**
+     * @brief Records a deleted key. Called by committing transactions.
+     * @param tableId The internal id of the table.
+     * @param key The primary key buffer.
+     * @param keyLen The primary key length.
+     * @param csn The commit sequence number of the deleting transaction.
+     */
+    void Record(uint32_t tableId, const uint8_t* key, uint16_t keyLen, uint64_t csn);
+
+    /**
+     * @brief Moves all the recorded keys out of the log, grouped by table id. Must be called while no
+     * transaction is committing (checkpoint RESOLVE phase).
+     * @param deletedKeys The returned deleted keys map.
+     * @return False if some keys could not be recorded since the previous drain.
+     */
+    bool Drain(DeletedKeysMap& deletedKeys);
+
+    /**
+     * @brief Releases a map of drained keys.
+     * @param deletedKeys The deleted keys map to release.
+     */
+    static void Release(DeletedKeysMap& deletedKeys);
+
+    CheckpointDeleteLog(const CheckpointDeleteLog& orig) = delete;
+
+    CheckpointDeleteLog& operator=(const CheckpointDeleteLog&) = delete;
+
+private:
+    static constexpr uint32_t NUM_BUCKETS = 64;
+
+    struct Bucket {
+        spin_lock m_lock;
+        DeletedKey* m_head = nullptr;
+    };
+
+    static void ReleaseList(DeletedKey* head);
+
+    /** @var Keys are spread over the buckets by table id to reduce contention. */
+    Bucket m_buckets[NUM_BUCKETS];
+
+    /** @var Set when a key could not be recorded due to lack of memory. */
+    std::atomic<bool> m_overflow;
+};
+}  // namespace MOT
+
+#endif /* CHECKPOINT_DELTA_H */
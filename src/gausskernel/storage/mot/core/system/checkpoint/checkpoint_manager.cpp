@@ -58,7 +58,13 @@ CheckpointManager::CheckpointManager()
       m_lastReplayLsn(0),
       m_workingDir(""),
       m_inProcessTxnsLsn(0),
-      m_numSerializedEntries(0)
+      m_numSerializedEntries(0),
+      m_deltaMinCsn(0),
+      m_nextDeltaMinCsn(0),
+      m_numDeltas(0),
+      m_isDeltaCheckpoint(false),
+      m_deltaChainValid(false),
+      m_nextDeltaChainValid(false)
 {}
 
 bool CheckpointManager::Initialize()
@@ -92,6 +98,7 @@ void CheckpointManager::ResetFlags()
 CheckpointManager::~CheckpointManager()
 {
     DestroyCheckpointers();
+    CheckpointDeleteLog::Release(m_deletedKeys);
     (void)pthread_rwlock_destroy(&m_fetchLock);
     m_redoLogHandler = nullptr;
 }
@@ -152,6 +159,7 @@ bool CheckpointManager::CreateSnapShot()
     // It is safe now to obtain a list of all tables to included in this checkpoint.
     // The tables are read locked in order to avoid drop/truncate during checkpoint.
     FillTasksQueue();
+    PrepareDeltaCheckpoint();
 
     if (!CreatePendingRecoveryDataFile()) {
         MOT_LOG_ERROR("Failed to create the pending recovery data file");
@@ -216,6 +224,7 @@ bool CheckpointManager::BeginCheckpoint()
     if (!m_errorSet) {
         CompleteCheckpoint();
     }
+    CheckpointDeleteLog::Release(m_deletedKeys);
 
     // No locking required here, as the checkpoint workers have already exited.
     UnlockAndClearTables(m_tasksList);
@@ -260,6 +269,7 @@ bool CheckpointManager::Abort()
         // No locking required here, as there no checkpoint workers when the control reaches here.
         UnlockAndClearTables(m_tasksList);
         UnlockAndClearTables(m_finishedTasks);
+        CheckpointDeleteLog::Release(m_deletedKeys);
         m_numCpTasks = 0;
 
         // Move to rest
@@ -456,6 +466,10 @@ void CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, const Acces
     PrimarySentinel* s = static_cast<PrimarySentinel*>(origRow->GetPrimarySentinel());
     MOT_ASSERT(s != nullptr);
 
+    if (type == DEL && GetGlobalConfiguration().m_enableDeltaCheckpoint) {
+        RecordDeletedKey(origRow, txnMan->GetCommitSequenceNumber());
+    }
+
     bool statusBit = s->GetStableStatus();
     switch (startPhase) {
         case REST:
@@ -540,6 +554,9 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
             std::lock_guard<std::mutex> guard(m_tasksMutex);
             m_mapfileInfo.push_back(entry);
             m_finishedTasks.push_back(table);
+            if (m_nextDeltaChainValid) {
+                AddDeltaChainLink(table, numSegs);
+            }
         } else {
             OnError(CheckpointWorkerPool::ErrCodes::MEMORY, "Failed to allocate map file entry", nullptr);
             return;
@@ -565,6 +582,11 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    if (m_nextDeltaChainValid && !CreateDeltaChainFile()) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create delta chain file", nullptr);
+        return;
+    }
+
     if (!ctrlFile->IsValid()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Invalid control file", nullptr);
         return;
@@ -585,6 +607,14 @@ void CheckpointManager::CompleteCheckpoint()
 
         // Update checkpoint Id
         SetId(m_inProgressId);
+
+        // The fetch lock also guards the delta chain, which lists the directories to send along
+        m_deltaChain.swap(m_nextDeltaChain);
+        m_nextDeltaChain.clear();
+        m_deltaChainValid = m_nextDeltaChainValid;
+        m_deltaMinCsn = m_nextDeltaMinCsn;
+        m_numDeltas = m_isDeltaCheckpoint ? (m_numDeltas + 1) : 0;
+        UpdateDeltaChainIds();
         finishedUpdatingFiles = true;
     } while (0);
     (void)pthread_rwlock_unlock(&m_fetchLock);
@@ -594,7 +624,11 @@ void CheckpointManager::CompleteCheckpoint()
     }
 
     RemoveOldCheckpoints(m_inProgressId);
-    MOT_LOG_INFO("MOT checkpoint [%lu:%lu:%lu] completed", m_inProgressId, GetLsn(), GetLastReplayLsn());
+    MOT_LOG_INFO("MOT checkpoint [%lu:%lu:%lu] completed (%s)",
+        m_inProgressId,
+        GetLsn(),
+        GetLastReplayLsn(),
+        m_isDeltaCheckpoint ? "delta" : "full image");
 }
 
 void CheckpointManager::DestroyCheckpointers()
@@ -641,7 +675,7 @@ void CheckpointManager::RemoveOldCheckpoints(uint64_t curCheckcpointId)
             }
 
             uint64_t chkptId = strtoll(p->d_name + strlen(CheckpointUtils::CKPT_DIR_PREFIX), NULL, 10);
-            if (chkptId == curCheckcpointId) {
+            if (chkptId == curCheckcpointId || m_deltaChainIds.count(chkptId) != 0) {
                 MOT_LOG_DEBUG("RemoveOldCheckpoints: exclude %lu", chkptId);
                 continue;
             }
@@ -927,4 +961,185 @@ bool CheckpointManager::CreateEndFile()
 
     return ret;
 }
+
+void CheckpointManager::PrepareDeltaCheckpoint()
+{
+    // The drained deleted keys are lost if this checkpoint fails, so the chain can be extended again only once
+    // this checkpoint completes.
+    bool chainValid = m_deltaChainValid;
+    m_deltaChainValid = false;
+    m_isDeltaCheckpoint = false;
+    m_nextDeltaChainValid = false;
+    m_nextDeltaChain.clear();
+    CheckpointDeleteLog::Release(m_deletedKeys);
+    if (!GetGlobalConfiguration().m_enableDeltaCheckpoint) {
+        return;
+    }
+
+    // In RESOLVE phase all the transactions that started to commit earlier are completed, and the new ones
+    // are blocked until CAPTURE. Every row committed so far has a CSN lower than the next one to be assigned,
+    // and the delete log holds exactly the deletes that are part of this checkpoint.
+    m_nextDeltaMinCsn = GetCSNManager().GetGcEpoch();
+    bool logComplete = m_deleteLog.Drain(m_deletedKeys);
+    if (MOTEngine::GetInstance()->IsRecovering()) {
+        // Replayed transactions may commit in RESOLVE phase on the standby, so the CSN boundary is not exact.
+        MOT_LOG_TRACE("MOT checkpoint %lu is a full image (standby)", m_inProgressId);
+        return;
+    }
+
+    m_nextDeltaChainValid = true;
+    m_isDeltaCheckpoint = chainValid && logComplete && (m_deltaMinCsn != 0) &&
+                          (m_numDeltas < GetGlobalConfiguration().m_checkpointFullImageInterval);
+    MOT_LOG_INFO("MOT checkpoint %lu is a %s (%u deltas since full image, %lu tables with deletes)",
+        m_inProgressId,
+        m_isDeltaCheckpoint ? "delta" : "full image",
+        m_numDeltas,
+        m_deletedKeys.size());
+}
+
+uint64_t CheckpointManager::GetDeltaMinCsn(const Table* table) const
+{
+    if (!m_isDeltaCheckpoint) {
+        return 0;
+    }
+
+    // tables that were created, truncated or altered since the last checkpoint start a new chain
+    DeltaChainMap::const_iterator it = m_deltaChain.find(table->GetTableId());
+    if (it == m_deltaChain.end() || it->second.m_links.empty() || it->second.m_exId != table->GetTableExId() ||
+        it->second.m_metadataVer != table->GetMetadataVer()) {
+        return 0;
+    }
+    return m_deltaMinCsn;
+}
+
+const CheckpointDeleteLog::DeletedKey* CheckpointManager::GetDeletedKeys(uint32_t tableId) const
+{
+    CheckpointDeleteLog::DeletedKeysMap::const_iterator it = m_deletedKeys.find(tableId);
+    if (it == m_deletedKeys.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void CheckpointManager::AddDeltaChainLink(const Table* table, uint32_t numSegs)
+{
+    CheckpointUtils::ChainLink link{m_inProgressId, numSegs, 0};
+    TableDeltaChain& chain = m_nextDeltaChain[table->GetTableId()];
+    if (GetDeltaMinCsn(table) != 0) {
+        // the workers read the current chain concurrently, so it must not be modified here
+        chain.m_links = m_deltaChain.find(table->GetTableId())->second.m_links;
+        for (const CheckpointDeleteLog::DeletedKey* key = GetDeletedKeys(table->GetTableId()); key != nullptr;
+             key = key->m_next) {
+            link.m_numDeletes++;
+        }
+    }
+    chain.m_exId = table->GetTableExId();
+    chain.m_metadataVer = table->GetMetadataVer();
+    chain.m_links.push_back(link);
+}
+
+bool CheckpointManager::CreateDeltaChainFile()
+{
+    int fd = -1;
+    std::string fileName;
+    bool ret = false;
+
+    do {
+        CheckpointUtils::MakeChainFilename(fileName, m_workingDir, m_inProgressId);
+        if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+            MOT_LOG_ERROR("CreateDeltaChainFile: failed to create file '%s' - %d - %s",
+                fileName.c_str(),
+                errno,
+                gs_strerror(errno));
+            break;
+        }
+
+        CheckpointUtils::ChainFileHeader chainFileHeader{CheckpointUtils::HEADER_MAGIC,
+            m_nextDeltaMinCsn,
+            m_isDeltaCheckpoint ? (m_numDeltas + 1) : 0,
+            m_nextDeltaChain.size()};
+        if (CheckpointUtils::WriteFile(fd, (const char*)&chainFileHeader, sizeof(CheckpointUtils::ChainFileHeader)) !=
+            sizeof(CheckpointUtils::ChainFileHeader)) {
+            MOT_LOG_ERROR("CreateDeltaChainFile: failed to write chain file's header %d %s", errno, gs_strerror(errno));
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        bool entriesWritten = true;
+        for (DeltaChainMap::const_iterator it = m_nextDeltaChain.begin(); it != m_nextDeltaChain.end(); (void)++it) {
+            CheckpointUtils::ChainFileEntry entry{it->first, (uint32_t)it->second.m_links.size()};
+            size_t linksSize = sizeof(CheckpointUtils::ChainLink) * entry.m_numLinks;
+            if (CheckpointUtils::WriteFile(fd, (const char*)&entry, sizeof(CheckpointUtils::ChainFileEntry)) !=
+                    sizeof(CheckpointUtils::ChainFileEntry) ||
+                CheckpointUtils::WriteFile(fd, (const char*)it->second.m_links.data(), linksSize) != linksSize) {
+                MOT_LOG_ERROR("CreateDeltaChainFile: failed to write chain file entry");
+                entriesWritten = false;
+                break;
+            }
+        }
+
+        if (!entriesWritten) {
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaChainFile: failed to flush chain file");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::CloseFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaChainFile: failed to close chain file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    return ret;
+}
+
+void CheckpointManager::RecordDeletedKey(Row* row, uint64_t csn)
+{
+    MaxKey key;
+    Table* table = row->GetTable();
+    Index* index = table->GetPrimaryIndex();
+    key.InitKey(index->GetKeyLength());
+    index->BuildKey(table, row, &key);
+    m_deleteLog.Record(table->GetTableId(), key.GetKeyBuf(), key.GetKeyLength(), csn);
+}
+
+void CheckpointManager::UpdateDeltaChainIds()
+{
+    m_deltaChainIds.clear();
+    for (DeltaChainMap::const_iterator it = m_deltaChain.begin(); it != m_deltaChain.end(); (void)++it) {
+        for (const CheckpointUtils::ChainLink& link : it->second.m_links) {
+            (void)m_deltaChainIds.insert(link.m_checkpointId);
+        }
+    }
+}
+
+void CheckpointManager::SetDeltaChain(DeltaChainMap& chain, uint64_t minCsn, uint32_t numDeltas)
+{
+    (void)pthread_rwlock_wrlock(&m_fetchLock);
+    m_deltaChain.swap(chain);
+    chain.clear();
+    m_deltaMinCsn = minCsn;
+    m_numDeltas = numDeltas;
+    m_deltaChainValid = true;
+    UpdateDeltaChainIds();
+    (void)pthread_rwlock_unlock(&m_fetchLock);
+}
+
+void CheckpointManager::GetDeltaChainDirNames(std::vector<std::string>& dirNames) const
+{
+    for (uint64_t chainId : m_deltaChainIds) {
+        if (chainId == m_id) {
+            continue;
+        }
+        std::string dirName;
+        (void)CheckpointUtils::SetDirName(dirName, chainId);
+        dirNames.push_back(dirName);
+    }
+}
 }  // namespace MOT
@@ -27,6 +27,7 @@
 
 #include <atomic>
 #include <iostream>
+#include <set>
 #include <pthread.h>
 #include "rw_lock.h"
 #include "global.h"
@@ -123,6 +124,10 @@ public:
      */
     void TaskDone(Table* table, uint32_t numSegs, bool success) override;
 
+    uint64_t GetDeltaMinCsn(const Table* table) const override;
+
+    const CheckpointDeleteLog::DeletedKey* GetDeletedKeys(uint32_t tableId) const override;
+
     std::string& GetWorkingDir() override
     {
         return m_workingDir;
@@ -152,11 +157,27 @@ public:
     }
 
     /**
-     * @brief Deletes 'old' checkpoint directories
+     * @brief Deletes 'old' checkpoint directories, except the ones referenced by the current delta chain
      * @param the current checkpoint id which should not be deleted
      */
     void RemoveOldCheckpoints(uint64_t curCheckcpointId);
 
+    /**
+     * @brief Sets the delta chain of the checkpoint that the database was recovered from, so that the
+     * next checkpoint can extend it.
+     * @param chain The tables' delta chains. The map is consumed.
+     * @param minCsn The CSN boundary of the recovered checkpoint.
+     * @param numDeltas The number of delta checkpoints since the last full image.
+     */
+    void SetDeltaChain(DeltaChainMap& chain, uint64_t minCsn, uint32_t numDeltas);
+
+    /**
+     * @brief Returns the directory names of the older checkpoints that the current checkpoint depends on.
+     * Should be called while holding the fetch lock.
+     * @param dirNames The returned directory names.
+     */
+    void GetDeltaChainDirNames(std::vector<std::string>& dirNames) const;
+
     int GetErrorCode() const
     {
         return m_checkpointError;
@@ -299,6 +320,39 @@ private:
     // this lock guards gs_ctl checkpoint fetching
     pthread_rwlock_t m_fetchLock;
 
+    // Keys deleted since the last checkpoint cut
+    CheckpointDeleteLog m_deleteLog;
+
+    // Keys deleted between the previous and the current checkpoint cuts, grouped by table
+    CheckpointDeleteLog::DeletedKeysMap m_deletedKeys;
+
+    // Delta chains of the last valid (completed) checkpoint
+    DeltaChainMap m_deltaChain;
+
+    // Delta chains of the current (in-progress) checkpoint
+    DeltaChainMap m_nextDeltaChain;
+
+    // Ids of the checkpoints referenced by the last valid delta chain
+    std::set<uint64_t> m_deltaChainIds;
+
+    // Rows with a lower CSN were captured by the last valid checkpoint
+    uint64_t m_deltaMinCsn;
+
+    // CSN boundary of the current (in-progress) checkpoint
+    uint64_t m_nextDeltaMinCsn;
+
+    // Number of delta checkpoints since the last full image
+    uint32_t m_numDeltas;
+
+    // Indicates the current checkpoint writes deltas
+    bool m_isDeltaCheckpoint;
+
+    // Indicates the last valid checkpoint can be extended by a delta
+    bool m_deltaChainValid;
+
+    // Indicates the current checkpoint can be extended by a delta once completed
+    bool m_nextDeltaChainValid;
+
     CheckpointPhase GetPhase() const
     {
         return m_phase;
@@ -401,6 +455,34 @@ private:
 
     void ResetFlags();
 
+    /**
+     * @brief Decides whether the current checkpoint is a delta or a full image, and collects the deleted keys.
+     * Must be called in RESOLVE phase.
+     */
+    void PrepareDeltaCheckpoint();
+
+    /**
+     * @brief Adds the current checkpoint to a table's delta chain. Called with the tasks mutex held.
+     * @param table The table's pointer.
+     * @param numSegs The maximum segment id written.
+     */
+    void AddDeltaChainLink(const Table* table, uint32_t numSegs);
+
+    /**
+     * @brief Creates the checkpoint's delta chain file, listing the checkpoints holding each table's data.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateDeltaChainFile();
+
+    /**
+     * @brief Records the primary key of a deleted row for the next delta checkpoint.
+     * @param row The deleted row.
+     * @param csn The commit sequence number of the deleting transaction.
+     */
+    void RecordDeletedKey(Row* row, uint64_t csn);
+
+    void UpdateDeltaChainIds();
+
     /**
      * @brief Deletes a checkpoint directory
      * @param checkpointId The checkpoint id to be deleted.
@@ -22,10 +22,13 @@
  * -------------------------------------------------------------------------
  */
 
+#include <algorithm>
 #include "global.h"
 #include "checkpoint_utils.h"
 #include "utilities.h"
 #include "mot_error.h"
+#include "buffer.h"
+#include "lz4.h"
 
 namespace MOT {
 DECLARE_LOGGER(CheckpointUtils, Checkpoint);
@@ -207,5 +210,115 @@ void Hexdump(const char* msg, char* b, uint32_t buflen)
         (void)fprintf(stderr, "%s\n", line);
     }
 }
+
+size_t CompressBound(size_t rawLen)
+{
+    return sizeof(CompressedBlockHeader) + (size_t)LZ4_compressBound((int)rawLen);
+}
+
+bool WriteCompressedBlock(int fd, const char* data, size_t len, char* compressBuf)
+{
+    CompressedBlockHeader* header = (CompressedBlockHeader*)compressBuf;
+    char* compressedData = compressBuf + sizeof(CompressedBlockHeader);
+    int compressedLen = LZ4_compress_default(data, compressedData, (int)len, LZ4_compressBound((int)len));
+    header->m_rawLen = (uint32_t)len;
+    if (compressedLen <= 0 || (size_t)compressedLen >= len) {
+        // incompressible data is stored as is
+        header->m_compressedLen = (uint32_t)len;
+        if (WriteFile(fd, compressBuf, sizeof(CompressedBlockHeader)) != sizeof(CompressedBlockHeader)) {
+            return false;
+        }
+        return (WriteFile(fd, data, len) == len);
+    }
+    header->m_compressedLen = (uint32_t)compressedLen;
+    size_t blockLen = sizeof(CompressedBlockHeader) + (size_t)compressedLen;
+    return (WriteFile(fd, compressBuf, blockLen) == blockLen);
+}
+
+DataFileReader::~DataFileReader()
+{
+    if (m_blockData != nullptr) {
+        delete[] m_blockData;
+        m_blockData = nullptr;
+    }
+    if (m_compressedData != nullptr) {
+        delete[] m_compressedData;
+        m_compressedData = nullptr;
+    }
+}
+
+bool DataFileReader::Attach(int fd, bool compressed)
+{
+    m_fd = fd;
+    m_compressed = compressed;
+    m_blockLen = 0;
+    m_blockOffset = 0;
+    if (compressed && m_blockData == nullptr) {
+        // buffers are allocated on first use, so recovery of uncompressed checkpoints does not pay for them
+        m_blockData = new (std::nothrow) char[DEFAULT_BUFFER_SIZE];
+        m_compressedData = new (std::nothrow) char[LZ4_compressBound(DEFAULT_BUFFER_SIZE)];
+        if (m_blockData == nullptr || m_compressedData == nullptr) {
+            MOT_LOG_ERROR("DataFileReader::Attach: Failed to allocate decompression buffers");
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t DataFileReader::Read(char* data, size_t len)
+{
+    if (!m_compressed) {
+        return ReadFile(m_fd, data, len);
+    }
+
+    size_t bytesRead = 0;
+    while (bytesRead < len) {
+        if (m_blockOffset == m_blockLen && !ReadBlock()) {
+            break;
+        }
+        size_t chunk = std::min(len - bytesRead, (size_t)(m_blockLen - m_blockOffset));
+        errno_t erc = memcpy_s(data + bytesRead, len - bytesRead, m_blockData + m_blockOffset, chunk);
+        securec_check(erc, "\0", "\0");
+        m_blockOffset += (uint32_t)chunk;
+        bytesRead += chunk;
+    }
+    return bytesRead;
+}
+
+bool DataFileReader::ReadBlock()
+{
+    CompressedBlockHeader header;
+    if (ReadFile(m_fd, (char*)&header, sizeof(CompressedBlockHeader)) != sizeof(CompressedBlockHeader)) {
+        MOT_LOG_ERROR("DataFileReader::ReadBlock: Failed to read block header");
+        return false;
+    }
+    if (header.m_rawLen == 0 || header.m_rawLen > DEFAULT_BUFFER_SIZE || header.m_compressedLen > header.m_rawLen) {
+        MOT_LOG_ERROR("DataFileReader::ReadBlock: Invalid block header, raw length %u, compressed length %u",
+            header.m_rawLen,
+            header.m_compressedLen);
+        return false;
+    }
+
+    if (header.m_compressedLen == header.m_rawLen) {
+        if (ReadFile(m_fd, m_blockData, header.m_rawLen) != header.m_rawLen) {
+            MOT_LOG_ERROR("DataFileReader::ReadBlock: Failed to read %u bytes", header.m_rawLen);
+            return false;
+        }
+    } else {
+        if (ReadFile(m_fd, m_compressedData, header.m_compressedLen) != header.m_compressedLen) {
+            MOT_LOG_ERROR("DataFileReader::ReadBlock: Failed to read %u bytes", header.m_compressedLen);
+            return false;
+        }
+        int rawLen = LZ4_decompress_safe(
+            m_compressedData, m_blockData, (int)header.m_compressedLen, (int)DEFAULT_BUFFER_SIZE);
+        if (rawLen != (int)header.m_rawLen) {
+            MOT_LOG_ERROR("DataFileReader::ReadBlock: Failed to decompress block (%d)", rawLen);
+            return false;
+        }
+    }
+    m_blockLen = header.m_rawLen;
+    m_blockOffset = 0;
+    return true;
+}
 }  // namespace CheckpointUtils
 }  // namespace MOT
@@ -39,6 +39,9 @@ namespace CheckpointUtils {
 // Checkpoint file header magic number
 const uint64_t HEADER_MAGIC = 0xaabbccdd;
 
+// Header magic number of checkpoint data files holding LZ4 compressed blocks
+const uint64_t COMPRESSED_HEADER_MAGIC = 0xaabbccee;
+
 // Checkpoint dir prefix
 const char* const CKPT_DIR_PREFIX = "chkpt_";
 
@@ -60,6 +63,12 @@ const char* const IPD_FILE_SUFFIX = ".ptd";
 // End file suffix
 const char* const END_FILE_SUFFIX = ".end";
 
+// Delta chain file suffix
+const char* const CHAIN_FILE_SUFFIX = ".chn";
+
+// Deleted keys file suffix
+const char* const DEL_FILE_SUFFIX = ".del";
+
 // Max path length
 const size_t MAX_PATH = 1024;
 
@@ -302,6 +311,33 @@ inline void MakeEndFilename(std::string& fileName, const std::string& workingDir
     (void)fileName.append(END_FILE_SUFFIX);
 }
 
+/**
+ * @brief Creates a delta chain filename according to the checkpoint id
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param cpId The checkpoint id.
+ */
+inline void MakeChainFilename(std::string& fileName, const std::string& workingDir, uint64_t cpId)
+{
+    MakeFilename(fileName, workingDir);
+    (void)fileName.append(std::to_string(cpId));
+    (void)fileName.append(CHAIN_FILE_SUFFIX);
+}
+
+/**
+ * @brief Creates a delta checkpoint deleted keys filename
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ */
+inline void MakeDelFilename(uint64_t tableId, std::string& fileName, const std::string& workingDir)
+{
+    MakeFilename(fileName, workingDir);
+    (void)fileName.append("tab_");
+    (void)fileName.append(std::to_string(tableId));
+    (void)fileName.append(DEL_FILE_SUFFIX);
+}
+
 /**
  * @brief Sets the cpu affinity for a given thread
  * @param cpu The cpu that the thread should run on.
@@ -350,11 +386,36 @@ struct MapFileHeader {
     uint64_t m_numEntries;
 };
 
+struct ChainFileHeader {
+    uint64_t m_magic;
+    uint64_t m_minCsn;
+    uint64_t m_numDeltas;
+    uint64_t m_numEntries;
+};
+
+struct ChainFileEntry {
+    uint32_t m_tableId;
+    uint32_t m_numLinks;
+};
+
+/* One checkpoint in a table's delta chain. The first link of a chain is always a full image. */
+struct ChainLink {
+    uint64_t m_checkpointId;
+    uint32_t m_maxSegId;
+    uint32_t m_numDeletes;
+};
+
 struct PendingTxnDataFileHeader {
     uint64_t m_magic;
     uint64_t m_numEntries;
 };
 
+/* Precedes each block of a compressed data file. A block whose lengths are equal is stored uncompressed. */
+struct CompressedBlockHeader {
+    uint32_t m_rawLen;
+    uint32_t m_compressedLen;
+};
+
 /* Deprecated, used in older versions (metaVersion < METADATA_VER_LOW_RTO). */
 struct TpcEntryHeader {
     uint64_t m_magic;
@@ -368,6 +429,81 @@ struct TpcEntryHeader {
  * @param bufLen the buffer length
  */
 void Hexdump(const char* msg, char* b, uint32_t bufLen);
+
+/**
+ * @brief Returns the size of the buffer needed to compress a block.
+ * @param rawLen The maximal length of the block to compress.
+ * @return The compression buffer size.
+ */
+size_t CompressBound(size_t rawLen);
+
+/**
+ * @brief Compresses a block of data with LZ4 and writes it to a file, preceded by its block header.
+ * @param fd The file descriptor to write to.
+ * @param data The data to compress.
+ * @param len The data length.
+ * @param compressBuf The compression buffer, of at least CompressBound(len) bytes.
+ * @return Boolean value denoting success or failure.
+ */
+bool WriteCompressedBlock(int fd, const char* data, size_t len, char* compressBuf);
+
+/**
+ * @class DataFileReader
+ * @brief Reads the entries of a checkpoint data file, decompressing the blocks of compressed files.
+ */
+class DataFileReader {
+public:
+    DataFileReader()
+        : m_fd(-1),
+          m_compressed(false),
+          m_blockData(nullptr),
+          m_compressedData(nullptr),
+          m_blockLen(0),
+          m_blockOffset(0)
+    {}
+
+    ~DataFileReader();
+
+    /**
+     * @brief Attaches the reader to a data file, positioned after its file header.
+     * @param fd The file descriptor to read from.
+     * @param compressed Specifies whether the file holds compressed blocks.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Attach(int fd, bool compressed);
+
+    /**
+     * @brief Reads from the data file.
+     * @param data The buffer to fill.
+     * @param len The number of bytes to read.
+     * @return The number of bytes that were read.
+     */
+    size_t Read(char* data, size_t len);
+
+    DataFileReader(const DataFileReader& orig) = delete;
+    DataFileReader& operator=(const DataFileReader& orig) = delete;
+
+private:
+    /**
+     * @brief Reads and decompresses the next block of the file.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadBlock();
+
+    int m_fd;
+
+    bool m_compressed;
+
+    // Decompressed data of the current block
+    char* m_blockData;
+
+    // Compressed data of the current block
+    char* m_compressedData;
+
+    uint32_t m_blockLen;
+
+    uint32_t m_blockOffset;
+};
 }  // namespace CheckpointUtils
 }  // namespace MOT
 
@@ -29,6 +29,7 @@
 #include "checkpoint_utils.h"
 #include "checkpoint_worker.h"
 #include "mot_engine.h"
+#include "cold_row_store.h"
 
 namespace MOT {
 DECLARE_LOGGER(CheckpointWorkerPool, Checkpoint);
@@ -85,7 +86,7 @@ CheckpointWorkerPool::~CheckpointWorkerPool()
     MOT_LOG_DEBUG("~CheckpointWorkerPool: Done");
 }
 
-bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd, uint64_t transactionId)
+bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, const SegmentFile& file, uint64_t transactionId)
 {
     MaxKey key;
     Key* primaryKey = &key;
@@ -95,17 +96,14 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd, uint64_t tran
     if (buffer->Size() + primaryKey->GetKeyLength() + row->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader) >
         buffer->MaxSize()) {
         // need to flush the buffer before serializing the next row
-        size_t wrSta = CheckpointUtils::WriteFile(fd, (const char*)buffer->Data(), buffer->Size());
-        if (wrSta != buffer->Size()) {
+        if (!FlushBuffer(file.m_fd, buffer, file.m_compressBuf)) {
             MOT_LOG_ERROR("CheckpointWorkerPool::Write - Failed to write %u bytes to [%d] (%d:%s)",
                 buffer->Size(),
-                fd,
+                file.m_fd,
                 errno,
                 gs_strerror(errno));
             return false;
         }
-
-        buffer->Reset();
     }
     CheckpointUtils::EntryHeader entryHeader;
     entryHeader.m_base.m_keyLen = primaryKey->GetKeyLength();
@@ -129,8 +127,8 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd, uint64_t tran
     return true;
 }
 
-int CheckpointWorkerPool::Checkpoint(
-    Buffer* buffer, PrimarySentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, Row*& deletedVersion)
+int CheckpointWorkerPool::Checkpoint(Buffer* buffer, PrimarySentinel* sentinel, const SegmentFile& file,
+    uint16_t threadId, bool& isDeleted, Row*& deletedVersion, uint64_t minCsn)
 {
     Row* mainRow = nullptr;
     Row* stableRow = nullptr;
@@ -145,6 +143,17 @@ int CheckpointWorkerPool::Checkpoint(
         return 0;
     }
 
+    if (sentinel->IsEvicted()) {
+        // evicted rows are neither deleted nor have a stable version
+        MOT_ASSERT(sentinel->GetStable() == nullptr);
+        if (sentinel->GetStableStatus() != !m_cpManager.GetNotAvailableBit()) {
+            sentinel->SetStableStatus(!m_cpManager.GetNotAvailableBit());
+            wrote = CheckpointEvicted(buffer, sentinel, file, minCsn);
+        }
+        sentinel->Unlock();
+        return wrote;
+    }
+
     stableRow = sentinel->GetStable();
     mainRow = sentinel->GetData();
     if (mainRow == nullptr) {
@@ -175,7 +184,13 @@ int CheckpointWorkerPool::Checkpoint(
                 break;
             }
 
-            if (!Write(buffer, stableRow, fd, stableRow->GetStableTid())) {
+            if (stableRow->GetCommitSequenceNumber() < minCsn) {
+                // unchanged since the previous checkpoint
+                if (!isDeleted) {
+                    CheckpointUtils::DestroyStableRow(stableRow);
+                    sentinel->SetStable(nullptr);
+                }
+            } else if (!Write(buffer, stableRow, file, stableRow->GetStableTid())) {
                 wrote = -1;
             } else {
                 if (!isDeleted) {
@@ -192,7 +207,9 @@ int CheckpointWorkerPool::Checkpoint(
                     break;
                 }
                 sentinel->SetStableStatus(!m_cpManager.GetNotAvailableBit());
-                if (!Write(buffer, mainRow, fd, mainRow->GetPrimarySentinel()->GetTransactionId())) {
+                if (mainRow->GetCommitSequenceNumber() < minCsn) {
+                    wrote = 0;  // unchanged since the previous checkpoint
+                } else if (!Write(buffer, mainRow, file, mainRow->GetPrimarySentinel()->GetTransactionId())) {
                     wrote = -1;  // we failed to write, set error
                 } else {
                     wrote = 1;
@@ -215,18 +232,131 @@ int CheckpointWorkerPool::Checkpoint(
     return wrote;
 }
 
-Table* CheckpointWorkerPool::GetTask()
+int CheckpointWorkerPool::CheckpointEvicted(
+    Buffer* buffer, PrimarySentinel* sentinel, const SegmentFile& file, uint64_t minCsn)
 {
-    std::lock_guard<std::mutex> lock(m_tasksLock);
-    Table* table = nullptr;
-    do {
-        if (m_cpManager.GetTasksList().empty()) {
-            break;
+    Table* table = sentinel->GetIndex()->GetTable();
+    ColdRowStore* store = table->GetColdStore();
+    uint64_t offset = sentinel->GetEvictedOffset();
+    if (minCsn != 0) {
+        ColdRowStore::RecordHeader header;
+        if (!store->ReadHeader(offset, header)) {
+            return -1;
         }
-        table = m_cpManager.GetTasksList().front();
+        if (header.m_csn < minCsn) {
+            return 0;  // unchanged since the previous checkpoint
+        }
+    }
+
+    Row* row = store->LoadRow(table, sentinel, offset);
+    if (row == nullptr) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::CheckpointEvicted: failed to load evicted row of table %u",
+            table->GetTableId());
+        return -1;
+    }
+    int wrote = Write(buffer, row, file, sentinel->GetTransactionId()) ? 1 : -1;
+    table->DestroyRow(row);
+    return wrote;
+}
+
+CheckpointWorkerPool::TableTask* CheckpointWorkerPool::GetTask(bool& isOwner)
+{
+    std::lock_guard<std::mutex> lock(m_tasksLock);
+    if (!m_cpManager.GetTasksList().empty()) {
+        Table* table = m_cpManager.GetTasksList().front();
         m_cpManager.GetTasksList().pop_front();
-    } while (0);
-    return table;
+        Index* index = table->GetPrimaryIndex();
+        bool shared = (index != nullptr);
+        TableTask* task = new (std::nothrow) TableTask(table,
+            m_cpManager.GetDeltaMinCsn(table),
+            shared,
+            GetGlobalConfiguration().m_enableCheckpointCompression);
+        if (task == nullptr) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::GetTask: Failed to allocate task for table %u", table->GetTableId());
+            m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
+            m_cpManager.TaskDone(table, 0, false);
+            return nullptr;
+        }
+        if (shared) {
+            m_sharedTasks.push_back(task);
+        }
+        isOwner = true;
+        return task;
+    }
+
+    // no table is left for a worker of its own, so help with the table that has the fewest writers
+    TableTask* task = nullptr;
+    for (TableTask* sharedTask : m_sharedTasks) {
+        if (!sharedTask->m_exhausted && (task == nullptr || sharedTask->m_numWriters < task->m_numWriters)) {
+            task = sharedTask;
+        }
+    }
+    if (task != nullptr) {
+        ++task->m_numWriters;
+        isOwner = false;
+    }
+    return task;
+}
+
+void CheckpointWorkerPool::LeaveTask(TableTask* task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_tasksLock);
+        if (--task->m_numWriters > 0) {
+            return;
+        }
+        if (task->m_shared) {
+            m_sharedTasks.remove(task);
+        }
+    }
+
+    m_cpManager.TaskDone(task->m_table, task->m_nextSegId - 1, !task->m_failed);
+    delete task;
+}
+
+uint32_t CheckpointWorkerPool::ClaimRange(
+    TableTask* task, Index* index, PrimarySentinel** range, uint16_t threadId, ErrCodes& err)
+{
+    err = ErrCodes::SUCCESS;
+    std::lock_guard<std::mutex> lock(task->m_lock);
+    if (task->m_exhausted) {
+        return 0;
+    }
+
+    IndexIterator* it = nullptr;
+    if (!task->m_started) {
+        it = index->Begin(threadId);
+        task->m_started = true;
+    } else {
+        it = index->Seek(&task->m_nextKey, threadId);
+    }
+    if (it == nullptr) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::ClaimRange: failed to obtain iterator for table %u",
+            task->m_table->GetTableId());
+        err = ErrCodes::INDEX;
+        return 0;
+    }
+
+    uint32_t rangeSize = 0;
+    while (rangeSize < MAX_ITERS_COUNT && it->IsValid()) {
+        PrimarySentinel* sentinel = static_cast<PrimarySentinel*>(it->GetPrimarySentinel());
+        MOT_ASSERT(sentinel);
+        if (sentinel != nullptr) {
+            range[rangeSize++] = sentinel;
+        } else {
+            MOT_LOG_ERROR("CheckpointWorkerPool::ClaimRange: encountered a null sentinel");
+        }
+        it->Next();
+    }
+
+    if (!it->IsValid()) {
+        task->m_exhausted = true;
+    } else {
+        // the next range may be claimed by another worker, so the scan continues from the next key
+        task->m_nextKey.CpKey(*(const Key*)(it->GetKey()));
+    }
+    delete it;
+    return rangeSize;
 }
 
 bool CheckpointWorkerPool::ExecuteMicroGcTransaction(
@@ -311,10 +441,13 @@ void CheckpointWorkerPool::WorkerFunc(uint32_t workerId)
     }
 
     DeletePair* deletedList = new (std::nothrow) DeletePair[DELETE_LIST_SIZE];
-    if (deletedList == nullptr) {
-        MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to allocate memory for deleted sentinel list");
+    PrimarySentinel** range = new (std::nothrow) PrimarySentinel*[MAX_ITERS_COUNT];
+    if (deletedList == nullptr || range == nullptr) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to allocate memory for sentinel lists");
         m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
         workerContext->SetError();
+        delete[] deletedList;
+        delete[] range;
         GetSessionManager()->DestroySessionContext(sessionContext);
         MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
         MOT_LOG_DEBUG("%s - Exiting", threadName);
@@ -323,6 +456,7 @@ void CheckpointWorkerPool::WorkerFunc(uint32_t workerId)
 
     workerContext->SetReady();
 
+    char* compressBuf = nullptr;
     bool taskSucceeded = true;
     while (taskSucceeded) {
         if (m_cpManager.GetThreadNotifier().Wait(Wakeup, &m_cpManager) == ThreadNotifier::ThreadState::TERMINATE) {
@@ -338,30 +472,46 @@ void CheckpointWorkerPool::WorkerFunc(uint32_t workerId)
             }
         }
 
-        Table* table = GetTask();
-        while (table != nullptr) {
-            uint32_t maxSegId = 0;
-
+        bool isOwner = false;
+        TableTask* task = GetTask(isOwner);
+        while (task != nullptr) {
+            Table* table = task->m_table;
             do {
                 // Try to clean previous garbage if any.
                 gcSession->GcEndTxn();
                 taskSucceeded = false;
                 uint32_t tableId = table->GetTableId();
-                ErrCodes errCode = WriteTableMetadataFile(table);
-                if (errCode != ErrCodes::SUCCESS) {
-                    MOT_LOG_ERROR(
-                        "CheckpointWorkerPool::WorkerFunc: Failed to write table metadata file for table %u", tableId);
-                    m_cpManager.OnError(
-                        errCode, "Failed to write table metadata file for table - ", std::to_string(tableId).c_str());
-                    workerContext->SetError();
-                    break;
+                ErrCodes errCode = ErrCodes::SUCCESS;
+                if (isOwner) {
+                    errCode = WriteTableMetadataFile(table);
+                    if (errCode != ErrCodes::SUCCESS) {
+                        MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to write table metadata file for "
+                                      "table %u",
+                            tableId);
+                        m_cpManager.OnError(errCode,
+                            "Failed to write table metadata file for table - ",
+                            std::to_string(tableId).c_str());
+                        workerContext->SetError();
+                        break;
+                    }
+                }
+
+                if (task->m_compress && compressBuf == nullptr) {
+                    compressBuf = new (std::nothrow) char[CheckpointUtils::CompressBound(buffer.MaxSize())];
+                    if (compressBuf == nullptr) {
+                        MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to allocate compression buffer");
+                        m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
+                        workerContext->SetError();
+                        break;
+                    }
                 }
 
                 struct timespec start, end;
                 uint64_t numOps = 0;
                 (void)clock_gettime(CLOCK_MONOTONIC, &start);
 
-                errCode = WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps);
+                errCode = WriteTableDataFile(
+                    task, isOwner, &buffer, range, deletedList, gcSession, threadId, compressBuf, numOps);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to write table data file for table %u, "
                                   "error: %u",
@@ -373,6 +523,21 @@ void CheckpointWorkerPool::WorkerFunc(uint32_t workerId)
                     break;
                 }
 
+                const CheckpointDeleteLog::DeletedKey* deletedKeys = m_cpManager.GetDeletedKeys(tableId);
+                if (isOwner && task->m_minCsn != 0 && deletedKeys != nullptr) {
+                    errCode = WriteTableDelFile(table, &buffer, deletedKeys);
+                    if (errCode != ErrCodes::SUCCESS) {
+                        MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to write deleted keys file for "
+                                      "table %u",
+                            tableId);
+                        m_cpManager.OnError(errCode,
+                            "Failed to write deleted keys file for table - ",
+                            std::to_string(tableId).c_str());
+                        workerContext->SetError();
+                        break;
+                    }
+                }
+
                 taskSucceeded = true;
                 (void)clock_gettime(CLOCK_MONOTONIC, &end);
                 /*
@@ -380,30 +545,39 @@ void CheckpointWorkerPool::WorkerFunc(uint32_t workerId)
                  * (/1000) is to convert nano seconds to micro seconds
                  */
                 uint64_t deltaUs = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
-                MOT_LOG_DEBUG(
-                    "CheckpointWorkerPool::WorkerFunc: Checkpoint of table %u completed in %luus, (%lu elements)",
+                MOT_LOG_DEBUG("CheckpointWorkerPool::WorkerFunc: Checkpoint of table %u (%s) completed in %luus, "
+                              "(%lu elements%s)",
                     tableId,
+                    isOwner ? "owner" : "helper",
                     deltaUs,
-                    numOps);
+                    numOps,
+                    (task->m_minCsn != 0) ? ", delta" : "");
             } while (0);
 
-            m_cpManager.TaskDone(table, maxSegId, taskSucceeded);
+            if (!taskSucceeded) {
+                // other writers of the table stop at their next range
+                task->m_failed = true;
+                task->m_exhausted = true;
+            }
+            LeaveTask(task);
 
             if (!taskSucceeded) {
                 break;
             }
 
-            table = GetTask();
+            task = GetTask(isOwner);
         }
     }
 
+    delete[] compressBuf;
+    delete[] range;
     delete[] deletedList;
     GetSessionManager()->DestroySessionContext(sessionContext);
     MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
     MOT_LOG_INFO("%s - Exiting", threadName);
 }
 
-bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId)
+bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId, bool compressed)
 {
     std::string fileName;
     CheckpointUtils::MakeCpFilename(tableId, fileName, m_cpManager.GetWorkingDir(), seg);
@@ -412,7 +586,8 @@ bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_
         return false;
     }
     MOT_LOG_DEBUG("CheckpointWorkerPool::beginFile: %s", fileName.c_str());
-    CheckpointUtils::FileHeader fileHeader{CheckpointUtils::HEADER_MAGIC, tableId, exId, 0};
+    uint64_t magic = compressed ? CheckpointUtils::COMPRESSED_HEADER_MAGIC : CheckpointUtils::HEADER_MAGIC;
+    CheckpointUtils::FileHeader fileHeader{magic, tableId, exId, 0};
     if (CheckpointUtils::WriteFile(fd, (const char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
         sizeof(CheckpointUtils::FileHeader)) {
         MOT_LOG_ERROR("CheckpointWorkerPool::BeginFile: failed to write file header: %s", fileName.c_str());
@@ -423,7 +598,7 @@ bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_
     return true;
 }
 
-bool CheckpointWorkerPool::FinishFile(int& fd, uint32_t tableId, uint64_t numOps, uint64_t exId)
+bool CheckpointWorkerPool::FinishFile(int& fd, uint32_t tableId, uint64_t numOps, uint64_t exId, bool compressed)
 {
     bool ret = false;
     do {
@@ -431,7 +606,8 @@ bool CheckpointWorkerPool::FinishFile(int& fd, uint32_t tableId, uint64_t numOps
             MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to seek in file (id: %u)", tableId);
             break;
         }
-        CheckpointUtils::FileHeader fileHeader{CheckpointUtils::HEADER_MAGIC, tableId, exId, numOps};
+        uint64_t magic = compressed ? CheckpointUtils::COMPRESSED_HEADER_MAGIC : CheckpointUtils::HEADER_MAGIC;
+        CheckpointUtils::FileHeader fileHeader{magic, tableId, exId, numOps};
         if (CheckpointUtils::WriteFile(fd, (const char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
             sizeof(CheckpointUtils::FileHeader)) {
             MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to write to file (id: %u)", tableId);
@@ -511,10 +687,14 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableMetadataFile(Tabl
     return ErrCodes::SUCCESS;
 }
 
-bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
+bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer, char* compressBuf)
 {
     if (buffer->Size() > 0) {  // there is data in the buffer that needs to be written
-        if (CheckpointUtils::WriteFile(fd, (const char*)buffer->Data(), buffer->Size()) != buffer->Size()) {
+        if (compressBuf != nullptr) {
+            if (!CheckpointUtils::WriteCompressedBlock(fd, (const char*)buffer->Data(), buffer->Size(), compressBuf)) {
+                return false;
+            }
+        } else if (CheckpointUtils::WriteFile(fd, (const char*)buffer->Data(), buffer->Size()) != buffer->Size()) {
             return false;
         }
         buffer->Reset();
@@ -522,39 +702,62 @@ bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
     return true;
 }
 
-bool CheckpointWorkerPool::KeepIterating(
-    Index* index, IndexIterator*& it, uint32_t& numIterations, uint16_t threadId, GcManager* gcSession, ErrCodes& err)
+bool CheckpointWorkerPool::CloseSegment(Table* table, Buffer* buffer, SegmentFile& file)
 {
-    err = ErrCodes::SUCCESS;
-    if (it->IsValid() && numIterations >= MAX_ITERS_COUNT) {
-        MaxKey lastKey;
-        lastKey.CpKey(*(const Key*)(it->GetKey()));
-        delete it;
-        gcSession->GcReinitEpoch();
-        bool found = false;
-        it = index->Search(&lastKey, true, true, threadId, found);
-        if (it == nullptr) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::KeepIterating: failed to obtain iterator");
-            err = ErrCodes::MEMORY;
-            return false;
-        }
-        numIterations = 0;
+    if (file.m_fd == -1) {
+        return true;
+    }
+
+    uint32_t tableId = table->GetTableId();
+    if (!FlushBuffer(file.m_fd, buffer, file.m_compressBuf)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::CloseSegment: failed to write remaining buffer data (%u bytes) to "
+                      "data file %u for table %u",
+            buffer->Size(),
+            file.m_segId,
+            tableId);
+        (void)CheckpointUtils::CloseFile(file.m_fd);
+        file.m_fd = -1;
+        return false;
+    }
+
+    /* FinishFile will reset the fd to -1 on success. */
+    if (!FinishFile(file.m_fd, tableId, file.m_numOps, table->GetTableExId(), file.m_compressBuf != nullptr)) {
+        MOT_LOG_ERROR(
+            "CheckpointWorkerPool::CloseSegment: failed to close data file %u for table %u", file.m_segId, tableId);
+        (void)CheckpointUtils::CloseFile(file.m_fd);
+        file.m_fd = -1;
+        return false;
+    }
+    return true;
+}
+
+bool CheckpointWorkerPool::NextSegment(Table* table, Buffer* buffer, SegmentFile& file, uint32_t segId)
+{
+    if (!CloseSegment(table, buffer, file)) {
+        return false;
+    }
+
+    file.m_segId = segId;
+    file.m_numOps = 0;
+    file.m_len = 0;
+    if (!BeginFile(file.m_fd, table->GetTableId(), segId, table->GetTableExId(), file.m_compressBuf != nullptr)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::NextSegment: failed to create data file %u for table %u",
+            segId,
+            table->GetTableId());
+        return false;
     }
-    return it->IsValid();
+    return true;
 }
 
-CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* table, Buffer* buffer,
-    DeletePair* deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps)
+CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(TableTask* task, bool isOwner, Buffer* buffer,
+    PrimarySentinel** range, DeletePair* deletedList, GcManager* gcSession, uint16_t threadId, char* compressBuf,
+    uint64_t& numOps)
 {
+    Table* table = task->m_table;
     uint32_t tableId = table->GetTableId();
-    uint64_t exId = table->GetTableExId();
-    int fd = -1;
     uint16_t deletedListLocation = 0;
-    uint64_t currFileOps = 0;
-    uint32_t curSegLen = 0;
-    uint32_t numIterations = 0;
+    SegmentFile file = {-1, 0, 0, 0, task->m_compress ? compressBuf : nullptr};
 
-    maxSegId = 0;
     numOps = 0;
     Index* index = table->GetPrimaryIndex();
     if (index == nullptr) {
@@ -567,18 +770,8 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
         return ErrCodes::MEMORY;
     }
 
-    IndexIterator* it = index->Begin(threadId);
-    if (it == nullptr) {
-        MOT_LOG_ERROR(
-            "CheckpointWorkerPool::WriteTableDataFile: failed to get iterator for primary index on table %u", tableId);
-        gcSession->GcEndTxn();
-        return ErrCodes::INDEX;
-    }
-
-    if (!BeginFile(fd, tableId, maxSegId, exId)) {
-        MOT_LOG_ERROR(
-            "CheckpointWorkerPool::WriteTableDataFile: failed to create data file %u for table %u", maxSegId, tableId);
-        delete it;
+    // the owner always writes the first segment, so an empty table still has one
+    if (isOwner && !NextSegment(table, buffer, file, 0)) {
         gcSession->GcEndTxn();
         return ErrCodes::FILE_IO;
     }
@@ -588,72 +781,46 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
     bool isDeleted = false;
     bool needGc = false;
     Row* deletedVersion = nullptr;
-    while (KeepIterating(index, it, numIterations, threadId, gcSession, errCode)) {
-        MOT::PrimarySentinel* sentinel = static_cast<PrimarySentinel*>(it->GetPrimarySentinel());
-        MOT_ASSERT(sentinel);
-        if (sentinel == nullptr) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDataFile: encountered a null sentinel");
-            it->Next();
-            continue;
-        }
-        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted, deletedVersion);
-        needGc = (isDeleted and !executeGcTxnFailure);
-        if (needGc) {
-            if (!ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, DELETE_LIST_SIZE)) {
-                executeGcTxnFailure = true;
-            }
-            deletedList[deletedListLocation].first = sentinel;
-            deletedList[deletedListLocation].second = deletedVersion;
-            deletedListLocation++;
-        }
-        if (ckptStatus == 1) {
-            currFileOps++;
-            curSegLen += table->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader);
-            if (curSegLen >= m_checkpointSegsize) {
-                if (!FlushBuffer(fd, buffer)) {
-                    MOT_LOG_ERROR(
-                        "CheckpointWorkerPool::WriteTableDataFile: failed to write remaining buffer data (%u bytes) to "
-                        "data file %u for table %u",
-                        buffer->Size(),
-                        maxSegId,
-                        tableId);
-                    errCode = ErrCodes::FILE_IO;
-                    break;
+    uint32_t rangeSize = ClaimRange(task, index, range, threadId, errCode);
+    while (rangeSize > 0) {
+        // helpers open a segment only once they claimed a range, so they do not leave empty files behind
+        if (file.m_fd == -1 && !NextSegment(table, buffer, file, task->m_nextSegId++)) {
+            errCode = ErrCodes::FILE_IO;
+            break;
+        }
+        for (uint32_t i = 0; i < rangeSize; ++i) {
+            PrimarySentinel* sentinel = range[i];
+            int ckptStatus = Checkpoint(buffer, sentinel, file, threadId, isDeleted, deletedVersion, task->m_minCsn);
+            needGc = (isDeleted and !executeGcTxnFailure);
+            if (needGc) {
+                if (!ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, DELETE_LIST_SIZE)) {
+                    executeGcTxnFailure = true;
                 }
-
-                /* FinishFile will reset the fd to -1 on success. */
-                if (!FinishFile(fd, tableId, currFileOps, exId)) {
-                    MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDataFile: failed to close data file %u for table %u",
-                        maxSegId,
-                        tableId);
+                deletedList[deletedListLocation].first = sentinel;
+                deletedList[deletedListLocation].second = deletedVersion;
+                deletedListLocation++;
+            }
+            if (ckptStatus == 1) {
+                numOps++;
+                file.m_numOps++;
+                file.m_len += table->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader);
+                if (file.m_len >= m_checkpointSegsize && !NextSegment(table, buffer, file, task->m_nextSegId++)) {
                     errCode = ErrCodes::FILE_IO;
                     break;
                 }
-
-                maxSegId++;
-                numOps += currFileOps;
-
-                if (!BeginFile(fd, tableId, maxSegId, exId)) {
-                    MOT_LOG_ERROR(
-                        "CheckpointWorkerPool::WriteTableDataFile: failed to create data file %u for table %u",
-                        maxSegId,
-                        tableId);
-                    break;
-                }
-
-                currFileOps = 0;
-                curSegLen = 0;
+            } else if (ckptStatus < 0) {
+                errCode = ErrCodes::CALC;
+                break;
             }
-        } else if (ckptStatus < 0) {
-            errCode = ErrCodes::CALC;
+        }
+        if (errCode != ErrCodes::SUCCESS) {
             break;
         }
-        numIterations++;
-        it->Next();
-    }
 
-    delete it;
-    it = nullptr;
+        // every range is re-positioned by key, so the epoch may advance between ranges
+        gcSession->GcReinitEpoch();
+        rangeSize = ClaimRange(task, index, range, threadId, errCode);
+    }
 
     // Clean leftovers (if any).
     needGc = (deletedListLocation > 0 && !executeGcTxnFailure);
@@ -666,31 +833,84 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
     gcSession->GcEndTxn();
     table->ClearThreadMemoryCache();
     if (errCode != ErrCodes::SUCCESS) {
-        if (fd != -1) {
-            (void)CheckpointUtils::CloseFile(fd);
+        if (file.m_fd != -1) {
+            (void)CheckpointUtils::CloseFile(file.m_fd);
         }
         return errCode;
     }
 
+    if (!CloseSegment(table, buffer, file)) {
+        return ErrCodes::FILE_IO;
+    }
+    return ErrCodes::SUCCESS;
+}
+
+CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDelFile(
+    Table* table, Buffer* buffer, const CheckpointDeleteLog::DeletedKey* deletedKeys)
+{
+    uint32_t tableId = table->GetTableId();
+    uint64_t exId = table->GetTableExId();
+    uint64_t numOps = 0;
+    int fd = -1;
+
+    std::string fileName;
+    CheckpointUtils::MakeDelFilename(tableId, fileName, m_cpManager.GetWorkingDir());
+    if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to create file: %s", fileName.c_str());
+        return ErrCodes::FILE_IO;
+    }
+
+    CheckpointUtils::FileHeader fileHeader{CheckpointUtils::HEADER_MAGIC, tableId, exId, 0};
+    if (CheckpointUtils::WriteFile(fd, (const char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
+        sizeof(CheckpointUtils::FileHeader)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to write file header: %s", fileName.c_str());
+        (void)CheckpointUtils::CloseFile(fd);
+        return ErrCodes::FILE_IO;
+    }
+
+    // deleted keys are written as data-less entries
+    for (const CheckpointDeleteLog::DeletedKey* key = deletedKeys; key != nullptr; key = key->m_next) {
+        if (buffer->Size() + key->m_keyLen + sizeof(CheckpointUtils::EntryHeader) > buffer->MaxSize()) {
+            if (!FlushBuffer(fd, buffer)) {
+                MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to write %u bytes to %s",
+                    buffer->Size(),
+                    fileName.c_str());
+                (void)CheckpointUtils::CloseFile(fd);
+                return ErrCodes::FILE_IO;
+            }
+        }
+
+        CheckpointUtils::EntryHeader entryHeader;
+        entryHeader.m_base.m_keyLen = key->m_keyLen;
+        entryHeader.m_base.m_dataLen = 0;
+        entryHeader.m_base.m_csn = key->m_csn;
+        entryHeader.m_base.m_rowId = Row::INVALID_ROW_ID;
+        entryHeader.m_transactionId = INVALID_TRANSACTION_ID;
+        if (!buffer->Append(&entryHeader, sizeof(CheckpointUtils::EntryHeader)) ||
+            !buffer->Append(key->GetKeyBuf(), key->m_keyLen)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: Failed to write entry to buffer");
+            (void)CheckpointUtils::CloseFile(fd);
+            return ErrCodes::MEMORY;
+        }
+        numOps++;
+    }
+
     if (!FlushBuffer(fd, buffer)) {
-        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDataFile: failed to write remaining buffer data (%u bytes) to "
-                      "data file %u for table %u",
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to write remaining buffer data (%u bytes) to %s",
             buffer->Size(),
-            maxSegId,
-            tableId);
+            fileName.c_str());
         (void)CheckpointUtils::CloseFile(fd);
         return ErrCodes::FILE_IO;
     }
 
     /* FinishFile will reset the fd to -1 on success. */
-    if (!FinishFile(fd, tableId, currFileOps, exId)) {
-        MOT_LOG_ERROR(
-            "CheckpointWorkerPool::WriteTableDataFile: failed to close data file %u for table %u", maxSegId, tableId);
+    if (!FinishFile(fd, tableId, numOps, exId)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to close file: %s", fileName.c_str());
         (void)CheckpointUtils::CloseFile(fd);
         return ErrCodes::FILE_IO;
     }
 
-    numOps += currFileOps;
+    MOT_LOG_DEBUG("CheckpointWorkerPool::WriteTableDelFile: table %u, %lu deleted keys", tableId, numOps);
     return ErrCodes::SUCCESS;
 }
 }  // namespace MOT
@@ -35,8 +35,10 @@
 #include <condition_variable>
 #include "global.h"
 #include "buffer.h"
+#include "key.h"
 #include "mm_gc_manager.h"
 #include "thread_utils.h"
+#include "checkpoint_delta.h"
 
 namespace MOT {
 using DeletePair = std::pair<PrimarySentinel*, Row*>;
@@ -56,11 +58,25 @@ public:
      * @brief Checkpoint task completion callback
      * @param checkpointId The checkpoint's id.
      * @param table The table's pointer.
-     * @param numSegs number of segments written.
+     * @param numSegs The maximal segment id written.
      * @param success Indicates a success or a failure.
      */
     virtual void TaskDone(Table* table, uint32_t numSegs, bool success) = 0;
 
+    /**
+     * @brief Returns the minimal CSN of the rows that should be written for a table.
+     * @param table The table's pointer.
+     * @return The minimal CSN, or zero if a full image of the table should be written.
+     */
+    virtual uint64_t GetDeltaMinCsn(const Table* table) const = 0;
+
+    /**
+     * @brief Returns the keys that were deleted from a table since the previous checkpoint.
+     * @param tableId The table's internal id.
+     * @return The deleted keys list, or nullptr if there are none.
+     */
+    virtual const CheckpointDeleteLog::DeletedKey* GetDeletedKeys(uint32_t tableId) const = 0;
+
     /**
      * @brief returns the current in progress checkpoint working dir.
      */
@@ -109,6 +125,69 @@ public:
     static constexpr uint16_t MAX_ITERS_COUNT = 10000;
 
 private:
+    /**
+     * @struct TableTask
+     * @brief A table being checkpointed. Tables are scanned in ranges of the primary index, which any number of
+     * workers claim and write to segments of their own, so a single large table does not bound the checkpoint
+     * duration. Each range is re-positioned by key (see Index::Seek), so no iterator outlives a GC epoch.
+     */
+    struct TableTask {
+        TableTask(Table* table, uint64_t minCsn, bool shared, bool compress)
+            : m_table(table),
+              m_minCsn(minCsn),
+              m_shared(shared),
+              m_compress(compress),
+              m_started(false),
+              m_exhausted(false),
+              m_failed(false),
+              m_numWriters(1),
+              m_nextSegId(1)
+        {}
+
+        Table* m_table;
+
+        // Rows with a lower CSN were not changed since the previous checkpoint
+        uint64_t m_minCsn;
+
+        // Specifies whether other workers may join the scan
+        bool m_shared;
+
+        // Specifies whether the data files are compressed
+        bool m_compress;
+
+        // Guards the scan position
+        std::mutex m_lock;
+
+        // The first key of the next range
+        MaxKey m_nextKey;
+
+        bool m_started;
+
+        std::atomic<bool> m_exhausted;
+
+        std::atomic<bool> m_failed;
+
+        // Number of workers writing the table, guarded by the tasks lock
+        uint32_t m_numWriters;
+
+        // The next segment id to allocate. The task owner writes segment zero.
+        std::atomic<uint32_t> m_nextSegId;
+    };
+
+    /**
+     * @struct SegmentFile
+     * @brief The data file a worker currently writes for a table.
+     */
+    struct SegmentFile {
+        int m_fd;
+        uint32_t m_segId;
+        uint64_t m_numOps;
+        uint64_t m_len;
+
+        // Compression buffer of the worker, or nullptr if the file is not compressed
+        char* m_compressBuf;
+    };
+
     /**
      * @brief The main worker function.
      */
@@ -118,29 +197,58 @@ private:
      * @brief Appends a row to the buffer. The buffer will be flushed in case it is full.
      * @param buffer The buffer to fill.
      * @param row The row to write.
-     * @param fd The file descriptor to write to.
+     * @param file The data file to write to.
      * @param the row's transaction id.
      * @return Boolean value denoting success or failure.
      */
-    bool Write(Buffer* buffer, Row* row, int fd, uint64_t transactionId);
+    bool Write(Buffer* buffer, Row* row, const SegmentFile& file, uint64_t transactionId);
 
     /**
      * @brief Checkpoints a row, according to whether a stable version exists or not.
      * @param buffer The buffer to fill.
      * @param sentinel The sentinel that holds to row.
-     * @param fd The file descriptor to write to.
+     * @param file The data file to write to.
      * @param threadId The thread id.
      * @param isDeleted The row delete status.
+     * @param minCsn Rows with a lower CSN were not changed since the previous checkpoint and are skipped.
+     * @return -1 on error, 0 if nothing was written and 1 if the row was written.
+     */
+    int Checkpoint(Buffer* buffer, PrimarySentinel* sentinel, const SegmentFile& file, uint16_t threadId,
+        bool& isDeleted, Row*& deletedVersion, uint64_t minCsn);
+
+    /**
+     * @brief Checkpoints an evicted row from the cold row store, without faulting it in. The sentinel is locked.
+     * @param buffer The buffer to fill.
+     * @param sentinel The sentinel of the evicted row.
+     * @param file The data file to write to.
+     * @param minCsn Rows with a lower CSN were not changed since the previous checkpoint and are skipped.
      * @return -1 on error, 0 if nothing was written and 1 if the row was written.
      */
-    int Checkpoint(
-        Buffer* buffer, PrimarySentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, Row*& deletedVersion);
+    int CheckpointEvicted(Buffer* buffer, PrimarySentinel* sentinel, const SegmentFile& file, uint64_t minCsn);
 
     /**
-     * @brief Pops a task (table pointer) from the tasks queue.
-     * @return the address of the pop'd table, or nullptr if the queue was empty.
+     * @brief Pops a table from the tasks queue, or joins the scan of a shared table once the queue is empty.
+     * @param[out] isOwner Set to true if the table was popped from the queue.
+     * @return The task, or nullptr if there is nothing left to write.
      */
-    Table* GetTask();
+    TableTask* GetTask(bool& isOwner);
+
+    /**
+     * @brief Leaves a task whose scan is exhausted. The last worker to leave reports the table to the manager.
+     * @param task The task to leave.
+     */
+    void LeaveTask(TableTask* task);
+
+    /**
+     * @brief Claims the next key range of a table.
+     * @param task The table task.
+     * @param index The table's primary index.
+     * @param range The array to fill with the sentinels of the range, of MAX_ITERS_COUNT elements.
+     * @param threadId The thread id.
+     * @param err returned error code.
+     * @return The number of sentinels in the range, zero if the scan is exhausted.
+     */
+    uint32_t ClaimRange(TableTask* task, Index* index, PrimarySentinel** range, uint16_t threadId, ErrCodes& err);
 
     /**
      * @brief Initializes a checkpoint file
@@ -148,9 +256,10 @@ private:
      * @param tableId The table id that is checkpointed.
      * @param seg The table's segment number
      * @param exId The table's external table id
+     * @param compressed Specifies whether the file holds compressed blocks.
      * @return Boolean value denoting success or failure.
      */
-    bool BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId);
+    bool BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId, bool compressed = false);
 
     /**
      * @brief Updates the file's header flushes and closes it.
@@ -158,9 +267,10 @@ private:
      * @param tableId The table id that is checkpointed.
      * @param numOps The number of operation that were save in the file.
      * @param exId The table's external table id
+     * @param compressed Specifies whether the file holds compressed blocks.
      * @return Boolean value denoting success or failure.
      */
-    bool FinishFile(int& fd, uint32_t tableId, uint64_t numOps, uint64_t exId);
+    bool FinishFile(int& fd, uint32_t tableId, uint64_t numOps, uint64_t exId, bool compressed = false);
 
     bool ExecuteMicroGcTransaction(
         DeletePair* deletedList, GcManager* gcSession, Table* table, uint16_t& deletedCounter, uint16_t limit);
@@ -173,32 +283,57 @@ private:
     ErrCodes WriteTableMetadataFile(Table* table);
 
     /**
-     * @brief Writes table data to the data file.
-     * @param table The table's pointer.
+     * @brief Writes the key ranges of a table claimed by the current worker to data files.
+     * @param task The table task.
+     * @param isOwner Specifies whether the current worker owns the task, and writes the first segment.
      * @param buffer The buffer to fill.
+     * @param range Array to collect the sentinels of a claimed range.
      * @param deletedList Array to collect the sentinels deleted rows to be cleaned.
      * @param gcSession GC manager object.
      * @param threadId The thread id.
-     * @param maxSegId The maximum segment ID of the table.
+     * @param compressBuf The compression buffer of the worker.
      * @param numOps The number of rows written.
      * @return Returns the error code of type ErrCodes.
      */
-    ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, DeletePair* deletedList, GcManager* gcSession,
-        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps);
+    ErrCodes WriteTableDataFile(TableTask* task, bool isOwner, Buffer* buffer, PrimarySentinel** range,
+        DeletePair* deletedList, GcManager* gcSession, uint16_t threadId, char* compressBuf, uint64_t& numOps);
 
-    /* @brief Checks whether we should continue to iterate on a table.
-     * Recreates the iterator when the number of iterations exceeds a threshold.
-     * @param index the index to iterate on.
-     * @param it iterators's pointer.
-     * @param numIterations The current number of iterations.
-     * @param threadId The thread id.
-     * @param gcSession GC manager object.
-     * @param err returned error code.
+    /**
+     * @brief Flushes the buffer to the current data file of a table, if any, and closes it.
+     * @param table The table's pointer.
+     * @param buffer The buffer to flush.
+     * @param file The data file.
+     * @return Boolean value denoting success or failure.
      */
-    bool KeepIterating(Index* index, IndexIterator*& it, uint32_t& numIterations, uint16_t threadId,
-        GcManager* gcSession, ErrCodes& err);
+    bool CloseSegment(Table* table, Buffer* buffer, SegmentFile& file);
 
-    bool FlushBuffer(int fd, Buffer* buffer);
+    /**
+     * @brief Closes the current data file of a table, if any, and begins the next segment.
+     * @param table The table's pointer.
+     * @param buffer The buffer to flush.
+     * @param file The data file.
+     * @param segId The segment id of the next file.
+     * @return Boolean value denoting success or failure.
+     */
+    bool NextSegment(Table* table, Buffer* buffer, SegmentFile& file, uint32_t segId);
+
+    /**
+     * @brief Writes the keys deleted from a table since the previous checkpoint to the deleted keys file.
+     * @param table The table's pointer.
+     * @param buffer The buffer to fill.
+     * @param deletedKeys The deleted keys list.
+     * @return Returns the error code of type ErrCodes.
+     */
+    ErrCodes WriteTableDelFile(Table* table, Buffer* buffer, const CheckpointDeleteLog::DeletedKey* deletedKeys);
+
+    /**
+     * @brief Writes the buffer to a file and resets it.
+     * @param fd The file descriptor to write to.
+     * @param buffer The buffer to flush.
+     * @param compressBuf The compression buffer, or nullptr to write the buffer as is.
+     * @return Boolean value denoting success or failure.
+     */
+    bool FlushBuffer(int fd, Buffer* buffer, char* compressBuf = nullptr);
 
     // Worker thread contexts
     std::vector<ThreadContext*> m_workerContexts;
@@ -206,9 +341,12 @@ private:
     // Workers threads
     std::vector<std::thread> m_workers;
 
-    // Guards tasksList pops
+    // Guards tasksList pops and the shared tasks
     std::mutex m_tasksLock;
 
+    // Tasks whose scan other workers may join
+    std::list<TableTask*> m_sharedTasks;
+
     // Checkpoint manager callbacks
     CheckpointManagerCallbacks& m_cpManager;
 
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * cold_row_evictor.cpp
+ *    Background task evicting rows that are not accessed to the table cold row stores.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/system/common/cold_row_evictor.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <list>
+#include <chrono>
+#include <system_error>
+#include <pthread.h>
+#include "cold_row_evictor.h"
+#include "cold_row_store.h"
+#include "mot_engine.h"
+#include "row.h"
+#include "db_session_statistics.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(ColdRowEvictor, System);
+
+bool ColdRowEvictor::Start()
+{
+    m_stop = false;
+    m_evictCsn = 0;
+    try {
+        m_thread = std::thread(&ColdRowEvictor::EvictorFunc, this);
+    } catch (const std::system_error& e) {
+        MOT_REPORT_ERROR(
+            MOT_ERROR_SYSTEM_FAILURE, "Cold Row Eviction", "Failed to start eviction thread: %s", e.what());
+        return false;
+    }
+    return true;
+}
+
+void ColdRowEvictor::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void ColdRowEvictor::EvictorFunc()
+{
+    MOT_DECLARE_NON_KERNEL_THREAD();
+    (void)pthread_setname_np(pthread_self(), "ColdRowEvictor");
+    MOT_LOG_INFO("ColdRowEvictor - Starting");
+
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        MOT_LOG_ERROR("ColdRowEvictor::EvictorFunc: Failed to initialize Session Context");
+        MOTEngine::GetInstance()->OnCurrentThreadEnding();
+        return;
+    }
+    // the eviction thread has no kernel snapshot, so its GC transactions use the global epoch
+    GcManager* gcSession = sessionContext->GetTxnManager()->GetGcSession();
+    gcSession->SetGcType(GcManager::GC_TYPE::GC_CHECKPOINT);
+    uint16_t threadId = MOTCurrThreadId;
+
+    std::chrono::seconds period(GetGlobalConfiguration().m_coldRowEvictionPeriodSeconds);
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (!m_stop) {
+        (void)m_cv.wait_for(lock, period, [this] { return m_stop; });
+        if (m_stop) {
+            break;
+        }
+        lock.unlock();
+        if (!MOTEngine::GetInstance()->IsRecovering()) {
+            EvictPass(gcSession, threadId);
+        }
+        lock.lock();
+    }
+    lock.unlock();
+
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    MOTEngine::GetInstance()->OnCurrentThreadEnding();
+    MOT_LOG_INFO("ColdRowEvictor - Exiting");
+}
+
+void ColdRowEvictor::EvictPass(GcManager* gcSession, uint16_t threadId)
+{
+    // rows changed since this point are not evicted on the next pass
+    uint64_t passCsn = GetCSNManager().GetGcEpoch();
+    std::list<InternalTableId> tableIds;
+    GetTableManager()->AddTableIdsToList(tableIds);
+    for (InternalTableId tableId : tableIds) {
+        if (m_stop) {
+            break;
+        }
+        EvictTable(tableId, gcSession, threadId);
+    }
+    m_evictCsn = passCsn;
+}
+
+void ColdRowEvictor::EvictTable(uint32_t tableId, GcManager* gcSession, uint16_t threadId)
+{
+    uint64_t evicted = 0;
+    bool isFirstBatch = true;
+    MaxKey nextKey;
+    while (!m_stop) {
+        // the table is looked up again for every batch, so it may be dropped or altered in between
+        Table* table = GetTableManager()->GetTableSafe(tableId);
+        if (table == nullptr) {
+            return;
+        }
+        Index* index = table->GetPrimaryIndex();
+        if (index == nullptr || table->IsEvictionBlocked()) {
+            table->Unlock();
+            return;
+        }
+        if (isFirstBatch && table->GetColdStore() != nullptr) {
+            table->GetColdStore()->Compact();
+        }
+        if (!gcSession->ReserveGCMemory(EVICT_BATCH_SIZE) || gcSession->GcStartTxn() != RC_OK) {
+            MOT_LOG_ERROR("ColdRowEvictor::EvictTable: Failed to start GC transaction");
+            table->Unlock();
+            return;
+        }
+
+        IndexIterator* it = nullptr;
+        if (isFirstBatch) {
+            it = index->Begin(threadId);
+        } else {
+            it = index->Seek(&nextKey, threadId);
+        }
+        if (it == nullptr) {
+            MOT_LOG_ERROR("ColdRowEvictor::EvictTable: Failed to get iterator for table %u", tableId);
+            gcSession->GcEndTxn();
+            table->Unlock();
+            return;
+        }
+
+        uint64_t csn = GetCSNManager().GetGcEpoch();
+        uint32_t numIterations = 0;
+        while (it->IsValid() && numIterations < EVICT_BATCH_SIZE) {
+            PrimarySentinel* ps = static_cast<PrimarySentinel*>(it->GetPrimarySentinel());
+            Row* row = TryEvict(table, ps, threadId);
+            if (row != nullptr) {
+                // readers that started before the eviction may still use the resident row
+                gcSession->GcRecordObject(GC_QUEUE_TYPE::GENERIC_QUEUE,
+                    index->GetIndexId(),
+                    row,
+                    table,
+                    EvictedRowDtor,
+                    table->GetRowSizeFromPool(),
+                    csn);
+                evicted++;
+            }
+            numIterations++;
+            it->Next();
+        }
+
+        bool done = !it->IsValid();
+        if (!done) {
+            nextKey.CpKey(*(const Key*)(it->GetKey()));
+        }
+        delete it;
+        gcSession->GcEndTxn();
+        table->Unlock();
+        if (done) {
+            break;
+        }
+        isFirstBatch = false;
+    }
+
+    if (evicted > 0) {
+        MOT_LOG_DEBUG("ColdRowEvictor::EvictTable: Evicted %" PRIu64 " rows of table %u", evicted, tableId);
+    }
+}
+
+Row* ColdRowEvictor::TryEvict(Table* table, PrimarySentinel* ps, uint16_t threadId)
+{
+    // second chance for rows read since the previous pass
+    if (ps->ClearAccessed() || ps->IsEvicted()) {
+        return nullptr;
+    }
+    if (!ps->TryLock(threadId)) {
+        return nullptr;
+    }
+
+    // only the single committed version of an idle row is evicted, so neither the checkpoint nor the GC need it
+    Row* row = ps->GetResidentData();
+    bool isEvictable = ps->IsCommited() && row != nullptr && !row->IsRowDeleted() &&
+                       row->GetNextVersion() == nullptr && row->GetCommitSequenceNumber() < m_evictCsn &&
+                       ps->GetStable() == nullptr && !ps->GetStablePreAllocStatus() &&
+                       ps->GetGcInfo().GetCounter() == 0 && !table->IsEvictionBlocked();
+    ColdRowStore* store = isEvictable ? table->CreateColdStore() : nullptr;
+    uint64_t offset = 0;
+    if (store == nullptr || !store->Store(ps, row, offset)) {
+        ps->Unlock();
+        return nullptr;
+    }
+    ps->SetEvictedOffset(offset);
+    ps->Unlock();
+    DbSessionStatisticsProvider::GetInstance().AddColdRowEvict();
+    return row;
+}
+
+uint32_t ColdRowEvictor::EvictedRowDtor(void* gcElement, void* oper, void* aux)
+{
+    GC_OPERATION_TYPE gcOperType = (*(GC_OPERATION_TYPE*)oper);
+    LimboElement* elem = reinterpret_cast<LimboElement*>(gcElement);
+    Table* table = reinterpret_cast<Table*>(elem->m_objectPool);
+    uint32_t size = table->GetRowSizeFromPool();
+    // the row pool is released with the index
+    if (unlikely(gcOperType == GC_OPERATION_TYPE::GC_OPER_DROP_INDEX)) {
+        return size;
+    }
+    Row* row = reinterpret_cast<Row*>(elem->m_objectPtr);
+    row->GetTable()->DestroyRow(row);
+    return size;
+}
+}  // namespace MOT
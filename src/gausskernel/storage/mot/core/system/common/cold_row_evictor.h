@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * cold_row_evictor.h
+ *    Background task evicting rows that are not accessed to the table cold row stores.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/system/common/cold_row_evictor.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef COLD_ROW_EVICTOR_H
+#define COLD_ROW_EVICTOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "global.h"
+#include "utilities.h"
+
+namespace MOT {
+class Row;
+class Table;
+class PrimarySentinel;
+class GcManager;
+
+/**
+ * @class ColdRowEvictor
+ * @brief Periodically scans the primary index of every table and evicts the rows that were neither read nor
+ * changed since the previous pass (CLOCK second chance): a read marks the sentinel as accessed, and the pass
+ * clears the mark, so a row is evicted only on the next pass, and only if its commit sequence number precedes
+ * the start of the previous pass.
+ */
+class ColdRowEvictor {
+public:
+    ColdRowEvictor() : m_stop(false), m_evictCsn(0)
+    {}
+
+    ~ColdRowEvictor()
+    {}
+
+    /**
+     * @brief Starts the eviction thread.
+     * @return True on success.
+     */
+    bool Start();
+
+    /** @brief Stops the eviction thread and waits for it to end. */
+    void Stop();
+
+    ColdRowEvictor(const ColdRowEvictor& orig) = delete;
+
+    ColdRowEvictor& operator=(const ColdRowEvictor&) = delete;
+
+private:
+    /** @brief The eviction thread function. */
+    void EvictorFunc();
+
+    /**
+     * @brief Runs an eviction pass over all tables.
+     * @param gcSession The GC session of the eviction thread.
+     * @param threadId The eviction thread identifier.
+     */
+    void EvictPass(GcManager* gcSession, uint16_t threadId);
+
+    /**
+     * @brief Runs an eviction pass over a table, in batches that hold the table lock.
+     * @param tableId The internal table identifier.
+     * @param gcSession The GC session of the eviction thread.
+     * @param threadId The eviction thread identifier.
+     */
+    void EvictTable(uint32_t tableId, GcManager* gcSession, uint16_t threadId);
+
+    /**
+     * @brief Evicts a row if it was not accessed since the previous pass.
+     * @param table The table of the row.
+     * @param ps The primary sentinel of the row.
+     * @param threadId The eviction thread identifier.
+     * @return The evicted row, to be retired by the caller, or null if the row was not evicted.
+     */
+    Row* TryEvict(Table* table, PrimarySentinel* ps, uint16_t threadId);
+
+    /**
+     * @brief GC callback releasing an evicted row.
+     * @param gcElement The GC element of the row.
+     * @param oper The GC operation.
+     * @param aux Unused.
+     * @return The size of the released row.
+     */
+    static uint32_t EvictedRowDtor(void* gcElement, void* oper, void* aux);
+
+    /** @var Number of sentinels processed while holding the table lock. */
+    static constexpr uint32_t EVICT_BATCH_SIZE = 1000;
+
+    /** @var The eviction thread. */
+    std::thread m_thread;
+
+    /** @var Guards the stop flag. */
+    std::mutex m_lock;
+
+    /** @var Wakes up the eviction thread when stopping. */
+    std::condition_variable m_cv;
+
+    /** @var Specifies whether the eviction thread should stop. */
+    std::atomic<bool> m_stop;
+
+    /** @var Rows committed at or after this CSN (the start of the previous pass) are not evicted. */
+    uint64_t m_evictCsn;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* COLD_ROW_EVICTOR_H */
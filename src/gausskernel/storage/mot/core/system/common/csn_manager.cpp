@@ -39,9 +39,13 @@ void CSNManager::SetCSN(uint64_t value)
         MOT_LOG_ERROR("Set CSN is supported only during recovery");
         MOT_ASSERT(false);
     } else {
-        // CAS is not needed as it used only by a single thread always.
-        if (m_csn.load() <= value) {
-            m_csn = value + 1;  // GetNextCSN is fetch and then increment.
+        // Partitioned recovery commits on several processors, so the CSN only moves forward.
+        uint64_t current = m_csn.load();
+        while (current <= value) {
+            // GetNextCSN is fetch and then increment.
+            if (m_csn.compare_exchange_weak(current, value + 1)) {
+                break;
+            }
         }
     }
 }
@@ -47,6 +47,22 @@ bool TableManager::AddTable(Table* table)
     return true;
 }
 
+void TableManager::PrintTableContention()
+{
+    m_rwLock.RdLock();
+    for (InternalTableMap::iterator it = m_tablesById.begin(); it != m_tablesById.end(); (void)++it) {
+        Table* table = it->second;
+        uint32_t abortRate = table->GetValidationAbortRate();
+        if (abortRate > 0 || table->IsContended()) {
+            MOT_LOG_INFO("Table %s: validation abort rate %u%%%s",
+                table->GetLongTableName().c_str(),
+                abortRate,
+                table->IsContended() ? " (contended)" : "");
+        }
+    }
+    m_rwLock.RdUnlock();
+}
+
 void TableManager::ClearTablesThreadMemoryCache()
 {
     m_rwLock.RdLock();
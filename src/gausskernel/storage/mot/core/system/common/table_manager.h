@@ -93,6 +93,27 @@ public:
         return table;
     }
 
+    /**
+     * @brief Retrieves a read-locked table from the engine. Caller is responsible for unlocking the table when done
+     * using it, by calling @ref Table::Unlock.
+     * @param tableId The internal (engine-given) identifier of the table to retrieve.
+     * @return The table object or null pointer if not found.
+     */
+    inline Table* GetTableSafe(InternalTableId tableId)
+    {
+        Table* table = nullptr;
+        m_rwLock.RdLock();
+        InternalTableMap::iterator it = m_tablesById.find(tableId);
+        if (it != m_tablesById.end()) {
+            table = it->second;
+            if (table != nullptr) {
+                table->RdLock();
+            }
+        }
+        m_rwLock.RdUnlock();
+        return table;
+    }
+
     /**
      * @brief Retrieves a locked table from the engine. Caller is responsible for unlocking the table when done using
      * it, by calling @ref Table::Unlock.
@@ -200,9 +221,27 @@ public:
         m_rwLock.RdUnlock();
     }
 
+    /**
+     * @brief Adds the internal identifiers of all tables into a list.
+     * @param[out] tableIds Receives the table identifiers.
+     */
+    inline void AddTableIdsToList(std::list<InternalTableId>& tableIds)
+    {
+        m_rwLock.RdLock();
+        for (InternalTableMap::iterator it = m_tablesById.begin(); it != m_tablesById.end(); (void)++it) {
+            tableIds.push_back(it->first);
+        }
+        m_rwLock.RdUnlock();
+    }
+
     /** @brief Clears all object-pool table caches for the current thread. */
     void ClearTablesThreadMemoryCache();
 
+    /**
+     * @brief Prints the commit validation abort rate of the tables that had aborts recently.
+     */
+    void PrintTableContention();
+
     /** @brief Clears all tables and all releases all associated resources. */
     void ClearAllTables();
 
@@ -66,6 +66,11 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_DELTA_CHECKPOINT;
+constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_FULL_IMAGE_INTERVAL;
+constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_FULL_IMAGE_INTERVAL;
+constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_FULL_IMAGE_INTERVAL;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_CHECKPOINT_COMPRESSION;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
@@ -78,6 +83,12 @@ constexpr uint32_t MOTConfiguration::MAX_PARALLEL_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::DEFAULT_PARALLEL_RECOVERY_QUEUE_SIZE;
 constexpr uint32_t MOTConfiguration::MIN_PARALLEL_RECOVERY_QUEUE_SIZE;
 constexpr uint32_t MOTConfiguration::MAX_PARALLEL_RECOVERY_QUEUE_SIZE;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_PARALLEL_RECOVERY_PARTITIONING;
+// concurrency control configuration members
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_ADAPTIVE_VALIDATION;
+constexpr uint32_t MOTConfiguration::DEFAULT_ADAPTIVE_VALIDATION_ABORT_RATE;
+constexpr uint32_t MOTConfiguration::MIN_ADAPTIVE_VALIDATION_ABORT_RATE;
+constexpr uint32_t MOTConfiguration::MAX_ADAPTIVE_VALIDATION_ABORT_RATE;
 // machine configuration members
 constexpr uint16_t MOTConfiguration::DEFAULT_NUMA_NODES;
 constexpr uint16_t MOTConfiguration::DEFAULT_CORES_PER_CPU;
@@ -171,6 +182,15 @@ constexpr const char* MOTConfiguration::DEFAULT_GC_HIGH_RECLAIM_THRESHOLD;
 constexpr uint64_t MOTConfiguration::DEFAULT_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
 constexpr uint64_t MOTConfiguration::MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
 constexpr uint64_t MOTConfiguration::MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_GC_RECLAIMER;
+constexpr const char* MOTConfiguration::DEFAULT_GC_RECLAIMER_PERIOD;
+constexpr uint64_t MOTConfiguration::DEFAULT_GC_RECLAIMER_PERIOD_MILLIS;
+constexpr uint64_t MOTConfiguration::MIN_GC_RECLAIMER_PERIOD_MILLIS;
+constexpr uint64_t MOTConfiguration::MAX_GC_RECLAIMER_PERIOD_MILLIS;
+constexpr const char* MOTConfiguration::DEFAULT_GC_STALL_REPORT_PERIOD;
+constexpr uint64_t MOTConfiguration::DEFAULT_GC_STALL_REPORT_PERIOD_SECONDS;
+constexpr uint64_t MOTConfiguration::MIN_GC_STALL_REPORT_PERIOD_SECONDS;
+constexpr uint64_t MOTConfiguration::MAX_GC_STALL_REPORT_PERIOD_SECONDS;
 // JIT configuration members
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_MOT_CODEGEN;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_MOT_QUERY_CODEGEN;
@@ -183,9 +203,16 @@ constexpr uint32_t MOTConfiguration::DEFAULT_MOT_CODEGEN_LIMIT;
 constexpr uint32_t MOTConfiguration::MIN_MOT_CODEGEN_LIMIT;
 constexpr uint32_t MOTConfiguration::MAX_MOT_CODEGEN_LIMIT;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_MOT_CODEGEN_PROFILE;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_MOT_CODEGEN_WARMUP;
 // storage configuration
 constexpr bool MOTConfiguration::DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN;
 constexpr IndexTreeFlavor MOTConfiguration::DEFAULT_INDEX_TREE_FLAVOR;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_COLD_ROW_EVICTION;
+constexpr const char* MOTConfiguration::DEFAULT_COLD_ROW_EVICTION_PERIOD;
+constexpr uint64_t MOTConfiguration::DEFAULT_COLD_ROW_EVICTION_PERIOD_SECONDS;
+constexpr uint64_t MOTConfiguration::MIN_COLD_ROW_EVICTION_PERIOD_SECONDS;
+constexpr uint64_t MOTConfiguration::MAX_COLD_ROW_EVICTION_PERIOD_SECONDS;
+constexpr const char* MOTConfiguration::DEFAULT_COLD_ROW_STORE_DIR;
 // general configuration members
 constexpr const char* MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD;
 constexpr uint64_t MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD_SECONDS;
@@ -471,10 +498,16 @@ MOTConfiguration::MOTConfiguration()
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_enableDeltaCheckpoint(DEFAULT_ENABLE_DELTA_CHECKPOINT),
+      m_checkpointFullImageInterval(DEFAULT_CHECKPOINT_FULL_IMAGE_INTERVAL),
+      m_enableCheckpointCompression(DEFAULT_ENABLE_CHECKPOINT_COMPRESSION),
       m_recoveryMode(DEFAULT_RECOVERY_MODE),
       m_parallelRecoveryWorkers(DEFAULT_PARALLEL_RECOVERY_WORKERS),
       m_parallelRecoveryQueueSize(DEFAULT_PARALLEL_RECOVERY_QUEUE_SIZE),
+      m_enableParallelRecoveryPartitioning(DEFAULT_ENABLE_PARALLEL_RECOVERY_PARTITIONING),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
+      m_enableAdaptiveValidation(DEFAULT_ENABLE_ADAPTIVE_VALIDATION),
+      m_adaptiveValidationAbortRate(DEFAULT_ADAPTIVE_VALIDATION_ABORT_RATE),
       m_abortBufferEnable(true),
       m_preAbort(true),
       m_validationLock(TxnValidation::TXN_VALIDATION_NO_WAIT),
@@ -520,6 +553,9 @@ MOTConfiguration::MOTConfiguration()
       m_gcReclaimThresholdBytes(DEFAULT_GC_RECLAIM_THRESHOLD_BYTES),
       m_gcReclaimBatchSize(DEFAULT_GC_RECLAIM_BATCH_SIZE),
       m_gcHighReclaimThresholdBytes(DEFAULT_GC_HIGH_RECLAIM_THRESHOLD_BYTES),
+      m_enableGcReclaimer(DEFAULT_ENABLE_GC_RECLAIMER),
+      m_gcReclaimerPeriodMillis(DEFAULT_GC_RECLAIMER_PERIOD_MILLIS),
+      m_gcStallReportPeriodSeconds(DEFAULT_GC_STALL_REPORT_PERIOD_SECONDS),
       m_enableCodegen(DEFAULT_ENABLE_MOT_CODEGEN),
       m_enableQueryCodegen(DEFAULT_ENABLE_MOT_QUERY_CODEGEN),
       m_enableSPCodegen(DEFAULT_ENABLE_MOT_SP_CODEGEN),
@@ -529,8 +565,12 @@ MOTConfiguration::MOTConfiguration()
       m_enableCodegenPrint(DEFAULT_ENABLE_MOT_CODEGEN_PRINT),
       m_codegenLimit(DEFAULT_MOT_CODEGEN_LIMIT),
       m_enableCodegenProfile(DEFAULT_ENABLE_MOT_CODEGEN_PROFILE),
+      m_enableCodegenWarmup(DEFAULT_ENABLE_MOT_CODEGEN_WARMUP),
       m_allowIndexOnNullableColumn(DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN),
       m_indexTreeFlavor(DEFAULT_INDEX_TREE_FLAVOR),
+      m_enableColdRowEviction(DEFAULT_ENABLE_COLD_ROW_EVICTION),
+      m_coldRowEvictionPeriodSeconds(DEFAULT_COLD_ROW_EVICTION_PERIOD_SECONDS),
+      m_coldRowStoreDir(DEFAULT_COLD_ROW_STORE_DIR),
       m_configMonitorPeriodSeconds(DEFAULT_CFG_MONITOR_PERIOD_SECONDS),
       m_runInternalConsistencyValidation(DEFAULT_RUN_INTERNAL_CONSISTENCY_VALIDATION),
       m_runInternalMvccConsistencyValidation(DEFAULT_RUN_INTERNAL_CONSISTENCY_VALIDATION),
@@ -584,10 +624,17 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseBool(name, "enable_delta_checkpoint", value, &m_enableDeltaCheckpoint)) {
+    } else if (ParseUint32(name, "checkpoint_full_image_interval", value, &m_checkpointFullImageInterval)) {
+    } else if (ParseBool(name, "enable_checkpoint_compression", value, &m_enableCheckpointCompression)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
     } else if (ParseRecoveryMode(name, "recovery_mode", value, &m_recoveryMode)) {
     } else if (ParseUint32(name, "parallel_recovery_workers", value, &m_parallelRecoveryWorkers)) {
     } else if (ParseUint32(name, "parallel_recovery_queue_size", value, &m_parallelRecoveryQueueSize)) {
+    } else if (ParseBool(
+                   name, "enable_parallel_recovery_partitioning", value, &m_enableParallelRecoveryPartitioning)) {
+    } else if (ParseBool(name, "enable_adaptive_validation", value, &m_enableAdaptiveValidation)) {
+    } else if (ParseUint32(name, "adaptive_validation_abort_rate", value, &m_adaptiveValidationAbortRate)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
     } else if (ParseValidation(name, "validation_lock", value, &m_validationLock)) {
@@ -629,14 +676,21 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
                    value,
                    &m_sessionLargeBufferStoreMaxObjectSizeMB)) {
     } else if (ParseUint64(name, "session_max_huge_object_size_mb", value, &m_sessionMaxHugeObjectSizeMB)) {
+    } else if (ParseBool(name, "enable_gc_reclaimer", value, &m_enableGcReclaimer)) {
+    } else if (ParseUint64(name, "gc_reclaimer_period_millis", value, &m_gcReclaimerPeriodMillis)) {
+    } else if (ParseUint64(name, "gc_stall_report_period_seconds", value, &m_gcStallReportPeriodSeconds)) {
     } else if (ParseBool(name, "enable_mot_codegen", value, &m_enableCodegen)) {
     } else if (ParseBool(name, "enable_mot_query_codegen", value, &m_enableQueryCodegen)) {
     } else if (ParseBool(name, "enable_mot_sp_codegen", value, &m_enableSPCodegen)) {
     } else if (ParseBool(name, "enable_mot_codegen_print", value, &m_enableCodegenPrint)) {
     } else if (ParseUint32(name, "mot_codegen_limit", value, &m_codegenLimit)) {
     } else if (ParseBool(name, "enable_mot_codegen_profile", value, &m_enableCodegenProfile)) {
+    } else if (ParseBool(name, "enable_mot_codegen_warmup", value, &m_enableCodegenWarmup)) {
     } else if (ParseBool(name, "allow_index_on_nullable_column", value, &m_allowIndexOnNullableColumn)) {
     } else if (ParseIndexTreeFlavor(name, "index_tree_flavor", value, &m_indexTreeFlavor)) {
+    } else if (ParseBool(name, "enable_cold_row_eviction", value, &m_enableColdRowEviction)) {
+    } else if (ParseUint64(name, "cold_row_eviction_period_seconds", value, &m_coldRowEvictionPeriodSeconds)) {
+    } else if (ParseString(name, "cold_row_store_dir", value, &m_coldRowStoreDir)) {
     } else if (ParseUint64(name, "config_monitor_period_seconds", value, &m_configMonitorPeriodSeconds)) {
     } else if (ParseBool(name, "run_internal_consistency_validation", value, &m_runInternalConsistencyValidation)) {
     } else {
@@ -988,6 +1042,14 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_BOOL_CFG(m_enableDeltaCheckpoint, "enable_delta_checkpoint", DEFAULT_ENABLE_DELTA_CHECKPOINT);
+    UPDATE_INT_CFG(m_checkpointFullImageInterval,
+        "checkpoint_full_image_interval",
+        DEFAULT_CHECKPOINT_FULL_IMAGE_INTERVAL,
+        MIN_CHECKPOINT_FULL_IMAGE_INTERVAL,
+        MAX_CHECKPOINT_FULL_IMAGE_INTERVAL);
+    UPDATE_BOOL_CFG(
+        m_enableCheckpointCompression, "enable_checkpoint_compression", DEFAULT_ENABLE_CHECKPOINT_COMPRESSION);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
@@ -1024,6 +1086,18 @@ void MOTConfiguration::LoadConfig()
         m_parallelRecoveryQueueSize = m_parallelRecoveryWorkers;  // At least one transaction per processor
     }
 
+    UPDATE_BOOL_CFG(m_enableParallelRecoveryPartitioning,
+        "enable_parallel_recovery_partitioning",
+        DEFAULT_ENABLE_PARALLEL_RECOVERY_PARTITIONING);
+
+    // Concurrency control configuration
+    UPDATE_BOOL_CFG(m_enableAdaptiveValidation, "enable_adaptive_validation", DEFAULT_ENABLE_ADAPTIVE_VALIDATION);
+    UPDATE_INT_CFG(m_adaptiveValidationAbortRate,
+        "adaptive_validation_abort_rate",
+        DEFAULT_ADAPTIVE_VALIDATION_ABORT_RATE,
+        MIN_ADAPTIVE_VALIDATION_ABORT_RATE,
+        MAX_ADAPTIVE_VALIDATION_ABORT_RATE);
+
     // Tx configuration - not configurable yet
     if (m_loadExtraParams) {
         UPDATE_BOOL_CFG(m_abortBufferEnable, "tx_abort_buffers_enable", true);
@@ -1086,6 +1160,19 @@ void MOTConfiguration::LoadConfig()
         SCALE_BYTES,
         MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES,
         MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES);
+    UPDATE_BOOL_CFG(m_enableGcReclaimer, "enable_gc_reclaimer", DEFAULT_ENABLE_GC_RECLAIMER);
+    UPDATE_TIME_CFG(m_gcReclaimerPeriodMillis,
+        "gc_reclaimer_period",
+        DEFAULT_GC_RECLAIMER_PERIOD,
+        SCALE_MILLIS,
+        MIN_GC_RECLAIMER_PERIOD_MILLIS,
+        MAX_GC_RECLAIMER_PERIOD_MILLIS);
+    UPDATE_TIME_CFG(m_gcStallReportPeriodSeconds,
+        "gc_stall_report_period",
+        DEFAULT_GC_STALL_REPORT_PERIOD,
+        SCALE_SECONDS,
+        MIN_GC_STALL_REPORT_PERIOD_SECONDS,
+        MAX_GC_STALL_REPORT_PERIOD_SECONDS);
 
     // JIT configuration
     UPDATE_BOOL_CFG(m_enableCodegen, "enable_mot_codegen", DEFAULT_ENABLE_MOT_CODEGEN);
@@ -1102,6 +1189,7 @@ void MOTConfiguration::LoadConfig()
     UPDATE_INT_CFG(
         m_codegenLimit, "mot_codegen_limit", DEFAULT_MOT_CODEGEN_LIMIT, MIN_MOT_CODEGEN_LIMIT, MAX_MOT_CODEGEN_LIMIT);
     UPDATE_BOOL_CFG(m_enableCodegenProfile, "enable_mot_codegen_profile", DEFAULT_ENABLE_MOT_CODEGEN_PROFILE);
+    UPDATE_BOOL_CFG(m_enableCodegenWarmup, "enable_mot_codegen_warmup", DEFAULT_ENABLE_MOT_CODEGEN_WARMUP);
 
     // storage configuration
     if (m_loadExtraParams) {
@@ -1109,6 +1197,14 @@ void MOTConfiguration::LoadConfig()
             m_allowIndexOnNullableColumn, "allow_index_on_nullable_column", DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN);
         UPDATE_USER_CFG(m_indexTreeFlavor, "index_tree_flavor", DEFAULT_INDEX_TREE_FLAVOR);
     }
+    UPDATE_BOOL_CFG(m_enableColdRowEviction, "enable_cold_row_eviction", DEFAULT_ENABLE_COLD_ROW_EVICTION);
+    UPDATE_TIME_CFG(m_coldRowEvictionPeriodSeconds,
+        "cold_row_eviction_period",
+        DEFAULT_COLD_ROW_EVICTION_PERIOD,
+        SCALE_SECONDS,
+        MIN_COLD_ROW_EVICTION_PERIOD_SECONDS,
+        MAX_COLD_ROW_EVICTION_PERIOD_SECONDS);
+    UPDATE_STRING_CFG(m_coldRowStoreDir, "cold_row_store_dir", DEFAULT_COLD_ROW_STORE_DIR);
 
     // general configuration
     if (m_loadExtraParams) {
@@ -170,6 +170,15 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Enable delta checkpoints (persist only the rows changed since the previous checkpoint). */
+    bool m_enableDeltaCheckpoint;
+
+    /** @var Number of delta checkpoints between two full image checkpoints. */
+    uint32_t m_checkpointFullImageInterval;
+
+    /** @var Enable LZ4 compression of checkpoint data files. */
+    bool m_enableCheckpointCompression;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -183,9 +192,21 @@ public:
     /** @var Specifies parallel recovery's queue size. */
     uint32_t m_parallelRecoveryQueueSize;
 
+    /** @var Specifies whether parallel recovery replays single-table transactions on per-table processors. */
+    bool m_enableParallelRecoveryPartitioning;
+
     /** @var Specifies the number of workers used to recover from checkpoint. */
     uint32_t m_checkpointRecoveryWorkers;
 
+    /**********************************************************************/
+    // Concurrency control configuration
+    /**********************************************************************/
+    /** @var Enable waiting for row locks at commit on tables with a high validation abort rate. */
+    bool m_enableAdaptiveValidation;
+
+    /** @var Validation abort rate (percentage) above which a table is considered contended. */
+    uint32_t m_adaptiveValidationAbortRate;
+
     /**********************************************************************/
     // Transaction management variables (not configurable)
     /**********************************************************************/
@@ -335,6 +356,15 @@ public:
     /** @var The high threshold in bytes for reclamation to be triggered (per-thread). */
     uint64_t m_gcHighReclaimThresholdBytes;
 
+    /** @var Specifies whether background threads reclaim the limbo of idle sessions (one per NUMA node). */
+    bool m_enableGcReclaimer;
+
+    /** @var The background reclamation pass period in milliseconds. */
+    uint64_t m_gcReclaimerPeriodMillis;
+
+    /** @var The time in seconds a snapshot holds back reclamation before it is reported. */
+    uint64_t m_gcStallReportPeriodSeconds;
+
     /**********************************************************************/
     // JIT configuration
     /**********************************************************************/
@@ -366,6 +396,10 @@ public:
     /** @var Specified whether to enable jitted functions profiling. */
     bool m_enableCodegenProfile;
 
+    /** @var Specifies whether jitted queries are recorded on disk and compiled again ahead of first use after restart.
+     */
+    bool m_enableCodegenWarmup;
+
     /**********************************************************************/
     // Storage configuration
     /**********************************************************************/
@@ -375,6 +409,15 @@ public:
     /** @var Specifies the tree flavor for tree indexes. */
     IndexTreeFlavor m_indexTreeFlavor;
 
+    /** @var Specifies whether rows that are not read for a while are evicted to disk. */
+    bool m_enableColdRowEviction;
+
+    /** @var The cold row eviction pass period in seconds. */
+    uint64_t m_coldRowEvictionPeriodSeconds;
+
+    /** @var The directory of the cold row store files. */
+    std::string m_coldRowStoreDir;
+
     /**********************************************************************/
     // General configuration
     /**********************************************************************/
@@ -474,6 +517,15 @@ public:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default enable delta checkpoint. */
+    static constexpr bool DEFAULT_ENABLE_DELTA_CHECKPOINT = false;
+
+    /** @var Default number of delta checkpoints between two full image checkpoints. */
+    static constexpr uint32_t DEFAULT_CHECKPOINT_FULL_IMAGE_INTERVAL = 10;
+    static constexpr uint32_t MIN_CHECKPOINT_FULL_IMAGE_INTERVAL = 1;
+    static constexpr uint32_t MAX_CHECKPOINT_FULL_IMAGE_INTERVAL = 1000;
+    static constexpr bool DEFAULT_ENABLE_CHECKPOINT_COMPRESSION = false;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
@@ -493,9 +545,21 @@ public:
     static constexpr uint32_t MIN_PARALLEL_RECOVERY_QUEUE_SIZE = 16;
     static constexpr uint32_t MAX_PARALLEL_RECOVERY_QUEUE_SIZE = 4096;
 
+    /** @var Default enable partitioned parallel recovery. */
+    static constexpr bool DEFAULT_ENABLE_PARALLEL_RECOVERY_PARTITIONING = true;
+
     /** @var Default enable log recovery statistics. */
     static constexpr bool DEFAULT_ENABLE_LOG_RECOVERY_STATS = false;
 
+    /** ------------------ Default Concurrency Control Configuration ------------ */
+    /** @var Default enable adaptive validation. */
+    static constexpr bool DEFAULT_ENABLE_ADAPTIVE_VALIDATION = false;
+
+    /** @var Default validation abort rate (percentage) of a contended table. */
+    static constexpr uint32_t DEFAULT_ADAPTIVE_VALIDATION_ABORT_RATE = 30;
+    static constexpr uint32_t MIN_ADAPTIVE_VALIDATION_ABORT_RATE = 1;
+    static constexpr uint32_t MAX_ADAPTIVE_VALIDATION_ABORT_RATE = 100;
+
     /** ------------------ Default Machine Configuration ------------ */
     /** @var Default number of NUMA nodes of the machine. */
     static constexpr uint16_t DEFAULT_NUMA_NODES = 1;
@@ -672,6 +736,21 @@ public:
     static constexpr uint64_t MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES = 1 * MEGA_BYTE;      // 1 MB
     static constexpr uint64_t MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES = 64 * MEGA_BYTE;     // 64 MB
 
+    /** @var Default enable background reclamation of idle sessions. */
+    static constexpr bool DEFAULT_ENABLE_GC_RECLAIMER = false;
+
+    /** @var Default background reclamation pass period. */
+    static constexpr const char* DEFAULT_GC_RECLAIMER_PERIOD = "100 ms";
+    static constexpr uint64_t DEFAULT_GC_RECLAIMER_PERIOD_MILLIS = 100;
+    static constexpr uint64_t MIN_GC_RECLAIMER_PERIOD_MILLIS = 1;
+    static constexpr uint64_t MAX_GC_RECLAIMER_PERIOD_MILLIS = 60000;  // 1 minute
+
+    /** @var Default time a snapshot holds back reclamation before it is reported. */
+    static constexpr const char* DEFAULT_GC_STALL_REPORT_PERIOD = "5 minutes";
+    static constexpr uint64_t DEFAULT_GC_STALL_REPORT_PERIOD_SECONDS = 300;
+    static constexpr uint64_t MIN_GC_STALL_REPORT_PERIOD_SECONDS = 1;
+    static constexpr uint64_t MAX_GC_STALL_REPORT_PERIOD_SECONDS = 86400;  // 1 day
+
     /** ------------------ Default JIT Configuration ------------ */
     /** @var Default enable JIT compilation and execution. */
     static constexpr bool DEFAULT_ENABLE_MOT_CODEGEN = false;
@@ -706,6 +785,9 @@ public:
     /** @var Default enable profiling of jitted functions. */
     static constexpr bool DEFAULT_ENABLE_MOT_CODEGEN_PROFILE = true;
 
+    /** @var Default enable compiling jitted queries of previous runs after restart. */
+    static constexpr bool DEFAULT_ENABLE_MOT_CODEGEN_WARMUP = false;
+
     /** ------------------ Default Storage Configuration ------------ */
     /** @var The default allow index on null-able column. */
     static constexpr bool DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN = false;
@@ -713,6 +795,18 @@ public:
     /** @var The default tree flavor for tree indexes. */
     static constexpr IndexTreeFlavor DEFAULT_INDEX_TREE_FLAVOR = IndexTreeFlavor::INDEX_TREE_FLAVOR_MASSTREE;
 
+    /** @var Default enable cold row eviction. */
+    static constexpr bool DEFAULT_ENABLE_COLD_ROW_EVICTION = false;
+
+    /** @var Default cold row eviction pass period in seconds. */
+    static constexpr const char* DEFAULT_COLD_ROW_EVICTION_PERIOD = "1 hours";
+    static constexpr uint64_t DEFAULT_COLD_ROW_EVICTION_PERIOD_SECONDS = 3600;
+    static constexpr uint64_t MIN_COLD_ROW_EVICTION_PERIOD_SECONDS = 1;
+    static constexpr uint64_t MAX_COLD_ROW_EVICTION_PERIOD_SECONDS = 2592000;  // 30 days
+
+    /** @var Default cold row store directory (the data directory). */
+    static constexpr const char* DEFAULT_COLD_ROW_STORE_DIR = "";
+
     /** ------------------ Default General Configuration ------------ */
     /** @var Default configuration monitor period in seconds. */
     static constexpr const char* DEFAULT_CFG_MONITOR_PERIOD = "5 seconds";
@@ -45,6 +45,8 @@
 #include "debug_utils.h"
 #include "recovery_manager_factory.h"
 #include "csn_manager.h"
+#include "cold_row_evictor.h"
+#include "mm_gc_reclaimer.h"
 
 // For mtSessionThreadInfo thread local
 #include "kvthread.hh"
@@ -90,6 +92,8 @@ MOTEngine::MOTEngine()
       m_recoveryManager(nullptr),
       m_redoLogHandler(nullptr),
       m_checkpointManager(nullptr),
+      m_coldRowEvictor(nullptr),
+      m_gcReclaimer(nullptr),
       m_ddlSigFunc(nullptr)
 {}
 
@@ -104,6 +108,8 @@ MOTEngine::~MOTEngine()
     m_surrogateKeyManager = nullptr;
     m_redoLogHandler = nullptr;
     m_checkpointManager = nullptr;
+    m_coldRowEvictor = nullptr;
+    m_gcReclaimer = nullptr;
 }
 
 MOTEngine* MOTEngine::CreateInstance(
@@ -457,6 +463,40 @@ bool MOTEngine::StartBackgroundTasks()
             MOT_LOG_INFO("Startup: Statistics reporter started");
             m_startBgStack.push(START_STAT_PRINT_PHASE);
         }
+
+        if (GetGlobalConfiguration().m_enableColdRowEviction) {
+            m_coldRowEvictor = new (std::nothrow) ColdRowEvictor();
+            if (m_coldRowEvictor == nullptr) {
+                MOT_REPORT_ERROR(MOT_ERROR_OOM, "MOT Engine Startup", "Failed to allocate cold row evictor");
+                result = false;
+                break;
+            }
+            result = m_coldRowEvictor->Start();
+            if (!result) {
+                delete m_coldRowEvictor;
+                m_coldRowEvictor = nullptr;
+            }
+            CHECK_INIT_STATUS(result, "Failed to start the cold row eviction task");
+            MOT_LOG_INFO("Startup: Cold row eviction started");
+            m_startBgStack.push(START_COLD_ROW_EVICTION_PHASE);
+        }
+
+        if (GetGlobalConfiguration().m_enableGcReclaimer) {
+            m_gcReclaimer = new (std::nothrow) GcReclaimer();
+            if (m_gcReclaimer == nullptr) {
+                MOT_REPORT_ERROR(MOT_ERROR_OOM, "MOT Engine Startup", "Failed to allocate GC reclaimer");
+                result = false;
+                break;
+            }
+            result = m_gcReclaimer->Start();
+            if (!result) {
+                delete m_gcReclaimer;
+                m_gcReclaimer = nullptr;
+            }
+            CHECK_INIT_STATUS(result, "Failed to start the GC reclamation task");
+            MOT_LOG_INFO("Startup: GC reclamation started");
+            m_startBgStack.push(START_GC_RECLAIMER_PHASE);
+        }
     } while (0);
 
     if (result) {
@@ -569,6 +609,22 @@ void MOTEngine::StopBackgroundTasks()
 
     while (!m_startBgStack.empty()) {
         switch (m_startBgStack.top()) {
+            case START_GC_RECLAIMER_PHASE:
+                if (m_gcReclaimer != nullptr) {
+                    m_gcReclaimer->Stop();
+                    delete m_gcReclaimer;
+                    m_gcReclaimer = nullptr;
+                }
+                break;
+
+            case START_COLD_ROW_EVICTION_PHASE:
+                if (m_coldRowEvictor != nullptr) {
+                    m_coldRowEvictor->Stop();
+                    delete m_coldRowEvictor;
+                    m_coldRowEvictor = nullptr;
+                }
+                break;
+
             case START_STAT_PRINT_PHASE:
                 if (GetGlobalConfiguration().m_enableStats) {
                     StatisticsManager::GetInstance().Stop();
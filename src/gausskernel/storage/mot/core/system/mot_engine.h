@@ -48,6 +48,8 @@
 namespace MOT {
 class ConfigLoader;
 class RedoLogHandler;
+class ColdRowEvictor;
+class GcReclaimer;
 
 /** @typedef CpSigFunc Callback for notifying envelope that engine finished checkpoint. */
 typedef void (*CpSigFunc)(void);
@@ -604,6 +606,12 @@ private:
     /** @var The checkpoint manager. */
     CheckpointManager* m_checkpointManager;
 
+    /** @var The cold row eviction task. */
+    ColdRowEvictor* m_coldRowEvictor;
+
+    /** @var The background GC reclamation task. */
+    GcReclaimer* m_gcReclaimer;
+
     /** @var DDL event */
     DDLSigFunc m_ddlSigFunc;
 
@@ -644,7 +652,12 @@ private:
     };
     stack<InitAppPhase> m_initAppStack;
 
-    enum StartBgTaskPhase { START_STAT_PRINT_PHASE, START_BG_TASK_DONE };
+    enum StartBgTaskPhase {
+        START_STAT_PRINT_PHASE,
+        START_COLD_ROW_EVICTION_PHASE,
+        START_GC_RECLAIMER_PHASE,
+        START_BG_TASK_DONE
+    };
     stack<StartBgTaskPhase> m_startBgStack;
 
     /**
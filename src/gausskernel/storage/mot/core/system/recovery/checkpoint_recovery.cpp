@@ -25,6 +25,8 @@
 #include <thread>
 #include "mot_engine.h"
 #include "checkpoint_recovery.h"
+#include "cold_row_store.h"
+#include "db_session_statistics.h"
 #include "irecovery_manager.h"
 #include "redo_log_transaction_iterator.h"
 
@@ -92,7 +94,15 @@ bool CheckpointRecovery::Recover()
 
     m_maxTransactionId = CheckpointControlFile::GetCtrlFile()->GetMaxTransactionId();
 
-    int taskFillStat = FillTasksFromMapFile();
+    int taskFillStat = 0;
+    std::string chainFile;
+    CheckpointUtils::MakeChainFilename(chainFile, m_workingDir, m_checkpointId);
+    if (m_checkpointId != CheckpointControlFile::INVALID_ID && CheckpointUtils::IsFileExists(chainFile)) {
+        taskFillStat = FillTasksFromChainFile();
+    } else {
+        taskFillStat = FillTasksFromMapFile();
+    }
+
     if (taskFillStat < 0) {
         MOT_LOG_ERROR("CheckpointRecovery:: failed to read map file");
         return false;
@@ -136,6 +146,18 @@ bool CheckpointRecovery::Recover()
      */
     engine->GetCheckpointManager()->SetId(m_checkpointId);
 
+    if (m_hasDeltaChain) {
+        // the next checkpoint can keep extending the chain, as long as the tables were not changed since
+        for (auto it = m_deltaChain.begin(); it != m_deltaChain.end(); (void)++it) {
+            Table* table = GetTableManager()->GetTable(it->first);
+            if (table != nullptr) {
+                it->second.m_exId = table->GetTableExId();
+                it->second.m_metadataVer = table->GetMetadataVer();
+            }
+        }
+        engine->GetCheckpointManager()->SetDeltaChain(m_deltaChain, m_deltaMinCsn, m_numDeltas);
+    }
+
     MOT_LOG_INFO("Checkpoint Recovery: Finished recovering %lu tables from checkpoint [%lu:%lu:%lu]",
         m_tableIds.size(),
         m_checkpointId,
@@ -161,6 +183,34 @@ bool CheckpointRecovery::PerformRecovery()
         }
     }
 
+    RunRecoveryWorkers();
+
+    // the newest link of each delta chain was recovered, now merge the older links one step at a time
+    for (uint32_t step = 1; m_hasDeltaChain && !m_errorSet; step++) {
+        if (!LoadDeletedKeys(step - 1)) {
+            MOT_LOG_ERROR("CheckpointRecovery: Failed to load deleted keys of delta chain step %u", step - 1);
+            return false;
+        }
+
+        if (!FillTasksFromDeltaChain(step)) {
+            MOT_LOG_ERROR("CheckpointRecovery: Failed to fill tasks of delta chain step %u", step);
+            return false;
+        }
+
+        if (m_tasksList.empty()) {
+            break;
+        }
+
+        MOT_LOG_INFO("CheckpointRecovery: Merging delta chain step %u (%lu tasks)", step, m_tasksList.size());
+        RunRecoveryWorkers();
+    }
+
+    m_deletedKeys.clear();
+    return true;
+}
+
+void CheckpointRecovery::RunRecoveryWorkers()
+{
     std::vector<std::thread> threadPool;
     for (uint32_t i = 0; i < m_numWorkers; ++i) {
         threadPool.push_back(std::thread(CheckpointRecoveryWorker, i, this));
@@ -177,8 +227,6 @@ bool CheckpointRecovery::PerformRecovery()
             worker.join();
         }
     }
-
-    return true;
 }
 
 int CheckpointRecovery::FillTasksFromMapFile()
@@ -221,7 +269,7 @@ int CheckpointRecovery::FillTasksFromMapFile()
         }
         (void)m_tableIds.insert(entry.m_tableId);
         for (uint32_t j = 0; j <= entry.m_maxSegId; j++) {
-            Task* recoveryTask = new (std::nothrow) Task(entry.m_tableId, j);
+            Task* recoveryTask = new (std::nothrow) Task(entry.m_tableId, j, m_checkpointId);
             if (recoveryTask == nullptr) {
                 (void)CheckpointUtils::CloseFile(fd);
                 MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromMapFile: Failed to allocate task object");
@@ -240,6 +288,173 @@ int CheckpointRecovery::FillTasksFromMapFile()
     return 1;
 }
 
+int CheckpointRecovery::FillTasksFromChainFile()
+{
+    std::string chainFile;
+    CheckpointUtils::MakeChainFilename(chainFile, m_workingDir, m_checkpointId);
+    int fd = -1;
+    if (!CheckpointUtils::OpenFileRead(chainFile, fd)) {
+        MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromChainFile: Failed to open chain file '%s'", chainFile.c_str());
+        return -1;
+    }
+
+    CheckpointUtils::ChainFileHeader chainFileHeader;
+    if (CheckpointUtils::ReadFile(fd, (char*)&chainFileHeader, sizeof(CheckpointUtils::ChainFileHeader)) !=
+            sizeof(CheckpointUtils::ChainFileHeader) ||
+        chainFileHeader.m_magic != CheckpointUtils::HEADER_MAGIC) {
+        MOT_LOG_ERROR(
+            "CheckpointRecovery::FillTasksFromChainFile: Failed to verify chain file '%s' header", chainFile.c_str());
+        (void)CheckpointUtils::CloseFile(fd);
+        return -1;
+    }
+
+    CheckpointUtils::ChainFileEntry entry;
+    for (uint64_t i = 0; i < chainFileHeader.m_numEntries; i++) {
+        if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::ChainFileEntry)) !=
+                sizeof(CheckpointUtils::ChainFileEntry) ||
+            entry.m_numLinks == 0) {
+            MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromChainFile: Failed to read chain file '%s' entry: %lu",
+                chainFile.c_str(),
+                i);
+            (void)CheckpointUtils::CloseFile(fd);
+            return -1;
+        }
+
+        std::vector<CheckpointUtils::ChainLink>& links = m_deltaChain[entry.m_tableId].m_links;
+        links.resize(entry.m_numLinks);
+        size_t linksSize = sizeof(CheckpointUtils::ChainLink) * entry.m_numLinks;
+        if (CheckpointUtils::ReadFile(fd, (char*)links.data(), linksSize) != linksSize) {
+            MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromChainFile: Failed to read chain file '%s' links: %lu",
+                chainFile.c_str(),
+                i);
+            (void)CheckpointUtils::CloseFile(fd);
+            return -1;
+        }
+
+        for (const CheckpointUtils::ChainLink& link : links) {
+            if (link.m_checkpointId != m_checkpointId && !IsCheckpointValid(link.m_checkpointId)) {
+                MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromChainFile: Delta chain of table %u is broken",
+                    entry.m_tableId);
+                (void)CheckpointUtils::CloseFile(fd);
+                return -1;
+            }
+        }
+
+        (void)m_tableIds.insert(entry.m_tableId);
+        (void)m_deletedKeys[entry.m_tableId];
+    }
+
+    if (CheckpointUtils::CloseFile(fd)) {
+        MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromChainFile: Failed to close chain file");
+        return -1;
+    }
+
+    m_deltaMinCsn = chainFileHeader.m_minCsn;
+    m_numDeltas = (uint32_t)chainFileHeader.m_numDeltas;
+    m_hasDeltaChain = true;
+    if (!FillTasksFromDeltaChain(0)) {
+        return -1;
+    }
+
+    MOT_LOG_INFO("CheckpointRecovery::FillTasksFromChainFile: Filled %lu tasks, %u deltas in chain",
+        m_tasksList.size(),
+        m_numDeltas);
+    return 1;
+}
+
+bool CheckpointRecovery::FillTasksFromDeltaChain(uint32_t step)
+{
+    for (auto it = m_deltaChain.begin(); it != m_deltaChain.end(); (void)++it) {
+        const std::vector<CheckpointUtils::ChainLink>& links = it->second.m_links;
+        if (links.size() <= step) {
+            continue;
+        }
+
+        const CheckpointUtils::ChainLink& link = links[links.size() - 1 - step];
+        for (uint32_t j = 0; j <= link.m_maxSegId; j++) {
+            Task* recoveryTask = new (std::nothrow) Task(it->first, j, link.m_checkpointId, step > 0);
+            if (recoveryTask == nullptr) {
+                MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromDeltaChain: Failed to allocate task object");
+                return false;
+            }
+            m_tasksList.push_back(recoveryTask);
+        }
+    }
+    return true;
+}
+
+bool CheckpointRecovery::LoadDeletedKeys(uint32_t step)
+{
+    char keyData[MAX_KEY_SIZE];
+    for (auto it = m_deltaChain.begin(); it != m_deltaChain.end(); (void)++it) {
+        const std::vector<CheckpointUtils::ChainLink>& links = it->second.m_links;
+        if (links.size() <= step + 1) {
+            continue;  // nothing older to merge for this table
+        }
+
+        const CheckpointUtils::ChainLink& link = links[links.size() - 1 - step];
+        if (link.m_numDeletes == 0) {
+            continue;
+        }
+
+        int fd = -1;
+        std::string workingDir;
+        std::string fileName;
+        if (!CheckpointUtils::SetWorkingDir(workingDir, link.m_checkpointId)) {
+            return false;
+        }
+        CheckpointUtils::MakeDelFilename(it->first, fileName, workingDir);
+        if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+            MOT_LOG_ERROR("CheckpointRecovery::LoadDeletedKeys: failed to open file: %s", fileName.c_str());
+            return false;
+        }
+
+        CheckpointUtils::FileHeader fileHeader;
+        if (CheckpointUtils::ReadFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
+                sizeof(CheckpointUtils::FileHeader) ||
+            fileHeader.m_magic != CheckpointUtils::HEADER_MAGIC || fileHeader.m_tableId != it->first) {
+            MOT_LOG_ERROR("CheckpointRecovery::LoadDeletedKeys: file: %s is corrupted", fileName.c_str());
+            (void)CheckpointUtils::CloseFile(fd);
+            return false;
+        }
+
+        std::unordered_set<std::string>& deletedKeys = m_deletedKeys[it->first];
+        CheckpointUtils::EntryHeader entry;
+        bool entriesRead = true;
+        for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
+            if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader)) !=
+                    sizeof(CheckpointUtils::EntryHeader) ||
+                entry.m_base.m_keyLen > MAX_KEY_SIZE ||
+                CheckpointUtils::ReadFile(fd, keyData, entry.m_base.m_keyLen) != entry.m_base.m_keyLen) {
+                MOT_LOG_ERROR("CheckpointRecovery::LoadDeletedKeys: failed to read entry %lu of file: %s",
+                    i,
+                    fileName.c_str());
+                entriesRead = false;
+                break;
+            }
+            (void)deletedKeys.emplace(keyData, entry.m_base.m_keyLen);
+            SetMaxCsn(entry.m_base.m_csn);
+        }
+
+        if (CheckpointUtils::CloseFile(fd) || !entriesRead) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CheckpointRecovery::IsSupersededRow(Table* table, const char* keyData, uint16_t keyLen) const
+{
+    auto it = m_deletedKeys.find(table->GetTableId());
+    if (it != m_deletedKeys.end() && it->second.count(std::string(keyData, keyLen)) != 0) {
+        return true;
+    }
+
+    MaxKey key;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    return (table->GetPrimaryIndex()->IndexReadHeader(&key, MOTCurrThreadId) != nullptr);
+}
+
 bool CheckpointRecovery::RecoverTableMetadata(uint32_t tableId)
 {
     int fd = -1;
@@ -436,13 +651,15 @@ void CheckpointRecovery::CheckpointRecoveryWorker(uint32_t workerId, CheckpointR
 
     MOT_LOG_DEBUG("%s[%u] start on cpu %d", threadName, (unsigned)threadId, sched_getcpu());
 
+    // each worker decompresses the segments it recovers, so compressed checkpoints are decompressed in parallel
+    CheckpointUtils::DataFileReader reader;
     uint64_t maxCsn = 0;
     RC status = RC_OK;
     while (!checkpointRecovery->ShouldStopWorkers()) {
         CheckpointRecovery::Task* task = checkpointRecovery->GetTask();
         if (task != nullptr) {
             bool hadError = false;
-            if (!checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status)) {
+            if (!checkpointRecovery->RecoverTableRows(task, reader, keyData, entryData, maxCsn, sState, status)) {
                 MOT_LOG_ERROR("CheckpointRecoveryWorker: Failed to recover table %u", task->m_tableId);
                 checkpointRecovery->OnError(status,
                     "CheckpointRecoveryWorker: Failed to recover table",
@@ -475,8 +692,8 @@ void CheckpointRecovery::CheckpointRecoveryWorker(uint32_t workerId, CheckpointR
     MOT_LOG_DEBUG("%s[%u] end on cpu %d", threadName, (unsigned)threadId, sched_getcpu());
 }
 
-bool CheckpointRecovery::RecoverTableRows(
-    Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status)
+bool CheckpointRecovery::RecoverTableRows(Task* task, CheckpointUtils::DataFileReader& dataReader, char* keyData,
+    char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status)
 {
     if (task == nullptr) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: no task given");
@@ -494,8 +711,15 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(workingDir, task->m_checkpointId)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to obtain checkpoint %lu working dir",
+            task->m_checkpointId);
+        return false;
+    }
+
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    CheckpointUtils::MakeCpFilename(tableId, fileName, workingDir, seg);
     if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to open file: %s", fileName.c_str());
         return false;
@@ -509,7 +733,8 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
-    if (fileHeader.m_magic != CheckpointUtils::HEADER_MAGIC || fileHeader.m_tableId != tableId) {
+    bool compressed = (fileHeader.m_magic == CheckpointUtils::COMPRESSED_HEADER_MAGIC);
+    if ((fileHeader.m_magic != CheckpointUtils::HEADER_MAGIC && !compressed) || fileHeader.m_tableId != tableId) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: file: %s is corrupted", fileName.c_str());
         (void)CheckpointUtils::CloseFile(fd);
         return false;
@@ -523,17 +748,31 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
+    // once the memory left cannot hold the segment, its rows go straight to the cold row store, so a table
+    // larger than memory only needs memory for its keys
+    bool evictRows = false;
     if (IsMemoryLimitReached(m_numWorkers, GetGlobalConfiguration().m_checkpointSegThreshold)) {
-        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: Memory hard limit reached. Cannot recover datanode");
+        if (!GetGlobalConfiguration().m_enableColdRowEviction) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: Memory hard limit reached. Cannot recover datanode");
+            (void)CheckpointUtils::CloseFile(fd);
+            return false;
+        }
+        evictRows = true;
+    }
+
+    if (!dataReader.Attach(fd, compressed)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to attach reader to file: %s", fileName.c_str());
         (void)CheckpointUtils::CloseFile(fd);
+        status = RC_MEMORY_ALLOCATION_ERROR;
         return false;
     }
 
     CheckpointUtils::EntryHeader entry;
     size_t entryHeaderSize =
         !m_preMvccUpgrade ? sizeof(CheckpointUtils::EntryHeader) : sizeof(CheckpointUtils::EntryHeaderBase);
+    uint64_t numInserted = 0;
     for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
-        status = ReadEntry(fd, entryHeaderSize, entry, keyData, entryData);
+        status = ReadEntry(dataReader, entryHeaderSize, entry, keyData, entryData);
         if (status != RC_OK) {
             MOT_LOG_ERROR("CheckpointRecovery: failed to read row (elem: %lu / %lu), error: %s (%d)",
                 i,
@@ -543,6 +782,14 @@ bool CheckpointRecovery::RecoverTableRows(
             break;
         }
 
+        if (entry.m_base.m_csn > maxCsn) {
+            maxCsn = entry.m_base.m_csn;
+        }
+
+        if (task->m_merge && IsSupersededRow(table, keyData, entry.m_base.m_keyLen)) {
+            continue;
+        }
+
         InsertRow(table,
             keyData,
             entry.m_base.m_keyLen,
@@ -553,7 +800,8 @@ bool CheckpointRecovery::RecoverTableRows(
             sState,
             status,
             entry.m_base.m_rowId,
-            entry.m_transactionId);
+            entry.m_transactionId,
+            evictRows);
         if (status != RC_OK) {
             MOT_LOG_ERROR("CheckpointRecovery: failed to insert row (elem: %lu / %lu), error: %s (%d)",
                 i,
@@ -564,9 +812,7 @@ bool CheckpointRecovery::RecoverTableRows(
         }
 
         MOT_LOG_DEBUG("Inserted into table %u row with CSN %" PRIu64, tableId, entry.m_base.m_csn);
-        if (entry.m_base.m_csn > maxCsn) {
-            maxCsn = entry.m_base.m_csn;
-        }
+        numInserted++;
     }
 
     if (CheckpointUtils::CloseFile(fd)) {
@@ -577,21 +823,21 @@ bool CheckpointRecovery::RecoverTableRows(
     }
 
     if (status == RC_OK) {
-        table->UpdateRowCount(fileHeader.m_numOps);
+        table->UpdateRowCount(numInserted);
     }
     MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u, %lu rows recovered (%s)",
         MOTCurrThreadId,
         tableId,
         seg,
-        fileHeader.m_numOps,
+        numInserted,
         (status == RC_OK) ? "OK" : "Error");
     return (status == RC_OK);
 }
 
-RC CheckpointRecovery::ReadEntry(
-    int fd, size_t entryHeaderSize, CheckpointUtils::EntryHeader& entry, char* keyData, char* entryData) const
+RC CheckpointRecovery::ReadEntry(CheckpointUtils::DataFileReader& dataReader, size_t entryHeaderSize,
+    CheckpointUtils::EntryHeader& entry, char* keyData, char* entryData) const
 {
-    size_t reader = CheckpointUtils::ReadFile(fd, (char*)&entry, entryHeaderSize);
+    size_t reader = dataReader.Read((char*)&entry, entryHeaderSize);
     if (reader != entryHeaderSize) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry header, reader %lu", reader);
         return RC_ERROR;
@@ -613,13 +859,13 @@ RC CheckpointRecovery::ReadEntry(
         return RC_ERROR;
     }
 
-    reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_base.m_keyLen);
+    reader = dataReader.Read(keyData, entry.m_base.m_keyLen);
     if (reader != entry.m_base.m_keyLen) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry key, reader %lu", reader);
         return RC_ERROR;
     }
 
-    reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_base.m_dataLen);
+    reader = dataReader.Read(entryData, entry.m_base.m_dataLen);
     if (reader != entry.m_base.m_dataLen) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry data, reader %lu", reader);
         return RC_ERROR;
@@ -665,7 +911,7 @@ bool CheckpointRecovery::IsMemoryLimitReached(uint32_t numThreads, uint64_t need
 }
 
 void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen,
-    uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId, uint64_t version)
+    uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId, uint64_t version, bool evict)
 {
     MaxKey key;
     Row* row = table->CreateNewRow();
@@ -695,9 +941,35 @@ void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen,
         table->DestroyRow(row);
     } else {
         row->GetPrimarySentinel()->SetTransactionId(version);
+        if (evict && !EvictRow(table, row)) {
+            status = RC_ERROR;
+            MOT_REPORT_ERROR(MOT_ERROR_RESOURCE_UNAVAILABLE, "Recovery Manager Insert Row", "failed to evict row");
+        }
     }
 }
 
+bool CheckpointRecovery::EvictRow(Table* table, Row* row) const
+{
+    ColdRowStore* store = table->CreateColdStore();
+    if (store == nullptr) {
+        return false;
+    }
+
+    // the row is reachable only through its sentinel until recovery ends, so no GC deferral is needed
+    PrimarySentinel* ps = row->GetPrimarySentinel();
+    uint64_t offset = 0;
+    ps->Lock(MOTCurrThreadId);
+    if (!store->Store(ps, row, offset)) {
+        ps->Unlock();
+        return false;
+    }
+    ps->SetEvictedOffset(offset);
+    ps->Unlock();
+    table->DestroyRow(row);
+    DbSessionStatisticsProvider::GetInstance().AddColdRowEvict();
+    return true;
+}
+
 bool CheckpointRecovery::RecoverInProcessData()
 {
     int fd = -1;
@@ -28,11 +28,14 @@
 #include <set>
 #include <list>
 #include <mutex>
+#include <string>
+#include <unordered_set>
 #include "global.h"
 #include "spin_lock.h"
 #include "table.h"
 #include "surrogate_state.h"
 #include "checkpoint_utils.h"
+#include "checkpoint_delta.h"
 
 namespace MOT {
 class CheckpointRecovery {
@@ -47,7 +50,10 @@ public:
           m_stopWorkers(false),
           m_errorSet(false),
           m_errorCode(RC_OK),
-          m_preMvccUpgrade(false)
+          m_preMvccUpgrade(false),
+          m_hasDeltaChain(false),
+          m_deltaMinCsn(0),
+          m_numDeltas(0)
     {}
 
     ~CheckpointRecovery()
@@ -72,15 +78,20 @@ public:
 
     /**
      * @struct Task
-     * @brief Describes a checkpoint recovery task by its table id and
-     * segment file number.
+     * @brief Describes a checkpoint recovery task by its table id, segment
+     * file number and the checkpoint holding the segment.
      */
     struct Task {
-        explicit Task(uint32_t tableId = 0, uint32_t segId = 0) : m_tableId(tableId), m_segId(segId)
+        explicit Task(uint32_t tableId = 0, uint32_t segId = 0, uint64_t checkpointId = 0, bool merge = false)
+            : m_tableId(tableId), m_segId(segId), m_checkpointId(checkpointId), m_merge(merge)
         {}
 
         uint32_t m_tableId;
         uint32_t m_segId;
+        uint64_t m_checkpointId;
+
+        /** @var Rows already recovered from a newer delta, or deleted by one, are skipped. */
+        bool m_merge;
     };
 
     /**
@@ -92,6 +103,7 @@ public:
     /**
      * @brief Reads and inserts rows from a checkpoint file
      * @param task The task (tableid / segment) to recover from.
+     * @param dataReader The data file reader of the worker, which decompresses compressed files.
      * @param keyData A key buffer.
      * @param entryData A row buffer..
      * @param maxCsn The returned maxCsn encountered during the recovery.
@@ -100,8 +112,8 @@ public:
      * @param status RC returned from the Insert function.
      * @return Boolean value denoting success or failure.
      */
-    bool RecoverTableRows(
-        Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status);
+    bool RecoverTableRows(Task* task, CheckpointUtils::DataFileReader& dataReader, char* keyData, char* entryData,
+        uint64_t& maxCsn, SurrogateState& sState, RC& status);
 
     uint64_t GetLsn() const
     {
@@ -159,6 +171,42 @@ private:
      */
     int FillTasksFromMapFile();
 
+    /**
+     * @brief Reads the checkpoint delta chain file and fills the tasks queue
+     * with the newest link of each table's chain.
+     * @return Int value where -1 denotes an error and 1 means a success.
+     */
+    int FillTasksFromChainFile();
+
+    /**
+     * @brief Fills the tasks queue with the segments of a delta chain link.
+     * @param step The link position, counted from the newest link.
+     * @return Boolean value denoting success or failure.
+     */
+    bool FillTasksFromDeltaChain(uint32_t step);
+
+    /**
+     * @brief Loads the keys deleted by a delta chain link, so that older links skip them.
+     * @param step The link position, counted from the newest link.
+     * @return Boolean value denoting success or failure.
+     */
+    bool LoadDeletedKeys(uint32_t step);
+
+    /**
+     * @brief Checks if a row from an older delta chain link was already recovered from a newer
+     * link or was deleted by one.
+     * @param table The table's pointer.
+     * @param keyData The row's key buffer.
+     * @param keyLen The row's key length.
+     * @return Boolean value that is true if the row should be skipped.
+     */
+    bool IsSupersededRow(Table* table, const char* keyData, uint16_t keyLen) const;
+
+    /**
+     * @brief Spawns the recovery workers and waits until the tasks queue is consumed.
+     */
+    void RunRecoveryWorkers();
+
     /**
      * @brief Checks if all the tasks are completed.
      * @return Boolean value that is true if all the tasks are completed.
@@ -184,9 +232,18 @@ private:
      * @param status the returned status of the operation.
      * @param rowId the row's internal id.
      * @param version the row's version.
+     * @param evict specifies whether the row is moved to the table cold row store once inserted.
      */
     void InsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen, uint64_t csn,
-        uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId, uint64_t version);
+        uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId, uint64_t version, bool evict);
+
+    /**
+     * @brief Moves a recovered row to the table cold row store, leaving only its key in memory.
+     * @param table the table of the row.
+     * @param row the recovered row, destroyed on success.
+     * @return Boolean value denoting success or failure.
+     */
+    bool EvictRow(Table* table, Row* row) const;
 
     /**
      * @brief performs table creation.
@@ -217,8 +274,8 @@ private:
      */
     bool RecoverInProcessData();
 
-    RC ReadEntry(
-        int fd, size_t entryHeaderSize, CheckpointUtils::EntryHeader& entry, char* keyData, char* entryData) const;
+    RC ReadEntry(CheckpointUtils::DataFileReader& dataReader, size_t entryHeaderSize,
+        CheckpointUtils::EntryHeader& entry, char* keyData, char* entryData) const;
 
     uint64_t m_checkpointId;
 
@@ -251,6 +308,16 @@ private:
     std::list<Task*> m_tasksList;
 
     bool m_preMvccUpgrade;
+
+    bool m_hasDeltaChain;
+
+    uint64_t m_deltaMinCsn;
+
+    uint32_t m_numDeltas;
+
+    DeltaChainMap m_deltaChain;
+
+    std::map<uint32_t, std::unordered_set<std::string>> m_deletedKeys;
 };
 }  // namespace MOT
 
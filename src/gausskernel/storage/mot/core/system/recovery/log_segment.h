@@ -50,7 +50,11 @@ struct LogSegment : public Serializable {
 
     RedoLogTransactionPlayer* m_player;
 
-    LogSegment() : m_data(nullptr), m_len(0), m_replayLsn(0), m_allocator(nullptr), m_player(nullptr)
+    /** @var A fence holds back its processor until the multi-partition transaction of its player commits. */
+    bool m_isFence;
+
+    LogSegment()
+        : m_data(nullptr), m_len(0), m_replayLsn(0), m_allocator(nullptr), m_player(nullptr), m_isFence(false)
     {}
 
     ~LogSegment()
@@ -27,7 +27,9 @@
 #include "checkpoint_utils.h"
 #include "checkpoint_manager.h"
 #include "pending_txn_logger.h"
+#include "cycles.h"
 #include "utils/memutils.h"
+#include <algorithm>
 
 namespace MOT {
 DECLARE_LOGGER(MTLSRecoveryManager, Recovery);
@@ -38,6 +40,7 @@ static constexpr uint32_t WAIT_FOR_PLAYER_TIMEOUT = 1000 * 1000 * 10;
 static constexpr uint32_t WAIT_FOR_PLAYER_WARNING_LOG_THRESHOLD = 1000 * 1000;  // 1 sec
 static constexpr uint32_t QUEUE_MAX_CAPACITY_THRESHOLD = 80;
 static constexpr uint32_t QUEUE_MAX_CAPACITY_TIMEOUT = 1000 * 1000 * 10;  // 10 sec
+static constexpr double RECOVERY_PROGRESS_REPORT_INTERVAL = 10.0;       // 10 sec
 
 static void TransactionProcessorThread(MTLSTransactionProcessorContext* context)
 {
@@ -134,6 +137,7 @@ bool MTLSRecoveryManager::RecoverDbEnd()
 {
     Flush();
     StopThreads();
+    ReportProgress(GetLastReplayLsn(), true);
     if (m_maxCsn) {
         GetCSNManager().SetCSN(m_maxCsn);
     }
@@ -183,7 +187,7 @@ void MTLSRecoveryManager::StopThreads()
     m_threads.clear();
 }
 
-RedoLogTransactionPlayer* MTLSRecoveryManager::AssignPlayer(LogSegment* segment)
+RedoLogTransactionPlayer* MTLSRecoveryManager::AssignPlayer(LogSegment* segment, uint32_t poolId)
 {
     // In case of upgrade from 1VCC to MVCC, we use INITIAL_CSN, because the CSN in the 1VCC log segment
     // is not compatible with envelope CSN.
@@ -224,8 +228,7 @@ RedoLogTransactionPlayer* MTLSRecoveryManager::AssignPlayer(LogSegment* segment)
                 MOT_LOG_ERROR("MTLSRecoveryManager::AssignPlayer: Timed out after waiting for %uus", waitedUs);
                 return nullptr;
             }
-            uint32_t queueId = ComputeProcessorQueueId(segment->m_controlBlock);
-            player = GetPlayerFromPool(queueId);
+            player = GetPlayerFromPool(poolId);
             if (player == nullptr) {
                 (void)usleep(ThreadContext::THREAD_SLEEP_TIME_US);
                 waitedUs += ThreadContext::THREAD_SLEEP_TIME_US;
@@ -294,7 +297,9 @@ bool MTLSRecoveryManager::ApplyLogSegmentData(char* data, size_t len, uint64_t r
         }
 
         RedoLogTransactionIterator iterator(curData, len);
-        uint32_t queueId = ComputeProcessorQueueId(iterator.GetEndSegmentBlock());
+        bool isPartitioned = IsPartitionedTransaction(iterator, curData);
+        uint32_t queueId =
+            (isPartitioned ? m_txnPartitions.front() : ComputeProcessorQueueId(iterator.GetEndSegmentBlock()));
         if (!FlowControl(queueId)) {
             MOT_LOG_ERROR("ApplyLogSegmentFromData - Timeout");
             return false;
@@ -313,7 +318,10 @@ bool MTLSRecoveryManager::ApplyLogSegmentData(char* data, size_t len, uint64_t r
             delete segment;
             return false;
         }
-        if (!ProcessSegment(segment)) {
+        if (IsCommitOp(opCode)) {
+            m_numDispatchedTxns++;
+        }
+        if (!(isPartitioned ? ProcessPartitionedSegment(segment) : ProcessSegment(segment))) {
             MOT_LOG_ERROR("ApplyLogSegmentFromData: Failed to process log segment");
             delete segment;
             return false;
@@ -321,14 +329,160 @@ bool MTLSRecoveryManager::ApplyLogSegmentData(char* data, size_t len, uint64_t r
         curData += iterator.GetRedoTransactionLength();
     }
     m_notifier.Notify(ThreadNotifier::ThreadState::ACTIVE);
+    ReportProgress(replayLsn);
     return true;
 }
 
+bool MTLSRecoveryManager::IsPartitionedTransaction(const RedoLogTransactionIterator& iterator, char* data)
+{
+    const EndSegmentBlock& endSegmentBlock = iterator.GetEndSegmentBlock();
+    if (!m_enablePartitioning || m_confNumProcessors == 1 || endSegmentBlock.m_opCode != OperationCode::COMMIT_TX ||
+        (endSegmentBlock.m_flags & EndSegmentBlock::MOT_UPDATE_INDEX_COLUMN_FLAG) ||
+        m_txnMap.find(endSegmentBlock.m_internalTransactionId) != m_txnMap.end()) {
+        return false;
+    }
+
+    /*
+     * Transactions in the commit queue precede this one in the log, and may touch the same tables. They must be
+     * committed first, so that the commit order of each row follows the log order. This also applies committed DDL
+     * before the row operations are parsed with the table definitions.
+     */
+    if (!m_committer->QueueEmpty()) {
+        DrainCommitter();
+    }
+
+    m_txnPartitions.clear();
+    uint8_t* operationData = (uint8_t*)(data + sizeof(uint32_t));
+    uint8_t* endPosition = (uint8_t*)(data + iterator.GetRedoTransactionLength() - sizeof(EndSegmentBlock));
+    while (operationData < endPosition) {
+        Table* table = nullptr;
+        uint32_t operationLength = RecoveryOps::GetLogOperationTable(operationData, endPosition, table);
+        if (operationLength == 0) {
+            return false;
+        }
+        uint32_t partition = table->GetTableId() % m_confNumProcessors;
+        if (std::find(m_txnPartitions.begin(), m_txnPartitions.end(), partition) == m_txnPartitions.end()) {
+            m_txnPartitions.push_back(partition);
+        }
+        operationData += operationLength;
+    }
+    if (m_txnPartitions.empty()) {
+        return false;
+    }
+
+    // The lowest partition owns the transaction, so fences are always queued in the same order.
+    std::sort(m_txnPartitions.begin(), m_txnPartitions.end());
+    return true;
+}
+
+bool MTLSRecoveryManager::ProcessPartitionedSegment(LogSegment* segment)
+{
+    uint64_t intTxnId = segment->m_controlBlock.m_internalTransactionId;
+    uint32_t queueId = m_txnPartitions.front();
+    uint32_t numFences = (uint32_t)(m_txnPartitions.size() - 1);
+    RedoLogTransactionPlayer* player = AssignPlayer(segment, m_confNumProcessors + queueId);
+    if (player == nullptr) {
+        MOT_LOG_ERROR("ProcessPartitionedSegment - Failed to assign a player for the segment");
+        return false;
+    }
+
+    segment->SetPlayer(player);
+    player->GetTxn()->SetInternalTransactionId(intTxnId);
+    player->SetPartitioned(numFences);
+    SetMaxTransactionId(intTxnId);
+    SetMaxCsn(segment->m_controlBlock.m_csn);
+
+    if (!m_processors[queueId]->QueuePut(segment)) {
+        /*
+         * The single segment MOT only transaction is not in the txn map and nothing is replayed yet, so the player
+         * is deleted directly (see ProcessSegment).
+         */
+        MOT_LOG_ERROR("ProcessPartitionedSegment - Failed to put the player [%p:%lu:%lu] to the processor queue",
+            player,
+            player->GetTransactionId(),
+            player->GetPrevId());
+        delete player;
+        m_numAllocatedPlayers--;
+        return false;
+    }
+    m_numPartitionedDispatched++;
+    if (numFences > 0) {
+        m_numMultiPartitionTxns++;
+    }
+
+    for (uint32_t i = 1; i < m_txnPartitions.size(); i++) {
+        LogSegment* fence = new (std::nothrow) LogSegment();
+        if (fence != nullptr) {
+            fence->m_isFence = true;
+            fence->SetPlayer(player);
+            if (m_processors[m_txnPartitions[i]]->QueuePut(fence)) {
+                continue;
+            }
+            delete fence;
+        }
+        /*
+         * The segment is already queued and its processor waits for the fences, so recovery fails here. The player
+         * is rolled back and released when the processor queues are cleaned up.
+         */
+        MOT_LOG_ERROR("ProcessPartitionedSegment - Failed to put a fence of TXN %lu to processor %u",
+            intTxnId,
+            m_txnPartitions[i]);
+        SetError();
+        break;
+    }
+    return true;
+}
+
+bool MTLSRecoveryManager::HasPendingPartitionedTransactions() const
+{
+    uint64_t numCommitted = 0;
+    for (uint32_t i = 0; i < m_confNumProcessors; i++) {
+        numCommitted += m_processors[i]->GetNumPartitionedCommitted();
+    }
+    return (m_numPartitionedDispatched > numCommitted);
+}
+
+void MTLSRecoveryManager::DrainPartitioned()
+{
+    m_notifier.Notify(ThreadNotifier::ThreadState::ACTIVE);
+    while (HasPendingPartitionedTransactions() && !m_errorSet) {
+        (void)usleep(ThreadContext::THREAD_SLEEP_TIME_US);
+    }
+}
+
+void MTLSRecoveryManager::ReportProgress(uint64_t replayLsn, bool isFinal)
+{
+    uint64_t now = GetSysClock();
+    if (m_progressStartTime == 0) {
+        m_progressStartTime = now;
+        m_progressReportTime = now;
+        return;
+    }
+
+    double interval = CpuCyclesLevelTime::CyclesToSeconds(now - m_progressReportTime);
+    if (!isFinal && interval < RECOVERY_PROGRESS_REPORT_INTERVAL) {
+        return;
+    }
+    double elapsed = CpuCyclesLevelTime::CyclesToSeconds(now - m_progressStartTime);
+    double rate = (interval > 0) ? ((double)(m_numDispatchedTxns - m_progressReportTxns) / interval) : 0;
+    MOT_LOG_INFO("MOT redo replay %s: LSN %lu, %lu transactions (%lu partitioned, %lu multi-partition), "
+                 "%.0f transactions/sec, %.0f seconds elapsed",
+        isFinal ? "done" : "in progress",
+        replayLsn,
+        m_numDispatchedTxns,
+        m_numPartitionedDispatched,
+        m_numMultiPartitionTxns,
+        rate,
+        elapsed);
+    m_progressReportTime = now;
+    m_progressReportTxns = m_numDispatchedTxns;
+}
+
 bool MTLSRecoveryManager::ProcessSegment(LogSegment* segment)
 {
     uint64_t intTxnId = segment->m_controlBlock.m_internalTransactionId;
     uint32_t queueId = ComputeProcessorQueueId(segment->m_controlBlock);
-    RedoLogTransactionPlayer* player = AssignPlayer(segment);
+    RedoLogTransactionPlayer* player = AssignPlayer(segment, queueId);
     if (player == nullptr) {
         MOT_LOG_ERROR("ProcessSegment - Failed to assign a player for the segment");
         return false;
@@ -350,6 +504,7 @@ bool MTLSRecoveryManager::ProcessSegment(LogSegment* segment)
          * like generate series that might not be indexed because of that.
          */
         MOT_LOG_TRACE("MTLSRecoveryManager::ProcessSegment - Draining Committer");
+        DrainPartitioned();
         DrainCommitter();
     }
 
@@ -362,6 +517,8 @@ bool MTLSRecoveryManager::ProcessSegment(LogSegment* segment)
             player,
             player->GetTransactionId(),
             player->GetPrevId());
+        // The head of the commit queue does not retry, so the prior partitioned transactions must be committed.
+        DrainPartitioned();
         if (!m_committer->QueuePut(player)) {
             MOT_LOG_ERROR("ProcessSegment - Failed to put the player [%p:%lu:%lu] to the commit queue",
                 player,
@@ -469,6 +626,7 @@ bool MTLSRecoveryManager::CommitTransaction(uint64_t extTxnId)
 
             MOT_ASSERT(!player->m_inPool);
             MOT_ASSERT(player->GetTransactionId() == player->GetTxn()->GetInternalTransactionId());
+            DrainPartitioned();
             if (!m_committer->QueuePut(player)) {
                 MOT_LOG_ERROR("MTLSRecoveryManager::CommitTransaction - Failed to put player [%p:%lu:%lu] for "
                               "TXN [%lu:%lu] to the commit queue",
@@ -616,12 +774,12 @@ RedoLogTransactionPlayer* MTLSRecoveryManager::CreatePlayer()
 bool MTLSRecoveryManager::InitTxnPool()
 {
     m_txnPool = (SPSCQueue<RedoLogTransactionPlayer>**)calloc(
-        m_confNumProcessors, sizeof(SPSCQueue<RedoLogTransactionPlayer>*));
+        GetNumTxnPools(), sizeof(SPSCQueue<RedoLogTransactionPlayer>*));
     if (m_txnPool == nullptr) {
         return false;
     }
 
-    m_processorPlayerCounts = (uint32_t*)calloc(m_confNumProcessors, sizeof(uint32_t));
+    m_processorPlayerCounts = (uint32_t*)calloc(GetNumTxnPools(), sizeof(uint32_t));
     if (m_processorPlayerCounts == nullptr) {
         free(m_txnPool);
         m_txnPool = nullptr;
@@ -629,7 +787,7 @@ bool MTLSRecoveryManager::InitTxnPool()
     }
 
     uint32_t queueSize = ComputeNearestHighPow2(m_processorQueueSize);
-    for (uint32_t i = 0; i < m_confNumProcessors; i++) {
+    for (uint32_t i = 0; i < GetNumTxnPools(); i++) {
         m_txnPool[i] = new (std::nothrow) SPSCQueue<RedoLogTransactionPlayer>(queueSize);
         if (m_txnPool[i] == nullptr) {
             DestroyTxnPool();
@@ -929,7 +1087,7 @@ void MTLSRecoveryManager::CleanupTxnPool()
     MOT_LOG_TRACE("MTLSRecoveryManager::CleanupTxnPool - Cleaning txnPool");
     uint32_t deleteCount = 0;
     if (m_txnPool != nullptr) {
-        for (uint32_t i = 0; i < m_confNumProcessors; i++) {
+        for (uint32_t i = 0; i < GetNumTxnPools(); i++) {
             if (m_txnPool[i] == nullptr) {
                 continue;
             }
@@ -945,7 +1103,7 @@ void MTLSRecoveryManager::CleanupTxnPool()
     }
 
     if (m_processorPlayerCounts != nullptr) {
-        for (uint32_t i = 0; i < m_confNumProcessors; i++) {
+        for (uint32_t i = 0; i < GetNumTxnPools(); i++) {
             m_processorPlayerCounts[i] = 0;
         }
     }
@@ -959,7 +1117,7 @@ void MTLSRecoveryManager::DestroyTxnPool()
 {
     CleanupTxnPool();
     if (m_txnPool != nullptr) {
-        for (uint32_t i = 0; i < m_confNumProcessors; i++) {
+        for (uint32_t i = 0; i < GetNumTxnPools(); i++) {
             if (m_txnPool[i] == nullptr) {
                 continue;
             }
@@ -36,6 +36,7 @@
 #include "spsc_queue.h"
 #include "redo_log_transaction_player.h"
 #include "thread_utils.h"
+#include "redo_log_transaction_iterator.h"
 
 namespace MOT {
 /**
@@ -52,7 +53,14 @@ public:
           m_txnPool(nullptr),
           m_processorPlayerCounts(nullptr),
           m_processorQueueSize(m_confQueueSize / m_confNumProcessors),
-          m_committer(nullptr)
+          m_committer(nullptr),
+          m_enablePartitioning(GetGlobalConfiguration().m_enableParallelRecoveryPartitioning),
+          m_numPartitionedDispatched(0),
+          m_numDispatchedTxns(0),
+          m_numMultiPartitionTxns(0),
+          m_progressStartTime(0),
+          m_progressReportTime(0),
+          m_progressReportTxns(0)
     {}
 
     ~MTLSRecoveryManager() override;
@@ -100,7 +108,10 @@ public:
         if (IsErrorSet()) {
             return false;
         }
-        if (m_committer->QueuePeek() == player) {
+        // A partitioned transaction only depends on transactions of its own partitions, which are committed
+        // before it starts, or on transactions in the commit queue.
+        bool isNext = (player->IsPartitioned() ? m_committer->QueueEmpty() : (m_committer->QueuePeek() == player));
+        if (isNext) {
             if (player->IsRetried()) {
                 return false;
             } else {
@@ -153,6 +164,11 @@ public:
      */
     void DrainProcessors();
 
+    /**
+     * @brief Waits until all the dispatched partitioned transactions are committed by their processors.
+     */
+    void DrainPartitioned();
+
     /**
      * @brief Initializes the processor threads.
      * @return Boolean value denoting success or failure.
@@ -269,9 +285,47 @@ private:
     /**
      * @brief Assigns a player for a log segment.
      * @param LogSegment the segment to assign a player to.
+     * @param poolId the txn pool to take a new player from.
      * @return A player object or nullptr if one could not be obtained on time.
      */
-    RedoLogTransactionPlayer* AssignPlayer(LogSegment* segment);
+    RedoLogTransactionPlayer* AssignPlayer(LogSegment* segment, uint32_t poolId);
+
+    /**
+     * @brief Checks whether a transaction can be replayed and committed by the processors of the partitions
+     * (tables) it touches, outside the commit queue. Only single segment MOT transactions with row operations
+     * qualify. The partitions of the transaction are collected in m_txnPartitions, its owner first.
+     * @param iterator the iterator positioned on the transaction.
+     * @param data the transaction data.
+     * @return Boolean value that is true if the transaction is partitioned.
+     */
+    bool IsPartitionedTransaction(const RedoLogTransactionIterator& iterator, char* data);
+
+    /**
+     * @brief Enqueues a partitioned transaction to the processor of its owner partition, and a fence to the
+     * processors of its other partitions.
+     * @param segment the single segment of the transaction.
+     * @return Boolean value denoting success, or failure if the segment could not be enqueued.
+     */
+    bool ProcessPartitionedSegment(LogSegment* segment);
+
+    /**
+     * @brief Checks whether some dispatched partitioned transactions are not committed yet.
+     * @return Boolean value denoting true or false.
+     */
+    bool HasPendingPartitionedTransactions() const;
+
+    /**
+     * @brief Reports the redo replay progress, at most once per progress report interval.
+     * @param replayLsn the last replayed LSN.
+     * @param isFinal reports the final summary regardless of the interval.
+     */
+    void ReportProgress(uint64_t replayLsn, bool isFinal = false);
+
+    /** @brief Retrieves the number of txn pools: one ordered and one partitioned pool per processor. */
+    inline uint32_t GetNumTxnPools() const
+    {
+        return m_confNumProcessors * 2;
+    }
 
     /**
      * @brief Computes the processor queue id from EndSegmentBlock.
@@ -318,6 +372,7 @@ private:
      * new transaction. When there are no free players, it allocates a new player and assign it for a new transaction
      * (without putting it to the pool) or waits until a player becomes free if the current number of allocated players
      * already reached the configured queue size.
+     * The partitioned pool of each processor has the processor as its producer instead of the committer.
      */
     SPSCQueue<RedoLogTransactionPlayer>** m_txnPool;
     uint32_t* m_processorPlayerCounts;
@@ -329,6 +384,27 @@ private:
     std::vector<MTLSTransactionProcessorContext*> m_processors;
     MTLSTransactionCommitterContext* m_committer;
     ThreadNotifier m_notifier;
+
+    /*
+     * Partitioned replay: a transaction whose rows all belong to the tables of one partition (table id modulo the
+     * number of processors) is replayed and committed by the processor of that partition, in log order, without
+     * going through the committer. Transactions of other partitions touch other tables, so they never wait for it.
+     * A transaction touching several partitions is owned by its lowest partition, and the processors of its other
+     * partitions get a fence, so it starts after their prior transactions and they continue after it commits.
+     * Partitioned players are taken from the partitioned pool of the owner processor (pool id m_confNumProcessors +
+     * processor id), and released back to it by that processor. Switching between the commit queue and the
+     * partitions first drains the side used before, so the transactions of each table commit in log order.
+     */
+    bool m_enablePartitioning;
+    std::vector<uint32_t> m_txnPartitions;
+    uint64_t m_numPartitionedDispatched;
+
+    /* Progress reporting (recovery thread only). */
+    uint64_t m_numDispatchedTxns;
+    uint64_t m_numMultiPartitionTxns;
+    uint64_t m_progressStartTime;
+    uint64_t m_progressReportTime;
+    uint64_t m_progressReportTxns;
 };
 
 }  // namespace MOT
@@ -76,6 +76,17 @@ void MTLSTransactionProcessor::Start()
                 break;
             }
 
+            if (segment->m_isFence) {
+                if (!PassFence(player)) {
+                    MOT_LOG_ERROR("MTLSTransactionProcessor::Start: failed to pass fence");
+                    m_context->SetError();
+                    break;
+                }
+                m_context->QueuePop();
+                delete segment;
+                continue;
+            }
+
             SessionContext::SetTxnContext(player->GetTxn());
             player->SetSurrogateState(m_context->GetSurrogateStatePtr());
             if (player->IsFirstSegment()) {
@@ -87,13 +98,26 @@ void MTLSTransactionProcessor::Start()
                 player->SetFirstSegment(false);
             }
 
+            if (player->IsPartitioned() && !WaitForFences(player)) {
+                MOT_LOG_ERROR("MTLSTransactionProcessor::Start: failed to wait for fences");
+                m_context->SetError();
+                break;
+            }
+
             if (player->RedoSegment(segment) != RC_OK) {
                 MOT_LOG_ERROR("MTLSTransactionProcessor::Start: failed to redo segment");
                 m_context->SetError();
                 break;
             }
 
-            if (IsCommitOp(segment->m_controlBlock.m_opCode)) {
+            if (player->IsPartitioned()) {
+                // Partitioned transactions are committed here, before the segment leaves the queue.
+                if (!CommitPartitioned(player)) {
+                    MOT_LOG_ERROR("MTLSTransactionProcessor::Start: failed to commit partitioned transaction");
+                    m_context->SetError();
+                    break;
+                }
+            } else if (IsCommitOp(segment->m_controlBlock.m_opCode)) {
                 player->MarkProcessed();
                 m_context->GetThreadNotifier()->Notify(ThreadNotifier::ThreadState::ACTIVE);
             }
@@ -109,6 +133,60 @@ void MTLSTransactionProcessor::Start()
     MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
 }
 
+bool MTLSTransactionProcessor::ShouldStopWaiting() const
+{
+    return m_context->IsRecoveryErrorSet() ||
+           m_context->GetThreadNotifier()->GetState() == ThreadNotifier::ThreadState::TERMINATE;
+}
+
+bool MTLSTransactionProcessor::PassFence(RedoLogTransactionPlayer* player)
+{
+    // All the prior transactions of this partition are committed, so the owner may start.
+    player->ArriveFence();
+    while (!player->AreFencesReleased()) {
+        if (ShouldStopWaiting()) {
+            return false;
+        }
+        (void)usleep(ThreadContext::THREAD_SLEEP_TIME_US);
+    }
+    player->DepartFence();
+    return true;
+}
+
+bool MTLSTransactionProcessor::WaitForFences(RedoLogTransactionPlayer* player)
+{
+    while (!player->AllFencesArrived()) {
+        if (ShouldStopWaiting()) {
+            return false;
+        }
+        (void)usleep(ThreadContext::THREAD_SLEEP_TIME_US);
+    }
+    return true;
+}
+
+bool MTLSTransactionProcessor::CommitPartitioned(RedoLogTransactionPlayer* player)
+{
+    MOT_LOG_TRACE("MTLSTransactionProcessor::CommitPartitioned Committing TXN [%lu:%lu], NumFences: %u",
+        player->GetTransactionId(),
+        player->GetExternalId(),
+        player->GetNumFences());
+    if (player->CommitTransaction() != RC_OK) {
+        MOT_LOG_ERROR("MTLSTransactionProcessor::CommitPartitioned: commit failed");
+        return false;
+    }
+
+    // The player is reused once released, so wait until the other processors no longer access it.
+    player->ReleaseFences();
+    while (!player->AllFencesDeparted()) {
+        if (ShouldStopWaiting()) {
+            return false;
+        }
+        (void)usleep(ThreadContext::THREAD_SLEEP_TIME_US);
+    }
+    m_context->ReleasePartitionedPlayer(player);
+    return true;
+}
+
 void MTLSTransactionProcessorContext::PrintInfo() const
 {
     MOT_LOG_INFO("Processor%u : NumAlloc %lu, NumFreed %lu, Delta %lu, Usage: %u",
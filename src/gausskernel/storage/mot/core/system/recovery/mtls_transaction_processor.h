@@ -47,7 +47,8 @@ public:
           m_queue(queueSize),
           m_allocator(nullptr),
           m_sizeAlloc(0),
-          m_sizeFreed(0)
+          m_sizeFreed(0),
+          m_numPartitionedCommitted(0)
     {}
 
     ~MTLSTransactionProcessorContext()
@@ -79,6 +80,13 @@ public:
     {
         while (m_queue.Top() != nullptr) {
             LogSegment* segment = m_queue.Take();
+            RedoLogTransactionPlayer* player = segment->GetPlayer();
+            if (!segment->m_isFence && player != nullptr && player->IsPartitioned()) {
+                // Partitioned transactions are not in the commit queue, so they are rolled back here.
+                SessionContext::SetTxnContext(player->GetTxn());
+                player->GetTxn()->Rollback();
+                ReleasePartitionedPlayer(player);
+            }
             delete segment;
         }
         if (m_allocator != nullptr) {
@@ -152,6 +160,30 @@ public:
         return m_notifier;
     }
 
+    inline bool IsRecoveryErrorSet() const
+    {
+        return m_recoveryManager->IsErrorSet();
+    }
+
+    /**
+     * @brief Releases the player of a partitioned transaction, which was committed (or rolled back) by this
+     * processor, back to the partition pool of the processor.
+     * @param player The player to release.
+     */
+    inline void ReleasePartitionedPlayer(RedoLogTransactionPlayer* player)
+    {
+        // The committer convention: a committed player is removed from the txnMap when it is reused.
+        player->SetPrevId(player->GetTransactionId());
+        player->CleanupTransaction();
+        m_recoveryManager->ReleasePlayer(player);
+        (void)m_numPartitionedCommitted.fetch_add(1);
+    }
+
+    inline uint64_t GetNumPartitionedCommitted() const
+    {
+        return m_numPartitionedCommitted.load();
+    }
+
     static constexpr uint32_t ALLOCATOR_SIZE = (1024 * 1024 * 100);
 
 private:
@@ -164,6 +196,7 @@ private:
     SurrogateState m_surrogateState;
     volatile uint64_t m_sizeAlloc;
     volatile uint64_t m_sizeFreed;
+    std::atomic<uint64_t> m_numPartitionedCommitted;
 
     DECLARE_CLASS_LOGGER();
 };
@@ -185,6 +218,33 @@ public:
     void Start();
 
 private:
+    /**
+     * @brief Holds this processor back until the multi-partition transaction of a fence commits.
+     * @param player The player of the multi-partition transaction.
+     * @return Boolean value denoting success or failure.
+     */
+    bool PassFence(RedoLogTransactionPlayer* player);
+
+    /**
+     * @brief Waits until the processors of all the other partitions of a transaction reach its fences.
+     * @param player The player of the multi-partition transaction.
+     * @return Boolean value denoting success or failure.
+     */
+    bool WaitForFences(RedoLogTransactionPlayer* player);
+
+    /**
+     * @brief Commits a partitioned transaction and releases the other partitions it touches.
+     * @param player The player of the partitioned transaction.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CommitPartitioned(RedoLogTransactionPlayer* player);
+
+    /**
+     * @brief Checks whether the processor should stop waiting for other processors.
+     * @return Boolean value that is true if recovery failed or is terminating.
+     */
+    bool ShouldStopWaiting() const;
+
     MTLSTransactionProcessorContext* m_context;
 };
 }  // namespace MOT
@@ -1053,4 +1053,74 @@ RC RecoveryOps::BeginTransaction(IRecoveryOpsContext* ctx, uint64_t replayLsn)
     txn->m_accessMgr->ClearDummyTableCache();
     return rc;
 }
+
+uint32_t RecoveryOps::GetLogOperationTable(uint8_t* data, const uint8_t* endPosition, Table*& table)
+{
+    uint8_t* start = data;
+    uint64_t tableId, exId, version;
+    uint32_t metaVersion;
+    uint16_t keyLength;
+    table = nullptr;
+
+    // all row operations share the same prefix
+    if (data + sizeof(OperationCode) + sizeof(metaVersion) + sizeof(tableId) + sizeof(exId) > endPosition) {
+        return 0;
+    }
+    OperationCode opCode = *(OperationCode*)data;
+    if (opCode != CREATE_ROW && opCode != UPDATE_ROW && opCode != REMOVE_ROW) {
+        return 0;
+    }
+    data += sizeof(OperationCode);
+    Extract(data, metaVersion);
+    Extract(data, tableId);
+    Extract(data, exId);
+    table = GetTableManager()->GetTableByExternal(exId);
+    if (table == nullptr) {
+        return 0;
+    }
+
+    if (opCode == CREATE_ROW) {
+        uint64_t rowId, rowLength;
+        if (data + sizeof(rowId) + sizeof(keyLength) > endPosition) {
+            return 0;
+        }
+        Extract(data, rowId);
+        Extract(data, keyLength);
+        data += keyLength;
+        if (data + sizeof(rowLength) > endPosition) {
+            return 0;
+        }
+        Extract(data, rowLength);
+        data += rowLength;
+    } else {
+        if (data + sizeof(keyLength) > endPosition) {
+            return 0;
+        }
+        Extract(data, keyLength);
+        data += keyLength + sizeof(version);
+    }
+
+    if (opCode == UPDATE_ROW) {
+        if (metaVersion >= MetadataProtoVersion::METADATA_VER_IDX_COL_UPD) {
+            data += sizeof(bool);
+        }
+        uint16_t numColumns = table->GetFieldCount() - 1;
+        uint16_t bitmapLength = BitmapSet::GetLength(numColumns);
+        if (data + 2 * bitmapLength > endPosition) {
+            return 0;
+        }
+        BitmapSet updatedColumns(ExtractPtr(data, bitmapLength), numColumns);
+        BitmapSet validColumns(ExtractPtr(data, bitmapLength), numColumns);
+        for (uint16_t i = 0; i < numColumns; i++) {
+            if (updatedColumns.GetBit(i) && validColumns.GetBit(i)) {
+                data += table->GetFieldSize(i + 1);
+            }
+        }
+    }
+
+    if (data > endPosition) {
+        return 0;
+    }
+    return (uint32_t)(data - start);
+}
 }  // namespace MOT
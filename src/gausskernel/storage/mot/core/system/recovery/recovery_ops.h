@@ -103,6 +103,16 @@ public:
      */
     static RC BeginTransaction(IRecoveryOpsContext* ctx, uint64_t replayLsn = 0);
 
+    /**
+     * @brief Retrieves the table of a row operation without replaying it.
+     * @param data the buffer of the operation.
+     * @param endPosition the end of the operations buffer.
+     * @param[out] table the table of the operation.
+     * @return Int value denoting the number of bytes of the operation, or zero if this is not a row
+     * operation, its table does not exist, or the operation exceeds the buffer.
+     */
+    static uint32_t GetLogOperationTable(uint8_t* data, const uint8_t* endPosition, Table*& table);
+
 private:
     /**
      * @brief performs an insert operation of a data buffer.
@@ -73,6 +73,8 @@ void RedoLogTransactionPlayer::InitRedoTransactionData(
     m_csn = csn;
     m_replayLsn = replayLsn;
     m_retried = false;
+    m_partitioned = false;
+    m_numFences = 0;
     m_txn->SetTransactionId(externalId);
     m_txn->SetInternalTransactionId(transactionId);
     m_txn->SetReplayLsn(replayLsn);
@@ -139,6 +139,63 @@ public:
         return m_numSegs;
     }
 
+    /**
+     * @brief Marks the transaction as replayed and committed by the processor of its partition, instead of
+     * the committer.
+     * @param numFences The number of other partitions that the transaction touches.
+     */
+    inline void SetPartitioned(uint32_t numFences)
+    {
+        m_partitioned = true;
+        m_numFences = numFences;
+        m_fencesArrived.store(0);
+        m_fencesDeparted.store(0);
+        m_fencesReleased.store(false);
+    }
+
+    inline bool IsPartitioned() const
+    {
+        return m_partitioned;
+    }
+
+    inline uint32_t GetNumFences() const
+    {
+        return m_numFences;
+    }
+
+    /** @brief Called by the processor of another partition once all its prior transactions are committed. */
+    inline void ArriveFence()
+    {
+        (void)m_fencesArrived.fetch_add(1);
+    }
+
+    inline bool AllFencesArrived() const
+    {
+        return m_fencesArrived.load() == m_numFences;
+    }
+
+    /** @brief Called by the owner processor once the transaction is committed, to release the other partitions. */
+    inline void ReleaseFences()
+    {
+        m_fencesReleased.store(true);
+    }
+
+    inline bool AreFencesReleased() const
+    {
+        return m_fencesReleased.load();
+    }
+
+    /** @brief Called by the processor of another partition once it no longer accesses the player. */
+    inline void DepartFence()
+    {
+        (void)m_fencesDeparted.fetch_add(1);
+    }
+
+    inline bool AllFencesDeparted() const
+    {
+        return m_fencesDeparted.load() == m_numFences;
+    }
+
     /**
      * @brief performs a redo on a segment, which is either a recovery op
      * or a segment that belongs to a 2pc recovered transaction.
@@ -164,6 +221,11 @@ private:
     volatile bool m_firstSegment;
     bool m_initialized;
     volatile bool m_retried = false;
+    bool m_partitioned = false;
+    uint32_t m_numFences = 0;
+    std::atomic<uint32_t> m_fencesArrived{0};
+    std::atomic<uint32_t> m_fencesDeparted{0};
+    std::atomic<bool> m_fencesReleased{false};
     IRecoveryManager* m_recoveryManager;
     SurrogateState* m_surrogateState;
     TxnManager* m_txn;
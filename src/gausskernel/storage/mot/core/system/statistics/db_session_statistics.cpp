@@ -26,6 +26,7 @@
 #include "mot_configuration.h"
 #include "config_manager.h"
 #include "statistics_manager.h"
+#include "mot_engine.h"
 #include "mot_error.h"
 
 namespace MOT {
@@ -41,7 +42,10 @@ DbSessionThreadStatistics::DbSessionThreadStatistics(uint64_t threadId, void* in
       m_commitTxnCount(MakeName("commit-txn", threadId).c_str()),
       m_rollbackTxnCount(MakeName("rollback-txn", threadId).c_str()),
       m_commitPreparedTxnCount(MakeName("commit-prepared-txn", threadId).c_str()),
-      m_rollbackPreparedTxnCount(MakeName("rollback-prepared-txn", threadId).c_str())
+      m_rollbackPreparedTxnCount(MakeName("rollback-prepared-txn", threadId).c_str()),
+      m_validationWaitTxnCount(MakeName("validation-wait-txn", threadId).c_str()),
+      m_coldRowEvictCount(MakeName("cold-row-evict", threadId).c_str()),
+      m_coldRowFaultInCount(MakeName("cold-row-fault-in", threadId).c_str())
 {
     RegisterStatistics(&m_txnCount);
     RegisterStatistics(&m_rowPerTxnCount);
@@ -52,6 +56,9 @@ DbSessionThreadStatistics::DbSessionThreadStatistics(uint64_t threadId, void* in
     RegisterStatistics(&m_rollbackTxnCount);
     RegisterStatistics(&m_commitPreparedTxnCount);
     RegisterStatistics(&m_rollbackPreparedTxnCount);
+    RegisterStatistics(&m_validationWaitTxnCount);
+    RegisterStatistics(&m_coldRowEvictCount);
+    RegisterStatistics(&m_coldRowFaultInCount);
 }
 
 TypedStatisticsGenerator<DbSessionThreadStatistics, EmptyGlobalStatistics> DbSessionStatisticsProvider::m_generator;
@@ -129,4 +136,11 @@ void DbSessionStatisticsProvider::OnConfigChange()
         }
     }
 }
+
+void DbSessionStatisticsProvider::PrintStatisticsEx()
+{
+    if (GetGlobalConfiguration().m_enableAdaptiveValidation) {
+        GetTableManager()->PrintTableContention();
+    }
+}
 }  // namespace MOT
@@ -103,6 +103,24 @@ public:
         m_rollbackPreparedTxnCount.AddSample();
     }
 
+    /** @brief Updates the validation-waiting-transaction count statistics. */
+    inline void AddValidationWaitTxnCount()
+    {
+        m_validationWaitTxnCount.AddSample();
+    }
+
+    /** @brief Updates the evicted-row count statistics. */
+    inline void AddColdRowEvictCount()
+    {
+        m_coldRowEvictCount.AddSample();
+    }
+
+    /** @brief Updates the faulted-in-row count statistics. */
+    inline void AddColdRowFaultInCount()
+    {
+        m_coldRowFaultInCount.AddSample();
+    }
+
 private:
     /** @var The transaction count statistic variable. */
     FrequencyStatisticVariable m_txnCount;
@@ -130,6 +148,15 @@ private:
 
     /** @var The rolled-back-prepared-transaction count statistic variable. */
     FrequencyStatisticVariable m_rollbackPreparedTxnCount;
+
+    /** @var The count of transactions that waited for row locks during validation (contended tables). */
+    FrequencyStatisticVariable m_validationWaitTxnCount;
+
+    /** @var The count of rows evicted to the cold row store. */
+    FrequencyStatisticVariable m_coldRowEvictCount;
+
+    /** @var The count of evicted rows loaded back from the cold row store. */
+    FrequencyStatisticVariable m_coldRowFaultInCount;
 };
 
 /**
@@ -235,12 +262,43 @@ public:
         }
     }
 
+    /** @brief Records a transaction that waits for row locks during validation. */
+    inline void AddValidationWaitTxn()
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddValidationWaitTxnCount();
+        }
+    }
+
+    /** @brief Records a row eviction to the cold row store. */
+    inline void AddColdRowEvict()
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddColdRowEvictCount();
+        }
+    }
+
+    /** @brief Records an evicted row loaded back from the cold row store. */
+    inline void AddColdRowFaultIn()
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddColdRowFaultInCount();
+        }
+    }
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
      */
     void OnConfigChange() override;
 
+protected:
+    /** @brief Prints the validation abort rate of the contended tables. */
+    void PrintStatisticsEx() override;
+
 private:
     /** @brief Constructor. */
     DbSessionStatisticsProvider();
@@ -480,6 +480,13 @@ Access* TxnAccess::GetNewRowAccess(Sentinel* const& originalSentinel, AccessType
         return nullptr;
     }
 
+    // Keep the row in memory, and load it now if it was evicted, so a failure is not mistaken for an invisible row
+    ps->MarkAccessed();
+    if (unlikely(ps->IsEvicted()) && ps->GetData() == nullptr) {
+        rc = RC::RC_MEMORY_ALLOCATION_ERROR;
+        return nullptr;
+    }
+
     // Extract the visible row MVCC!
     Row* row = GetVisibleRow(ps, type, rc);
     if (row == nullptr) {
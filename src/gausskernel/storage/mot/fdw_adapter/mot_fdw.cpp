@@ -69,6 +69,7 @@
 #include "postmaster/bgwriter.h"
 #include "storage/lmgr.h"
 #include "storage/ipc.h"
+#include "vecexecutor/vecnodes.h"
 
 #include "mot_internal.h"
 #include "mot_fdw_helpers.h"
@@ -104,6 +105,7 @@ static const struct MOTFdwOption valid_options[] = {
     {"null", ForeignTableRelationId},
     {"encoding", ForeignTableRelationId},
     {"force_not_null", AttributeRelationId},
+    {"index_method", ForeignTableRelationId},
 
     /* Sentinel */
     {NULL, InvalidOid}};
@@ -127,6 +129,7 @@ static ForeignScan* MOTGetForeignPlan(PlannerInfo* root, RelOptInfo* baserel, Oi
 static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es);
 static void MOTBeginForeignScan(ForeignScanState* node, int eflags);
 static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node);
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node);
 static void MOTReScanForeignScan(ForeignScanState* node);
 static void MOTEndForeignScan(ForeignScanState* node);
 static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRte, Relation targetRelation);
@@ -274,6 +277,7 @@ Datum mot_fdw_handler(PG_FUNCTION_ARGS)
     fdwroutine->ExplainForeignScan = MOTExplainForeignScan;
     fdwroutine->BeginForeignScan = MOTBeginForeignScan;
     fdwroutine->IterateForeignScan = MOTIterateForeignScan;
+    fdwroutine->VecIterateForeignScan = MOTVecIterateForeignScan;
     fdwroutine->ReScanForeignScan = MOTReScanForeignScan;
     fdwroutine->EndForeignScan = MOTEndForeignScan;
     fdwroutine->AnalyzeForeignTable = MOTAnalyzeForeignTable;
@@ -371,6 +375,16 @@ Datum mot_fdw_validator(PG_FUNCTION_ARGS)
                     buf.len > 0 ? errhint("Valid options in this context are: %s", buf.data)
                                 : errhint("There are no valid options in this context.")));
         }
+
+        if (strcmp(def->defname, "index_method") == 0) {
+            char* value = defGetString(def);
+            if (pg_strcasecmp(value, "tree") != 0 && pg_strcasecmp(value, "hash") != 0) {
+                ereport(ERROR,
+                    (errcode(ERRCODE_FDW_INVALID_ATTRIBUTE_VALUE),
+                        errmsg("invalid value \"%s\" for option \"index_method\"", value),
+                        errhint("Valid values are: tree, hash")));
+            }
+        }
     }
 
     /*
@@ -578,7 +592,9 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
             list_free(usablePathkeys);
             usablePathkeys = nullptr;
         }
-    } else if (list_length(root->query_pathkeys) > 0) {
+    } else if (list_length(root->query_pathkeys) > 0 &&
+               pix->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        // full scan follows the primary index order, unless it is a hash index
         OrderSt ord;
         ord.init();
         List* keys;
@@ -723,9 +739,12 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
                     best->m_ix = six;
                     best->m_fullScan = true;
                     best->m_ixPosition = pos;
+                    // hash index full scan is unordered
+                    bool ordered = (six->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_HASH);
                     foreach (lcp, ip->path.pathkeys) {
                         PathKey* pathkey = (PathKey*)lfirst(lcp);
-                        if (!pathkey->pk_eclass->ec_has_volatile && IsOrderingApplicable(pathkey, baserel, six, &ord)) {
+                        if (ordered && !pathkey->pk_eclass->ec_has_volatile &&
+                            IsOrderingApplicable(pathkey, baserel, six, &ord)) {
                             usablePathkeys = lappend(usablePathkeys, pathkey);
                         }
                     }
@@ -1032,8 +1051,34 @@ static void MOTBeginForeignModify(
     festate->m_currTxn->SetIsolationLevel(u_sess->utils_cxt.XactIsoLevel);
 }
 
-static TupleTableSlot* IterateForeignScanStopAtFirst(
-    ForeignScanState* node, MOTFdwStateSt* festate, TupleTableSlot* slot)
+static void ReportRowLookupError(MOTFdwStateSt* festate, MOT::RC rc)
+{
+    if (rc == MOT::RC_ABORT) {
+        abortParentTransactionParamsNoDetail(ERRCODE_T_R_SERIALIZATION_FAILURE,
+            "Commit: could not serialize access due to concurrent update(%d)",
+            0);
+        return;
+    }
+    if (MOT_IS_SEVERE()) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTIterateForeignScan", "Failed to lookup row");
+        MOT_LOG_ERROR_STACK("Failed to lookup row");
+    }
+    CleanQueryStatesOnError(festate->m_currTxn);
+    report_pg_error(rc,
+        (void*)(festate->m_currTxn->m_errIx != nullptr ? festate->m_currTxn->m_errIx->GetName().c_str() : "unknown"),
+        (void*)festate->m_currTxn->m_errMsgBuf);
+}
+
+inline bool IsScanStopAtFirst(MOTFdwStateSt* festate)
+{
+    return (festate->m_bestIx && festate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
+            festate->m_bestIx->m_ix->GetUnique() == true);
+}
+
+/*
+ * Looks up the single row of an exact unique key scan.
+ */
+static MOT::Row* LookupFirstRow(ForeignScanState* node, MOTFdwStateSt* festate)
 {
     MOT::RC rc = MOT::RC_OK;
     ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
@@ -1043,68 +1088,18 @@ static TupleTableSlot* IterateForeignScanStopAtFirst(
     MOT::Sentinel* sentinel =
         festate->m_bestIx->m_ix->IndexReadSentinel(&festate->m_stateKey[0], festate->m_currTxn->GetThdId());
     MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, sentinel, rc);
-
-    if (currRow != NULL) {
-        MOTAdaptor::UnpackRow(slot, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
-        node->ss.is_scan_end = true;
-        fscan->scan.scan_qual_optimized = true;
-        (void)ExecStoreVirtualTuple(slot);
-        if (festate->m_ctidNum > 0) {
-            HeapTuple resultTup = ExecFetchSlotTuple(slot);
-            MOTRecConvertSt cv;
-            cv.m_u.m_ptr = (uint64_t)currRow->GetPrimarySentinel();
-            resultTup->t_self = cv.m_u.m_self;
-            HeapTupleSetXmin(resultTup, InvalidTransactionId);
-            HeapTupleSetXmax(resultTup, InvalidTransactionId);
-            HeapTupleHeaderSetCmin(resultTup->t_data, InvalidTransactionId);
-        }
-        festate->m_rowsFound++;
-        return slot;
+    if (currRow == nullptr && rc != MOT::RC_OK) {
+        ReportRowLookupError(festate, rc);
     }
-    if (rc != MOT::RC_OK) {
-        if (rc == MOT::RC_ABORT) {
-            abortParentTransactionParamsNoDetail(ERRCODE_T_R_SERIALIZATION_FAILURE,
-                "Commit: could not serialize access due to concurrent update(%d)",
-                0);
-            return nullptr;
-        }
-        if (MOT_IS_SEVERE()) {
-            MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTIterateForeignScan", "Failed to lookup row");
-            MOT_LOG_ERROR_STACK("Failed to lookup row");
-        }
-        CleanQueryStatesOnError(festate->m_currTxn);
-        report_pg_error(rc,
-            (void*)(festate->m_currTxn->m_errIx != nullptr ? festate->m_currTxn->m_errIx->GetName().c_str()
-                                                           : "unknown"),
-            (void*)festate->m_currTxn->m_errMsgBuf);
-        return nullptr;
-    }
-    return nullptr;
+    return currRow;
 }
 
 /*
- * Iterates to fetch the next row or null to indicate the end of the scan.
+ * Fetches the next row of a cursor scan, or null at the end of the scan.
  */
-static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
+static MOT::Row* FetchNextRow(ForeignScanState* node, MOTFdwStateSt* festate)
 {
     MOT::RC rc = MOT::RC_OK;
-    if (node->ss.is_scan_end) {
-        return nullptr;
-    }
-
-    MOT::Row* currRow = nullptr;
-    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
-    TupleTableSlot* slot = node->ss.ss_ScanTupleSlot;
-    bool found = false;
-    bool stopAtFirst = (festate->m_bestIx && festate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
-                        festate->m_bestIx->m_ix->GetUnique() == true);
-
-    (void)ExecClearTuple(slot);
-
-    if (stopAtFirst) {
-        return IterateForeignScanStopAtFirst(node, festate, slot);
-    }
-
     if (!festate->m_cursorOpened) {
         ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
         festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
@@ -1114,18 +1109,7 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
 
         festate->m_cursorOpened = true;
     }
-    /*
-     * The protocol for loading a virtual tuple into a slot is first
-     * ExecClearTuple, then fill the values/isnull arrays, then
-     * ExecStoreVirtualTuple.  If we don't find another row in the file, we
-     * just skip the last step, leaving the slot empty as required.
-     *
-     * We can pass ExprContext = NULL because we read all columns from the
-     * file, so no need to evaluate default expressions.
-     *
-     * We can also pass tupleOid = NULL because we don't allow oids for
-     * foreign tables.
-     */
+
     // festate->cursor[1] might be NULL (in case it is not in use)
     if (festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid() ||
         (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid())) {
@@ -1134,26 +1118,11 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
 
     do {
         MOT::Sentinel* sentinel = festate->m_cursor[0]->GetPrimarySentinel();
-        currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, sentinel, rc);
-        if (currRow == NULL) {
+        MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, sentinel, rc);
+        if (currRow == nullptr) {
             if (rc != MOT::RC_OK) {
-                if (rc == MOT::RC_ABORT) {
-                    abortParentTransactionParamsNoDetail(ERRCODE_T_R_SERIALIZATION_FAILURE,
-                        "Commit: could not serialize access due to concurrent update(%d)",
-                        0);
-                    return NULL;
-                }
-                if (MOT_IS_SEVERE()) {
-                    MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTIterateForeignScan", "Failed to lookup row");
-                    MOT_LOG_ERROR_STACK("Failed to lookup row");
-                }
-
-                CleanQueryStatesOnError(festate->m_currTxn);
-                report_pg_error(rc,
-                    (void*)(festate->m_currTxn->m_errIx != NULL ? festate->m_currTxn->m_errIx->GetName().c_str()
-                                                                : "unknown"),
-                    (void*)festate->m_currTxn->m_errMsgBuf);
-                return NULL;
+                ReportRowLookupError(festate, rc);
+                return nullptr;
             }
             festate->m_cursor[0]->Next();
             continue;
@@ -1163,33 +1132,116 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
         if (MOTAdaptor::IsScanEnd(festate)) {
             festate->m_cursor[0]->Invalidate();
             node->ss.is_scan_end = true;
-            break;
+            return nullptr;
         }
 
-        MOTAdaptor::UnpackRow(slot, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
-        found = true;
-
         festate->m_cursor[0]->Next();
-        break;
+        return currRow;
     } while (festate->m_cursor[0]->IsValid());
 
-    if (found) {
-        (void)ExecStoreVirtualTuple(slot);
+    return nullptr;
+}
+
+/*
+ * Loads a row into the scan slot.
+ */
+static TupleTableSlot* StoreScanRow(MOTFdwStateSt* festate, TupleTableSlot* slot, MOT::Row* currRow)
+{
+    /*
+     * The protocol for loading a virtual tuple into a slot is first
+     * ExecClearTuple, then fill the values/isnull arrays, then
+     * ExecStoreVirtualTuple.
+     *
+     * We can pass ExprContext = NULL because we read all columns from the
+     * file, so no need to evaluate default expressions.
+     *
+     * We can also pass tupleOid = NULL because we don't allow oids for
+     * foreign tables.
+     */
+    MOTAdaptor::UnpackRow(slot, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
+    (void)ExecStoreVirtualTuple(slot);
+    if (festate->m_ctidNum > 0) {
+        HeapTuple resultTup = ExecFetchSlotTuple(slot);
+        MOTRecConvertSt cv;
+        cv.m_u.m_ptr = (uint64_t)currRow->GetPrimarySentinel();
+        resultTup->t_self = cv.m_u.m_self;
+        HeapTupleSetXmin(resultTup, InvalidTransactionId);
+        HeapTupleSetXmax(resultTup, InvalidTransactionId);
+        HeapTupleHeaderSetCmin(resultTup->t_data, InvalidTransactionId);
+    }
+    festate->m_rowsFound++;
+    return slot;
+}
+
+/*
+ * Iterates to fetch the next row or null to indicate the end of the scan.
+ */
+static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
+{
+    if (node->ss.is_scan_end) {
+        return nullptr;
+    }
+
+    MOT::Row* currRow = nullptr;
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    TupleTableSlot* slot = node->ss.ss_ScanTupleSlot;
 
-        if (festate->m_ctidNum > 0) {
-            HeapTuple resultTup = ExecFetchSlotTuple(slot);
-            MOTRecConvertSt cv;
-            cv.m_u.m_ptr = (uint64_t)currRow->GetPrimarySentinel();
-            resultTup->t_self = cv.m_u.m_self;
-            HeapTupleSetXmin(resultTup, InvalidTransactionId);
-            HeapTupleSetXmax(resultTup, InvalidTransactionId);
-            HeapTupleHeaderSetCmin(resultTup->t_data, InvalidTransactionId);
+    (void)ExecClearTuple(slot);
+
+    if (IsScanStopAtFirst(festate)) {
+        currRow = LookupFirstRow(node, festate);
+        if (currRow == nullptr) {
+            return nullptr;
         }
-        festate->m_rowsFound++;
-        return slot;
+        node->ss.is_scan_end = true;
+        ((ForeignScan*)node->ss.ps.plan)->scan.scan_qual_optimized = true;
     } else {
-        return nullptr;
+        currRow = FetchNextRow(node, festate);
+        if (currRow == nullptr) {
+            return nullptr;
+        }
+    }
+    return StoreScanRow(festate, slot, currRow);
+}
+
+/*
+ * Iterates to fetch the next batch of rows directly into column vectors, or an empty batch to indicate the end of
+ * the scan. Index conditions are applied by the cursor as in the row scan, other conditions are evaluated on the
+ * batch by the vectorized executor.
+ */
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node)
+{
+    VectorBatch* batch = node->m_pScanBatch;
+    batch->Reset(true);
+    if (node->ss.is_scan_end) {
+        return batch;
     }
+
+    MOT::Row* currRow = nullptr;
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    TupleDesc tupdesc = RelationGetDescr(node->ss.ss_currentRelation);
+
+    if (IsScanStopAtFirst(festate)) {
+        currRow = LookupFirstRow(node, festate);
+        node->ss.is_scan_end = true;
+        if (currRow != nullptr) {
+            MOTAdaptor::UnpackRowToBatch(
+                batch, tupdesc, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
+            festate->m_rowsFound++;
+        }
+        return batch;
+    }
+
+    while (batch->m_rows < BatchMaxSize) {
+        currRow = FetchNextRow(node, festate);
+        if (currRow == nullptr) {
+            break;
+        }
+        MOTAdaptor::UnpackRowToBatch(
+            batch, tupdesc, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
+        festate->m_rowsFound++;
+    }
+    return batch;
 }
 
 /*
@@ -1202,8 +1254,7 @@ static void MOTReScanForeignScan(ForeignScanState* node)
     if (IsTxnInAbortState(txn)) {
         raiseAbortTxnError();
     }
-    bool stopAtFirst = (festate->m_bestIx && festate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
-                        festate->m_bestIx->m_ix->GetUnique() == true);
+    bool stopAtFirst = IsScanStopAtFirst(festate);
 
     node->ss.is_scan_end = false;
 
@@ -1962,6 +2013,8 @@ static void MOTCheckpointCallback(CheckpointEvent checkpointEvent, uint64_t lsn,
             break;
         case EVENT_CHECKPOINT_BEGIN_CHECKPOINT:
             status = engine->BeginCheckpoint();
+            // the JIT warm-up records are written by the checkpointer, out of the query path
+            JitExec::FlushJitWarmup();
             break;
         case EVENT_CHECKPOINT_ABORT:
             status = engine->AbortCheckpoint();
@@ -2304,6 +2357,32 @@ bool MOTCheckpointExists(
     return true;
 }
 
+bool MOTCheckpointChainDir(uint32_t index, char* checkpointDir, size_t checkpointLen)
+{
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    if (engine == nullptr || engine->GetCheckpointManager() == nullptr) {
+        return false;
+    }
+
+    MOT::CheckpointManager* checkpointManager = engine->GetCheckpointManager();
+    std::vector<std::string> dirNames;
+    checkpointManager->GetDeltaChainDirNames(dirNames);
+    if (index >= dirNames.size()) {
+        return false;
+    }
+
+    std::string workingDir;
+    if (checkpointManager->GetCheckpointWorkingDir(workingDir) == false) {
+        ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmodule(MOD_MOT), errmsg("Failed to obtain working dir")));
+        return false;
+    }
+
+    errno_t rc = snprintf_s(
+        checkpointDir, checkpointLen, checkpointLen - 1, "%s%s", workingDir.c_str(), dirNames[index].c_str());
+    securec_check_ss(rc, "", "");
+    return true;
+}
+
 bool MOTValidateLogLevel(const char* logLevelStr)
 {
     return MOT::ValidateLogLevel(logLevelStr);
@@ -39,8 +39,11 @@
 #include "executor/executor.h"
 #include "storage/ipc.h"
 #include "commands/dbcommands.h"
+#include "commands/defrem.h"
+#include "foreign/foreign.h"
 #include "knl/knl_session.h"
 #include "utils/date.h"
+#include "vecexecutor/vectorbatch.h"
 
 #include "mot_internal.h"
 #include "mot_fdw_helpers.h"
@@ -905,6 +908,23 @@ static void ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::TxnMana
     }
 }
 
+/*
+ * Checks whether the index_method option of the MOT table asks for hash indexes.
+ */
+static bool IsHashIndexingMethod(Oid foreignOid)
+{
+    ForeignTable* ftable = GetForeignTable(foreignOid);
+    ListCell* lc = nullptr;
+
+    foreach (lc, ftable->options) {
+        DefElem* def = (DefElem*)lfirst(lc);
+        if (strcmp(def->defname, "index_method") == 0) {
+            return (pg_strcasecmp(defGetString(def), "hash") == 0);
+        }
+    }
+    return false;
+}
+
 MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
 {
     MOT::RC res;
@@ -921,6 +941,7 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
         return MOT::RC_ERROR;
     }
 
+    bool useHash = IsHashIndexingMethod(stmt->relation->foreignOid);
     table->GetOrigTable()->WrLock();
 
     PG_TRY();
@@ -957,6 +978,11 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
         }
     }
 
+    // Hash indexes serve exact lookups only, so non-unique indexes (always scanned by prefix) stay trees
+    if (useHash && index_order != MOT::IndexOrder::INDEX_ORDER_SECONDARY) {
+        indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+    }
+
     index = MOT::IndexFactory::CreateIndex(index_order, indexing_method, flavor);
     if (index == nullptr) {
         table->GetOrigTable()->Unlock();
@@ -1994,6 +2020,30 @@ void MOTAdaptor::UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_
     }
 }
 
+void MOTAdaptor::UnpackRowToBatch(
+    VectorBatch* batch, TupleDesc tupdesc, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow)
+{
+    int row = batch->m_rows;
+    for (int i = 0; i < batch->m_cols; i++) {
+        ScalarVector* vec = &(batch->m_arr[i]);
+        Datum value = PointerGetDatum(nullptr);
+        bool isNull = true;
+        if (BITMAP_GET(attrs_used, i)) {
+            MOTToDatum(table, tupdesc->attrs[i], srcRow, &value, &isNull);
+        }
+        if (isNull) {
+            vec->SetNull(row);
+        } else if (vec->m_desc.encoded) {
+            // the vector keeps its own copy, the converted value is released with the per-batch memory context
+            (void)vec->AddVar(value, row);
+        } else {
+            vec->m_vals[row] = value;
+        }
+        vec->m_rows++;
+    }
+    batch->m_rows++;
+}
+
 // useful functions for data conversion: utils/fmgr/gmgr.cpp
 void MOTAdaptor::MOTToDatum(MOT::Table* table, const Form_pg_attribute attr, uint8_t* data, Datum* value, bool* is_null)
 {
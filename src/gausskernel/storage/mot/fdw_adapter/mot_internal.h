@@ -570,6 +570,17 @@ public:
      */
     static void UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
 
+    /**
+     * @brief Performs conversion of MOT row to the next row of a vector batch.
+     * @param batch PG vector batch
+     * @param tupdesc PG row descriptor
+     * @param table MOT table
+     * @param attrs_used bitmap indicating which columns should be converted
+     * @parma srcRow MOT data holder for a row
+     */
+    static void UnpackRowToBatch(
+        VectorBatch* batch, TupleDesc tupdesc, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
+
     /**
      * @brief Performs open of scan cursors for a query.
      * @param rel PG table
@@ -375,6 +375,12 @@ double MatchIndex::GetCost(int numClauses)
         return INT_MAX;
     }
 
+    // hash index can serve only an exact lookup on the full unique key
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH &&
+        (m_end != -1 || m_ixOpers[m_start] != KEY_OPER::READ_KEY_EXACT)) {
+        return INT_MAX;
+    }
+
     return m_cost;
 }
 
@@ -409,6 +415,11 @@ bool MatchIndex::CanApplyOrdering(const int* orderCols) const
 {
     int16_t numKeyCols = m_ix->GetNumFields();
 
+    // hash index is unordered
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        return false;
+    }
+
     // check if order columns are overlap index matched columns or are suffix for it
     for (int16_t i = 0; i < numKeyCols; i++) {
         // overlap: we can use index ordering
@@ -55,6 +55,7 @@
 #include "jit_plan.h"
 #include "jit_plan_sp.h"
 #include "jit_statistics.h"
+#include "jit_warmup.h"
 
 #include "mot_engine.h"
 #include "utilities.h"
@@ -878,7 +879,8 @@ extern MotJitContext* JitCodegenQuery(Query* query, const char* queryString, Jit
     return (MotJitContext*)result;
 }
 
-extern MotJitContext* TryJitCodegenQuery(Query* query, const char* queryString)
+extern MotJitContext* TryJitCodegenQuery(
+    Query* query, const char* queryString, const Oid* paramTypes /* = nullptr */, int paramCount /* = 0 */)
 {
     MotJitContext* jitContext = nullptr;
 
@@ -898,6 +900,8 @@ extern MotJitContext* TryJitCodegenQuery(Query* query, const char* queryString)
         jitContext = JitCodegenQuery(query, queryString, jitPlan, JIT_CONTEXT_LOCAL);
         if (jitContext == nullptr) {
             MOT_LOG_TRACE("Failed to generate jitted MOT code for query: %s", queryString);
+        } else {
+            RecordJitWarmupQuery(query, queryString, paramTypes, paramCount);
         }
         JitDestroyPlan(jitPlan);
     }
@@ -2044,6 +2048,7 @@ static void JitDDLCallback(uint64_t relationId, MOT::DDLAccessType event, MOT::T
         case MOT::DDL_ACCESS_DROP_COLUMN:
         case MOT::DDL_ACCESS_RENAME_COLUMN:
             PurgeJitSourceCache(relationId, JIT_PURGE_SCOPE_QUERY, JIT_PURGE_EXPIRE, nullptr);
+            PurgeJitWarmup(relationId);
             break;
 
         case MOT::DDL_ACCESS_CREATE_TABLE:
@@ -2167,6 +2172,15 @@ extern bool JitInitialize()
                 GetMotCodegenLimit());
             break;
         }
+
+        // load the queries recorded by previous runs
+        result = InitJitWarmup();
+        if (!result) {
+            MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "JIT Initialization", "Failed to initialize JIT warm-up list");
+            DestroyJitSourceMap();
+            break;
+        }
+
         MOT::MOTEngine::GetInstance()->SetDDLCallback(JitDDLCallback);
         // when no DDL was issued, but only SP REPLACE/DROP, we are still missing commit/rollback notification, so we
         // need to register a callback for that. This takes place in each session (see PrepareSessionAccess() above).
@@ -2197,6 +2211,7 @@ extern bool JitInitialize()
 extern void JitDestroy()
 {
     MOT::MOTEngine::GetInstance()->SetDDLCallback(nullptr);
+    DestroyJitWarmup();
     DestroyJitSourceMap();
     DestroyJitSourcePool();
     DestroyGlobalJitContextPool();
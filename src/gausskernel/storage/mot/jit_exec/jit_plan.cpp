@@ -286,6 +286,11 @@ static bool prepareRangeSearchExpressions(
             if (index_scan->_scan_type == JIT_INDEX_SCAN_TYPE_INVALID) {
                 MOT_LOG_TRACE("prepareRangeSearchExpressions(): Disqualifying query - invalid range scan type");
                 result = false;
+            } else if (index->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH &&
+                       index_scan->_scan_type != JIT_INDEX_SCAN_POINT) {
+                // hash indexes are unordered, they can only serve exact lookups
+                MOT_LOG_TRACE("prepareRangeSearchExpressions(): Disqualifying query - range scan on hash index");
+                result = false;
             }
         }
     }
@@ -0,0 +1,606 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * jit_warmup.cpp
+ *    Persistent list of jitted queries, compiled again ahead of first use after restart.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/jit_exec/jit_warmup.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "libintl.h"
+#include "postgres.h"
+#include "access/xact.h"
+#include "knl/knl_session.h"
+#include "nodes/parsenodes.h"
+#include "nodes/pg_list.h"
+#include "tcop/tcopprot.h"
+#include "utils/memutils.h"
+#include "utils/snapmgr.h"
+#include "storage/mot/jit_exec.h"
+
+#include "global.h"
+#include "jit_warmup.h"
+#include "utilities.h"
+#include "mot_configuration.h"
+#include "mot_error.h"
+#include "cycles.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// JIT Warm-up:
+// ===========
+// The generated code embeds the addresses of helper functions and of table/index objects, so it cannot be reused by
+// another process. Instead, the text of every jitted query is recorded on disk together with its parameter types and
+// the relations it refers, and after restart the recorded queries of each database are analyzed and compiled again by
+// the first session that opens that database, before it serves any query. Queries prepared concurrently by other
+// sessions find the JIT source being compiled and wait for it (or use a dummy context), as they would with any other
+// pending source. Stored procedures are covered through their invoke queries, which compile the invoked stored
+// procedure. Since all queries are analyzed again against the current catalog, schema changes made while the process
+// was down cannot lead to stale code. Queries that no longer parse, refer to other relations or fail to compile are
+// removed.
+// Recording a query only buffers its record in memory. The buffered records (or the entire list, after removals) are
+// written to the file on checkpoint and on shutdown, so the file I/O is kept out of the query path.
+
+namespace JitExec {
+DECLARE_LOGGER(JitWarmup, JitExec)
+
+/** @define Name of the warm-up file, under the data directory. */
+#define MOT_JIT_WARMUP_FILE_NAME "mot_jit_warmup"
+
+/** @define Magic number of a warm-up record. */
+#define MOT_JIT_WARMUP_MAGIC 0x4A495457u
+
+/** @struct Header of a warm-up record, followed by parameter types, relation identifiers and query string. */
+struct JitWarmupRecordHeader {
+    /** @var Record magic number. */
+    uint32_t m_magic;
+
+    /** @var The database identifier. */
+    uint32_t m_databaseId;
+
+    /** @var The number of query parameters. */
+    uint32_t m_paramCount;
+
+    /** @var The number of referred relations. */
+    uint32_t m_relationCount;
+
+    /** @var The query string length (not including terminating null). */
+    uint32_t m_queryLength;
+};
+
+/** @struct Recorded query attributes. */
+struct JitWarmupEntry {
+    /** @var The query parameter types. */
+    std::vector<Oid> m_paramTypes;
+
+    /** @var The external identifiers of the referred relations, in range table order. */
+    std::vector<Oid> m_relationIds;
+};
+
+/** @typedef Recorded query key (database identifier and query string). */
+using JitWarmupKey = std::pair<Oid, std::string>;
+
+/** @typedef Map of recorded queries. */
+using JitWarmupMap = std::map<JitWarmupKey, JitWarmupEntry>;
+
+/** @struct Global JIT warm-up list. */
+struct JitWarmupList {
+    /** @var Synchronize list access. */
+    pthread_mutex_t m_lock;
+
+    /** @var Serializes flushing the warm-up file, which is done outside the list lock. */
+    pthread_mutex_t m_fileLock;
+
+    /** @var Initialization flag. */
+    bool m_initialized = false;
+
+    /** @var The warm-up file path. */
+    std::string m_fileName;
+
+    /** @var The recorded queries. */
+    JitWarmupMap m_entries;
+
+    /** @var The databases already warmed-up (or being warmed-up) by this process. */
+    std::set<Oid> m_warmDatabases;
+
+    /** @var Serialized records of the queries recorded since the last flush. */
+    std::string m_pendingRecords;
+
+    /** @var Specifies whether queries were removed since the last flush, so the file needs to be rewritten. */
+    bool m_rewritePending = false;
+};
+
+// Global variables
+static JitWarmupList g_jitWarmup;
+
+static bool LoadJitWarmupFile();
+static bool SerializeJitWarmupEntries(std::string& buffer);
+static bool RewriteJitWarmupFile(const std::string& buffer);
+static bool AppendJitWarmupRecords(const std::string& buffer);
+static bool SerializeJitWarmupRecord(const JitWarmupKey& key, const JitWarmupEntry& entry, std::string& buffer);
+static bool WriteFully(int fd, const char* buffer, size_t length);
+static void WarmupJitSources(Oid databaseId, JitWarmupMap& entries);
+static bool WarmupJitQuery(const JitWarmupKey& key, JitWarmupEntry& entry);
+
+inline void CollectRelationIds(Query* query, std::vector<Oid>& relationIds)
+{
+    ListCell* lc = nullptr;
+    foreach (lc, query->rtable) {
+        RangeTblEntry* rte = (RangeTblEntry*)lfirst(lc);
+        if (rte->rtekind == RTE_RELATION) {
+            relationIds.push_back(rte->relid);
+        }
+    }
+}
+
+extern bool InitJitWarmup()
+{
+    if (!MOT::GetGlobalConfiguration().m_enableCodegenWarmup) {
+        return true;
+    }
+
+    char cwd[PATH_MAX] = {0};
+    if (getcwd(cwd, sizeof(cwd)) == nullptr) {
+        MOT_REPORT_SYSTEM_ERROR(getcwd, "JIT Initialization", "Failed to get current working directory");
+        return false;
+    }
+    (void)g_jitWarmup.m_fileName.assign(cwd).append("/" MOT_JIT_WARMUP_FILE_NAME);
+
+    int rc = pthread_mutex_init(&g_jitWarmup.m_lock, nullptr);
+    if (rc != 0) {
+        MOT_REPORT_SYSTEM_ERROR_CODE(
+            rc, pthread_mutex_init, "JIT Initialization", "Failed to initialize JIT warm-up list lock");
+        return false;
+    }
+    rc = pthread_mutex_init(&g_jitWarmup.m_fileLock, nullptr);
+    if (rc != 0) {
+        MOT_REPORT_SYSTEM_ERROR_CODE(
+            rc, pthread_mutex_init, "JIT Initialization", "Failed to initialize JIT warm-up file lock");
+        (void)pthread_mutex_destroy(&g_jitWarmup.m_lock);
+        return false;
+    }
+
+    // a warm-up file that cannot be read is not fatal, we just start with an empty list
+    g_jitWarmup.m_pendingRecords.clear();
+    g_jitWarmup.m_rewritePending = false;
+    if (!LoadJitWarmupFile()) {
+        MOT_LOG_WARN("Failed to load JIT warm-up file %s, starting with an empty list", g_jitWarmup.m_fileName.c_str());
+        g_jitWarmup.m_entries.clear();
+        (void)RewriteJitWarmupFile(std::string());
+    }
+    MOT_LOG_INFO("Loaded %u JIT warm-up queries", (unsigned)g_jitWarmup.m_entries.size());
+    g_jitWarmup.m_initialized = true;
+    return true;
+}
+
+extern void DestroyJitWarmup()
+{
+    if (g_jitWarmup.m_initialized) {
+        FlushJitWarmup();
+        g_jitWarmup.m_initialized = false;
+        g_jitWarmup.m_entries.clear();
+        g_jitWarmup.m_warmDatabases.clear();
+        g_jitWarmup.m_pendingRecords.clear();
+        (void)pthread_mutex_destroy(&g_jitWarmup.m_fileLock);
+        (void)pthread_mutex_destroy(&g_jitWarmup.m_lock);
+    }
+}
+
+extern void RecordJitWarmupQuery(Query* query, const char* queryString, const Oid* paramTypes, int paramCount)
+{
+    if (!g_jitWarmup.m_initialized || (paramCount > 0 && paramTypes == nullptr)) {
+        return;
+    }
+
+    JitWarmupKey key(u_sess->proc_cxt.MyDatabaseId, queryString);
+    (void)pthread_mutex_lock(&g_jitWarmup.m_lock);
+    if ((g_jitWarmup.m_entries.find(key) == g_jitWarmup.m_entries.end()) &&
+        (g_jitWarmup.m_entries.size() < GetMotCodegenLimit())) {
+        JitWarmupEntry entry;
+        entry.m_paramTypes.assign(paramTypes, paramTypes + paramCount);
+        CollectRelationIds(query, entry.m_relationIds);
+        if (SerializeJitWarmupRecord(key, entry, g_jitWarmup.m_pendingRecords)) {
+            (void)g_jitWarmup.m_entries.insert(JitWarmupMap::value_type(key, entry));
+            MOT_LOG_TRACE("Recorded JIT warm-up query: %s", queryString);
+        }
+    }
+    (void)pthread_mutex_unlock(&g_jitWarmup.m_lock);
+}
+
+extern void PurgeJitWarmup(uint64_t relationId)
+{
+    if (!g_jitWarmup.m_initialized) {
+        return;
+    }
+
+    uint32_t purgeCount = 0;
+    (void)pthread_mutex_lock(&g_jitWarmup.m_lock);
+    JitWarmupMap::iterator itr = g_jitWarmup.m_entries.begin();
+    while (itr != g_jitWarmup.m_entries.end()) {
+        const std::vector<Oid>& relationIds = itr->second.m_relationIds;
+        if (std::find(relationIds.begin(), relationIds.end(), (Oid)relationId) != relationIds.end()) {
+            itr = g_jitWarmup.m_entries.erase(itr);
+            ++purgeCount;
+        } else {
+            ++itr;
+        }
+    }
+    if (purgeCount > 0) {
+        g_jitWarmup.m_rewritePending = true;
+        g_jitWarmup.m_pendingRecords.clear();
+    }
+    (void)pthread_mutex_unlock(&g_jitWarmup.m_lock);
+
+    if (purgeCount > 0) {
+        MOT_LOG_TRACE("Purged %u JIT warm-up queries by relation %" PRIu64, purgeCount, relationId);
+    }
+}
+
+extern void FlushJitWarmup()
+{
+    if (!g_jitWarmup.m_initialized) {
+        return;
+    }
+
+    // only the buffer is taken under the list lock, so recording queries does not wait for the file I/O
+    std::string buffer;
+    bool rewrite = false;
+    bool result = true;
+    (void)pthread_mutex_lock(&g_jitWarmup.m_fileLock);
+    (void)pthread_mutex_lock(&g_jitWarmup.m_lock);
+    if (g_jitWarmup.m_rewritePending) {
+        rewrite = true;
+        result = SerializeJitWarmupEntries(buffer);
+        g_jitWarmup.m_rewritePending = !result;
+    } else {
+        buffer.swap(g_jitWarmup.m_pendingRecords);
+    }
+    g_jitWarmup.m_pendingRecords.clear();
+    (void)pthread_mutex_unlock(&g_jitWarmup.m_lock);
+
+    if (result && (rewrite || !buffer.empty())) {
+        result = rewrite ? RewriteJitWarmupFile(buffer) : AppendJitWarmupRecords(buffer);
+        if (!result) {
+            // the records are not lost, the entire list is written again on next flush
+            (void)pthread_mutex_lock(&g_jitWarmup.m_lock);
+            g_jitWarmup.m_rewritePending = true;
+            (void)pthread_mutex_unlock(&g_jitWarmup.m_lock);
+        }
+    }
+    (void)pthread_mutex_unlock(&g_jitWarmup.m_fileLock);
+
+    if (!result) {
+        MOT_LOG_WARN("Failed to flush JIT warm-up file %s", g_jitWarmup.m_fileName.c_str());
+    } else if (rewrite || !buffer.empty()) {
+        MOT_LOG_TRACE(
+            "Flushed JIT warm-up file %s (%s)", g_jitWarmup.m_fileName.c_str(), rewrite ? "rewrite" : "append");
+    }
+}
+
+extern void WarmupJitDatabase()
+{
+    if (!g_jitWarmup.m_initialized || !IsMotCodegenEnabled() || !IsMotQueryCodegenEnabled()) {
+        return;
+    }
+
+    // the database is marked first, so other sessions opening it do not warm it up again
+    Oid databaseId = u_sess->proc_cxt.MyDatabaseId;
+    JitWarmupMap entries;
+    (void)pthread_mutex_lock(&g_jitWarmup.m_lock);
+    if (g_jitWarmup.m_warmDatabases.insert(databaseId).second) {
+        JitWarmupMap::iterator itr = g_jitWarmup.m_entries.lower_bound(JitWarmupKey(databaseId, ""));
+        while ((itr != g_jitWarmup.m_entries.end()) && (itr->first.first == databaseId)) {
+            (void)entries.insert(*itr);
+            ++itr;
+        }
+    }
+    (void)pthread_mutex_unlock(&g_jitWarmup.m_lock);
+    if (entries.empty()) {
+        return;
+    }
+
+    // the recorded queries are analyzed and compiled in a transaction of their own
+    StartTransactionCommand();
+    PushActiveSnapshot(GetTransactionSnapshot());
+    WarmupJitSources(databaseId, entries);
+    PopActiveSnapshot();
+    CommitTransactionCommand();
+}
+
+static void WarmupJitSources(Oid databaseId, JitWarmupMap& entries)
+{
+    MOT_LOG_INFO("Warming up %u JIT queries of database %u", (unsigned)entries.size(), databaseId);
+    uint64_t startTime = GetSysClock();
+    uint32_t readyCount = 0;
+    std::vector<JitWarmupKey> failedKeys;
+    // every variable used after catch needs to be volatile (see longjmp() man page)
+    volatile MemoryContext origCxt = CurrentMemoryContext;
+    MemoryContext warmupCxt = AllocSetContextCreate(CurrentMemoryContext,
+        "MOT JIT warm-up",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+    (void)MemoryContextSwitchTo(warmupCxt);
+    PG_TRY();
+    {
+        for (JitWarmupMap::iterator itr = entries.begin(); itr != entries.end(); ++itr) {
+            if (WarmupJitQuery(itr->first, itr->second)) {
+                ++readyCount;
+            } else if (u_sess->mot_cxt.jit_codegen_error == ERRCODE_QUERY_CANCELED) {
+                ereport(ERROR, (errcode(ERRCODE_QUERY_CANCELED), errmsg("canceling statement due to user request")));
+            } else {
+                failedKeys.push_back(itr->first);
+            }
+            MemoryContextReset(warmupCxt);
+        }
+    }
+    PG_CATCH();
+    {
+        // the warm-up context is released with the aborted transaction, and the queries are compiled again by the
+        // next session opening the database
+        (void)MemoryContextSwitchTo(origCxt);
+        MOT_LOG_WARN("JIT warm-up of database %u interrupted", databaseId);
+        (void)pthread_mutex_lock(&g_jitWarmup.m_lock);
+        (void)g_jitWarmup.m_warmDatabases.erase(databaseId);
+        (void)pthread_mutex_unlock(&g_jitWarmup.m_lock);
+        std::vector<JitWarmupKey>().swap(failedKeys);
+        JitWarmupMap().swap(entries);
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+    (void)MemoryContextSwitchTo(origCxt);
+    MemoryContextDelete(warmupCxt);
+
+    if (!failedKeys.empty()) {
+        (void)pthread_mutex_lock(&g_jitWarmup.m_lock);
+        for (const JitWarmupKey& key : failedKeys) {
+            (void)g_jitWarmup.m_entries.erase(key);
+        }
+        g_jitWarmup.m_rewritePending = true;
+        g_jitWarmup.m_pendingRecords.clear();
+        (void)pthread_mutex_unlock(&g_jitWarmup.m_lock);
+    }
+
+    uint64_t timeMicros = MOT::CpuCyclesLevelTime::CyclesToMicroseconds(GetSysClock() - startTime);
+    MOT_LOG_INFO("Warmed up %u JIT queries of database %u in %" PRIu64 " micros (%u removed)",
+        readyCount,
+        databaseId,
+        timeMicros,
+        (unsigned)failedKeys.size());
+}
+
+static bool WarmupJitQuery(const JitWarmupKey& key, JitWarmupEntry& entry)
+{
+    // every variable used after catch needs to be volatile (see longjmp() man page)
+    volatile Query* query = nullptr;
+    volatile MemoryContext origCxt = CurrentMemoryContext;
+    const char* queryString = key.second.c_str();
+    Oid* paramTypes = entry.m_paramTypes.empty() ? nullptr : entry.m_paramTypes.data();
+    int paramCount = (int)entry.m_paramTypes.size();
+
+    PG_TRY();
+    {
+        List* parseTreeList = pg_parse_query(queryString);
+        if (list_length(parseTreeList) == 1) {
+            // queries prepared through SQL are keyed by the entire PREPARE statement
+            Node* parseTree = (Node*)linitial(parseTreeList);
+            if (IsA(parseTree, PrepareStmt)) {
+                parseTree = ((PrepareStmt*)parseTree)->query;
+            }
+            List* queryList = pg_analyze_and_rewrite(parseTree, queryString, paramTypes, paramCount);
+            if (list_length(queryList) == 1) {
+                query = (Query*)linitial(queryList);
+            }
+        }
+    }
+    PG_CATCH();
+    {
+        (void)MemoryContextSwitchTo(origCxt);
+        ErrorData* edata = CopyErrorData();
+        MOT_LOG_TRACE("Failed to analyze JIT warm-up query: %s (%s)", queryString, edata->message);
+        if ((edata->sqlerrcode == ERRCODE_QUERY_CANCELED) || (edata->sqlerrcode == ERRCODE_ADMIN_SHUTDOWN)) {
+            // cancel and terminate requests are not query failures, they abort the warm-up
+            FreeErrorData(edata);
+            PG_RE_THROW();
+        }
+        FlushErrorState();
+        FreeErrorData(edata);
+        query = nullptr;
+    }
+    PG_END_TRY();
+
+    if (query == nullptr) {
+        MOT_LOG_TRACE("Skipping JIT warm-up query, analysis failed: %s", queryString);
+        return false;
+    }
+
+    // the same text may now resolve to other relations (e.g. dropped and re-created, or different search path)
+    std::vector<Oid> relationIds;
+    CollectRelationIds((Query*)query, relationIds);
+    if (relationIds != entry.m_relationIds) {
+        MOT_LOG_TRACE("Skipping JIT warm-up query, referred relations changed: %s", queryString);
+        return false;
+    }
+
+    u_sess->mot_cxt.jit_codegen_error = 0;
+    MotJitContext* jitContext = TryJitCodegenQuery((Query*)query, queryString);
+    if (jitContext == nullptr) {
+        MOT_LOG_TRACE("Skipping JIT warm-up query, code generation failed: %s", queryString);
+        return false;
+    }
+
+    // the JIT source remains ready in the global source map
+    DestroyJitContext(jitContext, true);
+    return true;
+}
+
+static bool LoadJitWarmupFile()
+{
+    int fd = open(g_jitWarmup.m_fileName.c_str(), O_RDONLY);
+    if (fd == -1) {
+        if (errno == ENOENT) {
+            return true;
+        }
+        MOT_REPORT_SYSTEM_ERROR(open, "JIT Initialization", "Failed to open file %s", g_jitWarmup.m_fileName.c_str());
+        return false;
+    }
+
+    bool result = true;
+    bool isTruncated = false;
+    std::string buffer;
+    std::vector<char> chunk(BUFSIZ);
+    ssize_t bytesRead = 0;
+    while ((bytesRead = read(fd, chunk.data(), chunk.size())) > 0) {
+        (void)buffer.append(chunk.data(), (size_t)bytesRead);
+    }
+    if (bytesRead < 0) {
+        MOT_REPORT_SYSTEM_ERROR(read, "JIT Initialization", "Failed to read file %s", g_jitWarmup.m_fileName.c_str());
+        result = false;
+    }
+    (void)close(fd);
+
+    size_t offset = 0;
+    while (result && (offset < buffer.size())) {
+        JitWarmupRecordHeader header;
+        if (buffer.size() - offset < sizeof(JitWarmupRecordHeader)) {
+            isTruncated = true;
+            break;
+        }
+        errno_t erc = memcpy_s(&header, sizeof(header), buffer.data() + offset, sizeof(header));
+        securec_check(erc, "\0", "\0");
+        offset += sizeof(header);
+
+        size_t bodySize = ((size_t)header.m_paramCount + header.m_relationCount) * sizeof(Oid) + header.m_queryLength;
+        if ((header.m_magic != MOT_JIT_WARMUP_MAGIC) || (buffer.size() - offset < bodySize)) {
+            // a record is partially written when the process crashes while appending it
+            isTruncated = true;
+            break;
+        }
+
+        JitWarmupEntry entry;
+        const Oid* oids = (const Oid*)(buffer.data() + offset);
+        entry.m_paramTypes.assign(oids, oids + header.m_paramCount);
+        oids += header.m_paramCount;
+        entry.m_relationIds.assign(oids, oids + header.m_relationCount);
+        offset += ((size_t)header.m_paramCount + header.m_relationCount) * sizeof(Oid);
+        JitWarmupKey key(header.m_databaseId, std::string(buffer.data() + offset, header.m_queryLength));
+        offset += header.m_queryLength;
+        g_jitWarmup.m_entries[key] = entry;
+    }
+
+    if (result && isTruncated) {
+        MOT_LOG_WARN("Discarding partial record at offset %zu of JIT warm-up file %s",
+            offset,
+            g_jitWarmup.m_fileName.c_str());
+        std::string rewriteBuffer;
+        result = SerializeJitWarmupEntries(rewriteBuffer) && RewriteJitWarmupFile(rewriteBuffer);
+    }
+    return result;
+}
+
+static bool SerializeJitWarmupEntries(std::string& buffer)
+{
+    for (JitWarmupMap::iterator itr = g_jitWarmup.m_entries.begin(); itr != g_jitWarmup.m_entries.end(); ++itr) {
+        if (!SerializeJitWarmupRecord(itr->first, itr->second, buffer)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool RewriteJitWarmupFile(const std::string& buffer)
+{
+    // write aside and rename, so a crash leaves either the old or the new file
+    std::string tmpFileName = g_jitWarmup.m_fileName + ".tmp";
+    int fd = open(tmpFileName.c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR); /* 0600 */
+    if (fd == -1) {
+        MOT_REPORT_SYSTEM_ERROR(open, "JIT Warm-up", "Failed to create file %s", tmpFileName.c_str());
+        return false;
+    }
+    bool result = WriteFully(fd, buffer.data(), buffer.size());
+    if (result && (fsync(fd) != 0)) {
+        MOT_REPORT_SYSTEM_ERROR(fsync, "JIT Warm-up", "Failed to sync file %s", tmpFileName.c_str());
+        result = false;
+    }
+    (void)close(fd);
+    if (result && (rename(tmpFileName.c_str(), g_jitWarmup.m_fileName.c_str()) != 0)) {
+        MOT_REPORT_SYSTEM_ERROR(rename, "JIT Warm-up", "Failed to rename file %s", tmpFileName.c_str());
+        result = false;
+    }
+    if (!result) {
+        (void)unlink(tmpFileName.c_str());
+    }
+    return result;
+}
+
+static bool AppendJitWarmupRecords(const std::string& buffer)
+{
+    int fd = open(g_jitWarmup.m_fileName.c_str(), O_CREAT | O_APPEND | O_WRONLY, S_IRUSR | S_IWUSR); /* 0600 */
+    if (fd == -1) {
+        MOT_REPORT_SYSTEM_ERROR(open, "JIT Warm-up", "Failed to open file %s", g_jitWarmup.m_fileName.c_str());
+        return false;
+    }
+    bool result = WriteFully(fd, buffer.data(), buffer.size());
+    (void)close(fd);
+    return result;
+}
+
+static bool SerializeJitWarmupRecord(const JitWarmupKey& key, const JitWarmupEntry& entry, std::string& buffer)
+{
+    if (key.second.size() > UINT32_MAX) {
+        MOT_LOG_TRACE("Skipping JIT warm-up query, query string too long");
+        return false;
+    }
+
+    JitWarmupRecordHeader header;
+    header.m_magic = MOT_JIT_WARMUP_MAGIC;
+    header.m_databaseId = key.first;
+    header.m_paramCount = (uint32_t)entry.m_paramTypes.size();
+    header.m_relationCount = (uint32_t)entry.m_relationIds.size();
+    header.m_queryLength = (uint32_t)key.second.size();
+    (void)buffer.append((const char*)&header, sizeof(header));
+    (void)buffer.append((const char*)entry.m_paramTypes.data(), entry.m_paramTypes.size() * sizeof(Oid));
+    (void)buffer.append((const char*)entry.m_relationIds.data(), entry.m_relationIds.size() * sizeof(Oid));
+    (void)buffer.append(key.second);
+    return true;
+}
+
+static bool WriteFully(int fd, const char* buffer, size_t length)
+{
+    size_t offset = 0;
+    while (offset < length) {
+        ssize_t wrote = write(fd, buffer + offset, length - offset);
+        if (wrote < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            MOT_REPORT_SYSTEM_ERROR(write, "JIT Warm-up", "Failed to write %zu bytes", length - offset);
+            return false;
+        }
+        offset += (size_t)wrote;
+    }
+    return true;
+}
+}  // namespace JitExec
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * jit_warmup.h
+ *    Persistent list of jitted queries, compiled again ahead of first use after restart.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/jit_exec/jit_warmup.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef JIT_WARMUP_H
+#define JIT_WARMUP_H
+
+#include "postgres.h"
+#include "nodes/parsenodes.h"
+
+namespace JitExec {
+/**
+ * @brief Initializes the JIT warm-up list, and loads the queries recorded by previous runs.
+ * @return True if initialization succeeded, otherwise false.
+ */
+extern bool InitJitWarmup();
+
+/** @brief Destroys the JIT warm-up list. The recorded queries are flushed, and remain on disk for the next run. */
+extern void DestroyJitWarmup();
+
+/**
+ * @brief Records a successfully jitted query, so it is compiled again ahead of first use after restart. The record is
+ * buffered, and written to the warm-up file by @ref FlushJitWarmup().
+ * @param query The analyzed query.
+ * @param queryString The query string, which also serves as the JIT source key.
+ * @param paramTypes The query parameter types.
+ * @param paramCount The number of query parameters.
+ */
+extern void RecordJitWarmupQuery(Query* query, const char* queryString, const Oid* paramTypes, int paramCount);
+
+/**
+ * @brief Removes all queries referring to a relation that was dropped or altered. The warm-up file is rewritten by
+ * @ref FlushJitWarmup().
+ * @param relationId The external identifier of the relation.
+ */
+extern void PurgeJitWarmup(uint64_t relationId);
+}  // namespace JitExec
+
+#endif /* JIT_WARMUP_H */
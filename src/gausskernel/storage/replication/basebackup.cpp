@@ -20,6 +20,7 @@
 #include "access/xlog_internal.h" /* for pg_start/stop_backup */
 #include "access/cbmparsexlog.h"
 #include "catalog/catalog.h"
+#include "catalog/pg_tablespace.h"
 #include "catalog/pg_type.h"
 #include "gs_thread.h"
 #include "lib/stringinfo.h"
@@ -28,6 +29,7 @@
 #include "nodes/pg_list.h"
 #include "replication/basebackup.h"
 #include "replication/dcf_data.h"
+#include "replication/incrbackup.h"
 #include "replication/walsender.h"
 #include "replication/walsender_private.h"
 #include "replication/slot.h"
@@ -44,6 +46,7 @@
 #endif
 #include "utils/builtins.h"
 #include "utils/elog.h"
+#include "utils/hsearch.h"
 #include "utils/memutils.h"
 #include "utils/ps_status.h"
 #include "utils/timestamp.h"
@@ -66,8 +69,31 @@ typedef struct {
     bool isCopySecureFiles;
     bool isCopyUpgradeFile;
     bool isObsmode;
+    XLogRecPtr incrementalLsn;
+    int prefetchDepth;
 } basebackup_options;
 
+/*
+ * Blocks of one relation main fork changed since the reference backup of an
+ * incremental backup, as reported by the CBM. fullCopy is set when the
+ * relation was created, dropped or truncated in that range. Database and
+ * tablespace level changes (create, drop, relation map update) are keyed with
+ * relNode, and for a tablespace also dbNode, set to InvalidOid: every file
+ * under them is sent whole.
+ */
+typedef struct BackupChangedRelKey {
+    Oid spcNode;
+    Oid dbNode;
+    Oid relNode;
+} BackupChangedRelKey;
+
+typedef struct BackupChangedRel {
+    BackupChangedRelKey key;
+    bool fullCopy;
+    uint32 nblocks;
+    BlockNumber* blocks;
+} BackupChangedRel;
+
 #define BUILD_PATH_LEN 2560 /* (MAXPGPATH*2 + 512) */
 const int FILE_NAME_MAX_LEN = 1024;
 const int MATCH_ONE = 1;
@@ -82,6 +108,10 @@ const int MATCH_SEVEN = 7;
  * Size of each block sent into the tar stream for larger files.
  */
 #define TAR_SEND_SIZE (32 * 1024) /* data send unit 32KB */
+#define INCR_BACKUP_CBM_TIMEOUT 600000 /* ms to wait for cbm tracking to reach the backup start point */
+#define BACKUP_READAHEAD_WINDOW (1024 * 1024) /* read-ahead per prefetch window */
+/* segment-page storage keeps its extent groups in relfilenodes 1 .. EXTENT_TYPES */
+#define BACKUP_MAX_SEGMENT_RELNODE 5
 #define EREPORT_WAL_NOT_FOUND(segno)                                              \
     do {                                                                          \
         char walErrorName[MAXFNAMELEN];                                           \
@@ -125,6 +155,12 @@ static XLogRecPtr UpdateStartPtr(XLogRecPtr minLsn, XLogRecPtr curStartPtr);
 /* compressed Function */
 static void SendCompressedFile(char* readFileName, int basePathLen, struct stat& statbuf, bool missingOk, int64* size);
 
+/* incremental backup */
+static void LoadBackupChangedBlocks(XLogRecPtr incrementalLsn, XLogRecPtr backupStartPtr);
+static bool SendIncrementalFile(char* readFileName, char* tarFileName, struct stat* statbuf, int64* size);
+static void BackupReadAhead(FILE* fp, pgoff_t offset, pgoff_t fileSize);
+static void BackupReadAheadBlocks(FILE* fp, const BlockNumber* blocks, uint32 nblocks);
+
 /*
  * save xlog location
  */
@@ -240,6 +276,7 @@ static void send_xlog_location()
  */
 static void base_backup_cleanup(int code, Datum arg)
 {
+    t_thrd.basebackup_cxt.changedBlocks = NULL;
     do_pg_abort_backup();
 }
 
@@ -394,6 +431,7 @@ static void perform_base_backup(basebackup_options *opt, DIR *tblspcdir)
     char* tblspc_map_file = NULL;
     List* tablespaces = NIL;
     XLogSegNo startSegNo;
+    XLogRecPtr backupStartPtr;
 
     if (opt->isBuildFromStandby) {
         startptr = StandbyDoStartBackup(opt->label, &labelfile, &tblspc_map_file, &tablespaces,
@@ -403,6 +441,8 @@ static void perform_base_backup(basebackup_options *opt, DIR *tblspcdir)
             do_pg_start_backup(opt->label, opt->fastcheckpoint, &labelfile, tblspcdir, &tblspc_map_file, &tablespaces,
             opt->progress, opt->sendtblspcmapfile);
     }
+    /* the redo point changes are counted up to, startptr may be lowered below to keep xlog needed by slots */
+    backupStartPtr = startptr;
     if (opt->isObsmode) {
         t_thrd.walsender_cxt.is_obsmode = true;
     }
@@ -446,8 +486,12 @@ static void perform_base_backup(basebackup_options *opt, DIR *tblspcdir)
     SendXlogRecPtrResult(startptr);
 
     PG_ENSURE_ERROR_CLEANUP(base_backup_cleanup, (Datum)0);
+    if (!XLogRecPtrIsInvalid(opt->incrementalLsn)) {
+        LoadBackupChangedBlocks(opt->incrementalLsn, backupStartPtr);
+    }
     SendTableSpaceForBackup(opt, tablespaces, labelfile, tblspc_map_file);
     PG_END_ENSURE_ERROR_CLEANUP(base_backup_cleanup, (Datum)0);
+    t_thrd.basebackup_cxt.changedBlocks = NULL;
 
     if (opt->isBuildFromStandby) {
         endptr = StandbyDoStopBackup(labelfile);
@@ -718,6 +762,11 @@ void PerformMotCheckpointFetch()
             /* send the checkpoint dir */
             sendDir(fullChkptDir, (int)basePathLen, false, NIL, false);
 
+            /* send the older checkpoint dirs a delta checkpoint depends on */
+            for (uint32 i = 0; MOTCheckpointChainDir(i, fullChkptDir, MAXPGPATH); i++) {
+                sendDir(fullChkptDir, (int)basePathLen, false, NIL, false);
+            }
+
             /* CopyDone */
             pq_putemptymessage_noblock('c');
         }
@@ -743,6 +792,8 @@ static void parse_basebackup_options(List *options, basebackup_options *opt)
     bool o_iscopyupgradefile = false;
     bool o_tablespace_map = false;
     bool o_isobsmode = false;
+    bool o_incremental = false;
+    bool o_prefetch_depth = false;
     errno_t rc = memset_s(opt, sizeof(*opt), 0, sizeof(*opt));
     securec_check(rc, "", "");
     foreach (lopt, options) {
@@ -802,6 +853,29 @@ static void parse_basebackup_options(List *options, basebackup_options *opt)
             }
             opt->isCopyUpgradeFile = true;
             o_iscopyupgradefile = true;
+        } else if (strcmp(defel->defname, "incremental") == 0) {
+            uint32 hi = 0;
+            uint32 lo = 0;
+            if (o_incremental) {
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("duplicate option \"%s\"", defel->defname)));
+            }
+            if (sscanf_s(strVal(defel->arg), "%X/%X", &hi, &lo) != MATCH_TWO) {
+                ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                                errmsg("invalid incremental backup start point \"%s\"", strVal(defel->arg))));
+            }
+            opt->incrementalLsn = (((uint64)hi) << 32) | lo;
+            o_incremental = true;
+        } else if (strcmp(defel->defname, "prefetch_depth") == 0) {
+            if (o_prefetch_depth) {
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("duplicate option \"%s\"", defel->defname)));
+            }
+            opt->prefetchDepth = intVal(defel->arg);
+            if (opt->prefetchDepth < 1 || opt->prefetchDepth > MAX_BACKUP_PREFETCH_DEPTH) {
+                ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                                errmsg("prefetch depth %d is out of range (1 .. %d)", opt->prefetchDepth,
+                                       MAX_BACKUP_PREFETCH_DEPTH)));
+            }
+            o_prefetch_depth = true;
         } else {
             ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("option \"%s\" not recognized", defel->defname)));
         }
@@ -825,6 +899,9 @@ void SendBaseBackup(BaseBackupCmd *cmd)
     basebackup_options opt;
 
     parse_basebackup_options(cmd->options, &opt);
+    t_thrd.basebackup_cxt.changedBlocks = NULL;
+    t_thrd.basebackup_cxt.sendingTablespace = InvalidOid;
+    t_thrd.basebackup_cxt.readAheadStreams = (opt.prefetchDepth > 1) ? opt.prefetchDepth : 0;
 
     backup_context = AllocSetContextCreate(CurrentMemoryContext, "Streaming base backup context",
                                            ALLOCSET_DEFAULT_MINSIZE, ALLOCSET_DEFAULT_INITSIZE,
@@ -1306,6 +1383,9 @@ static int64 SendRealFile(bool sizeOnly, char* pathbuf, int basepathlen, struct
     if (!sizeOnly && g_instance.attr.attr_storage.enableIncrementalCheckpoint &&
         IsCompressedFile(pathbuf, strlen(pathbuf))) {
         SendCompressedFile(pathbuf, basepathlen, (*statbuf), true, &size);
+    } else if (!sizeOnly && t_thrd.basebackup_cxt.changedBlocks != NULL &&
+        SendIncrementalFile(pathbuf, pathbuf + basepathlen + 1, statbuf, &size)) {
+        /* only the changed blocks were sent */
     } else {
         bool sent = false;
         if (!sizeOnly) {
@@ -1831,7 +1911,9 @@ static void SendTableSpaceForBackup(basebackup_options* opt, List* tablespaces,
          */
         if (iterti->path != NULL) {
             /* Skip the tablespace if it's created in GAUSSDATA */
+            t_thrd.basebackup_cxt.sendingTablespace = (Oid)strtoul(iterti->oid, NULL, 10);
             sendTablespace(iterti->path, false);
+            t_thrd.basebackup_cxt.sendingTablespace = InvalidOid;
         } else {
             /* Then the tablespace_map file, if required... */
             if (tblspc_map_file && opt->sendtblspcmapfile) {
@@ -2094,6 +2176,9 @@ static bool sendFile(char *readfilename, char *tarfilename, struct stat *statbuf
     _tarWriteHeader(tarfilename, NULL, statbuf);
 
     while ((cnt = fread(t_thrd.basebackup_cxt.buf_block, 1, Min(TAR_SEND_SIZE, statbuf->st_size - len), fp)) > 0) {
+        if (t_thrd.basebackup_cxt.readAheadStreams > 0 && len % BACKUP_READAHEAD_WINDOW == 0) {
+            BackupReadAhead(fp, len, statbuf->st_size);
+        }
         if (t_thrd.walsender_cxt.walsender_ready_to_stop)
             ereport(ERROR, (errcode_for_file_access(), errmsg("base backup receive stop message, aborting backup")));
     recheck:
@@ -2187,6 +2272,376 @@ static bool sendFile(char *readfilename, char *tarfilename, struct stat *statbuf
     return true;
 }
 
+static int CompareBackupBlockNumbers(const void* a, const void* b)
+{
+    BlockNumber blkA = *(const BlockNumber*)a;
+    BlockNumber blkB = *(const BlockNumber*)b;
+
+    if (blkA == blkB) {
+        return 0;
+    }
+    return (blkA < blkB) ? -1 : 1;
+}
+
+/*
+ * Build the changed block map of an incremental backup from the CBM between
+ * the reference backup's start point and ours. Pages changed after our start
+ * point are restored by WAL replay, as for a full backup.
+ */
+static void LoadBackupChangedBlocks(XLogRecPtr incrementalLsn, XLogRecPtr backupStartPtr)
+{
+    HASHCTL ctl;
+    HTAB* changedBlocks = NULL;
+    HASH_SEQ_STATUS status;
+    BackupChangedRel* changedRel = NULL;
+    CBMArray* cbmArray = NULL;
+    XLogRecPtr trackedLsn;
+    errno_t rc;
+
+    if (!XLByteLT(incrementalLsn, backupStartPtr)) {
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                        errmsg("incremental backup start point %X/%X is not before the backup start point %X/%X",
+                               (uint32)(incrementalLsn >> 32), (uint32)incrementalLsn,
+                               (uint32)(backupStartPtr >> 32), (uint32)backupStartPtr)));
+    }
+
+    trackedLsn = ForceTrackCBMOnce(backupStartPtr, INCR_BACKUP_CBM_TIMEOUT, true, false);
+    if (XLogRecPtrIsInvalid(trackedLsn)) {
+        ereport(ERROR, (errcode(ERRCODE_CONNECTION_TIMED_OUT),
+                        errmsg("Timeout happened during force track cbm for incremental backup!")));
+    }
+
+    (void)LWLockAcquire(CBMParseXlogLock, LW_SHARED);
+    cbmArray = CBMGetMergedArray(incrementalLsn, trackedLsn);
+    LWLockRelease(CBMParseXlogLock);
+
+    if (XLByteLT(incrementalLsn, cbmArray->startLSN) || XLByteLT(cbmArray->endLSN, backupStartPtr)) {
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+                        errmsg("cbm tracking result %08X/%08X-%08X/%08X does not cover incremental backup range "
+                               "%08X/%08X-%08X/%08X",
+                               (uint32)(cbmArray->startLSN >> 32), (uint32)cbmArray->startLSN,
+                               (uint32)(cbmArray->endLSN >> 32), (uint32)cbmArray->endLSN,
+                               (uint32)(incrementalLsn >> 32), (uint32)incrementalLsn,
+                               (uint32)(backupStartPtr >> 32), (uint32)backupStartPtr),
+                        errhint("Take a full backup instead.")));
+    }
+
+    rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+    securec_check(rc, "\0", "\0");
+    ctl.keysize = sizeof(BackupChangedRelKey);
+    ctl.entrysize = sizeof(BackupChangedRel);
+    ctl.hash = tag_hash;
+    ctl.hcxt = CurrentMemoryContext;
+    changedBlocks = hash_create("incremental backup changed blocks", 1024, &ctl,
+                                HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+
+    for (long i = 0; i < cbmArray->arrayLength; i++) {
+        CBMArrayEntry* entry = &cbmArray->arrayEntry[i];
+        BackupChangedRelKey key;
+        BackupChangedRel* rel = NULL;
+        bool found = false;
+
+        /* other forks and bucket relations are always sent whole */
+        if (entry->cbmTag.forkNum != MAIN_FORKNUM || entry->cbmTag.rNode.bucketNode != InvalidBktId) {
+            continue;
+        }
+
+        key.spcNode = entry->cbmTag.rNode.spcNode;
+        key.dbNode = entry->cbmTag.rNode.dbNode;
+        key.relNode = entry->cbmTag.rNode.relNode;
+        rel = (BackupChangedRel*)hash_search(changedBlocks, &key, HASH_ENTER, &found);
+        if (!found) {
+            rel->fullCopy = false;
+            rel->nblocks = 0;
+            rel->blocks = NULL;
+        }
+
+        if (entry->changeType != PAGETYPE_MODIFY || !OidIsValid(key.relNode)) {
+            rel->fullCopy = true;
+            continue;
+        }
+        if (rel->fullCopy || entry->totalBlockNum == 0) {
+            continue;
+        }
+
+        Size newSize = (rel->nblocks + entry->totalBlockNum) * sizeof(BlockNumber);
+        rel->blocks = (rel->blocks == NULL) ? (BlockNumber*)palloc(newSize)
+                                            : (BlockNumber*)repalloc(rel->blocks, newSize);
+        rc = memcpy_s(rel->blocks + rel->nblocks, entry->totalBlockNum * sizeof(BlockNumber), entry->changedBlock,
+                      entry->totalBlockNum * sizeof(BlockNumber));
+        securec_check(rc, "\0", "\0");
+        rel->nblocks += entry->totalBlockNum;
+    }
+
+    /* the segments are sent in block order, sort each relation once all its entries are in */
+    hash_seq_init(&status, changedBlocks);
+    while ((changedRel = (BackupChangedRel*)hash_seq_search(&status)) != NULL) {
+        if (!changedRel->fullCopy && changedRel->nblocks > 1) {
+            qsort(changedRel->blocks, changedRel->nblocks, sizeof(BlockNumber), CompareBackupBlockNumbers);
+        }
+    }
+
+    ereport(LOG, (errmsg("incremental backup from %X/%X: %ld relations changed before %X/%X",
+                         (uint32)(incrementalLsn >> 32), (uint32)incrementalLsn, hash_get_num_entries(changedBlocks),
+                         (uint32)(backupStartPtr >> 32), (uint32)backupStartPtr)));
+
+    FreeCBMArray(cbmArray);
+    t_thrd.basebackup_cxt.changedBlocks = changedBlocks;
+}
+
+/*
+ * Map a member name to the relation main fork segment it holds. Only plain
+ * "<relfilenode>[.<segno>]" files under global, base or the version directory
+ * of the tablespace being sent qualify.
+ */
+static bool ParseBackupRelFile(const char* tarFileName, BackupChangedRelKey* key, uint32* segNo)
+{
+    char fileName[MAXPGPATH] = {0};
+    char* endPtr = NULL;
+    unsigned int dbNode = InvalidOid;
+    const char* tblspcDir = TABLESPACE_VERSION_DIRECTORY;
+
+    if (strncmp(tarFileName, "global/", strlen("global/")) == 0) {
+        if (sscanf_s(tarFileName, "global/%s", fileName, sizeof(fileName)) != MATCH_ONE) {
+            return false;
+        }
+        key->spcNode = GLOBALTABLESPACE_OID;
+    } else if (strncmp(tarFileName, "base/", strlen("base/")) == 0) {
+        if (sscanf_s(tarFileName, "base/%u/%s", &dbNode, fileName, sizeof(fileName)) != MATCH_TWO) {
+            return false;
+        }
+        key->spcNode = DEFAULTTABLESPACE_OID;
+    } else if (OidIsValid(t_thrd.basebackup_cxt.sendingTablespace) &&
+               strncmp(tarFileName, tblspcDir, strlen(tblspcDir)) == 0) {
+        if (sscanf_s(tarFileName, "%*[^/]/%u/%s", &dbNode, fileName, sizeof(fileName)) != MATCH_TWO) {
+            return false;
+        }
+        key->spcNode = t_thrd.basebackup_cxt.sendingTablespace;
+    } else {
+        return false;
+    }
+    key->dbNode = dbNode;
+
+    if (!isdigit((unsigned char)fileName[0])) {
+        return false;
+    }
+    key->relNode = (Oid)strtoul(fileName, &endPtr, 10);
+    *segNo = 0;
+    if (*endPtr == '.') {
+        char* segStr = endPtr + 1;
+        if (!isdigit((unsigned char)*segStr)) {
+            return false;
+        }
+        *segNo = (uint32)strtoul(segStr, &endPtr, 10);
+    }
+    if (*endPtr != '\0') {
+        return false;
+    }
+
+    /* segment-page storage files hold many relations, never diff them */
+    return key->relNode > BACKUP_MAX_SEGMENT_RELNODE;
+}
+
+/*
+ * Whether the database directory, or the whole tablespace, holding a relation
+ * was created, dropped or had its relation map rewritten since the reference
+ * backup. The reference may have no copy of its files at all then.
+ */
+static bool BackupDirChanged(Oid spcNode, Oid dbNode)
+{
+    BackupChangedRelKey key;
+    BackupChangedRel* dir = NULL;
+
+    key.spcNode = spcNode;
+    key.dbNode = dbNode;
+    key.relNode = InvalidOid;
+    dir = (BackupChangedRel*)hash_search(t_thrd.basebackup_cxt.changedBlocks, &key, HASH_FIND, NULL);
+    if (dir != NULL && dir->fullCopy) {
+        return true;
+    }
+    if (!OidIsValid(dbNode)) {
+        return false;
+    }
+
+    key.dbNode = InvalidOid;
+    dir = (BackupChangedRel*)hash_search(t_thrd.basebackup_cxt.changedBlocks, &key, HASH_FIND, NULL);
+    return dir != NULL && dir->fullCopy;
+}
+
+/*
+ * Read one page of a segment for an incremental backup, retrying like
+ * sendFile() while its checksum does not match a concurrent write. A page
+ * cut off by a concurrent truncate is sent as zeros; WAL replay fixes it.
+ */
+static void ReadBackupBlock(FILE* fp, const char* readFileName, BlockNumber segBlock, BlockNumber blkno, char* page)
+{
+    const int MAX_RETRY_LIMITA = 60;
+    int retryCnt = 0;
+    errno_t rc;
+
+    for (;;) {
+        if (fseeko(fp, (off_t)segBlock * BLCKSZ, SEEK_SET) != 0) {
+            ereport(ERROR, (errcode_for_file_access(), errmsg("could not seek in file \"%s\": %m", readFileName)));
+        }
+        if (fread(page, 1, BLCKSZ, fp) != BLCKSZ) {
+            if (ferror(fp)) {
+                ereport(ERROR, (errcode_for_file_access(), errmsg("could not read file \"%s\": %m", readFileName)));
+            }
+            rc = memset_s(page, BLCKSZ, 0, BLCKSZ);
+            securec_check(rc, "\0", "\0");
+            return;
+        }
+        if (!g_instance.attr.attr_storage.enableIncrementalCheckpoint) {
+            return;
+        }
+
+        PageHeader phdr = (PageHeader)page;
+        if (!CheckPageZeroCases(phdr)) {
+            return;
+        }
+        uint16 checksum = pg_checksum_page(page, blkno);
+        if (phdr->pd_checksum == checksum) {
+            return;
+        }
+        if (retryCnt == MAX_RETRY_LIMITA) {
+            ereport(ERROR, (errcode_for_file_access(),
+                            errmsg("base backup cheksum failed in file \"%s\" block %u (computed: %d, recorded: %d), "
+                                   "aborting backup",
+                                   readFileName, blkno, checksum, phdr->pd_checksum)));
+        }
+        retryCnt++;
+        pg_usleep(1000000);
+    }
+}
+
+/*
+ * Send a relation segment of an incremental backup as "<segment>.incr" with
+ * only the pages changed since the reference backup, see incrbackup.h.
+ * Returns false if the file must be sent whole instead.
+ */
+static bool SendIncrementalFile(char* readFileName, char* tarFileName, struct stat* statbuf, int64* size)
+{
+    BackupChangedRelKey key;
+    BackupChangedRel* rel = NULL;
+    IncrBackupFileHeader header;
+    struct stat incrStatbuf;
+    char incrFileName[MAXPGPATH];
+    BlockNumber* segBlocks = NULL;
+    uint32 nblocks = 0;
+    uint32 segNo = 0;
+    uint32 i;
+    size_t sendLen = 0;
+    size_t pad;
+    errno_t rc;
+
+    if (!ParseBackupRelFile(tarFileName, &key, &segNo)) {
+        return false;
+    }
+    if (BackupDirChanged(key.spcNode, key.dbNode)) {
+        return false;
+    }
+    rel = (BackupChangedRel*)hash_search(t_thrd.basebackup_cxt.changedBlocks, &key, HASH_FIND, NULL);
+    if (rel != NULL && rel->fullCopy) {
+        return false;
+    }
+
+    SendFilePreInit();
+    FILE* fp = SizeCheckAndAllocate(readFileName, *statbuf, true);
+    if (fp == NULL) {
+        return true;
+    }
+
+    /* changed blocks falling into this segment, made segment-relative */
+    BlockNumber segStart = segNo * RELSEG_SIZE;
+    BlockNumber segLength = (BlockNumber)(statbuf->st_size / BLCKSZ);
+    segBlocks = (BlockNumber*)palloc(Max(rel != NULL ? rel->nblocks : 0, 1) * sizeof(BlockNumber));
+    for (i = 0; rel != NULL && i < rel->nblocks; i++) {
+        BlockNumber blkno = rel->blocks[i];
+        if (blkno < segStart || blkno - segStart >= segLength) {
+            continue;
+        }
+        if (nblocks > 0 && segBlocks[nblocks - 1] == blkno - segStart) {
+            continue;
+        }
+        segBlocks[nblocks++] = blkno - segStart;
+    }
+
+    header.magic = INCR_BACKUP_MAGIC;
+    header.nblocks = nblocks;
+    header.truncateBlock = segLength;
+
+    rc = snprintf_s(incrFileName, sizeof(incrFileName), sizeof(incrFileName) - 1, "%s%s", tarFileName,
+                    INCR_BACKUP_SUFFIX);
+    securec_check_ss(rc, "\0", "\0");
+    incrStatbuf = *statbuf;
+    incrStatbuf.st_size = (off_t)IncrBackupFileSize(nblocks);
+    _tarWriteHeader(incrFileName, NULL, &incrStatbuf);
+
+    if (pq_putmessage_noblock('d', (char*)&header, sizeof(header)) ||
+        (nblocks > 0 && pq_putmessage_noblock('d', (char*)segBlocks, nblocks * sizeof(BlockNumber)))) {
+        ereport(ERROR, (errcode_for_file_access(), errmsg("base backup could not send data, aborting backup")));
+    }
+
+    for (i = 0; i < nblocks; i++) {
+        if (t_thrd.walsender_cxt.walsender_ready_to_stop) {
+            ereport(ERROR, (errcode_for_file_access(), errmsg("base backup receive stop message, aborting backup")));
+        }
+        if (t_thrd.basebackup_cxt.readAheadStreams > 0 && i % t_thrd.basebackup_cxt.readAheadStreams == 0) {
+            BackupReadAheadBlocks(fp, segBlocks + i,
+                                  Min(nblocks - i, (uint32)t_thrd.basebackup_cxt.readAheadStreams * 2));
+        }
+        ReadBackupBlock(fp, readFileName, segBlocks[i], segStart + segBlocks[i],
+                        t_thrd.basebackup_cxt.buf_block + sendLen);
+        sendLen += BLCKSZ;
+        if (sendLen == TAR_SEND_SIZE || i == nblocks - 1) {
+            if (pq_putmessage_noblock('d', t_thrd.basebackup_cxt.buf_block, sendLen)) {
+                ereport(ERROR,
+                        (errcode_for_file_access(), errmsg("base backup could not send data, aborting backup")));
+            }
+            sendLen = 0;
+        }
+    }
+
+    /* Pad to 512 byte boundary, per tar format requirements */
+    pad = (size_t)(((incrStatbuf.st_size + 511) & ~511) - incrStatbuf.st_size);
+    if (pad > 0) {
+        rc = memset_s(t_thrd.basebackup_cxt.buf_block, pad, 0, pad);
+        securec_check(rc, "\0", "\0");
+        (void)pq_putmessage_noblock('d', t_thrd.basebackup_cxt.buf_block, pad);
+    }
+
+    pfree(segBlocks);
+    (void)FreeFile(fp);
+    SEND_DIR_ADD_SIZE(*size, incrStatbuf);
+    return true;
+}
+
+/*
+ * With PREFETCH_DEPTH n the sender keeps n read-ahead windows in flight ahead of
+ * its read position, so that the storage serves several reads at once while
+ * the single COPY stream is busy sending.
+ */
+static void BackupReadAhead(FILE* fp, pgoff_t offset, pgoff_t fileSize)
+{
+#if defined(USE_POSIX_FADVISE) && defined(POSIX_FADV_WILLNEED)
+    pgoff_t amount = Min((pgoff_t)t_thrd.basebackup_cxt.readAheadStreams * BACKUP_READAHEAD_WINDOW,
+                         fileSize - offset);
+    if (amount > 0) {
+        /* just a hint, ignore failures */
+        (void)posix_fadvise(fileno(fp), (off_t)offset, (off_t)amount, POSIX_FADV_WILLNEED);
+    }
+#endif
+}
+
+static void BackupReadAheadBlocks(FILE* fp, const BlockNumber* blocks, uint32 nblocks)
+{
+#if defined(USE_POSIX_FADVISE) && defined(POSIX_FADV_WILLNEED)
+    for (uint32 i = 0; i < nblocks; i++) {
+        (void)posix_fadvise(fileno(fp), (off_t)blocks[i] * BLCKSZ, BLCKSZ, POSIX_FADV_WILLNEED);
+    }
+#endif
+}
+
 static void _tarWriteHeader(const char *filename, const char *linktarget, struct stat *statbuf)
 {
     char h[BUILD_PATH_LEN];
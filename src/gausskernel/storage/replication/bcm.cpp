@@ -69,6 +69,8 @@
 
 #include "utils/aiomem.h"
 #include "utils/memutils.h"
+#include "utils/ps_status.h"
+#include "utils/timestamp.h"
 #include "storage/custorage.h"
 #include "storage/ipc.h"
 #include "commands/tablespace.h"
@@ -81,16 +83,30 @@
  */
 #define BCM "_bcm"
 
+/* interval between two catchup progress reports, in milliseconds */
+#define CATCHUP_PROGRESS_INTERVAL 10000
+
+/* A relation whose pages are queued but not yet known to be on the standby */
+typedef struct BCMPendingRel {
+    Relation rel;
+    RelFileNode relfilenode;
+    BlockNumber metanum;
+    int col;
+} BCMPendingRel;
+
 /* prototypes for internal routines */
 static Buffer BCM_readbuf(Relation rel, BlockNumber blkno, bool extend, int col = 0);
 static void BCM_extend(Relation rel, BlockNumber nvmblocks, int col = 0);
 static void searchBCMFiles(const char *tableSpacePath, const char *relativepath, bool undertablespace, bool clear,
-                           int iterations);
+                           int iterations, List **bcmfiles);
 static void GetIncrementalBcmFilePathForDefault(const RelFileNodeKey &data, char *path, int length);
 static void GetIncrementalBcmFilePathForCustome(const RelFileNodeKey &data, char *path, int length);
 static void HandleBCMfile(char *bcmpath, bool clear);
 static void BCMClearFile(const RelFileNode &relfilenode, int col = 0);
 static void BCMSendData(const RelFileNode &relfilenode, const char *bcmpath, int col = 0);
+static void BCMFinishPendingRels(void);
+static void BCMStartCatchupProgress(int64 filesTotal);
+static void BCMReportCatchupProgress(bool force);
 static void bcm_read_multi_cu(CUFile *cFile, Relation rel, int col, BlockNumber heapBlock, int &contibits,
                               BlockNumber maxHeapBlock);
 static void BCMSetMetaBit(Relation rel, BlockNumber block, BCMBitStatus status, int col = 0);
@@ -100,6 +116,8 @@ static void BCMWalkMetaBuffer(Relation rel, CUFile *cFile, Buffer metabuffer, Bl
                               BlockNumber maxHeapBlock, int col = 0);
 static void BCMSendOneBuffer(Relation rel, CUFile *cFile, Buffer bcmbuffer, BlockNumber &heapBlock, int &contibits,
                              BlockNumber maxHeapBlock, int col = 0);
+static void BCMPrefetchHeapBlocks(Relation rel, const unsigned char *map, BlockNumber bcmBlock, uint32 curBit,
+                                  uint32 &prefetchBit, int &inflight, BlockNumber maxHeapBlock);
 static BlockNumber BCMGetDataFileMaxSize(Relation rel, int col);
 static bool CheckFilePostfix(const char *str1, const char *str2);
 
@@ -701,6 +719,9 @@ void BCM_pin(Relation rel, BlockNumber heapBlk, Buffer *buf)
  * hold the relation lock to avoid been dropped during catchup.
  * In order to speed up the check efficiency, we just need to walk the
  * bcm meta buffer instead. More comments see in bcm meta buffer.
+ *
+ * The relation stays locked after we return, until BCMFinishPendingRels
+ * has seen its pages reach the standby.
  */
 static void BCMSendData(const RelFileNode &relfilenode, const char *bcmpath, int col)
 {
@@ -712,8 +733,8 @@ static void BCMSendData(const RelFileNode &relfilenode, const char *bcmpath, int
     BlockNumber metanum = 1;
     BlockNumber maxHeapBlock = InvalidBlockNumber;
     struct stat stat_buf;
+    BCMPendingRel *pending = NULL;
 
-    volatile DataSndCtlData *datasndctl = t_thrd.datasender_cxt.DataSndCtl;
     bool isColStore = col > 0 ? true : false;
     int contibits = 0;
 
@@ -812,6 +833,37 @@ static void BCMSendData(const RelFileNode &relfilenode, const char *bcmpath, int
     if (cFile)
         DELETE_EX(cFile);
 
+    /*
+     * Waiting for the standby after every relation leaves the data sender
+     * idle while we scan the next one, which dominates when there are many
+     * small relations. Keep up to catchup_parallel_relations relations in
+     * flight and confirm them together.
+     */
+    pending = (BCMPendingRel *)palloc(sizeof(BCMPendingRel));
+    pending->rel = rel;
+    pending->relfilenode = relfilenode;
+    pending->metanum = metanum;
+    pending->col = col;
+    t_thrd.catchup_cxt.pending_rels = lappend(t_thrd.catchup_cxt.pending_rels, pending);
+
+    if (list_length(t_thrd.catchup_cxt.pending_rels) >= u_sess->attr.attr_storage.catchup_parallel_relations)
+        BCMFinishPendingRels();
+}
+
+/*
+ * BCMFinishPendingRels
+ *
+ * Wait until everything pushed for the pending relations has been sent to
+ * the standby, then mark their pages synced and release them.
+ */
+static void BCMFinishPendingRels(void)
+{
+    volatile DataSndCtlData *datasndctl = t_thrd.datasender_cxt.DataSndCtl;
+    ListCell *lc = NULL;
+
+    if (t_thrd.catchup_cxt.pending_rels == NIL)
+        return;
+
     /*
      * we should wait until all the pushed data has been send to the standby,
      * then clear the BCMArray.
@@ -822,12 +874,70 @@ static void BCMSendData(const RelFileNode &relfilenode, const char *bcmpath, int
     }
 
     ClearBCMArray();
-    BCMResetMetaBit(rel, metanum, col);
 
-    UnlockRelFileNode(relfilenode, ExclusiveLock);
-    FreeFakeRelcacheEntry(rel);
+    foreach (lc, t_thrd.catchup_cxt.pending_rels) {
+        BCMPendingRel *pending = (BCMPendingRel *)lfirst(lc);
+
+        BCMResetMetaBit(pending->rel, pending->metanum, pending->col);
+
+        UnlockRelFileNode(pending->relfilenode, ExclusiveLock);
+        FreeFakeRelcacheEntry(pending->rel);
 
-    UnlockSharedObject(DatabaseRelationId, relfilenode.dbNode, 0, RowExclusiveLock);
+        UnlockSharedObject(DatabaseRelationId, pending->relfilenode.dbNode, 0, RowExclusiveLock);
+    }
+
+    list_free_deep(t_thrd.catchup_cxt.pending_rels);
+    t_thrd.catchup_cxt.pending_rels = NIL;
+}
+
+/* Reset the progress counters at the start of a catchup over filesTotal bcm files */
+static void BCMStartCatchupProgress(int64 filesTotal)
+{
+    t_thrd.catchup_cxt.files_total = filesTotal;
+    t_thrd.catchup_cxt.files_done = 0;
+    t_thrd.catchup_cxt.blocks_sent = 0;
+    t_thrd.catchup_cxt.bytes_sent = 0;
+    t_thrd.catchup_cxt.start_time = GetCurrentTimestamp();
+    t_thrd.catchup_cxt.last_report_time = t_thrd.catchup_cxt.start_time;
+}
+
+/*
+ * Log how far catchup has got, at most once per CATCHUP_PROGRESS_INTERVAL
+ * unless forced. The time left is extrapolated from the share of bcm files
+ * handled so far.
+ */
+static void BCMReportCatchupProgress(bool force)
+{
+    knl_t_catchup_context *cxt = &t_thrd.catchup_cxt;
+    TimestampTz now = GetCurrentTimestamp();
+    long secs = 0;
+    int usecs = 0;
+    double elapsed;
+    double rate = 0;
+    double remaining = 0;
+    char activity[NAMEDATALEN];
+    int rc;
+
+    if (!force && !TimestampDifferenceExceeds(cxt->last_report_time, now, CATCHUP_PROGRESS_INTERVAL))
+        return;
+    cxt->last_report_time = now;
+
+    TimestampDifference(cxt->start_time, now, &secs, &usecs);
+    elapsed = (double)secs + (double)usecs / USECS_PER_SEC;
+    if (elapsed > 0)
+        rate = (double)cxt->bytes_sent / elapsed / (1024 * 1024);
+    if (cxt->files_done > 0 && cxt->files_total > cxt->files_done)
+        remaining = elapsed * (double)(cxt->files_total - cxt->files_done) / (double)cxt->files_done;
+
+    ereport(LOG, (errmsg("catchup progress: %ld of %ld bcm files, %ld blocks (%ld kB) sent in %.0f s, "
+                         "%.1f MB/s, about %.0f s remaining",
+                         cxt->files_done, cxt->files_total, cxt->blocks_sent, cxt->bytes_sent / 1024, elapsed, rate,
+                         remaining)));
+
+    rc = snprintf_s(activity, sizeof(activity), sizeof(activity) - 1, "%ld/%ld bcm files", cxt->files_done,
+                    cxt->files_total);
+    securec_check_ss(rc, "", "");
+    set_ps_display(activity, false);
 }
 
 /*
@@ -900,6 +1010,8 @@ static void BCMSendOneBuffer(Relation rel, CUFile *cFile, Buffer bcmbuffer, Bloc
     BCMBitStatus status;
     BlockNumber blocknum = 0;
     bool isColStore = col > 0 ? true : false;
+    uint32 prefetchBit = 0;
+    int inflight = 0;
 
     blocknum = BufferGetBlockNumber(bcmbuffer);
     Assert(isColStore || (cFile == NULL));
@@ -946,11 +1058,18 @@ static void BCMSendOneBuffer(Relation rel, CUFile *cFile, Buffer bcmbuffer, Bloc
                     if (heapBlock > maxHeapBlock)
                         return;
 
+                    if (u_sess->storage_cxt.target_prefetch_pages > 0)
+                        BCMPrefetchHeapBlocks(rel, map, blocknum, (uint32)(i * BCM_BLOCKS_PER_BYTE + j), prefetchBit,
+                                              inflight, maxHeapBlock);
+
                     heapbuffer = ReadBuffer(rel, heapBlock);
 
                     LockBuffer(heapbuffer, BUFFER_LOCK_SHARE);
                     PushHeapPageToDataQueue(heapbuffer);
                     UnlockReleaseBuffer(heapbuffer);
+
+                    t_thrd.catchup_cxt.blocks_sent++;
+                    t_thrd.catchup_cxt.bytes_sent += BLCKSZ;
                 }
             }
 
@@ -967,6 +1086,51 @@ static void BCMSendOneBuffer(Relation rel, CUFile *cFile, Buffer bcmbuffer, Bloc
     }
 }
 
+/*
+ * BCMPrefetchHeapBlocks
+ *
+ * Called before reading the NOTSYNCED heap block at bit curBit of a bcm page.
+ * Keep up to target_prefetch_pages of the NOTSYNCED blocks after it being
+ * read ahead, so that catchup does not wait for every read in turn.
+ * prefetchBit is the next bit to look at and inflight the number of blocks
+ * prefetched but not yet read; both start at zero for each bcm page.
+ */
+static void BCMPrefetchHeapBlocks(Relation rel, const unsigned char *map, BlockNumber bcmBlock, uint32 curBit,
+                                  uint32 &prefetchBit, int &inflight, BlockNumber maxHeapBlock)
+{
+    uint32 byte;
+    uint32 bit;
+    BCMBitStatus status;
+    BlockNumber blkno;
+
+    if (prefetchBit > curBit) {
+        /* curBit was prefetched before, unless its status changed since */
+        if (inflight > 0)
+            inflight--;
+    } else {
+        prefetchBit = curBit + 1;
+        inflight = 0;
+    }
+
+    while (inflight < u_sess->storage_cxt.target_prefetch_pages && prefetchBit < BCM_BLOCKS_PER_PAGE) {
+        byte = prefetchBit / BCM_BLOCKS_PER_BYTE;
+        bit = prefetchBit % BCM_BLOCKS_PER_BYTE;
+        status = ((map[byte] >> (bit * BCM_BITS_PER_BLOCK)) & BCM_SYNC_BITMASK) >> 1;
+        prefetchBit++;
+
+        if (status != NOTSYNCED)
+            continue;
+
+        blkno = GET_HEAP_BLOCK(bcmBlock, byte, bit);
+        if (blkno > maxHeapBlock) {
+            prefetchBit = BCM_BLOCKS_PER_PAGE;
+            break;
+        }
+        PrefetchBuffer(rel, MAIN_FORKNUM, blkno);
+        inflight++;
+    }
+}
+
 /*
  * Get max block num for bcm file relfilenode
  */
@@ -1046,7 +1210,7 @@ static void BCMClearFile(const RelFileNode &relfilenode, int col)
 
 /* Recursion search BCM files with the tableSpacePath */
 static void searchBCMFiles(const char *tableSpacePath, const char *relativepath, bool undertablespace, bool clear,
-                           int iterations)
+                           int iterations, List **bcmfiles)
 {
     DIR *dir = NULL;
     struct dirent *de;
@@ -1103,13 +1267,18 @@ static void searchBCMFiles(const char *tableSpacePath, const char *relativepath,
          */
         if (iterations < 3 && isDirExist(path)) {
             ereport(DEBUG3, (errmsg("search path %s, relative path: %s, iterations: %d.", path, rpath, iterations)));
-            searchBCMFiles(path, rpath, undertablespace, clear, iterations);
+            searchBCMFiles(path, rpath, undertablespace, clear, iterations, bcmfiles);
         } else {
             /*
              * When we handle the bcm files, we will find if we end with "_bcm".
              */
             if (CheckFilePostfix(rpath, BCM)) {
-                HandleBCMfile(rpath, clear);
+                if (clear) {
+                    HandleBCMfile(rpath, clear);
+                } else {
+                    /* send them once the total is known, for progress estimates */
+                    *bcmfiles = lappend(*bcmfiles, pstrdup(rpath));
+                }
             }
         }
     }
@@ -1149,6 +1318,9 @@ static void HandleBCMfile(char *bcmpath, bool clear)
 
         CatchupShutdownIfNoDataSender();
         BCMSendData(bcmfilenode.rnode.node, bcmpath, GetColumnNum(bcmfilenode.forknumber));
+
+        t_thrd.catchup_cxt.files_done++;
+        BCMReportCatchupProgress(false);
     }
 }
 
@@ -1160,6 +1332,7 @@ void GetBcmFileList(bool clear)
     ListCell *lc = NULL;
     struct dirent *de;
     tablespaceinfo *ti = NULL;
+    List *bcmfiles = NIL;
 
     MemoryContext bcm_context;
     MemoryContext old_context;
@@ -1229,15 +1402,25 @@ void GetBcmFileList(bool clear)
         if (tsi->path != NULL) {
             /* Tablespace create by user */
             ereport(DEBUG1, (errmsg("bcm path: %s; relative path: %s.", tsi->path, tsi->relativePath)));
-            searchBCMFiles(tsi->path, tsi->relativePath, true, clear, 0);
+            searchBCMFiles(tsi->path, tsi->relativePath, true, clear, 0, &bcmfiles);
         } else {
             /* Default tablespace */
             ereport(DEBUG1, (errmsg("bcm path: %s; relative path: %s.", ".", ".")));
-            searchBCMFiles(".", NULL, false, clear, 0);
+            searchBCMFiles(".", NULL, false, clear, 0, &bcmfiles);
         }
     }
 
     FreeDir(dir);
+
+    if (!clear) {
+        ereport(LOG, (errmsg("catchup process found %d bcm files.", list_length(bcmfiles))));
+        BCMStartCatchupProgress(list_length(bcmfiles));
+        foreach (lc, bcmfiles) {
+            HandleBCMfile((char *)lfirst(lc), false);
+        }
+        BCMFinishPendingRels();
+        BCMReportCatchupProgress(true);
+    }
     ereport(LOG, (errmsg("catchup process done to search all bcm files.")));
 
     MemoryContextSwitchTo(old_context);
@@ -1262,6 +1445,7 @@ void GetIncrementalBcmFileList()
 
     temp = fileList;
     ereport(LOG, (errmsg("num of file list we got from dummy:%d", num)));
+    BCMStartCatchupProgress(num);
 
     while (num != 0) {
         TimestampTz parseBcmStartTime = GetCurrentTimestamp();
@@ -1284,6 +1468,10 @@ void GetIncrementalBcmFileList()
         }
         num--;
     }
+    TimestampTz finishStartTime = GetCurrentTimestamp();
+    BCMFinishPendingRels();
+    getIncrementalCatchupHandleBcmTime += ComputeTimeStamp(finishStartTime);
+    BCMReportCatchupProgress(true);
     ReplaceOrFreeBcmFileListBuffer(NULL, 0);
     ereport(
         LOG,
@@ -1420,6 +1608,8 @@ static void bcm_read_multi_cu(CUFile *cFile, Relation rel, int col, BlockNumber
             check_cu_block(write_buf, realSize, (int)align_size);
 
         PushCUToDataQueue(rel, col, write_buf, offset, realSize, false);
+        t_thrd.catchup_cxt.blocks_sent += realSize / align_size;
+        t_thrd.catchup_cxt.bytes_sent += realSize;
         ereport(DEBUG3, (errmsg("cuBlock %u col %d read and send data's realsize is %d.", heapBlock, col, realSize)));
         offset += realSize;
         contibits -= realSize / align_size;
@@ -283,6 +283,9 @@ NON_EXEC_STATIC void CatchupMain()
          */
         ResetBCMArray();
 
+        /* Locks of pending relations go away with the transaction below. */
+        t_thrd.catchup_cxt.pending_rels = NIL;
+
         /* Abort the current transaction in order to recover */
         AbortCurrentTransaction();
 
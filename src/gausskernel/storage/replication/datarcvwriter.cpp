@@ -16,6 +16,7 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/xact.h"
 #include "access/xlogutils.h"
 #include "libpq/pqsignal.h"
 #include "miscadmin.h"
@@ -830,6 +831,10 @@ static void DataWriterHashRemove(bool flushdata)
     data_writer_rel *hentry = NULL;
     Relation reln;
     CUStorage *cuStorage = NULL;
+    HTAB *flushRels = NULL;
+    List *syncRels = NIL;
+    ListCell *lc = NULL;
+    RelFileNode flushNode;
 
     if (t_thrd.datarcvwriter_cxt.data_writer_rel_tab == NULL)
         return;
@@ -841,29 +846,59 @@ static void DataWriterHashRemove(bool flushdata)
     if (t_thrd.datarcvwriter_cxt.dataRcvWriterFlushPageErrorCount++ >= ERRORDATA_FLUSH_NUM)
         ereport(PANIC, (errmsg_internal("ERRORDATA_FLUSH_NUM exceeded")));
 
-    hash_seq_init(&status, t_thrd.datarcvwriter_cxt.data_writer_rel_tab);
-    while ((hentry = (data_writer_rel *)hash_seq_search(&status)) != NULL) {
-        if (hentry->key.type == ROW_STORE && !g_instance.attr.attr_storage.enable_mix_replication) {
-            reln = hentry->reln;
+    /*
+     * A catchup batch usually touches many row relations.  Collect the ones
+     * still on disk and write their dirty buffers out with a single pass over
+     * the buffer pool instead of one pass per relation, then fsync them.
+     */
+    if (flushdata && !g_instance.attr.attr_storage.enable_mix_replication) {
+        flushRels = relfilenode_hashtbl_create();
 
-            if (flushdata) {
-                char* path = relpath(reln->rd_smgr->smgr_rnode, MAIN_FORKNUM);
+        hash_seq_init(&status, t_thrd.datarcvwriter_cxt.data_writer_rel_tab);
+        while ((hentry = (data_writer_rel *)hash_seq_search(&status)) != NULL) {
+            if (hentry->key.type != ROW_STORE)
+                continue;
+
+            reln = hentry->reln;
+            char* path = relpath(reln->rd_smgr->smgr_rnode, MAIN_FORKNUM);
 #ifdef ENABLE_MULTIPLE_NODES
-                LockRelFileNode(reln->rd_node, AccessExclusiveLock);
+            LockRelFileNode(reln->rd_node, AccessExclusiveLock);
 #endif
-                /* do not sync the file if it not exists any more */
-                if (smgrexists(reln->rd_smgr, MAIN_FORKNUM) && CheckFileExists(path) == FILE_EXIST) {
-                    FlushRelationBuffers(reln);
-                    smgrimmedsync(reln->rd_smgr, MAIN_FORKNUM);
-                } else {
-                    ereport(WARNING, (errmsg("HA-DataWriterHashRemove: No File SYNC, rnode %u/%u/%u dose not exists",
-                                             reln->rd_node.spcNode, reln->rd_node.dbNode, reln->rd_node.relNode)));
-                }
+            /* do not sync the file if it not exists any more */
+            if (smgrexists(reln->rd_smgr, MAIN_FORKNUM) && CheckFileExists(path) == FILE_EXIST) {
+                flushNode = reln->rd_node;
+                flushNode.bucketNode = InvalidBktId;
+                flushNode.opt = 0;
+                (void)hash_search(flushRels, &flushNode, HASH_ENTER, NULL);
+                syncRels = lappend(syncRels, reln);
+            } else {
+                ereport(WARNING, (errmsg("HA-DataWriterHashRemove: No File SYNC, rnode %u/%u/%u dose not exists",
+                                         reln->rd_node.spcNode, reln->rd_node.dbNode, reln->rd_node.relNode)));
 #ifdef ENABLE_MULTIPLE_NODES
                 UnlockRelFileNode(reln->rd_node, AccessExclusiveLock);
 #endif
-                pfree_ext(path);
             }
+            pfree_ext(path);
+        }
+
+        if (syncRels != NIL)
+            FlushRelFileNodeAllBuffersUsingHash(flushRels);
+
+        foreach (lc, syncRels) {
+            reln = (Relation)lfirst(lc);
+            smgrimmedsync(reln->rd_smgr, MAIN_FORKNUM);
+#ifdef ENABLE_MULTIPLE_NODES
+            UnlockRelFileNode(reln->rd_node, AccessExclusiveLock);
+#endif
+        }
+        list_free_ext(syncRels);
+        hash_destroy(flushRels);
+    }
+
+    hash_seq_init(&status, t_thrd.datarcvwriter_cxt.data_writer_rel_tab);
+    while ((hentry = (data_writer_rel *)hash_seq_search(&status)) != NULL) {
+        if (hentry->key.type == ROW_STORE && !g_instance.attr.attr_storage.enable_mix_replication) {
+            reln = hentry->reln;
             RelationCloseSmgr(reln);
             FreeFakeRelcacheEntry(reln);
         } else if (hentry->key.type == COLUMN_STORE) {
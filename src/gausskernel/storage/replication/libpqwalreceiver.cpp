@@ -270,6 +270,10 @@ void StartRemoteStreaming(const LibpqrcvConnectParam *options)
             appendStringInfoString(&cmd, ", usesnapshot 'true'");
         }
 
+        if (options->streaming) {
+            appendStringInfoString(&cmd, ", streaming 'on'");
+        }
+
         appendStringInfoChar(&cmd, ')');
     }
 
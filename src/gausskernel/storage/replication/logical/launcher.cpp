@@ -158,7 +158,8 @@ List *logicalrep_workers_find(Oid subid, bool only_running)
 
 /*
  * Walks the workers array and searches for one that matches given
- * subscription id and relid.
+ * subscription id and relid. Parallel apply workers are never returned,
+ * they belong to the apply worker of the subscription.
  */
 LogicalRepWorker *logicalrep_worker_find(Oid subid, Oid relid, bool only_running)
 {
@@ -169,7 +170,7 @@ LogicalRepWorker *logicalrep_worker_find(Oid subid, Oid relid, bool only_running
     /* Search for attached worker for a given subscription id. */
     for (i = 0; i < g_instance.attr.attr_storage.max_logical_replication_workers; i++) {
         LogicalRepWorker *w = &t_thrd.applylauncher_cxt.applyLauncherShm->workers[i];
-        if (w->subid == subid && w->relid == relid && (!only_running || w->proc)) {
+        if (w->subid == subid && w->relid == relid && w->paIndex == 0 && (!only_running || w->proc)) {
             res = w;
             break;
         }
@@ -219,6 +220,11 @@ static void WaitForReplicationWorkerAttach()
             LogicalRepWorker *worker = t_thrd.applylauncher_cxt.applyLauncherShm->startingWorker;
             ereport(WARNING, (errmsg("Apply worker with sub id:%u took too long time to start, so canceled it",
                 worker->subid)));
+            if (worker->paGroup != NULL) {
+                worker->paGroup->workers[worker->paIndex - 1].worker = NULL;
+                worker->paGroup = NULL;
+                worker->paIndex = 0;
+            }
             worker->dbid = InvalidOid;
             worker->userid = InvalidOid;
             worker->subid = InvalidOid;
@@ -233,8 +239,12 @@ static void WaitForReplicationWorkerAttach()
 
 /*
  * Start new apply background worker.
+ *
+ * paGroup and paIndex are given by an apply worker starting its parallel
+ * apply workers.
  */
-void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid)
+void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid,
+    ParallelApplyGroup *paGroup, int paIndex)
 {
     int slot;
     LogicalRepWorker *worker = NULL;
@@ -279,6 +289,10 @@ void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid user
     worker->relstate = SUBREL_STATE_UNKNOWN;
     worker->relstate_lsn = InvalidXLogRecPtr;
     worker->relcsn = InvalidCommitSeqNo;
+    worker->paGroup = paGroup;
+    worker->paIndex = paIndex;
+    if (paGroup != NULL)
+        paGroup->workers[paIndex - 1].worker = worker;
     worker->last_lsn = InvalidXLogRecPtr;
     TIMESTAMP_NOBEGIN(worker->last_send_time);
     TIMESTAMP_NOBEGIN(worker->last_recv_time);
@@ -453,6 +467,19 @@ static void logicalrep_worker_detach(void)
     /* Block concurrent access. */
     (void)LWLockAcquire(LogicalRepWorkerLock, LW_EXCLUSIVE);
 
+    /* Let the leader know if a parallel apply worker went away unasked. */
+    if (t_thrd.applyworker_cxt.curWorker->paGroup != NULL) {
+        ParallelApplyGroup *group = t_thrd.applyworker_cxt.curWorker->paGroup;
+
+        group->workers[t_thrd.applyworker_cxt.curWorker->paIndex - 1].worker = NULL;
+        if (!group->shutdown)
+            group->failed = true;
+        if (group->leader->proc != NULL)
+            SetLatch(&group->leader->proc->procLatch);
+        t_thrd.applyworker_cxt.curWorker->paGroup = NULL;
+        t_thrd.applyworker_cxt.curWorker->paIndex = 0;
+    }
+
     t_thrd.applyworker_cxt.curWorker->dbid = InvalidOid;
     t_thrd.applyworker_cxt.curWorker->userid = InvalidOid;
     t_thrd.applyworker_cxt.curWorker->subid = InvalidOid;
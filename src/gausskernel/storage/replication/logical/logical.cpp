@@ -75,6 +75,10 @@ static void begin_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
 static void commit_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
 static void abort_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
 static void prepare_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
+static void stream_start_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
+static void stream_stop_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
+static void stream_commit_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
+static void stream_abort_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr abort_lsn);
 
 static void change_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, Relation relation,
                               ReorderBufferChange *change);
@@ -171,6 +175,23 @@ static LogicalDecodingContext *StartupDecodingContext(List *output_plugin_option
     ctx->reorder->apply_change = change_cb_wrapper;
     ctx->reorder->commit = commit_cb_wrapper;
 
+    /*
+     * Streaming is possible if the plugin implements the streaming callbacks,
+     * whether it is actually used is up to the plugin's startup callback.
+     * Without enable_logical_replication_streaming the backends do not log
+     * subtransaction assignments eagerly, and a subtransaction would look
+     * like a toplevel transaction until its parent commits.
+     */
+    ctx->streaming = u_sess->attr.attr_storage.enable_logical_replication_streaming &&
+                     (ctx->callbacks.stream_start_cb != NULL && ctx->callbacks.stream_stop_cb != NULL &&
+                      ctx->callbacks.stream_commit_cb != NULL && ctx->callbacks.stream_abort_cb != NULL);
+    if (ctx->streaming) {
+        ctx->reorder->stream_start = stream_start_cb_wrapper;
+        ctx->reorder->stream_stop = stream_stop_cb_wrapper;
+        ctx->reorder->stream_commit = stream_commit_cb_wrapper;
+        ctx->reorder->stream_abort = stream_abort_cb_wrapper;
+    }
+
     ctx->out = makeStringInfo();
     ctx->prepare_write = prepare_write;
     ctx->write = do_write;
@@ -957,6 +978,125 @@ static void commit_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogR
     t_thrd.log_cxt.error_context_stack = errcallback.previous;
 }
 
+static void stream_start_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_start";
+    state.report_location = txn->first_lsn;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /*
+     * set output state, the transaction is still in progress so nothing past
+     * its start may be confirmed on behalf of it
+     */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->first_lsn;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_start_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_stop_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_stop";
+    state.report_location = txn->first_lsn;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->first_lsn;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_stop_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_commit_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr commit_lsn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_commit";
+    state.report_location = txn->final_lsn; /* beginning of commit record */
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->end_lsn; /* points to the end of the record */
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_commit_cb(ctx, txn, commit_lsn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_abort_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr abort_lsn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_abort";
+    state.report_location = abort_lsn;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = abort_lsn;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_abort_cb(ctx, txn, abort_lsn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
 static void change_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, Relation relation,
                               ReorderBufferChange *change)
 {
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ *  logical_read_ahead.cpp
+ *      Read WAL ahead of the parallel decoding reader on helper threads.
+ *
+ * With the parallel-read-num option the reader of a parallel decoding slot
+ * hands disjoint, already flushed WAL ranges (chunks) to a ring pool (see
+ * ringpool.cpp), whose threads pread() them into the ring slots.  The
+ * reader's read_page callback then copies its pages out of the ring head, so
+ * the record parser sees exactly the byte stream the serial path would have
+ * read, while the file I/O of the next chunks proceeds in parallel.
+ *
+ * Record assembly and parsing stay on the reader: both depend on the record
+ * before them (continuation records, toast splicing, running xacts), so they
+ * cannot be split by LSN range without changing their result.
+ *
+ * Read-ahead is only an optimization.  A chunk that could not be read, a
+ * page beyond the last whole flushed chunk, or a wait cut short by a
+ * shutdown request all fall back to the serial read, which reads the page
+ * again and reports any error the usual way.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/replication/logical/logical_read_ahead.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "access/xlog.h"
+#include "access/xlog_internal.h"
+#include "miscadmin.h"
+#include "replication/parallel_decode_worker.h"
+#include "replication/ringpool.h"
+#include "utils/memutils.h"
+
+/* WAL read by one worker at a time, must divide the segment size */
+#define LOGICAL_READ_AHEAD_CHUNK_SIZE (1024 * 1024)
+/* chunks per worker, so every worker has the next range queued when it finishes one */
+#define LOGICAL_READ_AHEAD_SLOTS_PER_WORKER 4
+
+typedef struct LogicalReadAheadSlot {
+    XLogRecPtr startPtr;
+    XLogSegNo segno;
+    char path[MAXPGPATH];
+    char *buf;                       /* chunkSize bytes */
+    int err;                         /* errno of a failed read */
+} LogicalReadAheadSlot;
+
+/* Reader side of the pool, kept in pool->priv. */
+typedef struct LogicalReadAheadState {
+    uint32 chunkSize;
+    /*
+     * The ring slots hold consecutive chunks, the first one starting at the
+     * head slot's startPtr and the last one ending at nextPtr.
+     */
+    XLogRecPtr nextPtr;
+} LogicalReadAheadState;
+
+/* The segment a pool thread keeps open between chunks. */
+typedef struct LogicalReadAheadFile {
+    bool isOpen;
+    int fd;
+    XLogSegNo segno;
+} LogicalReadAheadFile;
+
+static int LogicalReadAheadChunk(int fd, LogicalReadAheadSlot *slot, uint32 chunkSize)
+{
+    off_t offset = (off_t)(slot->startPtr % XLogSegSize);
+    uint32 done = 0;
+
+    while (done < chunkSize) {
+        ssize_t nread = pread(fd, slot->buf + done, chunkSize - done, offset + (off_t)done);
+        if (nread < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        /* the segment is shorter than the flush position says, let the serial path sort it out */
+        if (nread == 0) {
+            return EIO;
+        }
+        done += (uint32)nread;
+    }
+    return 0;
+}
+
+static void LogicalReadAheadCloseFile(void *workerState)
+{
+    LogicalReadAheadFile *file = (LogicalReadAheadFile *)workerState;
+    if (file->isOpen) {
+        (void)close(file->fd);
+        file->isOpen = false;
+    }
+}
+
+/* Runs on a pool thread. */
+static bool LogicalReadAheadWork(const RingPool *pool, void *arg, void *workerState)
+{
+    LogicalReadAheadSlot *slot = (LogicalReadAheadSlot *)arg;
+    LogicalReadAheadFile *file = (LogicalReadAheadFile *)workerState;
+    uint32 chunkSize = ((LogicalReadAheadState *)pool->priv)->chunkSize;
+
+    /* consecutive chunks mostly come from the same segment, keep it open */
+    if (file->isOpen && file->segno != slot->segno) {
+        LogicalReadAheadCloseFile(file);
+    }
+    if (!file->isOpen) {
+        file->fd = open(slot->path, O_RDONLY | PG_BINARY, 0);
+        if (file->fd < 0) {
+            slot->err = errno;
+            return false;
+        }
+        file->isOpen = true;
+        file->segno = slot->segno;
+    }
+
+    slot->err = LogicalReadAheadChunk(file->fd, slot, chunkSize);
+    if (slot->err != 0) {
+        LogicalReadAheadCloseFile(file);
+        return false;
+    }
+    return true;
+}
+
+/* A stuck read must not keep the reader from noticing it is asked to stop. */
+static bool LogicalReadAheadInterrupt(void)
+{
+    CHECK_FOR_INTERRUPTS();
+    return IsLogicalWorkerShutdownRequested();
+}
+
+static RingPool *LogicalReadAheadPoolStart(int nworkers)
+{
+    RingPool *pool = RingPoolStart("LogicalReadAheadPool", nworkers, LOGICAL_READ_AHEAD_SLOTS_PER_WORKER,
+                                   sizeof(LogicalReadAheadSlot), sizeof(LogicalReadAheadFile),
+                                   LogicalReadAheadWork, LogicalReadAheadCloseFile, LogicalReadAheadInterrupt);
+    LogicalReadAheadState *state = (LogicalReadAheadState *)MemoryContextAllocZero(pool->context,
+                                                                                   sizeof(LogicalReadAheadState));
+    state->chunkSize = (uint32)Min(LOGICAL_READ_AHEAD_CHUNK_SIZE, XLogSegSize);
+    for (uint32 i = 0; i < pool->nslots; i++) {
+        LogicalReadAheadSlot *slot = (LogicalReadAheadSlot *)RingPoolSlot(pool, i);
+        slot->buf = (char *)MemoryContextAlloc(pool->context, state->chunkSize);
+    }
+    pool->priv = state;
+
+    ereport(LOG, (errmodule(MOD_LOGICAL_DECODE),
+                  errmsg("logical reader started %d WAL read-ahead threads", pool->nstarted)));
+    t_thrd.logicalreadworker_cxt.readAheadPool = pool;
+    return pool;
+}
+
+/*
+ * Throw away everything queued and start reading ahead again at the chunk
+ * holding startPtr.  Returns false if the chunks being read right now could
+ * not be waited for.
+ */
+static bool LogicalReadAheadReset(RingPool *pool, XLogRecPtr startPtr)
+{
+    LogicalReadAheadState *state = (LogicalReadAheadState *)pool->priv;
+
+    if (!RingPoolDiscard(pool)) {
+        return false;
+    }
+    state->nextPtr = startPtr - startPtr % state->chunkSize;
+    return true;
+}
+
+/* Queue as many whole, flushed chunks as there are free slots for. */
+static void LogicalReadAheadFill(RingPool *pool)
+{
+    LogicalReadAheadState *state = (LogicalReadAheadState *)pool->priv;
+    XLogRecPtr flushPtr = RecoveryInProgress() ? GetXLogReplayRecPtr(NULL) : GetFlushRecPtr();
+    uint64 newTail = pool->tail;
+
+    while (newTail - pool->head < pool->nslots && XLByteLE(state->nextPtr + state->chunkSize, flushPtr)) {
+        LogicalReadAheadSlot *slot = (LogicalReadAheadSlot *)RingPoolSlot(pool, newTail);
+        slot->startPtr = state->nextPtr;
+        XLByteToSeg(slot->startPtr, slot->segno);
+        XLogFilePath(slot->path, MAXPGPATH, t_thrd.xlog_cxt.ThisTimeLineID, slot->segno);
+        slot->err = 0;
+        state->nextPtr += state->chunkSize;
+        newTail++;
+    }
+    if (newTail != pool->tail) {
+        RingPoolSubmit(pool, newTail);
+    }
+}
+
+/*
+ * Copy the WAL page at pagePtr into page from the read-ahead ring.  Returns
+ * false if the page has to be read the usual way: read-ahead is off or
+ * could not start, the page is not flushed as a whole chunk yet, or the
+ * worker failed to read it.
+ */
+bool LogicalReadAheadPage(int nworkers, XLogRecPtr pagePtr, char *page)
+{
+    RingPool *pool = t_thrd.logicalreadworker_cxt.readAheadPool;
+
+    if (nworkers <= 0 || ENABLE_DSS) {
+        return false;
+    }
+    if (pool == NULL) {
+        pool = LogicalReadAheadPoolStart(nworkers);
+        (void)LogicalReadAheadReset(pool, pagePtr);
+    }
+    if (pool->nstarted == 0) {
+        return false;
+    }
+    LogicalReadAheadState *state = (LogicalReadAheadState *)pool->priv;
+
+    /* the reader went back, or skipped past what we have queued */
+    XLogRecPtr windowStart = (pool->head == pool->tail) ? state->nextPtr :
+        ((LogicalReadAheadSlot *)RingPoolSlot(pool, pool->head))->startPtr;
+    if (XLByteLT(pagePtr, windowStart) || XLByteLE(state->nextPtr, pagePtr)) {
+        if ((pool->head != pool->tail || pagePtr - pagePtr % state->chunkSize != state->nextPtr) &&
+            !LogicalReadAheadReset(pool, pagePtr)) {
+            return false;
+        }
+    }
+
+    /* release the chunks the reader is done with */
+    while (pool->head != pool->tail) {
+        LogicalReadAheadSlot *slot = (LogicalReadAheadSlot *)RingPoolSlot(pool, pool->head);
+        if (XLByteLT(pagePtr, slot->startPtr + state->chunkSize)) {
+            break;
+        }
+        if (RingPoolWaitSlot(pool, pool->head) == RING_SLOT_PENDING) {
+            return false;
+        }
+        RingPoolRelease(pool);
+    }
+
+    LogicalReadAheadFill(pool);
+    if (pool->head == pool->tail) {
+        return false;
+    }
+
+    LogicalReadAheadSlot *slot = (LogicalReadAheadSlot *)RingPoolSlot(pool, pool->head);
+    Assert(XLByteLE(slot->startPtr, pagePtr) && XLByteLT(pagePtr, slot->startPtr + state->chunkSize));
+    RingSlotState slotState = RingPoolWaitSlot(pool, pool->head);
+    if (slotState == RING_SLOT_PENDING) {
+        return false;
+    }
+    if (slotState == RING_SLOT_FAILED) {
+        ereport(DEBUG1, (errmodule(MOD_LOGICAL_DECODE),
+                         errmsg("WAL read-ahead of \"%s\" at %X/%X failed: %s, reading it again", slot->path,
+                                (uint32)(slot->startPtr >> 32), (uint32)slot->startPtr, gs_strerror(slot->err))));
+        return false;
+    }
+
+    errno_t rc = memcpy_s(page, XLOG_BLCKSZ, slot->buf + (pagePtr - slot->startPtr), XLOG_BLCKSZ);
+    securec_check(rc, "\0", "\0");
+
+    /*
+     * The segment might have been recycled while the worker read it, in which
+     * case the page may hold newer WAL.  Same check as after a serial read.
+     */
+    CheckXLogRemoved(slot->segno, t_thrd.xlog_cxt.ThisTimeLineID);
+    return true;
+}
+
+/*
+ * Stop the helper threads and release the pool.  Chunks still queued are
+ * dropped; the reader starts over from its own position next time.
+ */
+void LogicalReadAheadPoolStop(void)
+{
+    RingPool *pool = t_thrd.logicalreadworker_cxt.readAheadPool;
+    if (pool == NULL) {
+        return;
+    }
+    t_thrd.logicalreadworker_cxt.readAheadPool = NULL;
+    RingPoolStop(pool);
+}
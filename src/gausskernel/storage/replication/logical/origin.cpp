@@ -1052,6 +1052,40 @@ void replorigin_session_setup(RepOriginId node)
     pthread_mutex_unlock(&u_sess->reporigin_cxt.curRepState->originMutex);
 }
 
+/*
+ * Share a replication origin that another thread has already set up in its
+ * session, without taking it over.
+ *
+ * Used by parallel apply workers, whose commits advance the origin of their
+ * leader apply worker. Commits are made in remote commit order so the origin
+ * progress stays monotonic.
+ */
+void replorigin_session_attach(RepOriginId node, ThreadId acquired_by)
+{
+    int i;
+
+    if (u_sess->reporigin_cxt.curRepState != NULL)
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+            errmsg("cannot setup replication origin when one is already setup")));
+
+    LWLockAcquire(ReplicationOriginLock, LW_SHARED);
+
+    for (i = 0; i < g_instance.attr.attr_storage.max_replication_slots; i++) {
+        ReplicationState *curstate = &u_sess->reporigin_cxt.repStatesShm->states[i];
+
+        if (curstate->roident == node && curstate->acquired_by == acquired_by) {
+            u_sess->reporigin_cxt.curRepState = curstate;
+            break;
+        }
+    }
+
+    LWLockRelease(ReplicationOriginLock);
+
+    if (u_sess->reporigin_cxt.curRepState == NULL)
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+            errmsg("replication origin with OID %u is not active for PID %lu", node, acquired_by)));
+}
+
 /*
  * Reset replay state previously setup in this session.
  *
@@ -0,0 +1,967 @@
+/* ---------------------------------------------------------------------------------------
+ *
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * parallel_apply.cpp
+ *        Parallel apply of committed remote transactions for subscriptions.
+ *
+ * When max_parallel_apply_workers_per_subscription is set, the apply worker
+ * of a subscription (the leader) starts that many parallel apply workers and
+ * no longer applies changes itself. It buffers every remote transaction until
+ * its COMMIT and then hands it to one of the workers:
+ *
+ * - Every INSERT/UPDATE/DELETE is reduced to a hash of the relation and the
+ *   replica identity key of the row. The leader remembers which worker was
+ *   the last to get a transaction touching each key. A transaction touching
+ *   keys of not yet committed transactions of a single worker is queued
+ *   behind them on that worker; one depending on several workers waits until
+ *   all but one of them committed (a conflict wait). Others go to the least
+ *   loaded worker.
+ * - Workers apply their transactions concurrently, but commit them in remote
+ *   commit order. This keeps the replication origin progress, which the
+ *   workers share with the leader, valid for a restart, and keeps the flush
+ *   position reported to the publisher simple.
+ * - Transactions touching relations without a usable replica identity key,
+ *   or arriving while table synchronization is in progress, are applied by
+ *   the leader itself once the workers are idle.
+ * - If a worker fails, the leader stops the others and applies the not yet
+ *   committed transactions serially, then goes on without parallel apply.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/replication/logical/parallel_apply.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "funcapi.h"
+#include "miscadmin.h"
+
+#include "access/hash.h"
+#include "access/xact.h"
+
+#include "libpq/pqformat.h"
+
+#include "replication/logicalproto.h"
+#include "replication/logicalrelation.h"
+#include "replication/origin.h"
+#include "replication/worker_internal.h"
+
+#include "storage/ipc.h"
+#include "storage/lmgr.h"
+#include "storage/proc.h"
+
+#include "utils/builtins.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+#include "utils/timestamp.h"
+
+/* max sleep time while waiting for the other side (10ms) */
+static const long PARALLEL_APPLY_NAPTIME = 10L;
+/* prune committed entries from the key table once it gets this big */
+static const long PARALLEL_APPLY_KEYTAB_PRUNE = 65536L;
+static const int PARALLEL_APPLY_INIT_ITEMS = 16;
+static const int PG_GET_PARALLEL_APPLY_STATUS_COLS = 11;
+
+typedef struct ParallelApplyKeyEnt {
+    uint32 key;   /* replica identity key hash */
+    int worker;   /* index of the last worker given a transaction touching it */
+    uint64 seq;   /* commit order of that transaction */
+} ParallelApplyKeyEnt;
+
+typedef struct ParallelApplyRelMsgEnt {
+    uint32 relid;          /* remote relation id */
+    uint32 version;        /* bumped on every RELATION message */
+    StringInfoData msg;    /* last RELATION message */
+    uint32 *sentVersion;   /* version last sent to each worker */
+} ParallelApplyRelMsgEnt;
+
+static void ParallelApplyLeaderOnExit(int code, Datum arg);
+
+static inline ParallelApplyWorkerShared *ParallelApplyMyShared(void)
+{
+    return &t_thrd.applyworker_cxt.paGroup->workers[t_thrd.applyworker_cxt.curWorker->paIndex - 1];
+}
+
+static void *ParallelApplyGrowArray(void *array, int *maxitems, Size itemsize)
+{
+    if (array == NULL) {
+        *maxitems = PARALLEL_APPLY_INIT_ITEMS;
+        return MemoryContextAlloc(t_thrd.applyworker_cxt.paTxnContext, *maxitems * itemsize);
+    }
+    *maxitems *= 2;
+    return repalloc(array, *maxitems * itemsize);
+}
+
+static void ParallelApplyCopyMessage(StringInfo dst, StringInfo src)
+{
+    int len = src->len - src->cursor;
+    errno_t rc;
+
+    dst->data = (char *)MemoryContextAlloc(t_thrd.applyworker_cxt.paTxnContext, len + 1);
+    rc = memcpy_s(dst->data, len + 1, src->data + src->cursor, len);
+    securec_check(rc, "\0", "\0");
+    dst->data[len] = '\0';
+    dst->len = len;
+    dst->maxlen = len + 1;
+    dst->cursor = 0;
+}
+
+/*
+ * Start the parallel apply workers of this apply worker, if configured.
+ */
+void ParallelApplyStartWorkers(RepOriginId originid)
+{
+    int nworkers = u_sess->attr.attr_storage.max_parallel_apply_workers_per_subscription;
+    ParallelApplyGroup *group = NULL;
+    Subscription *sub = t_thrd.applyworker_cxt.mySubscription;
+    HASHCTL ctl;
+    Size size;
+    int i;
+    errno_t rc;
+
+    if (t_thrd.applyworker_cxt.paGroup != NULL)
+        ParallelApplyReleaseTxns(ParallelApplyStopWorkers());
+
+    if (nworkers <= 0 || AM_TABLESYNC_WORKER)
+        return;
+
+    if (t_thrd.applyworker_cxt.paTxnContext == NULL) {
+        t_thrd.applyworker_cxt.paTxnContext = AllocSetContextCreate(g_instance.instance_context,
+            "ParallelApplyTxnContext", ALLOCSET_DEFAULT_MINSIZE, ALLOCSET_DEFAULT_INITSIZE,
+            ALLOCSET_DEFAULT_MAXSIZE, SHARED_CONTEXT);
+    }
+
+    size = offsetof(ParallelApplyGroup, workers) + nworkers * sizeof(ParallelApplyWorkerShared);
+    group = (ParallelApplyGroup *)MemoryContextAllocZero(t_thrd.applyworker_cxt.paTxnContext, size);
+    group->subid = sub->oid;
+    group->leaderPid = t_thrd.proc_cxt.MyProcPid;
+    group->leader = t_thrd.applyworker_cxt.curWorker;
+    group->originId = originid;
+    group->txnContext = t_thrd.applyworker_cxt.paTxnContext;
+    pg_atomic_init_u64(&group->committedSeq, 0);
+    SpinLockInit(&group->mutex);
+    group->nworkers = nworkers;
+    for (i = 0; i < nworkers; i++) {
+        SpinLockInit(&group->workers[i].mutex);
+        pg_atomic_init_u64(&group->workers[i].assignedXacts, 0);
+        pg_atomic_init_u64(&group->workers[i].appliedXacts, 0);
+        pg_atomic_init_u64(&group->workers[i].conflictWaits, 0);
+        pg_atomic_init_u64(&group->workers[i].conflictWaitTime, 0);
+    }
+
+    t_thrd.applyworker_cxt.paGroup = group;
+    t_thrd.applyworker_cxt.paLastSeq = 0;
+    t_thrd.applyworker_cxt.paLastProgress = InvalidXLogRecPtr;
+
+    rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+    securec_check(rc, "\0", "\0");
+    ctl.keysize = sizeof(uint32);
+    ctl.entrysize = sizeof(ParallelApplyKeyEnt);
+    ctl.hcxt = t_thrd.applyworker_cxt.applyContext;
+    t_thrd.applyworker_cxt.paKeyTab = hash_create("parallel apply key table", 1024, &ctl,
+        HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+    ctl.entrysize = sizeof(ParallelApplyRelMsgEnt);
+    t_thrd.applyworker_cxt.paRelMsgTab = hash_create("parallel apply relation messages", 128, &ctl,
+        HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+    on_shmem_exit(ParallelApplyLeaderOnExit, (Datum)0);
+
+    for (i = 1; i <= nworkers; i++)
+        logicalrep_worker_launch(sub->dbid, sub->oid, sub->name, t_thrd.applyworker_cxt.curWorker->userid,
+            InvalidOid, group, i);
+
+    /* Go on serially rather than with fewer workers than asked for. */
+    (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+    for (i = 0; i < nworkers; i++) {
+        if (group->workers[i].worker == NULL || group->workers[i].worker->proc == NULL)
+            group->failed = true;
+    }
+    LWLockRelease(LogicalRepWorkerLock);
+
+    if (group->failed) {
+        ParallelApplyReleaseTxns(ParallelApplyStopWorkers());
+        ereport(WARNING, (errmsg("could not start parallel apply workers for subscription \"%s\", "
+            "applying changes serially", sub->name)));
+        return;
+    }
+
+    ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" started %d parallel apply workers",
+        sub->name, nworkers)));
+}
+
+static bool ParallelApplyWorkersGone(ParallelApplyGroup *group)
+{
+    bool gone = true;
+
+    (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+    for (int i = 0; i < group->nworkers; i++) {
+        if (group->workers[i].worker != NULL)
+            gone = false;
+    }
+    LWLockRelease(LogicalRepWorkerLock);
+    return gone;
+}
+
+/*
+ * Stop the parallel apply workers and release the group.
+ *
+ * Returns the transactions handed to the workers but not committed, in
+ * commit order. The caller must apply them itself and then hand them to
+ * ParallelApplyReleaseTxns(), which also drops the shared context they live in.
+ */
+List *ParallelApplyStopWorkers(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.paGroup;
+    List *uncommitted = NIL;
+    ListCell *lc = NULL;
+    uint64 committed;
+
+    if (group == NULL)
+        return NIL;
+
+    group->shutdown = true;
+
+    (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+    for (int i = 0; i < group->nworkers; i++) {
+        LogicalRepWorker *w = group->workers[i].worker;
+
+        if (w != NULL && w->proc != NULL)
+            (void)gs_signal_send(w->proc->pid, SIGTERM);
+    }
+    LWLockRelease(LogicalRepWorkerLock);
+
+    /* Also called on exit, so no interrupt processing here. */
+    while (!ParallelApplyWorkersGone(group)) {
+        int rc = WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+            PARALLEL_APPLY_NAPTIME);
+        if (rc & WL_POSTMASTER_DEATH)
+            break;
+        ResetLatch(&t_thrd.proc->procLatch);
+    }
+
+    committed = pg_atomic_read_u64(&group->committedSeq);
+    foreach (lc, t_thrd.applyworker_cxt.paDispatched) {
+        ParallelApplyTxn *txn = (ParallelApplyTxn *)lfirst(lc);
+
+        if (txn->seq <= committed) {
+            ParallelApplyFreeTxn(txn);
+        } else {
+            uncommitted = lappend(uncommitted, txn);
+        }
+    }
+    list_free(t_thrd.applyworker_cxt.paDispatched);
+    t_thrd.applyworker_cxt.paDispatched = NIL;
+
+    if (t_thrd.applyworker_cxt.paCurTxn != NULL) {
+        ParallelApplyFreeTxn(t_thrd.applyworker_cxt.paCurTxn);
+        t_thrd.applyworker_cxt.paCurTxn = NULL;
+    }
+
+    hash_destroy(t_thrd.applyworker_cxt.paKeyTab);
+    t_thrd.applyworker_cxt.paKeyTab = NULL;
+    hash_destroy(t_thrd.applyworker_cxt.paRelMsgTab);
+    t_thrd.applyworker_cxt.paRelMsgTab = NULL;
+
+    t_thrd.applyworker_cxt.paGroup = NULL;
+    pfree(group);
+
+    return uncommitted;
+}
+
+/*
+ * Release the transactions returned by ParallelApplyStopWorkers() along with
+ * the shared context of the buffered transactions. The context lives under
+ * the instance context, so it must not outlive the group.
+ */
+void ParallelApplyReleaseTxns(List *txns)
+{
+    Assert(t_thrd.applyworker_cxt.paGroup == NULL);
+
+    list_free(txns);
+    if (t_thrd.applyworker_cxt.paTxnContext != NULL) {
+        MemoryContextDelete(t_thrd.applyworker_cxt.paTxnContext);
+        t_thrd.applyworker_cxt.paTxnContext = NULL;
+    }
+}
+
+static void ParallelApplyLeaderOnExit(int code, Datum arg)
+{
+    /*
+     * The origin progress makes the publisher send the uncommitted ones
+     * again. The group may be gone already if the leader failed while
+     * applying them itself, the context is released anyway.
+     */
+    ParallelApplyReleaseTxns(ParallelApplyStopWorkers());
+}
+
+void ParallelApplyFreeTxn(ParallelApplyTxn *txn)
+{
+    int i;
+
+    for (i = 0; i < txn->nmsgs; i++)
+        pfree(txn->msgs[i].data);
+    for (i = 0; i < txn->nrelmsgs; i++)
+        pfree(txn->relmsgs[i].data);
+    if (txn->msgs != NULL)
+        pfree(txn->msgs);
+    if (txn->relmsgs != NULL)
+        pfree(txn->relmsgs);
+    if (txn->keys != NULL)
+        pfree(txn->keys);
+    if (txn->relids != NULL)
+        pfree(txn->relids);
+    pfree(txn);
+}
+
+bool ParallelApplyFailed(void)
+{
+    return t_thrd.applyworker_cxt.paGroup != NULL && t_thrd.applyworker_cxt.paGroup->failed;
+}
+
+/*
+ * Are there transactions handed to the workers that are not committed yet?
+ */
+bool ParallelApplyHasPendingTxns(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.paGroup;
+
+    return group != NULL && t_thrd.applyworker_cxt.paLastSeq > pg_atomic_read_u64(&group->committedSeq);
+}
+
+/*
+ * Get the remote and local end of the last transaction committed by the
+ * workers. Returns false if there is nothing new since the last call.
+ */
+bool ParallelApplyGetProgress(XLogRecPtr *remote_end, XLogRecPtr *local_end)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.paGroup;
+
+    if (group == NULL)
+        return false;
+
+    SpinLockAcquire(&group->mutex);
+    *remote_end = group->committedRemoteEnd;
+    *local_end = group->committedLocalEnd;
+    SpinLockRelease(&group->mutex);
+
+    if (*remote_end <= t_thrd.applyworker_cxt.paLastProgress)
+        return false;
+    t_thrd.applyworker_cxt.paLastProgress = *remote_end;
+    return true;
+}
+
+/*
+ * Remember a RELATION message, the workers get it along with the first
+ * transaction touching the relation that is handed to them after it.
+ */
+void ParallelApplyRememberRelation(StringInfo s)
+{
+    StringInfoData msg = *s;
+    ParallelApplyRelMsgEnt *ent = NULL;
+    MemoryContext oldctx;
+    uint32 relid;
+    bool found = false;
+
+    (void)pq_getmsgbyte(&msg);
+    relid = pq_getmsgint(&msg, 4);
+
+    ent = (ParallelApplyRelMsgEnt *)hash_search(t_thrd.applyworker_cxt.paRelMsgTab, &relid, HASH_ENTER, &found);
+    oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+    if (!found) {
+        ent->version = 0;
+        ent->sentVersion = (uint32 *)palloc0(t_thrd.applyworker_cxt.paGroup->nworkers * sizeof(uint32));
+    } else {
+        pfree(ent->msg.data);
+    }
+    ent->version++;
+    initStringInfo(&ent->msg);
+    appendBinaryStringInfo(&ent->msg, s->data + s->cursor, s->len - s->cursor);
+    MemoryContextSwitchTo(oldctx);
+}
+
+static void ParallelApplyAddRelation(ParallelApplyTxn *txn, uint32 relid)
+{
+    for (int i = 0; i < txn->nrelids; i++) {
+        if (txn->relids[i] == relid)
+            return;
+    }
+    if (txn->nrelids == txn->maxrelids)
+        txn->relids = (uint32 *)ParallelApplyGrowArray(txn->relids, &txn->maxrelids, sizeof(uint32));
+    txn->relids[txn->nrelids++] = relid;
+}
+
+/*
+ * Hash the replica identity key of a row, false if the tuple does not
+ * carry all of it.
+ */
+static bool ParallelApplyKeyHash(uint32 relid, LogicalRepRelation *remoterel, LogicalRepTupleData *tup,
+    uint32 *key)
+{
+    uint32 hashval = DatumGetUInt32(hash_uint32(relid));
+    int attnum = -1;
+
+    while ((attnum = bms_next_member(remoterel->attkeys, attnum)) >= 0) {
+        if (attnum >= tup->ncols || tup->colstatus[attnum] == LOGICALREP_COLUMN_UNCHANGED)
+            return false;
+
+        hashval = (hashval << 1) | (hashval >> 31);
+        if (tup->colstatus[attnum] != LOGICALREP_COLUMN_NULL)
+            hashval ^= DatumGetUInt32(hash_any((const unsigned char *)tup->colvalues[attnum].data,
+                tup->colvalues[attnum].len));
+    }
+
+    *key = hashval;
+    return true;
+}
+
+static void ParallelApplyAddKey(ParallelApplyTxn *txn, uint32 relid, LogicalRepRelation *remoterel,
+    LogicalRepTupleData *tup)
+{
+    uint32 key;
+
+    if (!ParallelApplyKeyHash(relid, remoterel, tup, &key)) {
+        txn->serial = true;
+        return;
+    }
+    if (txn->nkeys == txn->maxkeys)
+        txn->keys = (uint32 *)ParallelApplyGrowArray(txn->keys, &txn->maxkeys, sizeof(uint32));
+    txn->keys[txn->nkeys++] = key;
+}
+
+/*
+ * Collect the relation and the replica identity keys touched by a change.
+ */
+static void ParallelApplyTrackChange(ParallelApplyTxn *txn, StringInfo s)
+{
+    StringInfoData msg = *s;
+    LogicalRepTupleData oldtup;
+    LogicalRepTupleData newtup;
+    LogicalRepRelation *remoterel = NULL;
+    bool has_oldtup = false;
+    uint32 relid;
+    char action = pq_getmsgbyte(&msg);
+
+    switch (action) {
+        case 'I':
+            relid = logicalrep_read_insert(&msg, &newtup);
+            break;
+        case 'U':
+            relid = logicalrep_read_update(&msg, &has_oldtup, &oldtup, &newtup);
+            break;
+        default:
+            relid = logicalrep_read_delete(&msg, &oldtup);
+            has_oldtup = true;
+            break;
+    }
+
+    ParallelApplyAddRelation(txn, relid);
+
+    /*
+     * Rows of relations with REPLICA IDENTITY FULL or without any identity
+     * can't be told apart cheaply, leave those to the leader.
+     */
+    remoterel = logicalrep_remoterel_find(relid);
+    if (remoterel == NULL || remoterel->replident == REPLICA_IDENTITY_FULL || bms_is_empty(remoterel->attkeys)) {
+        txn->serial = true;
+        return;
+    }
+
+    if (has_oldtup)
+        ParallelApplyAddKey(txn, relid, remoterel, &oldtup);
+    if (action != 'D')
+        ParallelApplyAddKey(txn, relid, remoterel, &newtup);
+}
+
+/*
+ * Buffer a message of the remote transaction being received.
+ */
+void ParallelApplyBufferMessage(StringInfo s)
+{
+    ParallelApplyTxn *txn = t_thrd.applyworker_cxt.paCurTxn;
+    char action = s->data[s->cursor];
+
+    if (action == 'B') {
+        if (txn != NULL)
+            ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("BEGIN message sent out of order")));
+        txn = (ParallelApplyTxn *)MemoryContextAllocZero(t_thrd.applyworker_cxt.paTxnContext,
+            sizeof(ParallelApplyTxn));
+        t_thrd.applyworker_cxt.paCurTxn = txn;
+    } else if (txn == NULL) {
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+            errmsg("logical replication message \"%c\" sent outside of a transaction", action)));
+    }
+
+    if (txn->nmsgs == txn->maxmsgs)
+        txn->msgs = (StringInfoData *)ParallelApplyGrowArray(txn->msgs, &txn->maxmsgs, sizeof(StringInfoData));
+    ParallelApplyCopyMessage(&txn->msgs[txn->nmsgs++], s);
+
+    if (action == 'I' || action == 'U' || action == 'D') {
+        ParallelApplyTrackChange(txn, s);
+    } else if (action == 'C') {
+        StringInfoData msg = *s;
+        LogicalRepCommitData commit_data;
+
+        (void)pq_getmsgbyte(&msg);
+        logicalrep_read_commit(&msg, &commit_data);
+        txn->endLsn = commit_data.end_lsn;
+        txn->commitTime = commit_data.committime;
+    }
+}
+
+/*
+ * Free the dispatched transactions the workers have committed.
+ */
+static void ParallelApplyReclaimTxns(void)
+{
+    uint64 committed = pg_atomic_read_u64(&t_thrd.applyworker_cxt.paGroup->committedSeq);
+
+    while (t_thrd.applyworker_cxt.paDispatched != NIL) {
+        ParallelApplyTxn *txn = (ParallelApplyTxn *)linitial(t_thrd.applyworker_cxt.paDispatched);
+
+        if (txn->seq > committed)
+            break;
+        ParallelApplyFreeTxn(txn);
+        t_thrd.applyworker_cxt.paDispatched = list_delete_first(t_thrd.applyworker_cxt.paDispatched);
+    }
+}
+
+static void ParallelApplyPruneKeys(void)
+{
+    HASH_SEQ_STATUS status;
+    ParallelApplyKeyEnt *ent = NULL;
+    uint64 committed = pg_atomic_read_u64(&t_thrd.applyworker_cxt.paGroup->committedSeq);
+
+    if (hash_get_num_entries(t_thrd.applyworker_cxt.paKeyTab) < PARALLEL_APPLY_KEYTAB_PRUNE)
+        return;
+
+    hash_seq_init(&status, t_thrd.applyworker_cxt.paKeyTab);
+    while ((ent = (ParallelApplyKeyEnt *)hash_seq_search(&status)) != NULL) {
+        if (ent->seq <= committed)
+            (void)hash_search(t_thrd.applyworker_cxt.paKeyTab, &ent->key, HASH_REMOVE, NULL);
+    }
+}
+
+/*
+ * Wait until the transactions up to committedSeq are committed, or with
+ * queueWorker >= 0, until the queue of that worker has room.
+ *
+ * Returns false if a worker failed meanwhile.
+ */
+static bool ParallelApplyLeaderWait(uint64 committedSeq, int queueWorker)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.paGroup;
+
+    for (;;) {
+        int rc;
+
+        if (group->failed)
+            return false;
+        if (queueWorker >= 0) {
+            ParallelApplyWorkerShared *shared = &group->workers[queueWorker];
+            uint32 used;
+
+            SpinLockAcquire(&shared->mutex);
+            used = shared->tail - shared->head;
+            SpinLockRelease(&shared->mutex);
+            if (used < PARALLEL_APPLY_QUEUE_SIZE)
+                return true;
+        } else if (pg_atomic_read_u64(&group->committedSeq) >= committedSeq) {
+            return true;
+        }
+
+        rc = WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+            PARALLEL_APPLY_NAPTIME);
+        if (rc & WL_POSTMASTER_DEATH)
+            proc_exit(1);
+        ResetLatch(&t_thrd.proc->procLatch);
+        CHECK_FOR_INTERRUPTS();
+    }
+}
+
+static int ParallelApplyLeastLoaded(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.paGroup;
+    int start = (int)(t_thrd.applyworker_cxt.paLastSeq % group->nworkers);
+    int best = start;
+    uint32 bestUsed = PG_UINT32_MAX;
+
+    for (int n = 0; n < group->nworkers; n++) {
+        int i = (start + n) % group->nworkers;
+        ParallelApplyWorkerShared *shared = &group->workers[i];
+        uint32 used;
+
+        SpinLockAcquire(&shared->mutex);
+        used = shared->tail - shared->head;
+        SpinLockRelease(&shared->mutex);
+        if (used < bestUsed) {
+            best = i;
+            bestUsed = used;
+        }
+    }
+    return best;
+}
+
+/*
+ * Attach the RELATION messages of the touched relations the worker has not
+ * seen in their current version.
+ */
+static void ParallelApplyAttachRelations(ParallelApplyTxn *txn, int worker)
+{
+    for (int i = 0; i < txn->nrelids; i++) {
+        ParallelApplyRelMsgEnt *ent = (ParallelApplyRelMsgEnt *)hash_search(t_thrd.applyworker_cxt.paRelMsgTab,
+            &txn->relids[i], HASH_FIND, NULL);
+
+        if (ent == NULL || ent->sentVersion[worker] == ent->version)
+            continue;
+        if (txn->relmsgs == NULL)
+            txn->relmsgs = (StringInfoData *)MemoryContextAlloc(t_thrd.applyworker_cxt.paTxnContext,
+                txn->nrelids * sizeof(StringInfoData));
+        ParallelApplyCopyMessage(&txn->relmsgs[txn->nrelmsgs++], &ent->msg);
+        ent->sentVersion[worker] = ent->version;
+    }
+}
+
+/*
+ * Hand the transaction just buffered to a parallel apply worker.
+ *
+ * Returns NULL when it was handed over. Otherwise returns it for the leader
+ * to apply itself: all the transactions handed over before it are committed
+ * then, unless ParallelApplyFailed() says the workers must be stopped first.
+ */
+ParallelApplyTxn *ParallelApplyDispatchTxn(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.paGroup;
+    ParallelApplyTxn *txn = t_thrd.applyworker_cxt.paCurTxn;
+    ParallelApplyWorkerShared *shared = NULL;
+    uint64 committed;
+    uint64 targetSeq = 0;
+    uint64 waitSeq = 0;
+    int target = -1;
+    int i;
+
+    t_thrd.applyworker_cxt.paCurTxn = NULL;
+    ParallelApplyReclaimTxns();
+
+    if (txn->serial || !t_thrd.applyworker_cxt.tableStatesValid || t_thrd.applyworker_cxt.tableStates != NIL) {
+        (void)ParallelApplyLeaderWait(t_thrd.applyworker_cxt.paLastSeq, -1);
+        return txn;
+    }
+
+    /* Find the workers with uncommitted transactions touching the same keys. */
+    committed = pg_atomic_read_u64(&group->committedSeq);
+    for (i = 0; i < txn->nkeys; i++) {
+        ParallelApplyKeyEnt *ent = (ParallelApplyKeyEnt *)hash_search(t_thrd.applyworker_cxt.paKeyTab,
+            &txn->keys[i], HASH_FIND, NULL);
+
+        if (ent == NULL || ent->seq <= committed || ent->worker == target)
+            continue;
+        if (ent->seq > targetSeq) {
+            if (target >= 0)
+                waitSeq = Max(waitSeq, targetSeq);
+            target = ent->worker;
+            targetSeq = ent->seq;
+        } else {
+            waitSeq = Max(waitSeq, ent->seq);
+        }
+    }
+
+    if (target < 0)
+        target = ParallelApplyLeastLoaded();
+    shared = &group->workers[target];
+
+    /* Depends on more than one worker, wait for all but the latest one. */
+    if (waitSeq > 0) {
+        TimestampTz start = GetCurrentTimestamp();
+        long secs;
+        int usecs;
+
+        if (!ParallelApplyLeaderWait(waitSeq, -1))
+            return txn;
+        TimestampDifference(start, GetCurrentTimestamp(), &secs, &usecs);
+        (void)pg_atomic_fetch_add_u64(&shared->conflictWaits, 1);
+        (void)pg_atomic_fetch_add_u64(&shared->conflictWaitTime, (uint64)secs * USECS_PER_SEC + usecs);
+    }
+
+    if (!ParallelApplyLeaderWait(0, target))
+        return txn;
+
+    txn->seq = ++t_thrd.applyworker_cxt.paLastSeq;
+    ParallelApplyAttachRelations(txn, target);
+    for (i = 0; i < txn->nkeys; i++) {
+        ParallelApplyKeyEnt *ent = (ParallelApplyKeyEnt *)hash_search(t_thrd.applyworker_cxt.paKeyTab,
+            &txn->keys[i], HASH_ENTER, NULL);
+
+        ent->worker = target;
+        ent->seq = txn->seq;
+    }
+
+    t_thrd.applyworker_cxt.paDispatched = lappend(t_thrd.applyworker_cxt.paDispatched, txn);
+
+    SpinLockAcquire(&shared->mutex);
+    shared->queue[shared->tail % PARALLEL_APPLY_QUEUE_SIZE] = txn;
+    shared->tail++;
+    SpinLockRelease(&shared->mutex);
+    (void)pg_atomic_fetch_add_u64(&shared->assignedXacts, 1);
+
+    (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+    if (shared->worker != NULL && shared->worker->proc != NULL)
+        logicalrep_worker_wakeup_ptr(shared->worker);
+    LWLockRelease(LogicalRepWorkerLock);
+
+    ParallelApplyPruneKeys();
+    return NULL;
+}
+
+/*
+ * Wait until every transaction handed to the workers so far has committed,
+ * before the leader applies something itself. Returns false if a worker
+ * failed meanwhile.
+ */
+bool ParallelApplyWaitForAll(void)
+{
+    bool ok = ParallelApplyLeaderWait(t_thrd.applyworker_cxt.paLastSeq, -1);
+
+    ParallelApplyReclaimTxns();
+    return ok;
+}
+
+/*
+ * Set up a parallel apply worker: join the group and share the leader's
+ * replication origin.
+ */
+void ParallelApplyWorkerInit(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.curWorker->paGroup;
+
+    t_thrd.applyworker_cxt.paGroup = group;
+    replorigin_session_attach(group->originId, group->leaderPid);
+    u_sess->reporigin_cxt.originId = group->originId;
+}
+
+/*
+ * Take the next transaction queued to this worker, NULL if there is none.
+ */
+ParallelApplyTxn *ParallelApplyNextTxn(void)
+{
+    ParallelApplyWorkerShared *shared = ParallelApplyMyShared();
+    ParallelApplyTxn *txn = NULL;
+
+    if (t_thrd.applyworker_cxt.paGroup->shutdown)
+        proc_exit(0);
+
+    SpinLockAcquire(&shared->mutex);
+    if (shared->head != shared->tail) {
+        txn = shared->queue[shared->head % PARALLEL_APPLY_QUEUE_SIZE];
+        shared->head++;
+    }
+    SpinLockRelease(&shared->mutex);
+
+    if (txn != NULL)
+        shared->applyingSeq = txn->seq;
+    return txn;
+}
+
+/*
+ * The local transaction of the worker applying the given transaction, if
+ * it has one.
+ */
+static TransactionId ParallelApplyXidOf(uint64 seq)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.paGroup;
+    TransactionId xid = InvalidTransactionId;
+
+    (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+    for (int i = 0; i < group->nworkers; i++) {
+        LogicalRepWorker *w = group->workers[i].worker;
+
+        if (group->workers[i].applyingSeq == seq && w != NULL && w->proc != NULL) {
+            xid = g_instance.proc_base_all_xacts[w->proc->pgprocno].xid;
+            break;
+        }
+    }
+    LWLockRelease(LogicalRepWorkerLock);
+    return xid;
+}
+
+/*
+ * Wait until all transactions before the one being applied are committed.
+ *
+ * While in a transaction, wait on the local transaction of the worker that
+ * commits next, so that the deadlock detector sees the wait if that one is
+ * blocked by a row we changed.
+ */
+void ParallelApplyWaitCommitTurn(void)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.paGroup;
+    uint64 seq = t_thrd.applyworker_cxt.paCurTxn->seq;
+
+    for (;;) {
+        uint64 committed = pg_atomic_read_u64(&group->committedSeq);
+        TransactionId xid = InvalidTransactionId;
+
+        if (committed + 1 >= seq)
+            break;
+
+        if (IsTransactionState())
+            xid = ParallelApplyXidOf(committed + 1);
+        if (TransactionIdIsValid(xid)) {
+            XactLockTableWait(xid);
+        } else {
+            int rc = WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH, 1L);
+            if (rc & WL_POSTMASTER_DEATH)
+                proc_exit(1);
+            ResetLatch(&t_thrd.proc->procLatch);
+        }
+        CHECK_FOR_INTERRUPTS();
+    }
+}
+
+/*
+ * Publish the commit of the transaction being applied and wake up whoever
+ * waits for it.
+ *
+ * Once committedSeq is published the leader may free the transaction, so it
+ * must not be touched afterwards; paCurTxn is reset here.
+ */
+void ParallelApplyFinishTxn(XLogRecPtr local_end)
+{
+    ParallelApplyGroup *group = t_thrd.applyworker_cxt.paGroup;
+    ParallelApplyWorkerShared *shared = ParallelApplyMyShared();
+    ParallelApplyTxn *txn = t_thrd.applyworker_cxt.paCurTxn;
+    uint64 seq = txn->seq;
+    XLogRecPtr endLsn = txn->endLsn;
+    TimestampTz commitTime = txn->commitTime;
+    TimestampTz now = GetCurrentTimestamp();
+    long secs;
+    int usecs;
+
+    SpinLockAcquire(&group->mutex);
+    group->committedRemoteEnd = endLsn;
+    if (local_end > group->committedLocalEnd)
+        group->committedLocalEnd = local_end;
+    SpinLockRelease(&group->mutex);
+
+    t_thrd.applyworker_cxt.paCurTxn = NULL;
+    pg_atomic_write_u64(&group->committedSeq, seq);
+
+    TimestampDifference(commitTime, now, &secs, &usecs);
+    shared->applyingSeq = 0;
+    shared->lastCommitLsn = endLsn;
+    shared->applyLag = secs * MSECS_PER_SEC + usecs / USECS_PER_MSEC;
+    (void)pg_atomic_fetch_add_u64(&shared->appliedXacts, 1);
+
+    (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+    if (group->leader->proc != NULL)
+        SetLatch(&group->leader->proc->procLatch);
+    for (int i = 0; i < group->nworkers; i++) {
+        LogicalRepWorker *w = group->workers[i].worker;
+
+        if (w != NULL && w->proc != NULL && w != t_thrd.applyworker_cxt.curWorker)
+            SetLatch(&w->proc->procLatch);
+    }
+    LWLockRelease(LogicalRepWorkerLock);
+}
+
+/*
+ * Returns the state of the parallel apply workers.
+ */
+Datum gs_get_parallel_apply_status(PG_FUNCTION_ARGS)
+{
+    ReturnSetInfo *rsinfo = (ReturnSetInfo *)fcinfo->resultinfo;
+    TupleDesc tupdesc;
+    Tuplestorestate *tupstore;
+    MemoryContext per_query_ctx;
+    MemoryContext oldcontext;
+
+    /* check to see if caller supports us returning a tuplestore */
+    if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+            errmsg("set-valued function called in context that cannot accept a set")));
+    if (!(rsinfo->allowedModes & SFRM_Materialize))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("materialize mode required, but it is not "
+            "allowed in this context")));
+
+    /* Build a tuple descriptor for our result type */
+    if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+        elog(ERROR, "return type must be a row type");
+
+    per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+    oldcontext = MemoryContextSwitchTo(per_query_ctx);
+
+    tupstore = tuplestore_begin_heap(true, false, u_sess->attr.attr_memory.work_mem);
+    rsinfo->returnMode = SFRM_Materialize;
+    rsinfo->setResult = tupstore;
+    rsinfo->setDesc = tupdesc;
+
+    MemoryContextSwitchTo(oldcontext);
+
+    /* The group stays valid while any of its workers holds a slot. */
+    (void)LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+
+    for (int i = 0; i < g_instance.attr.attr_storage.max_logical_replication_workers; i++) {
+        LogicalRepWorker *w = &t_thrd.applylauncher_cxt.applyLauncherShm->workers[i];
+        ParallelApplyWorkerShared *shared = NULL;
+        Datum values[PG_GET_PARALLEL_APPLY_STATUS_COLS];
+        bool nulls[PG_GET_PARALLEL_APPLY_STATUS_COLS];
+        uint64 assigned;
+        uint64 applied;
+        XLogRecPtr lsn;
+        int idx = 0;
+        int rc;
+
+        if (w->paGroup == NULL || w->proc == NULL)
+            continue;
+        shared = &w->paGroup->workers[w->paIndex - 1];
+
+        rc = memset_s(nulls, sizeof(nulls), 0, sizeof(nulls));
+        securec_check(rc, "\0", "\0");
+
+        assigned = pg_atomic_read_u64(&shared->assignedXacts);
+        applied = pg_atomic_read_u64(&shared->appliedXacts);
+        lsn = shared->lastCommitLsn;
+
+        values[idx++] = ObjectIdGetDatum(w->subid);
+        values[idx++] = Int64GetDatum((int64)w->paGroup->leaderPid);
+        values[idx++] = Int32GetDatum(w->paIndex);
+        values[idx++] = Int64GetDatum((int64)w->proc->pid);
+        values[idx++] = Int64GetDatum((int64)assigned);
+        values[idx++] = Int64GetDatum((int64)applied);
+        values[idx++] = Int64GetDatum((int64)(assigned - applied));
+        values[idx++] = Int64GetDatum((int64)pg_atomic_read_u64(&shared->conflictWaits));
+        values[idx++] = Int64GetDatum((int64)pg_atomic_read_u64(&shared->conflictWaitTime));
+        if (XLogRecPtrIsInvalid(lsn)) {
+            nulls[idx++] = true;
+            nulls[idx++] = true;
+        } else {
+            char lsn_s[MAXFNAMELEN];
+            int nRet = snprintf_s(lsn_s, sizeof(lsn_s), sizeof(lsn_s) - 1, "%X/%X",
+                (uint32)(lsn >> BITS_PER_INT), (uint32)lsn);
+            securec_check_ss(nRet, "\0", "\0");
+            values[idx++] = CStringGetTextDatum(lsn_s);
+            values[idx++] = Int64GetDatum(shared->applyLag);
+        }
+
+        tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+    }
+
+    LWLockRelease(LogicalRepWorkerLock);
+
+    /* clean up and return the tuplestore */
+    tuplestore_donestoring(tupstore);
+
+    return (Datum)0;
+}
@@ -479,8 +479,40 @@ static inline bool AppendInvalidations(StringInfo s, TupleDesc tupdesc, HeapTupl
     return false;
 }
 
+/*
+ * Append one column value. With binarySend the type's send function is used, which avoids the
+ * text rendering of the output function and is what the client has to decode; otherwise the
+ * value is shipped in its text form.
+ */
+static inline void AppendColumnValue(StringInfo s, Oid typid, Datum origval, bool binarySend)
+{
+    bool typisvarlena = false;
+    Datum val = origval;
+
+    if (binarySend) {
+        Oid typsend = InvalidOid;
+        getTypeBinaryOutputInfo(typid, &typsend, &typisvarlena);
+        if (typisvarlena) {
+            val = PointerGetDatum(PG_DETOAST_DATUM(origval));
+        }
+        bytea *data = OidSendFunctionCall(typsend, val);
+        pq_sendint32(s, VARSIZE(data) - VARHDRSZ);
+        appendBinaryStringInfo(s, VARDATA(data), VARSIZE(data) - VARHDRSZ);
+        return;
+    }
+
+    Oid typoutput = InvalidOid;
+    getTypeOutputInfo(typid, &typoutput, &typisvarlena);
+    if (typisvarlena) {
+        val = PointerGetDatum(PG_DETOAST_DATUM(origval));
+    }
+    char *data = OidOutputFunctionCall(typoutput, val);
+    pq_sendint32(s, strlen(data));
+    appendStringInfoString(s, data);
+}
+
 /* decode a tuple into binary style */
-static void AppendTuple(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool skipNulls)
+static void AppendTuple(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool skipNulls, bool binarySend)
 {
     if (AppendInvalidations(s, tupdesc, tuple)) {
         return;
@@ -510,21 +542,11 @@ static void AppendTuple(StringInfo s, TupleDesc tupdesc, HeapTuple tuple, bool s
         pq_sendint16(s, (uint16)strlen(columnName));
         appendStringInfoString(s, columnName);
         pq_sendint32(s, typid);
-        Oid typoutput = 0;
-        bool typisvarlena = false;
-        getTypeOutputInfo(typid, &typoutput, &typisvarlena);
         const uint32 nullTag = 0xFFFFFFFF;
         if (isnull) {
             pq_sendint32(s, nullTag);
-        } else if (!typisvarlena) {
-            char *data = OidOutputFunctionCall(typoutput, origval);
-            pq_sendint32(s, strlen(data));
-            appendStringInfoString(s, data);
         } else {
-            Datum val = PointerGetDatum(PG_DETOAST_DATUM(origval));
-            char *data = OidOutputFunctionCall(typoutput, val);
-            pq_sendint32(s, strlen(data));
-            appendStringInfoString(s, data);
+            AppendColumnValue(s, typid, origval, binarySend);
         }
     }
     attrNum = ntohs(attrNum);
@@ -540,6 +562,7 @@ void parallel_decode_change_to_bin(Relation relation, ParallelReorderBufferChang
     logChange->lsn = change->lsn;
     logChange->xid = change->xid;
     ParallelDecodingData *data = (ParallelDecodingData *)ctx->output_plugin_private;
+    bool binarySend = data->pOptions.binary_send;
     MemoryContext old = MemoryContextSwitchTo(data->context);
 
     Form_pg_class class_form = RelationGetForm(relation);
@@ -562,7 +585,7 @@ void parallel_decode_change_to_bin(Relation relation, ParallelReorderBufferChang
             AppendRelation(logChange->out, tupdesc, schema, table);
             if (change->data.tp.newtuple != NULL) {
                 appendStringInfoChar(logChange->out, 'N');
-                AppendTuple(logChange->out, tupdesc, &change->data.tp.newtuple->tuple, false);
+                AppendTuple(logChange->out, tupdesc, &change->data.tp.newtuple->tuple, false, binarySend);
             }
             break;
 
@@ -573,11 +596,11 @@ void parallel_decode_change_to_bin(Relation relation, ParallelReorderBufferChang
 
             if (change->data.tp.newtuple != NULL) {
                 appendStringInfoChar(logChange->out, 'N');
-                AppendTuple(logChange->out, tupdesc, &change->data.tp.newtuple->tuple, false);
+                AppendTuple(logChange->out, tupdesc, &change->data.tp.newtuple->tuple, false, binarySend);
             }
             if (change->data.tp.oldtuple != NULL) {
                 appendStringInfoChar(logChange->out, 'O');
-                AppendTuple(logChange->out, tupdesc, &change->data.tp.oldtuple->tuple, true);
+                AppendTuple(logChange->out, tupdesc, &change->data.tp.oldtuple->tuple, true, binarySend);
             }
             break;
 
@@ -588,7 +611,7 @@ void parallel_decode_change_to_bin(Relation relation, ParallelReorderBufferChang
             /* if there was no PK, we only know that a delete happened */
             if (change->data.tp.oldtuple != NULL) {
                 appendStringInfoChar(logChange->out, 'O');
-                AppendTuple(logChange->out, tupdesc, &change->data.tp.oldtuple->tuple, true);
+                AppendTuple(logChange->out, tupdesc, &change->data.tp.oldtuple->tuple, true, binarySend);
             }
             break;
 
@@ -144,6 +144,8 @@ static void LogicalReadKill(int code, Datum arg)
 {
     ereport(LOG, (errmsg("LogicalReader process shutdown.")));
 
+    LogicalReadAheadPoolStop();
+
     /* Make sure active replication slots are released */
     CleanMyReplicationSlot();
 
@@ -931,6 +933,12 @@ static void ParseDecodingOption(ParallelDecodeOption *data, ListCell *option)
         CheckIntOption(elem, &data->max_reorderbuffer_in_memory, 0, 0, maxReorderBuffer);
     } else if (strncmp(elem->defname, "white-table-list", sizeof("white-table-list")) == 0) {
         ParseWhiteList(&data->tableWhiteList, elem);
+    } else if (strncmp(elem->defname, "streaming", sizeof("streaming")) == 0) {
+        CheckBooleanOption(elem, &data->streaming, false);
+        /* subtransactions are only known early enough to stream with the publisher setting on */
+        data->streaming = data->streaming && u_sess->attr.attr_storage.enable_logical_replication_streaming;
+    } else if (strncmp(elem->defname, "binary-send", sizeof("binary-send")) == 0) {
+        CheckBooleanOption(elem, &data->binary_send, true);
     }  else if (strncmp(elem->defname, "parallel-queue-size", sizeof("parallel-queue-size")) == 0) {
         CheckIntOption(elem, &data->parallel_queue_size, DEFAULT_PARALLEL_QUEUE_SIZE,
             MIN_PARALLEL_QUEUE_SIZE, MAX_PARALLEL_QUEUE_SIZE);
@@ -939,6 +947,8 @@ static void ParseDecodingOption(ParallelDecodeOption *data, ListCell *option)
             errmsg("option parallel-queue-size should be a power of two"),
             errdetail("N/A"),  errcause("Wrong input option"), erraction("Please check documents for help")));
         }
+    } else if (strncmp(elem->defname, "parallel-read-num", sizeof("parallel-read-num")) == 0) {
+        CheckIntOption(elem, &data->parallel_read_num, 0, 0, MAX_PARALLEL_READ_NUM);
     } else if (strncmp(elem->defname, "sender-timeout", sizeof("sender-timeout")) == 0 && elem->arg != NULL) {
         SetConfigOption("logical_sender_timeout", strVal(elem->arg), PGC_USERSET, PGC_S_OVERRIDE);
     } else if (strncmp(elem->defname, "parallel-decode-num", sizeof("parallel-decode-num")) != 0) {
@@ -957,6 +967,11 @@ static void ParseDecodingOptions(ParallelDecodeOption *data, List *options)
     foreach (option, options) {
         ParseDecodingOption(data, option);
     }
+    if (data->binary_send && data->decode_style != 'b') {
+        ereport(ERROR, (errmodule(MOD_LOGICAL_DECODE), errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+            errmsg("option binary-send is only supported with decode-style 'b'"),
+            errdetail("N/A"),  errcause("Wrong input option"), erraction("Please check documents for help")));
+    }
 }
 
 static void initParallelDecodeOption(ParallelDecodeOption *pOptions, int parallelDecodeNum)
@@ -970,6 +985,9 @@ static void initParallelDecodeOption(ParallelDecodeOption *pOptions, int paralle
     pOptions->sending_batch = 0;
     pOptions->decode_change = parallel_decode_change_to_bin;
     pOptions->parallel_queue_size = DEFAULT_PARALLEL_QUEUE_SIZE;
+    pOptions->parallel_read_num = 0;
+    pOptions->streaming = false;
+    pOptions->binary_send = false;
 
     /* GUC */
     DecodeOptionsDefault *defaultOption = LogicalDecodeGetOptionsDefault();
@@ -1234,6 +1252,21 @@ void LogicalReadWorkerMain(void* point)
     LogicalReadRecordMain(reader);
 }
 
+/*
+ * read_page callback of the reader: take the page from the WAL read ahead by
+ * the helper threads if there is one, read it ourselves otherwise.
+ */
+static int ParallelReadXLogPage(XLogReaderState *state, XLogRecPtr targetPagePtr, int reqLen,
+    XLogRecPtr targetRecPtr, char *cur_page, TimeLineID *pageTLI, char* xlog_path)
+{
+    int slotId = t_thrd.logical_cxt.dispatchSlotId;
+
+    if (LogicalReadAheadPage(g_Logicaldispatcher[slotId].pOptions.parallel_read_num, targetPagePtr, cur_page)) {
+        return XLOG_BLCKSZ;
+    }
+    return logical_read_xlog_page(state, targetPagePtr, reqLen, targetRecPtr, cur_page, pageTLI, xlog_path);
+}
+
 void LogicalReadRecordMain(ParallelDecodeReaderWorker *worker)
 {
     struct ParallelLogicalDecodingContext* ctx;
@@ -1257,7 +1290,7 @@ void LogicalReadRecordMain(ParallelDecodeReaderWorker *worker)
         int slotId = worker->slotId;
         g_Logicaldispatcher[slotId].MyReplicationSlot = t_thrd.slot_cxt.MyReplicationSlot;
 
-        ctx = ParallelCreateDecodingContext(0, NULL, false, logical_read_xlog_page, worker->slotId);
+        ctx = ParallelCreateDecodingContext(0, NULL, false, ParallelReadXLogPage, worker->slotId);
 
         ParallelDecodingData *data = (ParallelDecodingData *)MemoryContextAllocZero(
             g_instance.comm_cxt.pdecode_cxt[slotId].parallelDecodeCtx, sizeof(ParallelDecodingData));
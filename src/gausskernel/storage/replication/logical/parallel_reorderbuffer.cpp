@@ -67,7 +67,7 @@
 
 static void ParallelReorderBufferSerializeReserve(ParallelReorderBuffer *rb, Size sz);
 static void ParallelReorderBufferCheckSerializeTXN(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn,
-    int slotId);
+    logicalLog *change, int slotId);
 static void ParallelReorderBufferSerializeTXN(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn, int slotId);
 static void ParallelReorderBufferSerializeChange(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn, int fd,
     logicalLog *change);
@@ -77,6 +77,11 @@ static void ParallelReorderBufferRestoreChange(ParallelReorderBuffer *rb, Parall
     int slotId);
 void ParallelReorderBufferCleanupTXN(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn,
     XLogRecPtr lsn = InvalidXLogRecPtr);
+static bool ParallelReorderBufferCanStreamTXN(ParallelReorderBufferTXN *txn, logicalLog *change, int slotId);
+static void ParallelReorderBufferStreamTXN(ParallelReorderBuffer *prb, ParallelReorderBufferTXN *txn,
+    logicalLog *change, int slotId);
+static void ParallelReorderBufferStreamAbortTXN(ParallelReorderBuffer *prb, ParallelReorderBufferTXN *txn,
+    int slotId);
 
 
 /* Parallel decoding batch sending unit length is set to 1MB. */
@@ -114,7 +119,7 @@ void ParallelReorderBufferQueueChange(ParallelReorderBuffer *rb, logicalLog *cha
         g_Logicaldispatcher[slotId].workingTxnCnt = hash_get_num_entries(rb->by_txn);
     }
     ParallelReorderBufferUpdateMemory(rb, change, slotId, true);
-    ParallelReorderBufferCheckSerializeTXN(rb, txn, slotId);
+    ParallelReorderBufferCheckSerializeTXN(rb, txn, change, slotId);
 }
 
 void ParallelFreeTuple(ReorderBufferTupleBuf *tuple, int slotId)
@@ -847,14 +852,22 @@ static void ParallelReorderBufferSerializeReserve(ParallelReorderBuffer *rb, Siz
 
 /*
  * Check whether the transaction tx should spill its data to disk.
+ *
+ * If the client asked for streaming and the transaction qualifies, its
+ * in-memory changes are sent as a stream block instead of being spilled.
  */
-static void ParallelReorderBufferCheckSerializeTXN(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn, int slotId)
+static void ParallelReorderBufferCheckSerializeTXN(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn,
+    logicalLog *change, int slotId)
 {
     if (txn->nentries_mem >= (unsigned)g_instance.attr.attr_common.max_changes_in_memory ||
         (g_Logicaldispatcher[slotId].pOptions.max_txn_in_memory > 0 &&
         txn->size >= (Size)g_Logicaldispatcher[slotId].pOptions.max_txn_in_memory * sizeMB) ||
         (g_Logicaldispatcher[slotId].pOptions.max_reorderbuffer_in_memory > 0 &&
         rb->size >= (Size)g_Logicaldispatcher[slotId].pOptions.max_reorderbuffer_in_memory * sizeGB)) {
+        if (ParallelReorderBufferCanStreamTXN(txn, change, slotId)) {
+            ParallelReorderBufferStreamTXN(rb, txn, change, slotId);
+            return;
+        }
         ParallelReorderBufferSerializeTXN(rb, txn, slotId);
         Assert(txn->size == 0);
         Assert(txn->nentries_mem == 0);
@@ -1416,6 +1429,11 @@ void ParallelReorderBufferForget(ParallelReorderBuffer *prb, int slotId, Paralle
         return;
     ParallelReorderBufferIterTXNState *volatile iterstate = NULL;
 
+    /* the client already holds part of this transaction, tell it to throw that away */
+    if (txn->streamed) {
+        ParallelReorderBufferStreamAbortTXN(prb, txn, slotId);
+    }
+
     iterstate = ParallelReorderBufferIterTXNInit(prb, txn, slotId);
     while ((logChange = ParallelReorderBufferIterTXNNext(prb, iterstate, slotId)) != NULL) {
         dlist_delete(&logChange->node);
@@ -1585,6 +1603,197 @@ static void ParallelOutputCommit(StringInfo out, logicalLog *change, ParallelDec
     }
 }
 
+/*
+ * Parallel decoding stream messages share the framing of begin and commit: a length word and an lsn
+ * precede the body whenever the body is a separate block. The returned position is handed back to
+ * ParallelOutputStreamFinish to fill in the length.
+ */
+static int ParallelOutputStreamHeader(StringInfo out, XLogRecPtr lsn, ParallelDecodingData *pdata, bool batchSending)
+{
+    int curPos = out->len;
+    if (pdata->pOptions.decode_style == 'b' || batchSending) {
+        pq_sendint32(out, 0);
+        pq_sendint64(out, lsn);
+    }
+    return curPos;
+}
+
+static void ParallelOutputStreamFinish(StringInfo out, int curPos, ParallelDecodingData *pdata, bool batchSending)
+{
+    if (pdata->pOptions.decode_style == 'b' || batchSending) {
+        uint32 msgLen = htonl((uint32)(out->len - curPos) - (uint32)sizeof(uint32));
+        errno_t rc = memcpy_s(out->data + curPos, sizeof(uint32), &msgLen, sizeof(uint32));
+        securec_check(rc, "", "");
+    }
+}
+
+/*
+ * Parallel decoding output stream start message, opening a block of changes of an in-progress transaction.
+ */
+static void ParallelOutputStreamStart(StringInfo out, XLogRecPtr lsn, ParallelDecodingData *pdata,
+    ParallelReorderBufferTXN *txn, bool batchSending)
+{
+    int curPos = ParallelOutputStreamHeader(out, lsn, pdata, batchSending);
+    if (pdata->pOptions.decode_style == 'b') {
+        appendStringInfoChar(out, 'S');
+        pq_sendint64(out, txn->xid);
+        pq_sendbyte(out, txn->streamed ? 0 : 1);
+    } else {
+        appendStringInfo(out, "STREAM START xid: %lu first_segment: %s", txn->xid,
+            txn->streamed ? "false" : "true");
+    }
+    ParallelOutputStreamFinish(out, curPos, pdata, batchSending);
+}
+
+/*
+ * Parallel decoding output stream stop message.
+ */
+static void ParallelOutputStreamStop(StringInfo out, XLogRecPtr lsn, ParallelDecodingData *pdata,
+    ParallelReorderBufferTXN *txn, bool batchSending)
+{
+    int curPos = ParallelOutputStreamHeader(out, lsn, pdata, batchSending);
+    if (pdata->pOptions.decode_style == 'b') {
+        appendStringInfoChar(out, 'E');
+        pq_sendint64(out, txn->xid);
+    } else {
+        appendStringInfo(out, "STREAM STOP xid: %lu", txn->xid);
+    }
+    ParallelOutputStreamFinish(out, curPos, pdata, batchSending);
+}
+
+/*
+ * Parallel decoding output stream commit message, it replaces the commit message of a streamed transaction.
+ */
+static void ParallelOutputStreamCommit(StringInfo out, logicalLog *change, ParallelDecodingData *pdata,
+    ParallelReorderBufferTXN *txn, bool batchSending)
+{
+    int curPos = ParallelOutputStreamHeader(out, change->endLsn, pdata, batchSending);
+    if (pdata->pOptions.decode_style == 'b') {
+        appendStringInfoChar(out, 'c');
+        pq_sendint64(out, txn->xid);
+        pq_sendint64(out, change->csn);
+        if (pdata->pOptions.include_timestamp) {
+            appendStringInfoChar(out, 'T');
+            const char *timeStamp = timestamptz_to_str(txn->commit_time);
+            pq_sendint32(out, (uint32)(strlen(timeStamp)));
+            appendStringInfoString(out, timeStamp);
+        }
+    } else {
+        appendStringInfo(out, "STREAM COMMIT xid: %lu CSN: %lu", txn->xid, change->csn);
+        if (pdata->pOptions.include_timestamp) {
+            appendStringInfo(out, " (at %s)", timestamptz_to_str(txn->commit_time));
+        }
+    }
+    ParallelOutputStreamFinish(out, curPos, pdata, batchSending);
+}
+
+/*
+ * Parallel decoding output stream abort message.
+ */
+static void ParallelOutputStreamAbort(StringInfo out, XLogRecPtr lsn, ParallelDecodingData *pdata,
+    ParallelReorderBufferTXN *txn, bool batchSending)
+{
+    int curPos = ParallelOutputStreamHeader(out, lsn, pdata, batchSending);
+    if (pdata->pOptions.decode_style == 'b') {
+        appendStringInfoChar(out, 'A');
+        pq_sendint64(out, txn->xid);
+    } else {
+        appendStringInfo(out, "STREAM ABORT xid: %lu", txn->xid);
+    }
+    ParallelOutputStreamFinish(out, curPos, pdata, batchSending);
+}
+
+/*
+ * Check whether the in-memory changes of txn may be streamed to the client before commit.
+ *
+ * Only plain DML of a toplevel transaction without known subtransactions qualifies, and only when
+ * nothing of it has been spilled yet, so the changes sent so far are always a prefix of the
+ * transaction. Transactions that may end up being skipped as already confirmed are never streamed.
+ */
+static bool ParallelReorderBufferCanStreamTXN(ParallelReorderBufferTXN *txn, logicalLog *change, int slotId)
+{
+    dlist_iter iter;
+
+    if (!g_Logicaldispatcher[slotId].pOptions.streaming) {
+        return false;
+    }
+    if (txn->is_known_as_subxact || !dlist_is_empty(&txn->subtxns) || txn->serialized) {
+        return false;
+    }
+    if (XLByteLT(change->lsn, g_Logicaldispatcher[slotId].startpoint) ||
+        XLByteLT(change->lsn, t_thrd.walsender_cxt.firstConfirmedFlush)) {
+        return false;
+    }
+    dlist_foreach(iter, &txn->changes)
+    {
+        logicalLog *logChange = dlist_container(logicalLog, node, iter.cur);
+        if (logChange->type != LOGICAL_LOG_DML) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Send the in-memory changes of txn as one stream block and release them.
+ */
+static void ParallelReorderBufferStreamTXN(ParallelReorderBuffer *prb, ParallelReorderBufferTXN *txn,
+    logicalLog *change, int slotId)
+{
+    dlist_mutable_iter iter;
+    ParallelLogicalDecodingContext *ctx = (ParallelLogicalDecodingContext *)prb->private_data;
+    ParallelDecodingData* pdata = (ParallelDecodingData*)t_thrd.walsender_cxt.
+        parallel_logical_decoding_ctx->output_plugin_private;
+    bool batchSending = g_Logicaldispatcher[slotId].pOptions.sending_batch > 0;
+
+    ereport(DEBUG2, (errmodule(MOD_LOGICAL_DECODE),
+        errmsg("stream %u changes in tx %lu", (uint32)txn->nentries_mem, txn->xid)));
+
+    MemoryContext oldCtx = NULL;
+    ParallelCheckPrepare(ctx->out, change, pdata, slotId, &oldCtx);
+    ParallelOutputStreamStart(ctx->out, txn->first_lsn, pdata, txn, batchSending);
+    ParallelHandleBatch(ctx, change, pdata, slotId, &oldCtx);
+
+    dlist_foreach_modify(iter, &txn->changes)
+    {
+        logicalLog *logChange = dlist_container(logicalLog, node, iter.cur);
+        if (logChange->out != NULL && logChange->out->len != 0) {
+            appendBinaryStringInfo(ctx->out, logChange->out->data, logChange->out->len);
+            ParallelHandleBatch(ctx, change, pdata, slotId, &oldCtx);
+        }
+        dlist_delete(&logChange->node);
+        FreeLogicalLog(prb, logChange, slotId, false);
+    }
+    txn->nentries = 0;
+    txn->nentries_mem = 0;
+
+    ParallelOutputStreamStop(ctx->out, txn->first_lsn, pdata, txn, batchSending);
+    txn->streamed = true;
+
+    ParallelCheckBatch(ctx, pdata, slotId, &oldCtx, false);
+    MemoryContextReset(pdata->context);
+}
+
+/*
+ * Tell the client to discard what it has received of the streamed transaction txn.
+ */
+static void ParallelReorderBufferStreamAbortTXN(ParallelReorderBuffer *prb, ParallelReorderBufferTXN *txn,
+    int slotId)
+{
+    ParallelLogicalDecodingContext *ctx = (ParallelLogicalDecodingContext *)prb->private_data;
+    ParallelDecodingData* pdata = (ParallelDecodingData*)t_thrd.walsender_cxt.
+        parallel_logical_decoding_ctx->output_plugin_private;
+    XLogRecPtr lsn = XLogRecPtrIsValid(txn->final_lsn) ? txn->final_lsn : txn->first_lsn;
+
+    if (!g_Logicaldispatcher[slotId].remainPatch) {
+        WalSndPrepareWriteHelper(ctx->out, lsn, txn->xid, true);
+    }
+    MemoryContext oldCtx = MemoryContextSwitchTo(pdata->context);
+    ParallelOutputStreamAbort(ctx->out, lsn, pdata, txn, g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
+    ParallelCheckBatch(ctx, pdata, slotId, &oldCtx, false);
+    MemoryContextReset(pdata->context);
+}
+
 static void ReportToastChunkMissing(void)
 {
     ereport(ERROR, (errmodule(MOD_LOGICAL_DECODE), errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
@@ -1617,7 +1826,14 @@ void ParallelReorderBufferCommit(ParallelReorderBuffer *prb, logicalLog *change,
     ParallelReorderBufferIterTXNState *volatile iterstate = NULL;
     iterstate = ParallelReorderBufferIterTXNInit(prb, txn, slotId);
 
-    if (!pdata->pOptions.skip_empty_xacts) {
+    /* the rest of a streamed transaction goes out as its last stream block */
+    bool streamed = txn->streamed;
+    if (streamed) {
+        ParallelOutputStreamStart(ctx->out, txn->first_lsn, pdata, txn,
+            g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
+        ParallelHandleBatch(ctx, change, pdata, slotId, &oldCtx);
+        pdata->pOptions.xact_wrote_changes = true;
+    } else if (!pdata->pOptions.skip_empty_xacts) {
         ParallelOutputBegin(ctx->out, change, pdata, txn, g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
         ParallelHandleBatch(ctx, change, pdata, slotId, &oldCtx);
     }
@@ -1652,7 +1868,13 @@ void ParallelReorderBufferCommit(ParallelReorderBuffer *prb, logicalLog *change,
     if (XLByteLT(ctx->write_location, change->lsn)) {
         ctx->write_location = change->lsn;
     }
-    if (!pdata->pOptions.skip_empty_xacts || pdata->pOptions.xact_wrote_changes) {
+    if (streamed) {
+        ParallelOutputStreamStop(ctx->out, txn->first_lsn, pdata, txn,
+            g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
+        ParallelHandleBatch(ctx, change, pdata, slotId, &oldCtx);
+        ParallelOutputStreamCommit(ctx->out, change, pdata, txn,
+            g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
+    } else if (!pdata->pOptions.skip_empty_xacts || pdata->pOptions.xact_wrote_changes) {
         ParallelOutputCommit(ctx->out, change, pdata, txn,
             g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
     }
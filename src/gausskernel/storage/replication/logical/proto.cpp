@@ -103,6 +103,118 @@ void logicalrep_read_commit(StringInfo in, LogicalRepCommitData *commit_data)
     commit_data->committime = pq_getmsgint64(in);
 }
 
+/*
+ * Write STREAM START to the output stream.
+ */
+void logicalrep_write_stream_start(StringInfo out, TransactionId xid, bool first_segment)
+{
+    pq_sendbyte(out, 's'); /* STREAM START */
+
+    Assert(TransactionIdIsValid(xid));
+
+    /* transaction ID (we're starting to stream, so must be valid) */
+    pq_sendint64(out, xid);
+
+    /* 1 if this is the first streaming segment for this xid */
+    pq_sendbyte(out, first_segment ? 1 : 0);
+}
+
+/*
+ * Read STREAM START from the output stream.
+ */
+TransactionId logicalrep_read_stream_start(StringInfo in, bool *first_segment)
+{
+    TransactionId xid;
+
+    Assert(first_segment != NULL);
+
+    xid = pq_getmsgint64(in);
+    *first_segment = (pq_getmsgbyte(in) == 1);
+
+    return xid;
+}
+
+/*
+ * Write STREAM STOP to the output stream.
+ */
+void logicalrep_write_stream_stop(StringInfo out)
+{
+    pq_sendbyte(out, 'E'); /* STREAM STOP */
+}
+
+/*
+ * Write STREAM COMMIT to the output stream.
+ */
+void logicalrep_write_stream_commit(StringInfo out, ReorderBufferTXN *txn, XLogRecPtr commit_lsn)
+{
+    uint8 flags = 0;
+
+    pq_sendbyte(out, 'c'); /* STREAM COMMIT */
+
+    Assert(TransactionIdIsValid(txn->xid));
+
+    /* transaction ID */
+    pq_sendint64(out, txn->xid);
+
+    /* send the flags field (unused for now) */
+    pq_sendbyte(out, flags);
+
+    /* send fields */
+    pq_sendint64(out, commit_lsn);
+    pq_sendint64(out, txn->end_lsn);
+    pq_sendint64(out, txn->commit_time);
+}
+
+/*
+ * Read STREAM COMMIT from the output stream.
+ */
+TransactionId logicalrep_read_stream_commit(StringInfo in, LogicalRepCommitData *commit_data)
+{
+    TransactionId xid;
+    uint8 flags;
+
+    xid = pq_getmsgint64(in);
+
+    /* read flags (unused for now) */
+    flags = pq_getmsgbyte(in);
+    if (flags != 0) {
+        elog(ERROR, "unknown flags %u in commit message", flags);
+    }
+
+    /* read fields */
+    commit_data->commit_lsn = pq_getmsgint64(in);
+    commit_data->end_lsn = pq_getmsgint64(in);
+    commit_data->committime = pq_getmsgint64(in);
+
+    return xid;
+}
+
+/*
+ * Write STREAM ABORT to the output stream. Note that xid and subxid will be
+ * same for the top-level transaction abort.
+ */
+void logicalrep_write_stream_abort(StringInfo out, TransactionId xid, TransactionId subxid)
+{
+    pq_sendbyte(out, 'A'); /* STREAM ABORT */
+
+    Assert(TransactionIdIsValid(xid) && TransactionIdIsValid(subxid));
+
+    /* transaction ID */
+    pq_sendint64(out, xid);
+    pq_sendint64(out, subxid);
+}
+
+/*
+ * Read STREAM ABORT from the output stream.
+ */
+void logicalrep_read_stream_abort(StringInfo in, TransactionId *xid, TransactionId *subxid)
+{
+    Assert(xid && subxid);
+
+    *xid = pq_getmsgint64(in);
+    *subxid = pq_getmsgint64(in);
+}
+
 /*
  * Write ORIGIN to the output stream.
  */
@@ -120,10 +232,14 @@ void logicalrep_write_origin(StringInfo out, const char *origin, XLogRecPtr orig
 /*
  * Write INSERT to the output stream.
  */
-void logicalrep_write_insert(StringInfo out, Relation rel, HeapTuple newtuple, bool binary)
+void logicalrep_write_insert(StringInfo out, Relation rel, HeapTuple newtuple, bool binary, TransactionId xid)
 {
     pq_sendbyte(out, 'I'); /* action INSERT */
 
+    /* transaction ID (if in a streamed transaction) */
+    if (TransactionIdIsValid(xid))
+        pq_sendint64(out, xid);
+
     /* use Oid as relation identifier */
     pq_sendint32(out, RelationGetRelid(rel));
 
@@ -156,10 +272,15 @@ LogicalRepRelId logicalrep_read_insert(StringInfo in, LogicalRepTupleData *newtu
 /*
  * Write UPDATE to the output stream.
  */
-void logicalrep_write_update(StringInfo out, Relation rel, HeapTuple oldtuple, HeapTuple newtuple, bool binary)
+void logicalrep_write_update(StringInfo out, Relation rel, HeapTuple oldtuple, HeapTuple newtuple, bool binary,
+    TransactionId xid)
 {
     pq_sendbyte(out, 'U'); /* action UPDATE */
 
+    /* transaction ID (if in a streamed transaction) */
+    if (TransactionIdIsValid(xid))
+        pq_sendint64(out, xid);
+
     /* use Oid as relation identifier */
     pq_sendint32(out, RelationGetRelid(rel));
 
@@ -218,7 +339,7 @@ LogicalRepRelId logicalrep_read_update(StringInfo in, bool *has_oldtuple, Logica
 /*
  * Write DELETE to the output stream.
  */
-void logicalrep_write_delete(StringInfo out, Relation rel, HeapTuple oldtuple, bool binary)
+void logicalrep_write_delete(StringInfo out, Relation rel, HeapTuple oldtuple, bool binary, TransactionId xid)
 {
     char relreplident = RelationGetRelReplident(rel);
     Assert(relreplident == REPLICA_IDENTITY_DEFAULT ||
@@ -226,6 +347,10 @@ void logicalrep_write_delete(StringInfo out, Relation rel, HeapTuple oldtuple, b
 
     pq_sendbyte(out, 'D'); /* action DELETE */
 
+    /* transaction ID (if in a streamed transaction) */
+    if (TransactionIdIsValid(xid))
+        pq_sendint64(out, xid);
+
     /* use Oid as relation identifier */
     pq_sendint32(out, RelationGetRelid(rel));
 
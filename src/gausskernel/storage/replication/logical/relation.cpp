@@ -164,6 +164,24 @@ void logicalrep_relmap_update(LogicalRepRelation *remoterel)
     MemoryContextSwitchTo(oldctx);
 }
 
+/*
+ * Look up the publisher's description of a relation in the relation map
+ * cache, without opening the local relation.
+ *
+ * Returns NULL if the publisher did not send it yet.
+ */
+LogicalRepRelation *logicalrep_remoterel_find(LogicalRepRelId remoteid)
+{
+    LogicalRepRelMapEntry *entry;
+
+    if (t_thrd.applyworker_cxt.logicalRepRelMap == NULL)
+        return NULL;
+
+    entry = (LogicalRepRelMapEntry *)hash_search(t_thrd.applyworker_cxt.logicalRepRelMap,
+                                                 (void *)&remoteid, HASH_FIND, NULL);
+    return entry != NULL ? &entry->remoterel : NULL;
+}
+
 /*
  * Find attribute index in TupleDesc struct by attribute name.
  *
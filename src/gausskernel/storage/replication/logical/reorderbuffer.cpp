@@ -131,6 +131,16 @@ static void ReorderBufferExecuteInvalidations(ReorderBuffer *rb, ReorderBufferTX
  */
 static void ReorderBufferCheckSerializeTXN(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
 static void ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
+
+/* ---------------------------------------
+ * Streaming support functions
+ * ---------------------------------------
+ */
+static void ReorderBufferProcessTXN(ReorderBuffer *rb, ReorderBufferTXN *txn, XLogRecPtr commit_lsn, bool streaming);
+static bool ReorderBufferCanStreamTXN(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
+static void ReorderBufferStreamTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
+static void ReorderBufferTruncateTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
+static void ReorderBufferStreamAbortTXN(ReorderBuffer *rb, ReorderBufferTXN *txn, XLogRecPtr lsn);
 static void ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn, int fd, ReorderBufferChange *change);
 static Size ReorderBufferRestoreChanges(ReorderBuffer *rb, ReorderBufferTXN *txn, int *fd, XLogSegNo *segno);
 static void ReorderBufferRestoreChange(ReorderBuffer *rb, ReorderBufferTXN *txn, char *change);
@@ -188,6 +198,11 @@ ReorderBuffer *ReorderBufferAllocate(void)
     buffer->outbufsize = 0;
     buffer->size = 0;
 
+    buffer->stream_start = NULL;
+    buffer->stream_stop = NULL;
+    buffer->stream_commit = NULL;
+    buffer->stream_abort = NULL;
+
     buffer->current_restart_decoding_lsn = InvalidXLogRecPtr;
 
     dlist_init(&buffer->toplevel_by_lsn);
@@ -1140,6 +1155,12 @@ void ReorderBufferCleanupTXN(ReorderBuffer *rb, ReorderBufferTXN *txn, XLogRecPt
         dlist_delete(&txn->base_snapshot_node);
     }
 
+    /* and the snapshot a streamed transaction continues from */
+    if (txn->stream_snapshot != NULL) {
+        ReorderBufferFreeSnap(rb, txn->stream_snapshot);
+        txn->stream_snapshot = NULL;
+    }
+
     /*
      * Remove TXN from its containing list.
      *
@@ -1319,14 +1340,6 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
                          RepOriginId origin_id, XLogRecPtr origin_lsn, CommitSeqNo csn, TimestampTz commit_time)
 {
     ReorderBufferTXN *txn = NULL;
-    ReorderBufferIterTXNState *volatile iterstate = NULL;
-    ReorderBufferChange *change = NULL;
-
-    volatile CommandId command_id = FirstCommandId;
-    volatile Snapshot snapshot_now = NULL;
-    volatile bool txn_started = false;
-    volatile bool subtxn_started = false;
-    u_sess->attr.attr_common.extra_float_digits = LOGICAL_DECODE_EXTRA_FLOAT_DIGITS;
 
     txn = ReorderBufferTXNByXid(rb, xid, false, NULL, InvalidXLogRecPtr, false);
     /* unknown transaction, nothing to replay */
@@ -1352,7 +1365,40 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
         return;
     }
 
-    snapshot_now = txn->base_snapshot;
+    ReorderBufferProcessTXN(rb, txn, commit_lsn, false);
+}
+
+/*
+ * Replay the changes of a transaction and its subtransactions that are
+ * currently queued in the reorder buffer.
+ *
+ * Without streaming this is the final replay done at commit, wrapped in the
+ * begin/commit callbacks, after which the transaction is cleaned up. With
+ * streaming, the changes decoded so far are sent between the stream_start and
+ * stream_stop callbacks and then released, while the transaction itself stays
+ * around (remembering the snapshot it ended with) until it commits or aborts.
+ * The commit of a transaction that has been streamed before sends its
+ * remaining changes as a last chunk followed by stream_commit.
+ */
+static void ReorderBufferProcessTXN(ReorderBuffer *rb, ReorderBufferTXN *txn, XLogRecPtr commit_lsn, bool streaming)
+{
+    ReorderBufferIterTXNState *volatile iterstate = NULL;
+    ReorderBufferChange *change = NULL;
+
+    volatile CommandId command_id = FirstCommandId;
+    volatile Snapshot snapshot_now = NULL;
+    volatile bool txn_started = false;
+    volatile bool subtxn_started = false;
+    u_sess->attr.attr_common.extra_float_digits = LOGICAL_DECODE_EXTRA_FLOAT_DIGITS;
+
+    if (txn->stream_snapshot != NULL) {
+        /* continue where the previously streamed chunk stopped */
+        snapshot_now = txn->stream_snapshot;
+        command_id = snapshot_now->curcid;
+        txn->stream_snapshot = NULL;
+    } else {
+        snapshot_now = txn->base_snapshot;
+    }
 
     /* build data to be able to lookup the CommandIds of catalog tuples */
     ReorderBufferBuildTupleCidHash(rb, txn);
@@ -1382,7 +1428,10 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
             txn_started = true;
         }
 
-        rb->begin(rb, txn);
+        if (streaming || txn->streamed)
+            rb->stream_start(rb, txn);
+        else
+            rb->begin(rb, txn);
 
         iterstate = ReorderBufferIterTXNInit(rb, txn);
         while ((change = ReorderBufferIterTXNNext(rb, iterstate))) {
@@ -1613,8 +1662,15 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
         ReorderBufferIterTXNFinish(rb, iterstate);
         iterstate = NULL;
 
-        /* call commit callback */
-        rb->commit(rb, txn, commit_lsn);
+        /* call commit callback, or close the streamed chunk */
+        if (streaming) {
+            rb->stream_stop(rb, txn);
+        } else if (txn->streamed) {
+            rb->stream_stop(rb, txn);
+            rb->stream_commit(rb, txn, commit_lsn);
+        } else {
+            rb->commit(rb, txn, commit_lsn);
+        }
 
         /* this is just a sanity check against bad output plugin behaviour */
         if (GetCurrentTransactionIdIfAny() != InvalidTransactionId)
@@ -1638,11 +1694,27 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
         else if (txn_started)
             AbortCurrentTransaction();
 
-        if (snapshot_now->copied)
-            ReorderBufferFreeSnap(rb, snapshot_now);
+        if (streaming) {
+            /*
+             * Keep our own copy of the snapshot for the next chunk, the one in
+             * use may belong to a change that is released below.
+             */
+            if (snapshot_now->copied)
+                txn->stream_snapshot = snapshot_now;
+            else
+                txn->stream_snapshot = ReorderBufferCopySnap(rb, snapshot_now, txn, command_id);
+            snapshot_now = NULL;
+
+            /* the streamed changes are not needed anymore */
+            ReorderBufferTruncateTXN(rb, txn);
+            txn->streamed = true;
+        } else {
+            if (snapshot_now->copied)
+                ReorderBufferFreeSnap(rb, snapshot_now);
 
-        /* remove potential on-disk data, and deallocate */
-        ReorderBufferCleanupTXN(rb, txn);
+            /* remove potential on-disk data, and deallocate */
+            ReorderBufferCleanupTXN(rb, txn);
+        }
     }
     PG_CATCH();
     {
@@ -1698,6 +1770,9 @@ void ReorderBufferAbort(ReorderBuffer *rb, TransactionId xid, XLogRecPtr lsn)
     /* cosmetic... */
     txn->final_lsn = lsn;
 
+    /* the receiving side has to throw away what it got so far */
+    ReorderBufferStreamAbortTXN(rb, txn, lsn);
+
     /* remove potential on-disk data, and deallocate */
     ReorderBufferCleanupTXN(rb, txn);
 }
@@ -1728,6 +1803,8 @@ void ReorderBufferAbortOld(ReorderBuffer *rb, TransactionId oldestRunningXid, XL
         if (TransactionIdPrecedes(txn->xid, oldestRunningXid)) {
             ereport(DEBUG2, (errmodule(MOD_LOGICAL_DECODE), errmsg("aborting old transaction %lu", txn->xid)));
 
+            ReorderBufferStreamAbortTXN(rb, txn, lsn);
+
             /* remove potential on-disk data, and deallocate this tx */
             ReorderBufferCleanupTXN(rb, txn, lsn);
         } else
@@ -1783,6 +1860,9 @@ void ReorderBufferForget(ReorderBuffer *rb, TransactionId xid, XLogRecPtr lsn)
     } else
         Assert(txn->ninvalidations == 0);
 
+    /* changes already streamed must not be applied */
+    ReorderBufferStreamAbortTXN(rb, txn, lsn);
+
     /* remove potential on-disk data, and deallocate */
     ReorderBufferCleanupTXN(rb, txn);
 }
@@ -2017,12 +2097,121 @@ static void ReorderBufferCheckSerializeTXN(LogicalDecodingContext *ctx, ReorderB
         (data != NULL && data->max_txn_in_memory > 0 && txn->size >= (Size)data->max_txn_in_memory * sizeMB) ||
         (data != NULL && data->max_reorderbuffer_in_memory > 0 &&
         txn->size >= (Size)data->max_reorderbuffer_in_memory * sizeGB)) {
+        ReorderBufferTXN *toptxn = txn;
+
+        /* changes are streamed per toplevel transaction, subxacts included */
+        if (txn->is_known_as_subxact)
+            toptxn = ReorderBufferTXNByXid(ctx->reorder, txn->toplevel_xid, false, NULL, InvalidXLogRecPtr, false);
+
+        /* prefer sending the changes downstream over spilling them to disk */
+        if (toptxn != NULL && ReorderBufferCanStreamTXN(ctx, toptxn)) {
+            ReorderBufferStreamTXN(ctx->reorder, toptxn);
+            return;
+        }
+
         ReorderBufferSerializeTXN(ctx->reorder, txn);
         Assert(txn->size == 0);
         Assert(txn->nentries_mem == 0);
     }
 }
 
+/*
+ * Can the changes of toplevel transaction txn be streamed before it commits?
+ *
+ * Only if the output plugin asked for it, decoding has reached a consistent
+ * point past where the client wants changes, and neither the transaction nor
+ * any of its subtransactions modified the catalog or already spilled changes
+ * to disk. The latter ones are decoded at commit, as before.
+ */
+static bool ReorderBufferCanStreamTXN(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    dlist_iter iter;
+
+    if (!ctx->streaming || ctx->reorder->stream_start == NULL)
+        return false;
+
+    Assert(!txn->is_known_as_subxact);
+
+    /* nothing that could be decoded yet */
+    if (txn->base_snapshot == NULL)
+        return false;
+
+    if (SnapBuildCurrentState(ctx->snapshot_builder) < SNAPBUILD_CONSISTENT ||
+        SnapBuildXactNeedsSkip(ctx->snapshot_builder, ctx->reader->EndRecPtr))
+        return false;
+
+    if (txn->has_catalog_changes || txn->serialized)
+        return false;
+
+    dlist_foreach(iter, &txn->subtxns)
+    {
+        ReorderBufferTXN *subtxn = dlist_container(ReorderBufferTXN, node, iter.cur);
+
+        if (subtxn->has_catalog_changes || subtxn->serialized)
+            return false;
+    }
+
+    return true;
+}
+
+/*
+ * Send the changes of an in-progress toplevel transaction (and its
+ * subtransactions) decoded so far to the output plugin and release them.
+ */
+static void ReorderBufferStreamTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
+{
+    ereport(DEBUG2, (errmodule(MOD_LOGICAL_DECODE),
+        errmsg("stream %lu changes of in-progress transaction %lu", txn->nentries_mem, txn->xid)));
+
+    ReorderBufferProcessTXN(rb, txn, InvalidXLogRecPtr, true);
+}
+
+/*
+ * Release the changes of a transaction and its subtransactions once they have
+ * been streamed. Reassembled toast chunks are kept, as the tuple they belong
+ * to may only arrive in the next chunk.
+ */
+static void ReorderBufferTruncateTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
+{
+    dlist_mutable_iter iter;
+
+    dlist_foreach_modify(iter, &txn->subtxns)
+    {
+        ReorderBufferTXN *subtxn = dlist_container(ReorderBufferTXN, node, iter.cur);
+
+        ReorderBufferTruncateTXN(rb, subtxn);
+    }
+
+    dlist_foreach_modify(iter, &txn->changes)
+    {
+        ReorderBufferChange *change = dlist_container(ReorderBufferChange, node, iter.cur);
+
+        dlist_delete(&change->node);
+        ReorderBufferReturnChange(rb, change);
+    }
+
+    txn->nentries = 0;
+    txn->nentries_mem = 0;
+}
+
+/*
+ * Tell the output plugin that a (sub)transaction whose toplevel transaction
+ * has been streamed is gone, so the receiver discards what it got for it.
+ */
+static void ReorderBufferStreamAbortTXN(ReorderBuffer *rb, ReorderBufferTXN *txn, XLogRecPtr lsn)
+{
+    ReorderBufferTXN *toptxn = txn;
+
+    if (rb->stream_abort == NULL)
+        return;
+
+    if (txn->is_known_as_subxact)
+        toptxn = ReorderBufferTXNByXid(rb, txn->toplevel_xid, false, NULL, InvalidXLogRecPtr, false);
+
+    if (toptxn != NULL && toptxn->streamed)
+        rb->stream_abort(rb, txn, lsn);
+}
+
 /*
  * Spill data of a large transaction (and its subtransactions) to disk.
  */
@@ -75,6 +75,7 @@
 #include "rewrite/rewriteHandler.h"
 
 #include "storage/buf/bufmgr.h"
+#include "storage/buf/buffile.h"
 #include "storage/ipc.h"
 #include "storage/lmgr.h"
 #include "storage/proc.h"
@@ -108,13 +109,38 @@ typedef struct SlotErrCallbackArg {
     int remote_attnum;
 } SlotErrCallbackArg;
 
+/* Where the changes of a subtransaction start in the spool of its toplevel */
+typedef struct ApplyStreamSubXact {
+    TransactionId xid;
+    int fileno;
+    off_t offset;
+} ApplyStreamSubXact;
+
+/*
+ * A streamed remote transaction. Its changes are spooled to a temporary file
+ * as they arrive and applied when the STREAM COMMIT comes.
+ */
+typedef struct ApplyStreamTxn {
+    TransactionId xid; /* remote toplevel xid, hash key */
+    BufFile *file;
+    int endFileno;     /* logical end of the spool, moves back on subxact abort */
+    off_t endOffset;
+    ApplyStreamSubXact *subxacts; /* in order of their first change */
+    int nsubxacts;
+    int maxsubxacts;
+} ApplyStreamTxn;
+
 static void send_feedback(XLogRecPtr recvpos, bool force, bool requestReply);
-static void store_flush_position(XLogRecPtr remote_lsn);
+static void store_flush_position(XLogRecPtr remote_lsn, XLogRecPtr local_lsn);
 static void reread_subscription(void);
 static void ApplyWorkerProcessMsg(char type, StringInfo s, XLogRecPtr *lastRcv);
 static void apply_dispatch(StringInfo s);
 static void apply_handle_conninfo(StringInfo s);
 static void UpdateConninfo(char* standbysInfo);
+static void ParallelApplyCommit(LogicalRepCommitData *commit_data);
+static void apply_finish_commit(LogicalRepCommitData *commit_data);
+static void ApplyBufferedMessage(StringInfo msg);
+static bool handle_streamed_transaction(char action, StringInfo s);
 
 /*
  * Should this worker apply changes for given relation.
@@ -492,24 +518,361 @@ static void apply_handle_commit(StringInfo s)
 
     Assert(commit_data.commit_lsn == t_thrd.applyworker_cxt.remoteFinalLsn);
 
+    if (AM_PARALLEL_APPLY_WORKER) {
+        ParallelApplyCommit(&commit_data);
+        return;
+    }
+
+    apply_finish_commit(&commit_data);
+}
+
+/*
+ * Commit the local transaction of a remote transaction that has been applied.
+ */
+static void apply_finish_commit(LogicalRepCommitData *commit_data)
+{
     if (IsTransactionState()) {
         /*
          * Update origin state so we can restart streaming from correct
          * position in case of crash.
          */
-        u_sess->reporigin_cxt.originTs = commit_data.committime;
-        u_sess->reporigin_cxt.originLsn = commit_data.end_lsn;
+        u_sess->reporigin_cxt.originTs = commit_data->committime;
+        u_sess->reporigin_cxt.originLsn = commit_data->end_lsn;
 
         CommitTransactionCommand();
         pgstat_report_stat(false);
-        store_flush_position(commit_data.end_lsn);
+        store_flush_position(commit_data->end_lsn, t_thrd.xlog_cxt.XactLastCommitEnd);
     }
 
     t_thrd.applyworker_cxt.inRemoteTransaction = false;
 
     /* Process any tables that are being synchronized in parallel. */
-    process_syncing_tables(commit_data.end_lsn);
+    process_syncing_tables(commit_data->end_lsn);
+
+    pgstat_report_activity(STATE_IDLE, NULL);
+}
+
+/*
+ * Find the spool of a streamed remote transaction, creating it if asked to.
+ */
+static ApplyStreamTxn *ApplyStreamLookup(TransactionId xid, bool create)
+{
+    ApplyStreamTxn *stxn = NULL;
+    bool found = false;
+
+    if (t_thrd.applyworker_cxt.streamTxns == NULL) {
+        HASHCTL ctl;
+        int rc;
+
+        if (!create)
+            return NULL;
+
+        rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+        securec_check(rc, "\0", "\0");
+        ctl.keysize = sizeof(TransactionId);
+        ctl.entrysize = sizeof(ApplyStreamTxn);
+        ctl.hcxt = t_thrd.applyworker_cxt.applyContext;
+        t_thrd.applyworker_cxt.streamTxns = hash_create("logical replication streamed transactions", 16, &ctl,
+            HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+    }
+
+    stxn = (ApplyStreamTxn *)hash_search(t_thrd.applyworker_cxt.streamTxns, &xid, create ? HASH_ENTER : HASH_FIND,
+        &found);
+    if (create && !found) {
+        /* The spool outlives the messages and the local transactions. */
+        MemoryContext oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+
+        stxn->file = BufFileCreateTemp(true);
+        stxn->endFileno = 0;
+        stxn->endOffset = 0;
+        stxn->subxacts = NULL;
+        stxn->nsubxacts = 0;
+        stxn->maxsubxacts = 0;
+        MemoryContextSwitchTo(oldctx);
+    }
+
+    return stxn;
+}
+
+/*
+ * Throw away the spool of a streamed remote transaction.
+ */
+static void ApplyStreamDiscard(ApplyStreamTxn *stxn)
+{
+    TransactionId xid = stxn->xid;
+
+    BufFileClose(stxn->file);
+    if (stxn->subxacts != NULL)
+        pfree(stxn->subxacts);
+    (void)hash_search(t_thrd.applyworker_cxt.streamTxns, &xid, HASH_REMOVE, NULL);
+}
+
+/*
+ * Are there streamed transactions whose commit we have not seen yet?
+ */
+static bool ApplyStreamHasPendingTxns(void)
+{
+    return t_thrd.applyworker_cxt.streamTxns != NULL && hash_get_num_entries(t_thrd.applyworker_cxt.streamTxns) > 0;
+}
+
+/*
+ * Remember where the changes of a subtransaction start in the spool, so they
+ * can be dropped if the subtransaction aborts.
+ */
+static void ApplyStreamRememberSubXact(ApplyStreamTxn *stxn, TransactionId subxid)
+{
+    ApplyStreamSubXact *subxact = NULL;
+
+    /* Most of the time we get changes of the same subxact in a row. */
+    if (stxn->nsubxacts > 0 && stxn->subxacts[stxn->nsubxacts - 1].xid == subxid)
+        return;
+
+    for (int i = stxn->nsubxacts - 1; i >= 0; i--) {
+        if (stxn->subxacts[i].xid == subxid)
+            return;
+    }
+
+    if (stxn->nsubxacts == stxn->maxsubxacts) {
+        MemoryContext oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+
+        stxn->maxsubxacts = (stxn->maxsubxacts == 0) ? 16 : stxn->maxsubxacts * 2;
+        if (stxn->subxacts == NULL)
+            stxn->subxacts = (ApplyStreamSubXact *)palloc(stxn->maxsubxacts * sizeof(ApplyStreamSubXact));
+        else
+            stxn->subxacts = (ApplyStreamSubXact *)repalloc(stxn->subxacts,
+                stxn->maxsubxacts * sizeof(ApplyStreamSubXact));
+        MemoryContextSwitchTo(oldctx);
+    }
+
+    subxact = &stxn->subxacts[stxn->nsubxacts++];
+    subxact->xid = subxid;
+    subxact->fileno = stxn->endFileno;
+    subxact->offset = stxn->endOffset;
+}
+
+/*
+ * Spool a change received inside a stream block instead of applying it.
+ *
+ * Returns false if no stream block is open, the change is applied right away
+ * then.
+ */
+static bool handle_streamed_transaction(char action, StringInfo s)
+{
+    ApplyStreamTxn *stxn = t_thrd.applyworker_cxt.streamTxn;
+    TransactionId xid;
+    int len;
+
+    if (stxn == NULL)
+        return false;
+
+    /* The change is tagged with the (sub)transaction it belongs to. */
+    xid = pq_getmsgint64(s);
+    if (!TransactionIdIsValid(xid))
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+            errmsg("invalid transaction ID in streamed replication transaction")));
+    if (xid != stxn->xid)
+        ApplyStreamRememberSubXact(stxn, xid);
+
+    /* Spool the message without the xid, as apply_dispatch expects it. */
+    len = s->len - s->cursor + 1;
+    if (BufFileWrite(stxn->file, &len, sizeof(len)) != sizeof(len) ||
+        BufFileWrite(stxn->file, &action, sizeof(action)) != sizeof(action) ||
+        BufFileWrite(stxn->file, s->data + s->cursor, len - 1) != (size_t)(len - 1))
+        ereport(ERROR, (errcode_for_file_access(),
+            errmsg("could not write to streamed transaction %lu temporary file: %m", stxn->xid)));
+    BufFileTell(stxn->file, &stxn->endFileno, &stxn->endOffset);
+
+    return true;
+}
+
+/*
+ * Handle STREAM START message.
+ */
+static void apply_handle_stream_start(StringInfo s)
+{
+    ApplyStreamTxn *stxn = NULL;
+    TransactionId xid;
+    bool first_segment = false;
+
+    if (t_thrd.applyworker_cxt.streamTxn != NULL || t_thrd.applyworker_cxt.inRemoteTransaction)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("STREAM START message sent out of order")));
+
+    xid = logicalrep_read_stream_start(s, &first_segment);
+    if (!TransactionIdIsValid(xid))
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+            errmsg("invalid transaction ID in streamed replication transaction")));
+
+    stxn = ApplyStreamLookup(xid, first_segment);
+    if (stxn == NULL)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+            errmsg("missing the first chunk of streamed transaction %lu", xid)));
+
+    if (first_segment) {
+        /* The publisher starts over, forget anything left from earlier. */
+        stxn->endFileno = 0;
+        stxn->endOffset = 0;
+        stxn->nsubxacts = 0;
+    }
+
+    if (BufFileSeek(stxn->file, stxn->endFileno, stxn->endOffset, SEEK_SET) != 0)
+        ereport(ERROR, (errcode_for_file_access(),
+            errmsg("could not seek in streamed transaction %lu temporary file: %m", xid)));
+
+    t_thrd.applyworker_cxt.streamTxn = stxn;
+    pgstat_report_activity(STATE_RUNNING, NULL);
+}
+
+/*
+ * Handle STREAM STOP message.
+ */
+static void apply_handle_stream_stop(StringInfo s)
+{
+    if (t_thrd.applyworker_cxt.streamTxn == NULL)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("STREAM STOP message sent out of order")));
+
+    t_thrd.applyworker_cxt.streamTxn = NULL;
+    pgstat_report_activity(STATE_IDLE, NULL);
+}
+
+/*
+ * Handle STREAM ABORT message: drop the whole spool for a toplevel abort,
+ * or the changes from the aborted subtransaction on.
+ */
+static void apply_handle_stream_abort(StringInfo s)
+{
+    ApplyStreamTxn *stxn = NULL;
+    TransactionId xid;
+    TransactionId subxid;
+
+    if (t_thrd.applyworker_cxt.streamTxn != NULL)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("STREAM ABORT message sent out of order")));
+
+    logicalrep_read_stream_abort(s, &xid, &subxid);
+
+    /* Nothing spooled for it, e.g. when all its changes were filtered. */
+    stxn = ApplyStreamLookup(xid, false);
+    if (stxn == NULL)
+        return;
+
+    if (xid == subxid) {
+        ApplyStreamDiscard(stxn);
+        return;
+    }
+
+    /*
+     * Changes after the start of the subtransaction belong to it or to its
+     * own subtransactions, which are aborted as well.
+     */
+    for (int i = stxn->nsubxacts - 1; i >= 0; i--) {
+        if (stxn->subxacts[i].xid == subxid) {
+            stxn->endFileno = stxn->subxacts[i].fileno;
+            stxn->endOffset = stxn->subxacts[i].offset;
+            stxn->nsubxacts = i;
+            break;
+        }
+    }
+}
+
+/*
+ * Apply the spooled changes of a streamed transaction.
+ */
+static void ApplyStreamReplay(ApplyStreamTxn *stxn)
+{
+    StringInfoData buf;
+    MemoryContext oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+
+    initStringInfo(&buf);
+    MemoryContextSwitchTo(oldctx);
+
+    if (BufFileSeek(stxn->file, 0, 0, SEEK_SET) != 0)
+        ereport(ERROR, (errcode_for_file_access(),
+            errmsg("could not seek in streamed transaction %lu temporary file: %m", stxn->xid)));
+
+    for (;;) {
+        int fileno;
+        off_t offset;
+        int len;
+
+        BufFileTell(stxn->file, &fileno, &offset);
+        if (fileno == stxn->endFileno && offset == stxn->endOffset)
+            break;
+
+        if (BufFileRead(stxn->file, &len, sizeof(len)) != sizeof(len))
+            ereport(ERROR, (errcode_for_file_access(),
+                errmsg("could not read from streamed transaction %lu temporary file: %m", stxn->xid)));
+
+        resetStringInfo(&buf);
+        enlargeStringInfo(&buf, len);
+        if (BufFileRead(stxn->file, buf.data, len) != (size_t)len)
+            ereport(ERROR, (errcode_for_file_access(),
+                errmsg("could not read from streamed transaction %lu temporary file: %m", stxn->xid)));
+        buf.len = len;
+        buf.data[len] = '\0';
+
+        ApplyBufferedMessage(&buf);
+
+        /* Keep the publisher informed while applying a big transaction. */
+        send_feedback(InvalidXLogRecPtr, false, false);
+        CHECK_FOR_INTERRUPTS();
+    }
+
+    pfree(buf.data);
+}
+
+/*
+ * Handle STREAM COMMIT message: apply the spooled changes as one local
+ * transaction.
+ */
+static void apply_handle_stream_commit(StringInfo s)
+{
+    LogicalRepCommitData commit_data;
+    ApplyStreamTxn *stxn = NULL;
+    TransactionId xid;
+
+    if (t_thrd.applyworker_cxt.streamTxn != NULL || t_thrd.applyworker_cxt.inRemoteTransaction)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("STREAM COMMIT message sent out of order")));
+
+    xid = logicalrep_read_stream_commit(s, &commit_data);
+
+    t_thrd.applyworker_cxt.inRemoteTransaction = true;
+    t_thrd.applyworker_cxt.remoteFinalLsn = commit_data.commit_lsn;
+    pgstat_report_activity(STATE_RUNNING, NULL);
+
+    stxn = ApplyStreamLookup(xid, false);
+    if (stxn != NULL) {
+        ApplyStreamReplay(stxn);
+        ApplyStreamDiscard(stxn);
+    }
+
+    apply_finish_commit(&commit_data);
+}
+
+/*
+ * Handle COMMIT message in a parallel apply worker.
+ *
+ * Commit in remote commit order and leave the flush position tracking and
+ * the table synchronization to the leader.
+ */
+static void ParallelApplyCommit(LogicalRepCommitData *commit_data)
+{
+    XLogRecPtr local_end = InvalidXLogRecPtr;
+
+    ParallelApplyWaitCommitTurn();
+
+    /* Don't let an interrupt come between the commit and publishing it. */
+    HOLD_INTERRUPTS();
+    if (IsTransactionState()) {
+        u_sess->reporigin_cxt.originTs = commit_data->committime;
+        u_sess->reporigin_cxt.originLsn = commit_data->end_lsn;
 
+        CommitTransactionCommand();
+        local_end = t_thrd.xlog_cxt.XactLastCommitEnd;
+    }
+    ParallelApplyFinishTxn(local_end);
+    RESUME_INTERRUPTS();
+
+    pgstat_report_stat(false);
+    t_thrd.applyworker_cxt.inRemoteTransaction = false;
     pgstat_report_activity(STATE_IDLE, NULL);
 }
 
@@ -583,6 +946,9 @@ static void apply_handle_insert(StringInfo s)
     MemoryContext oldctx;
     FakeRelationPartition fakeRelInfo;
 
+    if (handle_streamed_transaction('I', s))
+        return;
+
     ensure_transaction();
 
     relid = logicalrep_read_insert(s, &newtup);
@@ -706,6 +1072,9 @@ static void apply_handle_update(StringInfo s)
     MemoryContext oldctx;
     FakeRelationPartition fakeRelInfo;
 
+    if (handle_streamed_transaction('U', s))
+        return;
+
     ensure_transaction();
 
     relid = logicalrep_read_update(s, &has_oldtup, &oldtup, &newtup);
@@ -824,6 +1193,9 @@ static void apply_handle_delete(StringInfo s)
     MemoryContext oldctx;
     FakeRelationPartition fakeRelInfo;
 
+    if (handle_streamed_transaction('D', s))
+        return;
+
     ensure_transaction();
 
     relid = logicalrep_read_delete(s, &oldtup);
@@ -932,6 +1304,22 @@ static void apply_dispatch(StringInfo s)
         case 'S':
             apply_handle_conninfo(s);
             break;
+        /* STREAM START */
+        case 's':
+            apply_handle_stream_start(s);
+            break;
+        /* STREAM STOP */
+        case 'E':
+            apply_handle_stream_stop(s);
+            break;
+        /* STREAM ABORT */
+        case 'A':
+            apply_handle_stream_abort(s);
+            break;
+        /* STREAM COMMIT */
+        case 'c':
+            apply_handle_stream_commit(s);
+            break;
         default:
             ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
                 errmsg("invalid logical replication message type \"%c\"", action)));
@@ -988,7 +1376,7 @@ static void get_flush_position(XLogRecPtr *write, XLogRecPtr *flush, bool *have_
 /*
  * Store current remote/local lsn pair in the tracking list.
  */
-static void store_flush_position(XLogRecPtr remote_lsn)
+static void store_flush_position(XLogRecPtr remote_lsn, XLogRecPtr local_lsn)
 {
     FlushPosition *flushpos;
 
@@ -997,7 +1385,7 @@ static void store_flush_position(XLogRecPtr remote_lsn)
 
     /* Track commit lsn  */
     flushpos = (FlushPosition *)palloc(sizeof(FlushPosition));
-    flushpos->local_end = t_thrd.xlog_cxt.XactLastCommitEnd;
+    flushpos->local_end = local_lsn;
     flushpos->remote_end = remote_lsn;
 
     dlist_push_tail(&t_thrd.applyworker_cxt.lsnMapping, &flushpos->node);
@@ -1005,6 +1393,153 @@ static void store_flush_position(XLogRecPtr remote_lsn)
 }
 
 
+/*
+ * With parallel apply the local commits are made by the parallel apply
+ * workers, track the latest one for the flush position reporting.
+ */
+static void ParallelApplyTrackProgress(void)
+{
+    XLogRecPtr remote_end;
+    XLogRecPtr local_end;
+
+    if (ParallelApplyGetProgress(&remote_end, &local_end))
+        store_flush_position(remote_end, local_end);
+}
+
+/*
+ * Apply a message buffered for parallel apply.
+ */
+static void ApplyBufferedMessage(StringInfo msg)
+{
+    StringInfoData s;
+
+    s.data = msg->data;
+    s.len = msg->len;
+    s.cursor = 0;
+    s.maxlen = -1;
+
+    MemoryContextSwitchTo(t_thrd.applyworker_cxt.messageContext);
+    apply_dispatch(&s);
+    MemoryContextReset(t_thrd.applyworker_cxt.messageContext);
+}
+
+/*
+ * Apply a transaction buffered for parallel apply in the leader itself.
+ * The RELATION messages were applied when they arrived.
+ */
+static void ApplyBufferedTxn(ParallelApplyTxn *txn)
+{
+    ParallelApplyTrackProgress();
+    for (int i = 0; i < txn->nmsgs; i++)
+        ApplyBufferedMessage(&txn->msgs[i]);
+}
+
+/*
+ * A parallel apply worker failed: stop the others, apply what they did not
+ * commit and go on without parallel apply.
+ *
+ * last, if not NULL, is a transaction the leader took back from dispatch. It
+ * lives in the shared context like the uncommitted ones, so it is applied
+ * after them and before that context is released.
+ */
+static void ParallelApplyFallback(ParallelApplyTxn *last)
+{
+    List *uncommitted = NIL;
+    ListCell *lc = NULL;
+
+    ParallelApplyTrackProgress();
+    uncommitted = ParallelApplyStopWorkers();
+
+    ereport(WARNING, (errmsg("logical replication parallel apply worker for subscription \"%s\" failed, "
+        "applying changes serially", t_thrd.applyworker_cxt.mySubscription->name)));
+
+    foreach (lc, uncommitted) {
+        ParallelApplyTxn *txn = (ParallelApplyTxn *)lfirst(lc);
+
+        ApplyBufferedTxn(txn);
+        ParallelApplyFreeTxn(txn);
+    }
+    if (last != NULL) {
+        ApplyBufferedTxn(last);
+        ParallelApplyFreeTxn(last);
+    }
+    ParallelApplyReleaseTxns(uncommitted);
+}
+
+/*
+ * Leader side of parallel apply: buffer each remote transaction and hand it
+ * to the parallel apply workers at its commit.
+ */
+static void ParallelApplyLeaderDispatch(StringInfo s)
+{
+    char action = s->data[s->cursor];
+
+    /* Changes of streamed transactions are spooled by the leader itself. */
+    if (t_thrd.applyworker_cxt.streamTxn != NULL) {
+        if (action == 'R')
+            ParallelApplyRememberRelation(s);
+        apply_dispatch(s);
+        return;
+    }
+
+    switch (action) {
+        case 'B':
+            ParallelApplyBufferMessage(s);
+            apply_dispatch(s);
+            break;
+        case 'I':
+        case 'U':
+        case 'D':
+            ParallelApplyBufferMessage(s);
+            break;
+        case 'C': {
+            ParallelApplyTxn *txn = NULL;
+            XLogRecPtr end_lsn;
+
+            ParallelApplyBufferMessage(s);
+            end_lsn = t_thrd.applyworker_cxt.paCurTxn->endLsn;
+
+            txn = ParallelApplyDispatchTxn();
+            if (txn != NULL) {
+                if (ParallelApplyFailed()) {
+                    ParallelApplyFallback(txn);
+                } else {
+                    ApplyBufferedTxn(txn);
+                    ParallelApplyFreeTxn(txn);
+                }
+                break;
+            }
+
+            t_thrd.applyworker_cxt.inRemoteTransaction = false;
+            process_syncing_tables(end_lsn);
+            pgstat_report_activity(STATE_IDLE, NULL);
+            break;
+        }
+        case 'R':
+            ParallelApplyRememberRelation(s);
+            apply_dispatch(s);
+            break;
+        case 'Y':
+            /*
+             * TYPE messages only describe the remote type of a column, the
+             * apply maps columns by the local types and ignores them, so
+             * there is nothing to forward to the parallel apply workers.
+             */
+            apply_dispatch(s);
+            break;
+        case 'c':
+            /* A streamed transaction commits after everything handed out before it. */
+            if (!ParallelApplyWaitForAll())
+                ParallelApplyFallback(NULL);
+            ParallelApplyTrackProgress();
+            apply_dispatch(s);
+            break;
+        default:
+            apply_dispatch(s);
+            break;
+    }
+}
+
 /* Update statistics of the worker. */
 static void UpdateWorkerStats(XLogRecPtr last_lsn, TimestampTz send_time, bool reply)
 {
@@ -1033,7 +1568,10 @@ static void ApplyWorkerProcessMsg(char type, StringInfo s, XLogRecPtr *lastRcv)
 
         UpdateWorkerStats(*lastRcv, sendTime, false);
 
-        apply_dispatch(s);
+        if (t_thrd.applyworker_cxt.paGroup != NULL)
+            ParallelApplyLeaderDispatch(s);
+        else
+            apply_dispatch(s);
     } else if (type == 'k') {
         PrimaryKeepaliveMessage keepalive;
         pq_copymsgbytes(s, (char*)&keepalive, sizeof(PrimaryKeepaliveMessage));
@@ -1171,6 +1709,18 @@ static void LogicalRepApplyLoop(XLogRecPtr last_received)
             if (!t_thrd.applyworker_cxt.mySubscriptionValid)
                 reread_subscription();
 
+            /* Take over from failed parallel apply workers. */
+            if (ParallelApplyFailed())
+                ParallelApplyFallback(NULL);
+
+            /* The publisher only streams transactions if asked to when we connect. */
+            if (u_sess->attr.attr_storage.enable_logical_replication_streaming !=
+                t_thrd.applyworker_cxt.streamingRequested && !AM_TABLESYNC_WORKER) {
+                ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" "
+                    "will restart because of a parameter change", t_thrd.applyworker_cxt.mySubscription->name)));
+                proc_exit(0);
+            }
+
             /* Process any table synchronization changes. */
             process_syncing_tables(last_received);
         }
@@ -1212,8 +1762,16 @@ static void send_feedback(XLogRecPtr recvpos, bool force, bool requestReply)
     if (recvpos < t_thrd.applyworker_cxt.lastRecvpos)
         recvpos = t_thrd.applyworker_cxt.lastRecvpos;
 
+    ParallelApplyTrackProgress();
     get_flush_position(&writepos, &flushpos, &have_pending_txes);
 
+    /*
+     * Transactions handed to parallel apply workers might not be committed
+     * yet, and streamed ones are not applied before their commit arrives.
+     */
+    if (ParallelApplyHasPendingTxns() || ApplyStreamHasPendingTxns())
+        have_pending_txes = true;
+
     /*
      * No outstanding transactions to flush, we can report the latest
      * received position. This is important for synchronous replication.
@@ -1388,6 +1946,63 @@ static void subscription_change_cb(Datum arg, int cacheid, uint32 hashvalue)
 }
 
 
+/*
+ * Main loop of a parallel apply worker: apply the transactions the leader
+ * hands over.
+ */
+static void ParallelApplyWorkerLoop(void)
+{
+    t_thrd.applyworker_cxt.messageContext = AllocSetContextCreate(t_thrd.applyworker_cxt.applyContext,
+        "ApplyMessageContext", ALLOCSET_DEFAULT_SIZES);
+
+    pgstat_report_activity(STATE_IDLE, NULL);
+
+    for (;;) {
+        ParallelApplyTxn *txn = NULL;
+        int i;
+
+        MemoryContextSwitchTo(t_thrd.applyworker_cxt.messageContext);
+
+        CHECK_FOR_INTERRUPTS();
+        ProcessApplyWorkerInterrupts();
+
+        txn = ParallelApplyNextTxn();
+        if (txn == NULL) {
+            int rc = WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+                NAPTIME_PER_CYCLE);
+            /* emergency bailout if postmaster has died */
+            if (rc & WL_POSTMASTER_DEATH)
+                proc_exit(1);
+            ResetLatch(&t_thrd.proc->procLatch);
+
+            AcceptInvalidationMessages();
+            /* Check for subscription change */
+            if (!t_thrd.applyworker_cxt.mySubscriptionValid)
+                reread_subscription();
+
+            if (t_thrd.applyworker_cxt.got_SIGHUP) {
+                t_thrd.applyworker_cxt.got_SIGHUP = false;
+                ProcessConfigFile(PGC_SIGHUP);
+            }
+            continue;
+        }
+
+        /*
+         * The leader may free txn as soon as its COMMIT, the last message, is
+         * published, so take what the loop needs before applying anything.
+         */
+        int nmsgs = txn->nmsgs;
+        StringInfoData *msgs = txn->msgs;
+
+        t_thrd.applyworker_cxt.paCurTxn = txn;
+        for (i = 0; i < txn->nrelmsgs; i++)
+            ApplyBufferedMessage(&txn->relmsgs[i]);
+        for (i = 0; i < nmsgs; i++)
+            ApplyBufferedMessage(&msgs[i]);
+        t_thrd.applyworker_cxt.paCurTxn = NULL;
+    }
+}
+
 /* Logical Replication Apply worker entry point */
 void ApplyWorkerMain()
 {
@@ -1480,6 +2095,10 @@ void ApplyWorkerMain()
         /* Now we can allow interrupts again */
         RESUME_INTERRUPTS();
 
+        /* The leader applies what a failed parallel apply worker did not commit. */
+        if (AM_PARALLEL_APPLY_WORKER)
+            proc_exit(1);
+
         /*
          * Sleep at least 1 second after any error.  We don't want to be
          * filling the error logs as fast as we can.
@@ -1544,12 +2163,21 @@ void ApplyWorkerMain()
     if (AM_TABLESYNC_WORKER)
         ereport(LOG, (errmsg("logical replication table synchronization for subscription %s, table %s has started",
             t_thrd.applyworker_cxt.mySubscription->name, get_rel_name(t_thrd.applyworker_cxt.curWorker->relid))));
+    else if (AM_PARALLEL_APPLY_WORKER)
+        ereport(LOG, (errmsg("logical replication parallel apply worker %d for subscription \"%s\" has started",
+            t_thrd.applyworker_cxt.curWorker->paIndex, t_thrd.applyworker_cxt.mySubscription->name)));
     else
         ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" has started",
             t_thrd.applyworker_cxt.mySubscription->name)));
 
     CommitTransactionCommand();
 
+    if (AM_PARALLEL_APPLY_WORKER) {
+        ParallelApplyWorkerInit();
+        ParallelApplyWorkerLoop();
+        proc_exit(0);
+    }
+
     if (AM_TABLESYNC_WORKER) {
         char *syncslotname;
 
@@ -1577,6 +2205,8 @@ void ApplyWorkerMain()
         origin_startpos = replorigin_session_get_progress(false);
         CommitTransactionCommand();
 
+        ParallelApplyStartWorkers(originid);
+
         if (!AttemptConnectPublisher(t_thrd.applyworker_cxt.mySubscription->conninfo, myslotname, true)) {
             ereport(ERROR, (errcode(ERRCODE_CONNECTION_FAILURE), errmsg("Failed to connect to publisher.")));
         }
@@ -1606,6 +2236,14 @@ void ApplyWorkerMain()
     options.binary = t_thrd.applyworker_cxt.mySubscription->binary;
     options.useSnapshot = AM_TABLESYNC_WORKER;
 
+    /* Table synchronization stops at a consistent point and never needs streaming. */
+    t_thrd.applyworker_cxt.streamingRequested =
+        !AM_TABLESYNC_WORKER && u_sess->attr.attr_storage.enable_logical_replication_streaming;
+    if (t_thrd.applyworker_cxt.streamingRequested) {
+        options.protoVersion = LOGICALREP_STREAM_PROTO_VERSION_NUM;
+        options.streaming = true;
+    }
+
     /* Start normal logical streaming replication. */
     (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_startstreaming(&options);
 
@@ -43,6 +43,10 @@ static void pgoutput_abort_txn(LogicalDecodingContext* ctx, ReorderBufferTXN* tx
 static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, Relation rel,
     ReorderBufferChange *change);
 static bool pgoutput_origin_filter(LogicalDecodingContext *ctx, RepOriginId origin_id);
+static void pgoutput_stream_start(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
+static void pgoutput_stream_stop(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
+static void pgoutput_stream_commit(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
+static void pgoutput_stream_abort(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, XLogRecPtr abort_lsn);
 
 static List *LoadPublications(List *pubnames);
 static void publication_invalidation_cb(Datum arg, int cacheid, uint32 hashvalue);
@@ -76,6 +80,10 @@ void _PG_output_plugin_init(OutputPluginCallbacks *cb)
     cb->abort_cb = pgoutput_abort_txn;
     cb->filter_by_origin_cb = pgoutput_origin_filter;
     cb->shutdown_cb = pgoutput_shutdown;
+    cb->stream_start_cb = pgoutput_stream_start;
+    cb->stream_stop_cb = pgoutput_stream_stop;
+    cb->stream_commit_cb = pgoutput_stream_commit;
+    cb->stream_abort_cb = pgoutput_stream_abort;
 }
 
 static void parse_output_parameters(List *options, PGOutputData *data)
@@ -85,8 +93,10 @@ static void parse_output_parameters(List *options, PGOutputData *data)
     bool publication_names_given = false;
     bool binary_option_given = false;
     bool use_snapshot_given = false;
+    bool streaming_given = false;
 
     data->binary = false;
+    data->streaming = false;
 
     foreach (lc, options) {
         DefElem *defel = (DefElem *)lfirst(lc);
@@ -128,6 +138,12 @@ static void parse_output_parameters(List *options, PGOutputData *data)
             use_snapshot_given = true;
 
             t_thrd.walsender_cxt.isUseSnapshot = true;
+        } else if (strcmp(defel->defname, "streaming") == 0) {
+            if (streaming_given)
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("conflicting or redundant options")));
+            streaming_given = true;
+
+            data->streaming = defGetBoolean(defel);
         } else
             elog(ERROR, "unrecognized pgoutput option: %s", defel->defname);
     }
@@ -171,6 +187,11 @@ static void pgoutput_startup(LogicalDecodingContext *ctx, OutputPluginOptions *o
         if (list_length(data->publication_names) < 1)
             ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("publication_names parameter missing")));
 
+        if (data->streaming && data->protocol_version < LOGICALREP_STREAM_PROTO_VERSION_NUM)
+            ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("requested proto_version=%d does not support streaming, need %d or higher",
+                data->protocol_version, LOGICALREP_STREAM_PROTO_VERSION_NUM)));
+
         /* Init publication state. */
         data->publications = NIL;
         t_thrd.publication_cxt.publications_valid = false;
@@ -182,6 +203,9 @@ static void pgoutput_startup(LogicalDecodingContext *ctx, OutputPluginOptions *o
         /* Initialize relation schema cache. */
         init_rel_sync_cache(THREAD_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_DEFAULT));
     }
+
+    /* Only stream in-progress transactions if the subscriber asked for it. */
+    ctx->streaming = ctx->streaming && data->streaming;
 }
 
 /*
@@ -317,10 +341,20 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
     PGOutputData *data = (PGOutputData *)ctx->output_plugin_private;
     MemoryContext old;
     RelationSyncEntry *relentry;
+    TransactionId xid = InvalidTransactionId;
 
     if (!is_publishable_relation(relation))
         return;
 
+    /*
+     * Changes of a streamed transaction carry the xid of the (sub)transaction
+     * they belong to, so that the subscriber can discard aborted subxacts.
+     * Relation and type messages are applied by the subscriber as soon as
+     * they arrive, so the schema is tracked the same way as without streaming.
+     */
+    if (data->in_streaming)
+        xid = change->txn->xid;
+
     relentry = get_rel_sync_entry(data, RelationGetRelid(relation));
     /* First check the table filter */
     if (!CheckAction(change->action, relentry->pubactions)) {
@@ -339,19 +373,21 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
     switch (change->action) {
         case REORDER_BUFFER_CHANGE_INSERT:
             OutputPluginPrepareWrite(ctx, true);
-            logicalrep_write_insert(ctx->out, relation, &change->data.tp.newtuple->tuple, data->binary);
+            logicalrep_write_insert(ctx->out, relation, &change->data.tp.newtuple->tuple, data->binary, xid);
             OutputPluginWrite(ctx, true);
             break;
         case REORDER_BUFFER_CHANGE_UINSERT:
             OutputPluginPrepareWrite(ctx, true);
-            logicalrep_write_insert(ctx->out, relation, (HeapTuple)(&change->data.utp.newtuple->tuple), data->binary);
+            logicalrep_write_insert(ctx->out, relation, (HeapTuple)(&change->data.utp.newtuple->tuple), data->binary,
+                xid);
             OutputPluginWrite(ctx, true);
             break;
         case REORDER_BUFFER_CHANGE_UPDATE: {
             HeapTuple oldtuple = change->data.tp.oldtuple ? &change->data.tp.oldtuple->tuple : NULL;
 
             OutputPluginPrepareWrite(ctx, true);
-            logicalrep_write_update(ctx->out, relation, oldtuple, &change->data.tp.newtuple->tuple, data->binary);
+            logicalrep_write_update(ctx->out, relation, oldtuple, &change->data.tp.newtuple->tuple, data->binary,
+                xid);
             OutputPluginWrite(ctx, true);
             break;
         }
@@ -359,14 +395,15 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
             HeapTuple oldtuple = change->data.utp.oldtuple ? ((HeapTuple)(&change->data.utp.oldtuple->tuple)) : NULL;
 
             OutputPluginPrepareWrite(ctx, true);
-            logicalrep_write_update(ctx->out, relation, oldtuple, (HeapTuple)(&change->data.utp.newtuple->tuple), data->binary);
+            logicalrep_write_update(ctx->out, relation, oldtuple, (HeapTuple)(&change->data.utp.newtuple->tuple),
+                data->binary, xid);
             OutputPluginWrite(ctx, true);
             break;
         }
         case REORDER_BUFFER_CHANGE_DELETE:
             if (change->data.tp.oldtuple) {
                 OutputPluginPrepareWrite(ctx, true);
-                logicalrep_write_delete(ctx->out, relation, &change->data.tp.oldtuple->tuple, data->binary);
+                logicalrep_write_delete(ctx->out, relation, &change->data.tp.oldtuple->tuple, data->binary, xid);
                 OutputPluginWrite(ctx, true);
             } else
                 elog(DEBUG1, "didn't send DELETE change because of missing oldtuple");
@@ -374,7 +411,8 @@ static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn,
         case REORDER_BUFFER_CHANGE_UDELETE:
             if (change->data.utp.oldtuple) {
                 OutputPluginPrepareWrite(ctx, true);
-                logicalrep_write_delete(ctx->out, relation, (HeapTuple)(&change->data.utp.oldtuple->tuple), data->binary);
+                logicalrep_write_delete(ctx->out, relation, (HeapTuple)(&change->data.utp.oldtuple->tuple),
+                    data->binary, xid);
                 OutputPluginWrite(ctx, true);
             } else
                 elog(DEBUG1, "didn't send DELETE change because of missing oldtuple");
@@ -399,6 +437,72 @@ static bool pgoutput_origin_filter(LogicalDecodingContext *ctx, RepOriginId orig
     return false;
 }
 
+/*
+ * START STREAM callback
+ */
+static void pgoutput_stream_start(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    PGOutputData *data = (PGOutputData *)ctx->output_plugin_private;
+
+    /* we can't nest streaming of transactions */
+    Assert(!data->in_streaming);
+
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_start(ctx->out, txn->xid, !txn->streamed);
+    OutputPluginWrite(ctx, true);
+
+    /* we're streaming a chunk of transaction now */
+    data->in_streaming = true;
+}
+
+/*
+ * STOP STREAM callback
+ */
+static void pgoutput_stream_stop(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    PGOutputData *data = (PGOutputData *)ctx->output_plugin_private;
+
+    /* we should be streaming a transaction */
+    Assert(data->in_streaming);
+
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_stop(ctx->out);
+    OutputPluginWrite(ctx, true);
+
+    /* we've stopped streaming a transaction */
+    data->in_streaming = false;
+}
+
+/*
+ * Notify downstream to discard the streamed transaction (along with all
+ * its subtransactions, if it's a toplevel transaction).
+ */
+static void pgoutput_stream_abort(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, XLogRecPtr abort_lsn)
+{
+    TransactionId topxid = txn->is_known_as_subxact ? txn->toplevel_xid : txn->xid;
+
+    /* aborts are never part of a stream block */
+    Assert(!((PGOutputData *)ctx->output_plugin_private)->in_streaming);
+
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_abort(ctx->out, topxid, txn->xid);
+    OutputPluginWrite(ctx, true);
+}
+
+/*
+ * Notify downstream to apply the streamed transaction (along with all
+ * its subtransactions).
+ */
+static void pgoutput_stream_commit(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, XLogRecPtr commit_lsn)
+{
+    Assert(!((PGOutputData *)ctx->output_plugin_private)->in_streaming);
+    Assert(!txn->is_known_as_subxact);
+
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_commit(ctx->out, txn, commit_lsn);
+    OutputPluginWrite(ctx, true);
+}
+
 /*
  * Shutdown the output plugin.
  *
@@ -94,6 +94,8 @@
 %token K_NEEDUPGRADEFILE
 %token K_WAL
 %token K_TABLESPACE_MAP
+%token K_INCREMENTAL
+%token K_PREFETCH_DEPTH
 %token K_DATA
 %token K_START_REPLICATION
 %token K_FETCH_MOT_CHECKPOINT
@@ -229,7 +231,7 @@ identify_az:
 
 /*
  * BASE_BACKUP [LABEL '<label>'] [PROGRESS] [FAST] [WAL] [NOWAIT] [BUILDSTANDBY] [OBSMODE] [COPYSECUREFILE] 
- * [COPYUPGRADEFILE] [TABLESPACE_MAP]
+ * [COPYUPGRADEFILE] [TABLESPACE_MAP] [INCREMENTAL '<lsn>'] [PREFETCH_DEPTH <n>]
  */
 base_backup:
 			K_BASE_BACKUP base_backup_opt_list
@@ -294,6 +296,16 @@ base_backup_opt:
 			          $$ = makeDefElem("tablespace_map",
 				                   (Node *)makeInteger(TRUE));
 				}
+			| K_INCREMENTAL SCONST
+				{
+				  $$ = makeDefElem("incremental",
+						   (Node *)makeString($2));
+				}
+			| K_PREFETCH_DEPTH ICONST
+				{
+				  $$ = makeDefElem("prefetch_depth",
+						   (Node *)makeInteger($2));
+				}
 			;
 
 /*
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ *  ringpool.cpp
+ *      In-order ring of work slots processed by a group of helper threads.
+ *
+ * The owner thread fills slots at the ring tail and submits them; helper
+ * threads claim pending slots in ring order and run the caller's work
+ * function on them in parallel; the owner consumes finished slots strictly
+ * from the ring head, so results come out in submission order whatever
+ * order they completed in.
+ *
+ * The helper threads are not backend threads: they never touch t_thrd,
+ * palloc or ereport, and neither may the work function. All memory is owned,
+ * sized and freed by the owner; a helper only works on the slot it claimed
+ * and reports the outcome under the pool mutex. While waiting for a slot the
+ * owner wakes up periodically to run its interrupt function, so a stuck
+ * helper cannot make it ignore cancel and shutdown requests.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/replication/ringpool.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+
+#include "replication/ringpool.h"
+#include "utils/memutils.h"
+
+/* how long the owner sleeps between interrupt checks while waiting on a slot */
+#define RING_POOL_WAIT_NSEC (10 * 1000 * 1000L)
+#define NSEC_PER_SEC (1000 * 1000 * 1000L)
+
+typedef struct RingPoolWorkerArg {
+    RingPool *pool;
+    void *workerState;
+} RingPoolWorkerArg;
+
+static void *RingPoolWorkerMain(void *arg)
+{
+    RingPool *pool = ((RingPoolWorkerArg *)arg)->pool;
+    void *workerState = ((RingPoolWorkerArg *)arg)->workerState;
+    sigset_t sigs;
+
+    /* signals are for the owner thread to handle */
+    (void)sigfillset(&sigs);
+    (void)pthread_sigmask(SIG_BLOCK, &sigs, NULL);
+
+    (void)pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (!pool->shutdown && pool->claim == pool->tail) {
+            (void)pthread_cond_wait(&pool->workCond, &pool->mutex);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        uint64 pos = pool->claim;
+        pool->claim++;
+        (void)pthread_mutex_unlock(&pool->mutex);
+
+        bool ok = pool->work(pool, RingPoolSlot(pool, pos), workerState);
+
+        (void)pthread_mutex_lock(&pool->mutex);
+        pool->states[pos % pool->nslots] = ok ? RING_SLOT_DONE : RING_SLOT_FAILED;
+        (void)pthread_cond_broadcast(&pool->doneCond);
+    }
+    (void)pthread_mutex_unlock(&pool->mutex);
+
+    if (pool->workerExit != NULL) {
+        pool->workerExit(workerState);
+    }
+    return NULL;
+}
+
+/*
+ * Start a pool of nworkers helper threads over a ring of slotsPerWorker
+ * slots per thread. Fewer threads may be running if some could not be
+ * started; the caller checks nstarted.
+ */
+RingPool *RingPoolStart(const char *name, int nworkers, uint32 slotsPerWorker, Size slotSize, Size workerStateSize,
+                        RingPoolWorkFunc work, RingPoolWorkerExitFunc workerExit, RingPoolInterruptFunc interrupt)
+{
+    MemoryContext context = AllocSetContextCreate(t_thrd.top_mem_cxt, name, ALLOCSET_DEFAULT_MINSIZE,
+                                                  ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE);
+    RingPool *pool = (RingPool *)MemoryContextAllocZero(context, sizeof(RingPool));
+    pool->context = context;
+    pool->nworkers = nworkers;
+    pool->nslots = (uint32)nworkers * slotsPerWorker;
+    pool->states = (RingSlotState *)MemoryContextAllocZero(context, sizeof(RingSlotState) * pool->nslots);
+    pool->slotSize = MAXALIGN(slotSize);
+    pool->slots = (char *)MemoryContextAllocZero(context, pool->slotSize * pool->nslots);
+    pool->workerStateSize = MAXALIGN(workerStateSize);
+    if (pool->workerStateSize > 0) {
+        pool->workerStates = (char *)MemoryContextAllocZero(context, pool->workerStateSize * nworkers);
+    }
+    pool->work = work;
+    pool->workerExit = workerExit;
+    pool->interrupt = interrupt;
+    pool->workers = (pthread_t *)MemoryContextAllocZero(context, sizeof(pthread_t) * nworkers);
+    RingPoolWorkerArg *args = (RingPoolWorkerArg *)MemoryContextAllocZero(context,
+                                                                          sizeof(RingPoolWorkerArg) * nworkers);
+    (void)pthread_mutex_init(&pool->mutex, NULL);
+    (void)pthread_cond_init(&pool->workCond, NULL);
+    (void)pthread_cond_init(&pool->doneCond, NULL);
+
+    for (int i = 0; i < nworkers; i++) {
+        args[i].pool = pool;
+        args[i].workerState = (pool->workerStates != NULL) ? pool->workerStates + i * pool->workerStateSize : NULL;
+        int rc = pthread_create(&pool->workers[i], NULL, RingPoolWorkerMain, &args[i]);
+        if (rc != 0) {
+            ereport(WARNING, (errmsg("could not start helper thread for %s: %s", name, gs_strerror(rc)),
+                              errdetail("%d of %d threads are running.", pool->nstarted, nworkers)));
+            break;
+        }
+        pool->nstarted++;
+    }
+    return pool;
+}
+
+/* Hand the slots filled in [tail, newTail) to the helper threads. */
+void RingPoolSubmit(RingPool *pool, uint64 newTail)
+{
+    Assert(newTail - pool->head <= pool->nslots);
+
+    (void)pthread_mutex_lock(&pool->mutex);
+    for (uint64 pos = pool->tail; pos < newTail; pos++) {
+        Assert(pool->states[pos % pool->nslots] == RING_SLOT_FREE);
+        pool->states[pos % pool->nslots] = RING_SLOT_PENDING;
+    }
+    pool->tail = newTail;
+    (void)pthread_cond_broadcast(&pool->workCond);
+    (void)pthread_mutex_unlock(&pool->mutex);
+}
+
+RingSlotState RingPoolPeekSlot(RingPool *pool, uint64 pos)
+{
+    (void)pthread_mutex_lock(&pool->mutex);
+    RingSlotState state = pool->states[pos % pool->nslots];
+    (void)pthread_mutex_unlock(&pool->mutex);
+    return state;
+}
+
+/*
+ * Wait for the slot at pos to finish. Returns RING_SLOT_PENDING only if the
+ * interrupt function gave up the wait.
+ */
+RingSlotState RingPoolWaitSlot(RingPool *pool, uint64 pos)
+{
+    RingSlotState state;
+
+    (void)pthread_mutex_lock(&pool->mutex);
+    while ((state = pool->states[pos % pool->nslots]) == RING_SLOT_PENDING) {
+        struct timespec deadline;
+        (void)clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += RING_POOL_WAIT_NSEC;
+        if (deadline.tv_nsec >= NSEC_PER_SEC) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= NSEC_PER_SEC;
+        }
+        (void)pthread_cond_timedwait(&pool->doneCond, &pool->mutex, &deadline);
+        if (pool->states[pos % pool->nslots] != RING_SLOT_PENDING || pool->interrupt == NULL) {
+            continue;
+        }
+
+        /* Process any requests or signals received recently; may not return */
+        (void)pthread_mutex_unlock(&pool->mutex);
+        bool giveUp = pool->interrupt();
+        (void)pthread_mutex_lock(&pool->mutex);
+        if (giveUp) {
+            state = pool->states[pos % pool->nslots];
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&pool->mutex);
+    return state;
+}
+
+/* Free the finished head slot for reuse. */
+void RingPoolRelease(RingPool *pool)
+{
+    Assert(pool->head != pool->tail);
+
+    /* no helper touches a finished slot, so this needs no lock */
+    Assert(pool->states[pool->head % pool->nslots] != RING_SLOT_PENDING);
+    pool->states[pool->head % pool->nslots] = RING_SLOT_FREE;
+    pool->head++;
+}
+
+/*
+ * Empty the ring. Slots not yet claimed are simply dropped; the ones a
+ * helper is working on right now have to finish before they can be reused.
+ * Returns false, with only those slots left in the ring, if the interrupt
+ * function gave up waiting for them.
+ */
+bool RingPoolDiscard(RingPool *pool)
+{
+    (void)pthread_mutex_lock(&pool->mutex);
+    for (uint64 pos = pool->claim; pos < pool->tail; pos++) {
+        pool->states[pos % pool->nslots] = RING_SLOT_FREE;
+    }
+    pool->tail = pool->claim;
+    (void)pthread_mutex_unlock(&pool->mutex);
+
+    while (pool->head != pool->tail) {
+        if (RingPoolWaitSlot(pool, pool->head) == RING_SLOT_PENDING) {
+            return false;
+        }
+        RingPoolRelease(pool);
+    }
+    return true;
+}
+
+/* Stop the helper threads and release the pool. Slots still queued are dropped. */
+void RingPoolStop(RingPool *pool)
+{
+    (void)pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    (void)pthread_cond_broadcast(&pool->workCond);
+    (void)pthread_mutex_unlock(&pool->mutex);
+    for (int i = 0; i < pool->nstarted; i++) {
+        (void)pthread_join(pool->workers[i], NULL);
+    }
+
+    (void)pthread_cond_destroy(&pool->doneCond);
+    (void)pthread_cond_destroy(&pool->workCond);
+    (void)pthread_mutex_destroy(&pool->mutex);
+    MemoryContextDelete(pool->context);
+}
@@ -86,6 +86,7 @@ static void SyncRepQueueInsert(int mode);
 static bool SyncRepCancelWait(void);
 static void SyncRepWaitCompletionQueue();
 static void SyncRepNotifyComplete();
+static void SyncRepReportWaitTime(int mode, instr_time waitStart);
 
 static void SyncRepGetStandbyGroupAndPriority(int* gid, int* prio);
 #ifndef ENABLE_MULTIPLE_NODES
@@ -207,6 +208,7 @@ SyncWaitRet SyncRepWaitForLSN(XLogRecPtr XactCommitLSN, bool enableHandleCancel)
     const char *old_status = NULL;
     int mode = u_sess->attr.attr_storage.sync_rep_wait_mode;
     SyncWaitRet waitStopRes = NOT_REQUEST;
+    instr_time waitStart;
 
     /*
      * Fast exit if user has not requested sync replication, or there are no
@@ -267,6 +269,8 @@ SyncWaitRet SyncRepWaitForLSN(XLogRecPtr XactCommitLSN, bool enableHandleCancel)
     Assert(SyncRepQueueIsOrderedByLSN(mode));
     LWLockRelease(SyncRepLock);
 
+    INSTR_TIME_SET_CURRENT(waitStart);
+
     /* Alter ps display to show waiting for sync rep. */
     if (u_sess->attr.attr_common.update_process_title) {
         int len;
@@ -453,6 +457,10 @@ SyncWaitRet SyncRepWaitForLSN(XLogRecPtr XactCommitLSN, bool enableHandleCancel)
         SyncRepNotifyComplete();
     }
 
+    if (waitStopRes == SYNC_COMPLETE) {
+        SyncRepReportWaitTime(mode, waitStart);
+    }
+
     (void)pgstat_report_waitstatus(oldStatus);
 
     /*
@@ -478,6 +486,62 @@ SyncWaitRet SyncRepWaitForLSN(XLogRecPtr XactCommitLSN, bool enableHandleCancel)
     return waitStopRes;
 }
 
+/*
+ * Account the time a commit spent waiting for its standby acknowledgement.
+ * Waits that were cancelled or gave up are not counted.
+ */
+static void SyncRepReportWaitTime(int mode, instr_time waitStart)
+{
+    instr_time waitTime;
+    uint64 us;
+    int bucket;
+
+    INSTR_TIME_SET_CURRENT(waitTime);
+    INSTR_TIME_SUBTRACT(waitTime, waitStart);
+    us = INSTR_TIME_GET_MICROSEC(waitTime);
+
+    /* bucket i holds waits in [2^i, 2^(i+1)) us, the first one also holds 0 */
+    bucket = (us < 2) ? 0 : pg_leftmost_one_pos32((uint32)Min(us, (uint64)PG_UINT32_MAX));
+    bucket = Min(bucket, SYNC_REP_WAIT_HIST_BUCKETS - 1);
+    (void)pg_atomic_fetch_add_u64(&t_thrd.walsender_cxt.WalSndCtl->syncRepWaitHist[mode][bucket], 1);
+}
+
+/*
+ * gs_syncrep_wait_histogram
+ *		Per wait mode histogram of the time commits spent waiting for the
+ *		synchronous standbys.  Only non-empty buckets are returned;
+ *		wait_time_us is the exclusive upper bound of the bucket, NULL for
+ *		the last, open-ended one.
+ */
+Datum gs_syncrep_wait_histogram(PG_FUNCTION_ARGS)
+{
+    static const char *modeNames[NUM_SYNC_REP_WAIT_MODE] = {"receive", "write", "flush", "apply"};
+    TupleDesc tupdesc;
+    Tuplestorestate *tupstore = BuildTupleResult(fcinfo, &tupdesc);
+    const uint32 syncrep_wait_hist_cols = 3;
+    Datum values[syncrep_wait_hist_cols];
+    bool nulls[syncrep_wait_hist_cols];
+    WalSndCtlData *walsndctl = t_thrd.walsender_cxt.WalSndCtl;
+
+    for (int i = 0; walsndctl != NULL && i < NUM_SYNC_REP_WAIT_MODE; i++) {
+        for (int j = 0; j < SYNC_REP_WAIT_HIST_BUCKETS; j++) {
+            uint64 count = pg_atomic_read_u64(&walsndctl->syncRepWaitHist[i][j]);
+            if (count == 0) {
+                continue;
+            }
+            values[0] = CStringGetTextDatum(modeNames[i]);
+            nulls[0] = false;
+            values[1] = Int64GetDatum(INT64CONST(1) << (j + 1));
+            nulls[1] = (j == SYNC_REP_WAIT_HIST_BUCKETS - 1);
+            values[2] = Int64GetDatum((int64)count);
+            nulls[2] = false;
+            tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+        }
+    }
+    tuplestore_donestoring(tupstore);
+    return (Datum)0;
+}
+
 /*
  * Insert t_thrd.proc into the specified SyncRepQueue, maintaining sorted invariant.
  *
@@ -630,6 +694,22 @@ void SyncRepReleaseWaiters(void)
         return;
     }
 
+    /*
+     * Every synced position is either the minimum over the sync standbys or,
+     * for quorum, the Nth largest one.  While none of our positions is ahead
+     * of what has already been released, nothing we report can move those
+     * past the released LSNs, so skip SyncRepLock altogether.  This is the
+     * common case for every reply but the first one after new WAL arrives.
+     * The LSNs only ever advance, so reading them unlocked is safe here.
+     */
+    if (!t_thrd.syncrep_cxt.announce_next_takeover &&
+        XLByteLE(t_thrd.walsender_cxt.MyWalSnd->receive, walsndctl->lsn[SYNC_REP_WAIT_RECEIVE]) &&
+        XLByteLE(t_thrd.walsender_cxt.MyWalSnd->write, walsndctl->lsn[SYNC_REP_WAIT_WRITE]) &&
+        XLByteLE(t_thrd.walsender_cxt.MyWalSnd->flush, walsndctl->lsn[SYNC_REP_WAIT_FLUSH]) &&
+        XLByteLE(t_thrd.walsender_cxt.MyWalSnd->apply, walsndctl->lsn[SYNC_REP_WAIT_APPLY])) {
+        return;
+    }
+
     /*
      * We're a potential sync standby. Release waiters if we are the highest
      * priority standby. If there are multiple standbys with same priorities
@@ -690,7 +770,7 @@ void SyncRepReleaseWaiters(void)
     }
     if (XLByteLT(walsndctl->lsn[SYNC_REP_WAIT_APPLY], replayPtr)) {
         walsndctl->lsn[SYNC_REP_WAIT_APPLY] = replayPtr;
-        numflush = SyncRepWakeQueue(false, SYNC_REP_WAIT_APPLY);
+        numapply = SyncRepWakeQueue(false, SYNC_REP_WAIT_APPLY);
     }
 
     LWLockRelease(SyncRepLock);
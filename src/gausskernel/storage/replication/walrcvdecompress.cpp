@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ *  walrcvdecompress.cpp
+ *      Decompress shipped WAL on helper threads of the walreceiver.
+ *
+ * When enable_wal_shipping_compression is on, every 'C' message carries one
+ * LZ4 block. With wal_receiver_decompress_workers > 0 the walreceiver copies
+ * each block into a slot of a ring pool (see ringpool.cpp) and goes back to
+ * the socket, while the pool threads decompress the slots in parallel.
+ * Finished slots are handed to the receive buffer strictly in ring order, so
+ * the WAL stream the writer sees is identical to the serial path.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/replication/walrcvdecompress.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "lz4.h"
+#include "portability/instr_time.h"
+#include "replication/ringpool.h"
+#include "replication/walreceiver.h"
+#include "utils/atomic.h"
+#include "utils/memutils.h"
+
+/* slots per worker, so every worker has the next block ready when it finishes one */
+#define WALRCV_DECOMPRESS_SLOTS_PER_WORKER 4
+
+typedef struct WalRcvDecompressSlot {
+    XLogRecPtr dataStart;
+    char *compressed;
+    int compressedLen;
+    int compressedCap;
+    char *decompressed;
+    int expectedLen;  /* what the sender says the block expands to */
+    int decompressCap;
+    int result;       /* LZ4_decompress_safe() return value */
+} WalRcvDecompressSlot;
+
+/* Runs on a pool thread, pool->priv is the decompress stage statistics. */
+static bool WalRcvDecompressWork(const RingPool *pool, void *arg, void *workerState)
+{
+    WalRcvDecompressSlot *slot = (WalRcvDecompressSlot *)arg;
+    WalRcvStageStat *stat = (WalRcvStageStat *)pool->priv;
+    instr_time start;
+    instr_time duration;
+
+    INSTR_TIME_SET_CURRENT(start);
+    int result = LZ4_decompress_safe(slot->compressed, slot->decompressed, slot->compressedLen, slot->expectedLen);
+    INSTR_TIME_SET_CURRENT(duration);
+    INSTR_TIME_SUBTRACT(duration, start);
+
+    (void)pg_atomic_fetch_add_u64(&stat->batches, 1);
+    (void)pg_atomic_fetch_add_u64(&stat->bytesIn, (uint64)slot->compressedLen);
+    (void)pg_atomic_fetch_add_u64(&stat->bytesOut, (uint64)Max(result, 0));
+    (void)pg_atomic_fetch_add_u64(&stat->busyTime, INSTR_TIME_GET_MICROSEC(duration));
+
+    slot->result = result;
+    /* the block must expand to exactly the range the sender announced */
+    return result == slot->expectedLen;
+}
+
+static bool WalRcvDecompressInterrupt(void)
+{
+    ProcessWalRcvInterrupts();
+    return false;
+}
+
+static RingPool *WalRcvDecompressPoolStart(int nworkers)
+{
+    RingPool *pool = RingPoolStart("WalRcvDecompressPool", nworkers, WALRCV_DECOMPRESS_SLOTS_PER_WORKER,
+                                   sizeof(WalRcvDecompressSlot), 0, WalRcvDecompressWork, NULL,
+                                   WalRcvDecompressInterrupt);
+    WalRcvStageStat *stat = &t_thrd.walreceiverfuncs_cxt.WalRcv->stageStats[WALRCV_STAGE_DECOMPRESS];
+    pool->priv = stat;
+    pg_atomic_write_u32(&stat->workers, (uint32)pool->nstarted);
+
+    ereport(LOG, (errmsg("walreceiver started %d WAL decompression threads", pool->nstarted)));
+    t_thrd.walreceiver_cxt.decompressPool = pool;
+    return pool;
+}
+
+/* Grow a slot buffer owned by the pool; contents need not be kept. */
+static void WalRcvDecompressReserve(RingPool *pool, char **buf, int *cap, int need)
+{
+    if (*cap >= need) {
+        return;
+    }
+    if (*buf != NULL) {
+        pfree(*buf);
+    }
+    *buf = (char *)MemoryContextAlloc(pool->context, (Size)need);
+    *cap = need;
+}
+
+/*
+ * Hand finished slots to the receive buffer in ring order. Slots before
+ * waitUpTo are waited for; after that, stop at the first unfinished one.
+ */
+static void WalRcvDecompressEmit(RingPool *pool, uint64 waitUpTo)
+{
+    while (pool->head != pool->tail) {
+        WalRcvDecompressSlot *slot = (WalRcvDecompressSlot *)RingPoolSlot(pool, pool->head);
+        RingSlotState state = (pool->head < waitUpTo) ? RingPoolWaitSlot(pool, pool->head) :
+                                                         RingPoolPeekSlot(pool, pool->head);
+        if (state == RING_SLOT_PENDING) {
+            return;
+        }
+
+        if (state == RING_SLOT_FAILED) {
+            ereport(ERROR, (errmsg("[DecompressFailed] startPtr %X/%X, compressedSize: %d, decompressSize: %d, "
+                                   "expected: %d",
+                                   (uint32)(slot->dataStart >> 32), (uint32)slot->dataStart, slot->compressedLen,
+                                   slot->result, slot->expectedLen)));
+        }
+
+        XLogWalRcvReceiveDeferred(slot->decompressed, (Size)slot->expectedLen, slot->dataStart);
+        RingPoolRelease(pool);
+    }
+}
+
+/*
+ * Queue one compressed block covering [dataStart, dataEnd) for the helper
+ * threads. Returns false if the block has to be decompressed inline: no
+ * workers configured or running, or the sender did not announce a usable
+ * range. The caller must then drain the pool first to keep WAL in order.
+ */
+bool WalRcvDecompressSubmit(const char *buf, Size len, XLogRecPtr dataStart, XLogRecPtr dataEnd)
+{
+    int nworkers = u_sess->attr.attr_storage.wal_receiver_decompress_workers;
+    RingPool *pool = t_thrd.walreceiver_cxt.decompressPool;
+    const uint64 maxBlockSize = (uint64)g_instance.attr.attr_storage.WalReceiverBufSize * 1024;
+
+    if (nworkers <= 0 || XLByteLE(dataEnd, dataStart) || dataEnd - dataStart > maxBlockSize ||
+        len > (Size)INT_MAX) {
+        return false;
+    }
+    if (pool == NULL) {
+        pool = WalRcvDecompressPoolStart(nworkers);
+    }
+    if (pool->nstarted == 0) {
+        return false;
+    }
+
+    /* ring full: the oldest block has to go out before we can reuse its slot */
+    if (pool->tail - pool->head == pool->nslots) {
+        WalRcvDecompressEmit(pool, pool->head + 1);
+    }
+
+    WalRcvDecompressSlot *slot = (WalRcvDecompressSlot *)RingPoolSlot(pool, pool->tail);
+    WalRcvDecompressReserve(pool, &slot->compressed, &slot->compressedCap, (int)len);
+    WalRcvDecompressReserve(pool, &slot->decompressed, &slot->decompressCap, (int)(dataEnd - dataStart));
+    errno_t rc = memcpy_s(slot->compressed, slot->compressedCap, buf, len);
+    securec_check(rc, "\0", "\0");
+    slot->compressedLen = (int)len;
+    slot->expectedLen = (int)(dataEnd - dataStart);
+    slot->dataStart = dataStart;
+    slot->result = 0;
+
+    RingPoolSubmit(pool, pool->tail + 1);
+
+    /* pass on whatever is already finished */
+    WalRcvDecompressEmit(pool, pool->head);
+    return true;
+}
+
+/* Wait for every queued block and hand all of them to the receive buffer. */
+void WalRcvDecompressDrain(void)
+{
+    RingPool *pool = t_thrd.walreceiver_cxt.decompressPool;
+    if (pool != NULL) {
+        WalRcvDecompressEmit(pool, pool->tail);
+    }
+}
+
+/*
+ * Stop the helper threads and release the pool. Blocks still queued are
+ * dropped; they are received again from the last receive position.
+ */
+void WalRcvDecompressPoolStop(void)
+{
+    RingPool *pool = t_thrd.walreceiver_cxt.decompressPool;
+    if (pool == NULL) {
+        return;
+    }
+    t_thrd.walreceiver_cxt.decompressPool = NULL;
+
+    WalRcvStageStat *stat = (WalRcvStageStat *)pool->priv;
+    RingPoolStop(pool);
+    pg_atomic_write_u32(&stat->workers, 0);
+}
+
+/* After a reload: restart the pool with the new size on the next block. */
+void WalRcvDecompressReloadConfig(void)
+{
+    RingPool *pool = t_thrd.walreceiver_cxt.decompressPool;
+    if (pool != NULL && pool->nworkers != u_sess->attr.attr_storage.wal_receiver_decompress_workers) {
+        WalRcvDecompressDrain();
+        WalRcvDecompressPoolStop();
+    }
+}
@@ -19,6 +19,7 @@
 #include "catalog/pg_tablespace.h"
 #include "libpq/pqsignal.h"
 #include "miscadmin.h"
+#include "portability/instr_time.h"
 #include "replication/walreceiver.h"
 #include "replication/dataqueue.h"
 #include "replication/datareceiver.h"
@@ -565,6 +566,8 @@ int walRcvWrite(WalRcvCtlBlock *walrcb)
     XLogRecPtr startptr;
     int64 recBufferSize = g_instance.attr.attr_storage.WalReceiverBufSize * 1024;
     int nbytes = 0;
+    instr_time writeStart;
+    instr_time writeTime;
 
     if (walrcb == NULL)
         return 0;
@@ -589,7 +592,11 @@ int walRcvWrite(WalRcvCtlBlock *walrcb)
 
     nbytes = (walfreeoffset < walwriteoffset) ? (recBufferSize - walwriteoffset) : (walfreeoffset - walwriteoffset);
 
+    INSTR_TIME_SET_CURRENT(writeStart);
     XLogWalRcvWrite(walrcb, walrecvbuf + walwriteoffset, nbytes, startptr);
+    INSTR_TIME_SET_CURRENT(writeTime);
+    INSTR_TIME_SUBTRACT(writeTime, writeStart);
+    WalRcvStageStatAdd(WALRCV_STAGE_WRITE, 1, (uint64)nbytes, (uint64)nbytes, INSTR_TIME_GET_MICROSEC(writeTime));
     XLByteAdvance(startptr, nbytes);
     ereport(DEBUG5,
             (errmsg("walRcvWrite: write len:%d, at %u,%X", nbytes, (uint32)(startptr >> 32), (uint32)startptr)));
@@ -649,6 +656,7 @@ static void ShutdownWalRcvWriter(int code, Datum arg)
 {
     /* clear WriterPid */
     emptyWalRcvWriterLatch();
+    pg_atomic_write_u32(&t_thrd.walreceiverfuncs_cxt.WalRcv->stageStats[WALRCV_STAGE_WRITE].workers, 0);
 }
 
 /* SIGUSR1: let latch facility handle the signal */
@@ -693,6 +701,7 @@ void walrcvWriterMain(void)
     (void)sigdelset(&t_thrd.libpq_cxt.BlockSig, SIGQUIT);
 
     on_shmem_exit(ShutdownWalRcvWriter, 0);
+    pg_atomic_write_u32(&t_thrd.walreceiverfuncs_cxt.WalRcv->stageStats[WALRCV_STAGE_WRITE].workers, 1);
 
     /*
      * Create a resource owner to keep track of our resources (currently only
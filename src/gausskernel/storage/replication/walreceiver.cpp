@@ -52,6 +52,7 @@
 #include "libpq/libpq-fe.h"
 #include "libpq/pqsignal.h"
 #include "miscadmin.h"
+#include "portability/instr_time.h"
 #include "replication/replicainternal.h"
 #include "replication/dataqueue.h"
 #include "replication/walprotocol.h"
@@ -85,6 +86,7 @@
 bool wal_catchup = false;
 
 #define NAPTIME_PER_CYCLE 1 /* max sleep time between cycles (1ms) */
+#define WALRCV_WAKEUP_FRACTION 4 /* wake the writer early once this part of the buffer is filled */
 
 #define WAL_DATA_LEN ((sizeof(uint32) + 1 + sizeof(XLogRecPtr)))
 
@@ -175,6 +177,8 @@ static void DisableWalRcvImmediateExit(void);
 static void WalRcvDie(int code, Datum arg);
 static void XLogWalRcvDataPageReplication(char *buf, Size len);
 static void XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len);
+static void XLogWalRcvReceiveInternal(char *buf, Size nbytes, XLogRecPtr recptr, bool deferWakeup);
+static void XLogWalRcvFlushReceived(void);
 static void XLogWalRcvSendHSFeedback(void);
 static void XLogWalRcvSendSwitchRequest(void);
 static void WalDataRcvReceive(char *buf, Size nbytes, XLogRecPtr recptr);
@@ -366,6 +370,7 @@ void WalRcvrProcessData(TimestampTz *last_recv_timestamp, bool *ping_sent)
     if (t_thrd.walreceiver_cxt.got_SIGHUP) {
         t_thrd.walreceiver_cxt.got_SIGHUP = false;
         ProcessConfigFile(PGC_SIGHUP);
+        WalRcvDecompressReloadConfig();
     }
 
     ArchiveTaskStatus *archive_task = walreceiver_find_archive_task_status(PITR_TASK_DONE);
@@ -410,6 +415,7 @@ void WalRcvrProcessData(TimestampTz *last_recv_timestamp, bool *ping_sent)
             *ping_sent = false;
             XLogWalRcvProcessMsg(type, buf, len);
         }
+        XLogWalRcvFlushReceived();
 
         /* Let the master know that we received some data. */
         if(walrcv->conn_target != REPCONNTARGET_OBS)
@@ -569,6 +575,7 @@ void WalReceiverMain(void)
     }
     /* Arrange to clean up at walreceiver exit */
     on_shmem_exit(WalRcvDie, 0);
+    pg_atomic_write_u32(&t_thrd.walreceiverfuncs_cxt.WalRcv->stageStats[WALRCV_STAGE_RECEIVE].workers, 1);
 
     /* Reset some signals that are accepted by postmaster but not here */
     (void)gspqsignal(SIGHUP, WalRcvSigHupHandler); /* set flag to read config file */
@@ -837,6 +844,7 @@ static void rcvAllXlog()
         XLogWalRcvProcessMsg(type, buf, len);
         t_thrd.walreceiver_cxt.hasReceiveNewData = true;
     }
+    XLogWalRcvFlushReceived();
 
     const uint32 shiftSize = 32;
     ereport(LOG, (errmsg("rcvAllXlog dorado position:%x/%x, flush position: %x/%x",
@@ -872,6 +880,10 @@ static void WalRcvDie(int code, Datum arg)
             pg_atomic_write_u32(&t_thrd.walreceiverfuncs_cxt.WalRcv->rcvDoneFromShareStorage, true);
         }
     }
+    /* Blocks still being decompressed are received again after restart */
+    WalRcvDecompressPoolStop();
+    pg_atomic_write_u32(&t_thrd.walreceiverfuncs_cxt.WalRcv->stageStats[WALRCV_STAGE_RECEIVE].workers, 0);
+
     /*
      * Shutdown WalRcvWriter thread, clear the data receive buffer.
      * Ensure that all WAL records received are flushed to disk.
@@ -1037,9 +1049,21 @@ static void XLogWalRcvDataPageReplication(char *buf, Size len)
 static void XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len)
 {
     errno_t errorno = EOK;
+    bool isWalData = (type == 'w' || type == 'C');
+    Size wireLen = len;
+    instr_time start;
+    instr_time duration;
 
     ereport(DEBUG5, (errmsg("received wal message type: %c", type)));
 
+    /* WAL still in the decompression pipeline goes first; keepalives need not wait */
+    if (type != 'C' && type != 'k') {
+        WalRcvDecompressDrain();
+    }
+    if (isWalData) {
+        INSTR_TIME_SET_CURRENT(start);
+    }
+
     switch (type) {
         case 'e': /* dummy standby sendxlog end. */
         {
@@ -1055,15 +1079,20 @@ static void XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len)
         {
             WalDataMessageHeader msghdr;
             XLogWalRecordsPreProcess(&buf, &len, &msghdr);
-            XLogWalRcvReceive(buf, len, msghdr.dataStart);
+            XLogWalRcvReceiveDeferred(buf, len, msghdr.dataStart);
             break;
         }
         case 'C': /* Compressed WAL records */
         {
             WalDataMessageHeader msghdr;
             XLogWalRecordsPreProcess(&buf, &len, &msghdr);
+            if (WalRcvDecompressSubmit(buf, len, msghdr.dataStart, msghdr.sender_sent_location)) {
+                break;
+            }
+            /* decompress inline, after everything queued before it */
+            WalRcvDecompressDrain();
             Size decompressedSize = (Size)XLogDecompression(buf, len, msghdr.dataStart);
-            XLogWalRcvReceive(t_thrd.libwalreceiver_cxt.decompressBuf, decompressedSize, msghdr.dataStart);
+            XLogWalRcvReceiveDeferred(t_thrd.libwalreceiver_cxt.decompressBuf, decompressedSize, msghdr.dataStart);
             break;
         }
         case 'd': /* Data page replication for the logical xlog */
@@ -1160,6 +1189,12 @@ static void XLogWalRcvProcessMsg(unsigned char type, char *buf, Size len)
             ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
                             errmsg_internal("invalid replication message type %c", type)));
     }
+
+    if (isWalData) {
+        INSTR_TIME_SET_CURRENT(duration);
+        INSTR_TIME_SUBTRACT(duration, start);
+        WalRcvStageStatAdd(WALRCV_STAGE_RECEIVE, 1, wireLen, 0, INSTR_TIME_GET_MICROSEC(duration));
+    }
 }
 
 void XLogWalRecordsPreProcess(char **buf, Size *len, WalDataMessageHeader *msghdr)
@@ -1182,11 +1217,18 @@ int XLogDecompression(const char *buf, Size len, XLogRecPtr dataStart)
 {
     char *decompressBuff = t_thrd.libwalreceiver_cxt.decompressBuf;
     const int maxBlockSize = g_instance.attr.attr_storage.WalReceiverBufSize * 1024;
+    instr_time start;
+    instr_time duration;
     if (decompressBuff == NULL) {
         t_thrd.libwalreceiver_cxt.decompressBuf = (char *)palloc0(maxBlockSize);
         decompressBuff = t_thrd.libwalreceiver_cxt.decompressBuf;
     }
+    INSTR_TIME_SET_CURRENT(start);
     int decompressedSize = LZ4_decompress_safe(buf, decompressBuff, len, maxBlockSize);
+    INSTR_TIME_SET_CURRENT(duration);
+    INSTR_TIME_SUBTRACT(duration, start);
+    WalRcvStageStatAdd(WALRCV_STAGE_DECOMPRESS, 1, len, (uint64)Max(decompressedSize, 0),
+                       INSTR_TIME_GET_MICROSEC(duration));
     if (decompressedSize <= 0) {
         ereport(ERROR, (errmsg("[DecompressFailed] startPtr %X/%X, compressedSize: %ld, decompressSize: %d",
                                (uint32)(dataStart >> 32), (uint32)dataStart, len, decompressedSize)));
@@ -1197,6 +1239,25 @@ int XLogDecompression(const char *buf, Size len, XLogRecPtr dataStart)
     return decompressedSize;
 }
 
+/* Account work done by one stage of the WAL receive pipeline. */
+void WalRcvStageStatAdd(WalRcvStage stage, uint64 batches, uint64 bytesIn, uint64 bytesOut, uint64 busyTime)
+{
+    WalRcvStageStat *stat = &t_thrd.walreceiverfuncs_cxt.WalRcv->stageStats[stage];
+
+    if (batches > 0) {
+        (void)pg_atomic_fetch_add_u64(&stat->batches, batches);
+    }
+    if (bytesIn > 0) {
+        (void)pg_atomic_fetch_add_u64(&stat->bytesIn, bytesIn);
+    }
+    if (bytesOut > 0) {
+        (void)pg_atomic_fetch_add_u64(&stat->bytesOut, bytesOut);
+    }
+    if (busyTime > 0) {
+        (void)pg_atomic_fetch_add_u64(&stat->busyTime, busyTime);
+    }
+}
+
 void WSDataRcvCheck(char *data_buf, Size nbytes)
 {
     errno_t errorno = EOK;
@@ -1361,15 +1422,41 @@ static void ProcessReplyFlags(void)
 }
 
 /*
- * Receive XLOG data into receiver buffer.
+ * Receive XLOG data into receiver buffer, and wake the writer.
  */
 void XLogWalRcvReceive(char *buf, Size nbytes, XLogRecPtr recptr)
+{
+    XLogWalRcvReceiveInternal(buf, nbytes, recptr, false);
+}
+
+/*
+ * Like XLogWalRcvReceive, but leave waking the writer to the end of the
+ * current burst of messages (XLogWalRcvFlushReceived) unless a good amount
+ * of WAL has piled up, so that the writer handles larger chunks per write.
+ */
+void XLogWalRcvReceiveDeferred(char *buf, Size nbytes, XLogRecPtr recptr)
+{
+    XLogWalRcvReceiveInternal(buf, nbytes, recptr, true);
+}
+
+/* End of a burst of messages: hand everything received so far to the writer. */
+static void XLogWalRcvFlushReceived(void)
+{
+    WalRcvDecompressDrain();
+    if (t_thrd.walreceiver_cxt.writerPendingBytes > 0) {
+        t_thrd.walreceiver_cxt.writerPendingBytes = 0;
+        wakeupWalRcvWriter();
+    }
+}
+
+static void XLogWalRcvReceiveInternal(char *buf, Size nbytes, XLogRecPtr recptr, bool deferWakeup)
 {
     int walfreeoffset;
     int walwriteoffset;
     char *walrecvbuf = NULL;
     XLogRecPtr startptr;
     int recBufferSize = g_instance.attr.attr_storage.WalReceiverBufSize * 1024;
+    Size totalBytes = nbytes;
 
     while (nbytes > 0) {
         int segbytes;
@@ -1478,7 +1565,12 @@ void XLogWalRcvReceive(char *buf, Size nbytes, XLogRecPtr recptr)
         SpinLockRelease(&t_thrd.walreceiver_cxt.walRcvCtlBlock->mutex);
     }
 
-    wakeupWalRcvWriter();
+    WalRcvStageStatAdd(WALRCV_STAGE_RECEIVE, 0, 0, totalBytes, 0);
+    t_thrd.walreceiver_cxt.writerPendingBytes += totalBytes;
+    if (!deferWakeup || t_thrd.walreceiver_cxt.writerPendingBytes >= (Size)(recBufferSize / WALRCV_WAKEUP_FRACTION)) {
+        t_thrd.walreceiver_cxt.writerPendingBytes = 0;
+        wakeupWalRcvWriter();
+    }
 }
 
 /*
@@ -2355,6 +2447,82 @@ Datum pg_stat_get_wal_receiver(PG_FUNCTION_ARGS)
     return (Datum)0;
 }
 
+/*
+ * Returns cumulative counters of the standby's WAL pipeline, one row per
+ * stage: receive (network messages), decompress and write.
+ */
+Datum gs_get_walrcv_pipeline_stat(PG_FUNCTION_ARGS)
+{
+#define GS_GET_WALRCV_PIPELINE_STAT_COLS 7
+    static const char *stageNames[WALRCV_STAGE_NUM] = {"receive", "decompress", "write"};
+    ReturnSetInfo *rsinfo = (ReturnSetInfo *)fcinfo->resultinfo;
+    TupleDesc tupdesc = NULL;
+    Tuplestorestate *tupstore = NULL;
+    MemoryContext per_query_ctx;
+    MemoryContext oldcontext;
+    WalRcvData *walrcv = t_thrd.walreceiverfuncs_cxt.WalRcv;
+    Datum values[GS_GET_WALRCV_PIPELINE_STAT_COLS];
+    bool nulls[GS_GET_WALRCV_PIPELINE_STAT_COLS];
+    errno_t rc = EOK;
+
+    /* check to see if caller supports us returning a tuplestore */
+    if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo)) {
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("set-valued function called in context that cannot accept a set")));
+        return (Datum)0;
+    }
+    if (!(rsinfo->allowedModes & SFRM_Materialize))
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("materialize mode required, but it is not allowed in this context")));
+
+    /* Build a tuple descriptor for our result type */
+    if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+        ereport(ERROR, (errcode(ERRCODE_DATATYPE_MISMATCH), errmsg("return type must be a row type")));
+
+    per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+    oldcontext = MemoryContextSwitchTo(per_query_ctx);
+
+    tupstore = tuplestore_begin_heap(true, false, u_sess->attr.attr_memory.work_mem);
+    rsinfo->returnMode = SFRM_Materialize;
+    rsinfo->setResult = tupstore;
+    rsinfo->setDesc = tupdesc;
+
+    (void)MemoryContextSwitchTo(oldcontext);
+
+    for (int i = 0; i < WALRCV_STAGE_NUM; i++) {
+        WalRcvStageStat *stat = &walrcv->stageStats[i];
+        uint64 bytesOut = pg_atomic_read_u64(&stat->bytesOut);
+        uint64 busyTime = pg_atomic_read_u64(&stat->busyTime);
+
+        rc = memset_s(nulls, sizeof(nulls), 0, sizeof(nulls));
+        securec_check(rc, "\0", "\0");
+        /* stage */
+        values[0] = CStringGetTextDatum(stageNames[i]);
+        /* workers */
+        values[1] = Int32GetDatum((int32)pg_atomic_read_u32(&stat->workers));
+        /* batches */
+        values[2] = Int64GetDatum((int64)pg_atomic_read_u64(&stat->batches));
+        /* bytes_in */
+        values[3] = Int64GetDatum((int64)pg_atomic_read_u64(&stat->bytesIn));
+        /* bytes_out */
+        values[4] = Int64GetDatum((int64)bytesOut);
+        /* busy_time, in microseconds */
+        values[5] = Int64GetDatum((int64)busyTime);
+        /* throughput, bytes out per busy second */
+        if (busyTime == 0) {
+            nulls[6] = true;
+        } else {
+            values[6] = Int64GetDatum((int64)((double)bytesOut * USECS_PER_SEC / busyTime));
+        }
+        tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+    }
+
+    /* clean up and return the tuplestore */
+    tuplestore_donestoring(tupstore);
+
+    return (Datum)0;
+}
+
 /*
  * Returns activity of ha state, including static connections,local role,
  * database state and rebuild reason if database state is unnormal.
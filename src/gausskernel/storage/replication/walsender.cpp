@@ -5528,6 +5528,12 @@ void WalSndShmemInit(void)
         t_thrd.walsender_cxt.WalSndCtl->keep_sync_window_start = 0;
         t_thrd.walsender_cxt.WalSndCtl->out_keep_sync_window = false;
         t_thrd.walsender_cxt.WalSndCtl->demotion = NoDemote;
+        pg_atomic_init_u64(&t_thrd.walsender_cxt.WalSndCtl->elrCommitLSN, InvalidXLogRecPtr);
+        for (int i = 0; i < NUM_SYNC_REP_WAIT_MODE; i++) {
+            for (int j = 0; j < SYNC_REP_WAIT_HIST_BUCKETS; j++) {
+                pg_atomic_init_u64(&t_thrd.walsender_cxt.WalSndCtl->syncRepWaitHist[i][j], 0);
+            }
+        }
         SpinLockInit(&t_thrd.walsender_cxt.WalSndCtl->mutex);
     }
 }
@@ -34,6 +34,8 @@
 #include "nodes/pg_list.h"
 #include "storage/proc.h"
 #include "access/redo_statistic.h"
+#include "access/multi_redo_settings.h"
+#include "storage/buf/buf_internals.h"
 #include "access/extreme_rto/redo_item.h"
 #include "access/extreme_rto/page_redo.h"
 #include "access/extreme_rto/txn_redo.h"
@@ -131,6 +133,17 @@ typedef struct RecordBufferState {
     uint32 waitRedoDone;
 } RecordBufferState;
 
+/* Size of a relation fork as last seen by the redo prefetcher */
+typedef struct RedoPrefetchRelSize {
+    RelFileNode rnode;
+    ForkNumber forknum;
+    BlockNumber nblocks;
+    bool valid;
+    bool truncated; /* nblocks comes from a truncate record, do not refresh it from disk */
+} RedoPrefetchRelSize;
+
+#define REDO_PREFETCH_RELSIZE_SLOTS 256
+
 typedef struct {
     MemoryContext oldCtx;
     PageRedoPipeline *pageLines;
@@ -174,6 +187,14 @@ typedef struct {
     volatile bool recoveryStop;
     volatile XLogRedoNumStatics xlogStatics[RM_NEXT_ID][MAX_XLOG_INFO_NUM];
     RedoTimeCost *startupTimeCost;
+
+    /* redo prefetch, only touched by the dispatcher thread */
+    RedoPrefetchRelSize prefetchRelSizes[REDO_PREFETCH_RELSIZE_SLOTS];
+    XLogRecPtr prefetchLsns[MAX_RECOVERY_PREFETCH_DISTANCE]; /* end of the records that issued the prefetches */
+    uint32 prefetchHead;
+    uint32 prefetchCount;
+    BufferTag prefetchLastTag;
+    bool prefetchUsed; /* files may have been opened for prefetching */
 } LogDispatcher;
 
 typedef struct {
@@ -41,6 +41,8 @@
 namespace extreme_rto {
 
 static const uint32 PAGE_WORK_QUEUE_SIZE = 8192;
+/* items a page manager hands to one redo worker per queue operation */
+static const uint32 PAGE_WORK_QUEUE_BATCH_SIZE = 64;
 
 static const uint32 EXTREME_RTO_ALIGN_LEN = 16; /* need 128-bit aligned */
 static const uint32 MAX_REMOTE_READ_INFO_NUM = 100;
@@ -66,6 +68,11 @@ typedef struct BadBlockRecEnt{
     XLogRecParseState *tail;
 } BadBlockRecEnt;
 
+typedef struct RedoItemBatch {
+    uint32 count;
+    void *items[PAGE_WORK_QUEUE_BATCH_SIZE];
+} RedoItemBatch;
+
 struct PageRedoWorker {
     /*
      * The last successfully applied log record's end position + 1 as an
@@ -170,6 +177,7 @@ struct PageRedoWorker {
     MemoryContext oldCtx;
 
     HTAB *redoItemHash;
+    RedoItemBatch *distributeBatches; /* page manager only, one per redo worker */
     TimeLineID recoveryTargetTLI;
     bool ArchiveRecoveryRequested;
     bool StandbyModeRequested;
@@ -213,6 +221,7 @@ void WaitPageRedoWorkerReachLastMark(PageRedoWorker *worker);
 
 /* Redo processing. */
 void AddPageRedoItem(PageRedoWorker *worker, void *item);
+void AddPageRedoItems(PageRedoWorker *worker, void **items, uint32 count);
 
 void UpdatePageRedoWorkerStandbyState(PageRedoWorker *worker, HotStandbyState newState);
 
@@ -225,6 +234,7 @@ PageRedoWorker *CreateWorker(uint32 id);
 extern void UpdateRecordGlobals(RedoItem *item, HotStandbyState standbyState);
 void ReferenceRedoItem(void *item);
 void DereferenceRedoItem(void *item);
+void ReferenceRedoItemN(void *item, uint32 n);
 void PushToWorkerLsn(bool force);
 void GetCompletedReadEndPtr(PageRedoWorker *worker, XLogRecPtr *readPtr, XLogRecPtr *endPtr);
 void SetReadBufferForExtRto(XLogReaderState *state, XLogRecPtr pageptr, int reqLen);
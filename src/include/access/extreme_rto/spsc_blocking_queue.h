@@ -50,6 +50,7 @@ SPSCBlockingQueue *SPSCBlockingQueueCreate(uint32 capacity, CallBackFunc func =
 void SPSCBlockingQueueDestroy(SPSCBlockingQueue *queue);
 
 bool SPSCBlockingQueuePut(SPSCBlockingQueue *queue, void *element);
+bool SPSCBlockingQueuePutN(SPSCBlockingQueue *queue, void **elements, uint32 n);
 void *SPSCBlockingQueueTake(SPSCBlockingQueue *queue);
 bool SPSCBlockingQueueIsEmpty(SPSCBlockingQueue *queue);
 void *SPSCBlockingQueueTop(SPSCBlockingQueue *queue);
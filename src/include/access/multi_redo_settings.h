@@ -51,6 +51,8 @@ typedef struct {
 static const int MOST_FAST_RECOVERY_LIMIT = 20;
 static const int MAX_PARSE_WORKERS = 16;
 static const int MAX_REDO_WORKERS_PER_PARSE = 8;
+/* upper bound of recovery_prefetch_distance, in blocks */
+static const int MAX_RECOVERY_PREFETCH_DISTANCE = 4096;
 
 
 static const int TRXN_REDO_MANAGER_NUM = 1;
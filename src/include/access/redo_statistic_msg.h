@@ -27,7 +27,7 @@
 #include "access/multi_redo_settings.h"
 
 
-const static uint32 REDO_WORKER_INFO_BUFFER_SIZE = 64 * (1 + MOST_FAST_RECOVERY_LIMIT);
+const static uint32 REDO_WORKER_INFO_BUFFER_SIZE = 64 * (2 + MOST_FAST_RECOVERY_LIMIT);
 const static uint32 VIEW_NAME_SIZE = 32;
 const static uint32 REDO_VIEW_COL_SIZE = 23;
 
@@ -63,6 +63,8 @@ typedef struct RedoStatsData {
     RedoWaitInfo wait_info[WAIT_REDO_NUM];
     uint32 speed_according_seg;
     XLogRecPtr local_max_lsn;
+    uint64 prefetch_issued;
+    uint64 prefetch_hit;
     uint32 worker_info_len;
     char worker_info[REDO_WORKER_INFO_BUFFER_SIZE];
 } RedoStatsData;
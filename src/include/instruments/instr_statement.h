@@ -61,6 +61,9 @@ struct LockSummaryStat {
     /* the maximum lock count at a time. */
     int64   lock_max_cnt;
     int64   lock_hold_cnt;
+
+    /* weak relation locks that did not fit into the fast-path slots */
+    int64   fastpath_overflow_cnt;
 };
 
 #pragma pack (1)
@@ -207,6 +210,7 @@ extern bool check_standby_statement_chain_size(char** newval, void** extra, GucS
 extern void assign_standby_statement_chain_size(const char* newval, void* extra);
 extern void instr_stmt_report_lock(
     StmtDetailType type, int lockmode = -1, const LOCKTAG *locktag = NULL, uint16 lwlockId = 0);
+extern void instr_stmt_report_lock_fastpath_overflow();
 
 extern void instr_stmt_report_stat_at_handle_init();
 extern void instr_stmt_report_stat_at_handle_commit();
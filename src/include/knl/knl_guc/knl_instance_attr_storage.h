@@ -189,6 +189,7 @@ typedef struct knl_instance_attr_storage {
     knl_instance_attr_dms dms_attr;
     int num_internal_lock_partitions[LWLOCK_PART_KIND];
     char* num_internal_lock_partitions_str;
+    char* lwlock_numa_handoff_tranches;
     int wal_insert_status_entries_power;
     int undo_zone_count;
     int64 xlog_file_size;
@@ -85,6 +85,9 @@ typedef struct knl_session_attr_storage {
     bool hot_standby_feedback;
     bool enable_stream_replication;
     bool guc_most_available_sync;
+    bool enable_early_lock_release;
+    bool enable_hot_row_queue;
+    bool enable_logical_replication_streaming;
     bool enable_show_any_tuples;
     bool enable_debug_vacuum;
     bool enable_adio_debug;
@@ -96,12 +99,15 @@ typedef struct knl_session_attr_storage {
     bool enable_ustore_partial_seqscan;
     int keep_sync_window;
     int wait_dummy_time;
+    int catchup_parallel_relations;
     int DeadlockTimeout;
     int LockWaitTimeout;
     int LockWaitUpdateTimeout;
     int max_standby_archive_delay;
     int max_standby_streaming_delay;
+    int recovery_prefetch_distance;
     int wal_receiver_status_interval;
+    int wal_receiver_decompress_workers;
     int wal_receiver_timeout;
     int wal_receiver_connect_timeout;
     int wal_receiver_connect_retries;
@@ -259,6 +265,7 @@ typedef struct knl_session_attr_storage {
     knl_session_attr_dcf dcf_attr;
     int catchup2normal_wait_time;
     int max_sync_workers_per_subscription;
+    int max_parallel_apply_workers_per_subscription;
 
     char* logical_decode_options_default_str;
     void* logical_decode_options_default;
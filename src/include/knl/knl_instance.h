@@ -83,6 +83,7 @@ const int MAX_AUDIT_NUM = 48;
 
 /* Maximum number of max parallel decode threads */
 #define MAX_PARALLEL_DECODE_NUM 20
+#define MAX_PARALLEL_READ_NUM 8
 
 /* Maximum number of max replication slots */
 #define MAX_REPLICATION_SLOT_NUM 100
@@ -293,6 +294,8 @@ typedef struct knl_g_stat_context {
     volatile uint32 snapshot_thread_counter;
     /* Record the sum of file io stat */
     struct FileIOStat* fileIOStat;
+    /* LWLock wait histograms and wakeup policy per tranche, see lwlock.cpp */
+    struct LWLockTrancheStat* lwlockTrancheStats;
 
     /* Active session history */
     MemoryContext AshContext;
@@ -670,6 +673,9 @@ typedef struct {
     uint32 speed_according_seg;
     XLogRecPtr local_max_lsn;
     uint64    oldest_segment;
+    /* extreme RTO redo prefetch, only written by the dispatcher */
+    volatile uint64 prefetch_issued; /* blocks not in shared buffers, read-ahead requested */
+    volatile uint64 prefetch_hit;    /* blocks already in shared buffers */
 } RedoPerf;
 
 
@@ -358,6 +358,13 @@ typedef struct knl_t_xact_context {
      * Some commands want to force synchronous commit.
      */
     bool forceSyncCommit;
+
+    /*
+     * Commit LSN whose WAL flush and synchronous replication wait were
+     * postponed until after lock release (enable_early_lock_release).
+     */
+    XLogRecPtr elrWaitLSN;
+
     /*
      * Private context for transaction-abort work --- we reserve space for this
      * at startup to ensure that AbortTransaction and AbortSubTransaction can work
@@ -2021,6 +2028,17 @@ typedef struct knl_t_poolcleaner_context {
 
 typedef struct knl_t_catchup_context {
     volatile sig_atomic_t catchup_shutdown_requested;
+
+    /* relations whose pages are queued but not yet known to be on the standby */
+    List* pending_rels;
+
+    /* progress of the running catchup, see BCMReportCatchupProgress */
+    int64 files_total;
+    int64 files_done;
+    int64 blocks_sent;
+    int64 bytes_sent;
+    TimestampTz start_time;
+    TimestampTz last_report_time;
 } knl_t_catchup_context;
 
 /*
@@ -2154,6 +2172,13 @@ typedef struct knl_t_basebackup_context {
     char g_xlog_location[MAXPGPATH];
 
     char* buf_block;
+
+    /* changed blocks since the reference backup, NULL for a full backup */
+    struct HTAB* changedBlocks;
+    /* tablespace whose version directory is being sent, InvalidOid for the data directory */
+    Oid sendingTablespace;
+    /* number of read-ahead windows kept in flight, 0 disables read-ahead */
+    int readAheadStreams;
 } knl_t_basebackup_context;
 
 typedef struct knl_t_datarcvwriter_context {
@@ -2313,6 +2338,8 @@ typedef struct knl_t_walreceiver_context {
     bool checkConsistencyOK;
     bool hasReceiveNewData;
     bool termChanged;
+    Size writerPendingBytes; /* WAL handed to the writer since it was last woken */
+    struct RingPool* decompressPool;
 } knl_t_walreceiver_context;
 
 typedef struct knl_t_walsender_context {
@@ -2512,6 +2539,7 @@ typedef struct knl_t_logical_read_worker_context {
     MemoryContext ReadWorkerCxt;
     ParallelDecodeWorker** parallelDecodeWorkers;
     int totalWorkerCount;
+    struct RingPool* readAheadPool;
 } knl_t_logical_read_worker_context;
 
 typedef struct knl_t_dataqueue_context {
@@ -2694,6 +2722,8 @@ typedef struct knl_t_storage_context {
      * real value, since only we can acquire locks on our own behalf.
      */
     int FastPathLocalUseCount;
+    /* Same as FastPathLocalUseCount, broken down per fast-path slot group. */
+    uint16* FastPathLocalUseCounts;
     volatile struct FastPathStrongRelationLockData* FastPathStrongRelationLocks;
     /*
      * Pointers to hash tables containing lock state
@@ -3318,6 +3348,21 @@ typedef struct knl_t_apply_worker_context {
     List *tableStates;
     XLogRecPtr remoteFinalLsn;
     CommitSeqNo curRemoteCsn;
+
+    /* Parallel apply, see parallel_apply.cpp */
+    struct ParallelApplyGroup *paGroup;
+    struct ParallelApplyTxn *paCurTxn; /* leader: being buffered, worker: being applied */
+    MemoryContext paTxnContext;        /* leader: shared context of the buffered transactions */
+    List *paDispatched;                /* leader: handed to workers, in commit order */
+    HTAB *paKeyTab;                    /* leader: replica identity key hash -> last writer */
+    HTAB *paRelMsgTab;                 /* leader: last RELATION message per remote relation */
+    uint64 paLastSeq;                  /* leader: last commit order assigned */
+    XLogRecPtr paLastProgress;         /* leader: last remote end fed to lsnMapping */
+
+    /* Streamed in-progress transactions, spooled until their commit */
+    bool streamingRequested;           /* asked the publisher to stream them */
+    HTAB *streamTxns;                  /* remote toplevel xid -> spool file */
+    struct ApplyStreamTxn *streamTxn;  /* spool of the open stream block, if any */
 } knl_t_apply_worker_context;
 
 typedef struct knl_t_publication_context {
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * incrbackup.h
+ *        On-the-wire layout of relation segments sent by an incremental base backup.
+ *
+ * A BASE_BACKUP with the INCREMENTAL option sends each relation segment that
+ * was not created, dropped or truncated since the reference backup, and whose
+ * database and tablespace were not created or dropped either, as a tar
+ * member named "<segment>.incr" instead of the segment itself.  The member
+ * holds an IncrBackupFileHeader, followed by nblocks segment-relative block
+ * numbers in ascending order, followed by the nblocks pages in that order.  The receiver rebuilds the segment from
+ * the reference backup: keep its first truncateBlock pages (zero filling any
+ * past the end of the reference copy), then overwrite the listed pages.  A
+ * segment missing from the reference is an error, unless the relation has
+ * grown into it since.
+ *
+ * IDENTIFICATION
+ *        src/include/replication/incrbackup.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef INCRBACKUP_H
+#define INCRBACKUP_H
+
+#define INCR_BACKUP_MAGIC 0x494E4352 /* "INCR" */
+#define INCR_BACKUP_SUFFIX ".incr"
+
+/* upper bound of the PREFETCH_DEPTH option of BASE_BACKUP */
+#define MAX_BACKUP_PREFETCH_DEPTH 64
+
+typedef struct IncrBackupFileHeader {
+    uint32 magic;
+    uint32 nblocks;          /* number of pages that follow */
+    uint32 truncateBlock;    /* length of the segment in pages */
+} IncrBackupFileHeader;
+
+#define IncrBackupFileSize(nblocks) \
+    (sizeof(IncrBackupFileHeader) + (size_t)(nblocks) * (sizeof(uint32) + BLCKSZ))
+
+#endif /* INCRBACKUP_H */
@@ -71,6 +71,13 @@ typedef struct LogicalDecodingContext {
      */
     bool fast_forward;
 
+    /*
+     * Does the output plugin stream large in-progress transactions instead
+     * of spilling them to disk? Set when the plugin provides the streaming
+     * callbacks, the plugin may clear it in its startup callback.
+     */
+    bool streaming;
+
     OutputPluginCallbacks callbacks;
     OutputPluginOptions options;
 
@@ -134,6 +141,9 @@ typedef struct {
     ParallelDecodeChangeCB decode_change;
     List *tableWhiteList;
     int parallel_queue_size;
+    int parallel_read_num; /* threads reading WAL ahead of the reader, 0 to read serially */
+    bool streaming; /* stream large in-progress transactions instead of spilling them */
+    bool binary_send; /* with decode style 'b', ship column values in their type's binary send format */
 } ParallelDecodeOption;
 
 typedef struct {
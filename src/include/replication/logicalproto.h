@@ -22,6 +22,7 @@
  *
  * LOGICALREP_PROTO_VERSION_NUM is our native protocol.
  * LOGICALREP_CONNINFO_PROTO_VERSION_NUM is the version that need to handle changed conninfo.
+ * LOGICALREP_STREAM_PROTO_VERSION_NUM is the version that can stream large in-progress transactions.
  * LOGICALREP_PROTO_MAX_VERSION_NUM is the greatest version we can support + 1.
  * LOGICALREP_PROTO_MIN_VERSION_NUM is the oldest version we
  * have backwards compatibility for - 1. The client requests protocol version at
@@ -31,6 +32,7 @@ typedef enum {
     LOGICALREP_PROTO_MIN_VERSION_NUM = 0,
     LOGICALREP_PROTO_VERSION_NUM,
     LOGICALREP_CONNINFO_PROTO_VERSION_NUM,
+    LOGICALREP_STREAM_PROTO_VERSION_NUM,
     LOGICALREP_PROTO_MAX_VERSION_NUM
 } LOGICALREP_VERSION_NUM;
 
@@ -95,12 +97,15 @@ extern void logicalrep_read_begin(StringInfo in, LogicalRepBeginData *begin_data
 extern void logicalrep_write_commit(StringInfo out, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
 extern void logicalrep_read_commit(StringInfo in, LogicalRepCommitData *commit_data);
 extern void logicalrep_write_origin(StringInfo out, const char *origin, XLogRecPtr origin_lsn);
-extern void logicalrep_write_insert(StringInfo out, Relation rel, HeapTuple newtuple, bool binary);
+extern void logicalrep_write_insert(StringInfo out, Relation rel, HeapTuple newtuple, bool binary,
+    TransactionId xid = InvalidTransactionId);
 extern LogicalRepRelId logicalrep_read_insert(StringInfo in, LogicalRepTupleData *newtup);
-extern void logicalrep_write_update(StringInfo out, Relation rel, HeapTuple oldtuple, HeapTuple newtuple, bool binary);
+extern void logicalrep_write_update(StringInfo out, Relation rel, HeapTuple oldtuple, HeapTuple newtuple, bool binary,
+    TransactionId xid = InvalidTransactionId);
 extern LogicalRepRelId logicalrep_read_update(StringInfo in, bool *has_oldtuple, LogicalRepTupleData *oldtup,
     LogicalRepTupleData *newtup);
-extern void logicalrep_write_delete(StringInfo out, Relation rel, HeapTuple oldtuple, bool binary);
+extern void logicalrep_write_delete(StringInfo out, Relation rel, HeapTuple oldtuple, bool binary,
+    TransactionId xid = InvalidTransactionId);
 extern LogicalRepRelId logicalrep_read_delete(StringInfo in, LogicalRepTupleData *oldtup);
 extern void logicalrep_write_rel(StringInfo out, Relation rel);
 extern LogicalRepRelation *logicalrep_read_rel(StringInfo in);
@@ -108,5 +113,12 @@ extern void logicalrep_write_typ(StringInfo out, Oid typoid);
 extern void logicalrep_read_typ(StringInfo out, LogicalRepTyp *ltyp);
 extern void logicalrep_write_conninfo(StringInfo out, char* conninfo);
 extern void logicalrep_read_conninfo(StringInfo in, char** conninfo);
+extern void logicalrep_write_stream_start(StringInfo out, TransactionId xid, bool first_segment);
+extern TransactionId logicalrep_read_stream_start(StringInfo in, bool *first_segment);
+extern void logicalrep_write_stream_stop(StringInfo out);
+extern void logicalrep_write_stream_commit(StringInfo out, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
+extern TransactionId logicalrep_read_stream_commit(StringInfo in, LogicalRepCommitData *commit_data);
+extern void logicalrep_write_stream_abort(StringInfo out, TransactionId xid, TransactionId subxid);
+extern void logicalrep_read_stream_abort(StringInfo in, TransactionId *xid, TransactionId *subxid);
 
 #endif /* LOGICALREP_PROTO_H */
@@ -37,6 +37,7 @@ typedef struct LogicalRepRelMapEntry
 } LogicalRepRelMapEntry;
 
 extern void logicalrep_relmap_update(LogicalRepRelation *remoterel);
+extern LogicalRepRelation *logicalrep_remoterel_find(LogicalRepRelId remoteid);
 extern LogicalRepRelMapEntry *logicalrep_rel_open(LogicalRepRelId remoteid, LOCKMODE lockmode);
 extern void logicalrep_rel_close(LogicalRepRelMapEntry *rel, LOCKMODE lockmode);
 
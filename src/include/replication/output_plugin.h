@@ -78,6 +78,28 @@ typedef void (*LogicalDecodeAbortCB)(struct LogicalDecodingContext* ctx, Reorder
  */
 typedef void (*LogicalDecodePrepareCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
 
+/*
+ * Called before a chunk of changes of an in-progress transaction is streamed.
+ */
+typedef void (*LogicalDecodeStreamStartCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+
+/*
+ * Called after a chunk of changes of an in-progress transaction was streamed.
+ */
+typedef void (*LogicalDecodeStreamStopCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+
+/*
+ * Called for the COMMIT of a transaction whose changes have been streamed.
+ */
+typedef void (*LogicalDecodeStreamCommitCB)(
+    struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
+
+/*
+ * Called when a streamed (sub)transaction aborts, txn may be a subtransaction.
+ */
+typedef void (*LogicalDecodeStreamAbortCB)(
+    struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr abort_lsn);
+
 /*
  * Called to shutdown an output plugin.
  */
@@ -100,6 +122,11 @@ typedef struct OutputPluginCallbacks {
     LogicalDecodePrepareCB prepare_cb;
     LogicalDecodeShutdownCB shutdown_cb;
     LogicalDecodeFilterByOriginCB filter_by_origin_cb;
+    /* streaming of in-progress transactions, optional */
+    LogicalDecodeStreamStartCB stream_start_cb;
+    LogicalDecodeStreamStopCB stream_stop_cb;
+    LogicalDecodeStreamCommitCB stream_commit_cb;
+    LogicalDecodeStreamAbortCB stream_abort_cb;
 } OutputPluginCallbacks;
 
 typedef struct ParallelOutputPluginCallbacks {
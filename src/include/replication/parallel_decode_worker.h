@@ -56,6 +56,8 @@ extern void LogicalReadRecordMain(ParallelDecodeReaderWorker *worker);
 extern int logical_read_xlog_page(XLogReaderState *state, XLogRecPtr targetPagePtr, int reqLen, XLogRecPtr targetRecPtr,
                                   char *cur_page, TimeLineID *pageTLI, char* xlog_path);
 extern bool IsLogicalWorkerShutdownRequested();
+extern bool LogicalReadAheadPage(int nworkers, XLogRecPtr pagePtr, char *page);
+extern void LogicalReadAheadPoolStop(void);
 extern void ReleaseParallelDecodeResource(int slotId);
 
 #endif
@@ -227,6 +227,9 @@ typedef struct ParallelReorderBufferTXN {
      */
     bool serialized;
 
+    /* Have changes of this transaction already been sent in stream blocks? */
+    bool streamed;
+
     /*
      * How many ReorderBufferChange's do we have in this txn.
      *
@@ -25,6 +25,8 @@ typedef struct PGOutputData {
     List *publication_names;
     List *publications;
     bool binary;
+    bool streaming;    /* client asked for in-progress transactions */
+    bool in_streaming; /* inside a stream start/stop block */
 } PGOutputData;
 
 #endif /* PGOUTPUT_H */
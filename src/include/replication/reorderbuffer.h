@@ -246,6 +246,18 @@ typedef struct ReorderBufferTXN {
      */
     bool serialized;
 
+    /*
+     * Have some of the changes of this (toplevel) transaction already been
+     * streamed to the output plugin while it was still in progress?
+     */
+    bool streamed;
+
+    /*
+     * Snapshot the last streamed chunk ended with, so that the next chunk
+     * (or the final commit) continues decoding from where it stopped.
+     */
+    Snapshot stream_snapshot;
+
     /*
      * List of ReorderBufferChange structs, including new Snapshots and new
      * CommandIds
@@ -315,6 +327,17 @@ typedef void (*ReorderBufferAbortCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
 /* prepare callback signature */
 typedef void (*ReorderBufferPrepareCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
 
+/* start streaming a chunk of an in-progress transaction */
+typedef void (*ReorderBufferStreamStartCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
+
+/* stop streaming a chunk of an in-progress transaction */
+typedef void (*ReorderBufferStreamStopCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
+
+/* commit of a transaction whose changes have been (partially) streamed */
+typedef void (*ReorderBufferStreamCommitCB)(ReorderBuffer* rb, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
+
+/* abort of a streamed (sub)transaction */
+typedef void (*ReorderBufferStreamAbortCB)(ReorderBuffer* rb, ReorderBufferTXN* txn, XLogRecPtr abort_lsn);
 
 struct ReorderBuffer {
     /*
@@ -353,6 +376,15 @@ struct ReorderBuffer {
     ReorderBufferAbortCB abort;
     ReorderBufferPrepareCB prepare;
 
+    /*
+     * Callbacks used to stream in-progress transactions, NULL if the output
+     * plugin does not support streaming.
+     */
+    ReorderBufferStreamStartCB stream_start;
+    ReorderBufferStreamStopCB stream_stop;
+    ReorderBufferStreamCommitCB stream_commit;
+    ReorderBufferStreamAbortCB stream_abort;
+
     /*
      * Pointer that will be passed untouched to the callbacks.
      */
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ringpool.h
+ *        In-order ring of work slots processed by a group of helper threads.
+ *
+ *
+ * IDENTIFICATION
+ *        src/include/replication/ringpool.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef _RINGPOOL_H
+#define _RINGPOOL_H
+
+#include <pthread.h>
+
+typedef enum {
+    RING_SLOT_FREE,
+    RING_SLOT_PENDING,
+    RING_SLOT_DONE,
+    RING_SLOT_FAILED
+} RingSlotState;
+
+struct RingPool;
+
+/*
+ * Runs on a helper thread: processes one slot and returns true on success.
+ * workerState is private to the thread, zeroed when the pool starts.
+ */
+typedef bool (*RingPoolWorkFunc)(const struct RingPool *pool, void *slot, void *workerState);
+
+/* Runs on a helper thread before it exits, releases what its workerState holds. */
+typedef void (*RingPoolWorkerExitFunc)(void *workerState);
+
+/*
+ * Runs on the owner thread while it waits for a slot. May not return;
+ * returning true gives up the wait.
+ */
+typedef bool (*RingPoolInterruptFunc)(void);
+
+typedef struct RingPool {
+    pthread_mutex_t mutex;
+    pthread_cond_t workCond; /* slots became pending, or shutdown */
+    pthread_cond_t doneCond; /* a slot finished */
+    bool shutdown;
+
+    int nworkers;            /* threads asked for at start */
+    int nstarted;
+    pthread_t *workers;
+
+    /*
+     * Ring positions, all increasing: head <= claim <= tail. Slots in
+     * [head, tail) are in flight; [claim, tail) wait for a worker. head and
+     * tail are advanced by the owner only, claim under the mutex.
+     */
+    uint32 nslots;
+    uint64 head;
+    uint64 claim;
+    uint64 tail;
+    RingSlotState *states;   /* protected by the mutex */
+    char *slots;             /* nslots caller-defined slots of slotSize bytes */
+    Size slotSize;
+    char *workerStates;      /* nworkers areas of workerStateSize bytes */
+    Size workerStateSize;
+
+    RingPoolWorkFunc work;
+    RingPoolWorkerExitFunc workerExit;
+    RingPoolInterruptFunc interrupt;
+    void *priv;              /* caller data, set before the first slot is submitted */
+    MemoryContext context;   /* owns the pool, and whatever the caller allocates for its slots */
+} RingPool;
+
+/* Slot at ring position pos, owned by the owner thread unless it is pending. */
+static inline void *RingPoolSlot(const RingPool *pool, uint64 pos)
+{
+    return pool->slots + (pos % pool->nslots) * pool->slotSize;
+}
+
+extern RingPool *RingPoolStart(const char *name, int nworkers, uint32 slotsPerWorker, Size slotSize,
+                               Size workerStateSize, RingPoolWorkFunc work, RingPoolWorkerExitFunc workerExit,
+                               RingPoolInterruptFunc interrupt);
+extern void RingPoolSubmit(RingPool *pool, uint64 newTail);
+extern RingSlotState RingPoolPeekSlot(RingPool *pool, uint64 pos);
+extern RingSlotState RingPoolWaitSlot(RingPool *pool, uint64 pos);
+extern void RingPoolRelease(RingPool *pool);
+extern bool RingPoolDiscard(RingPool *pool);
+extern void RingPoolStop(RingPool *pool);
+
+#endif /* _RINGPOOL_H */
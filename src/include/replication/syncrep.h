@@ -92,6 +92,11 @@ extern void SyncPaxosReleaseWaiters(XLogRecPtr PaxosConsensusLSN);
 /* called by wal writer */
 extern void SyncRepUpdateSyncStandbysDefined(void);
 
+/* number of log2 buckets in the sync rep wait time histogram */
+#define SYNC_REP_WAIT_HIST_BUCKETS 20
+
+extern Datum gs_syncrep_wait_histogram(PG_FUNCTION_ARGS);
+
 /* called by wal sender, check if any synchronous standby is alive */
 extern void SyncRepCheckSyncStandbyAlive(void);
 
@@ -40,6 +40,7 @@
 #define STREAMING_START_PERCENT 90
 #define IS_PAUSE_BY_TARGET_BARRIER 0x00000001
 #define IS_CANCEL_LOG_CTRL 0x00000010
+#define MAX_WALRCV_DECOMPRESS_WORKERS 16
 
 #ifdef ENABLE_MULTIPLE_NODES
 #define AM_HADR_CN_WAL_RECEIVER (t_thrd.postmaster_cxt.HaShmData->is_cross_region && \
@@ -115,6 +116,26 @@ typedef enum {
     REPCONNTARGET_PUBLICATION
 } ReplConnTarget;
 
+/*
+ * Stages WAL goes through on the standby: receive from the network,
+ * decompress (only for compressed shipping), write to disk.
+ */
+typedef enum {
+    WALRCV_STAGE_RECEIVE,
+    WALRCV_STAGE_DECOMPRESS,
+    WALRCV_STAGE_WRITE,
+    WALRCV_STAGE_NUM
+} WalRcvStage;
+
+/* Cumulative per-stage counters, reported by gs_get_walrcv_pipeline_stat() */
+typedef struct WalRcvStageStat {
+    pg_atomic_uint64 batches;  /* messages, compressed blocks or write calls */
+    pg_atomic_uint64 bytesIn;
+    pg_atomic_uint64 bytesOut;
+    pg_atomic_uint64 busyTime; /* microseconds spent working, summed over workers */
+    pg_atomic_uint32 workers;
+} WalRcvStageStat;
+
 /* Shared memory area for management of walreceiver process */
 typedef struct WalRcvData {
     /*
@@ -232,6 +253,7 @@ typedef struct WalRcvData {
     struct ArchiveSlotConfig *archive_slot;
     uint32 rcvDoneFromShareStorage;
     uint32 shareStorageTerm;
+    WalRcvStageStat stageStats[WALRCV_STAGE_NUM];
 } WalRcvData;
 
 typedef struct WalReceiverFunc {
@@ -325,6 +347,15 @@ extern bool HasBuildReason();
 extern void GetMinLsnRecordsFromHadrCascadeStandby(void);
 extern void XLogWalRecordsPreProcess(char **buf, Size *len, WalDataMessageHeader *msghdr);
 extern int XLogDecompression(const char *buf, Size len, XLogRecPtr dataStart);
+extern void XLogWalRcvReceiveDeferred(char *buf, Size nbytes, XLogRecPtr recptr);
+extern void WalRcvStageStatAdd(WalRcvStage stage, uint64 batches, uint64 bytesIn, uint64 bytesOut, uint64 busyTime);
+extern Datum gs_get_walrcv_pipeline_stat(PG_FUNCTION_ARGS);
+
+/* prototypes for functions in walrcvdecompress.cpp */
+extern bool WalRcvDecompressSubmit(const char *buf, Size len, XLogRecPtr dataStart, XLogRecPtr dataEnd);
+extern void WalRcvDecompressDrain(void);
+extern void WalRcvDecompressPoolStop(void);
+extern void WalRcvDecompressReloadConfig(void);
 void GetPasswordForHadrStreamingReplication(char user[], char password[]);
 extern char* remove_ipv6_zone(char* addr_src, char* addr_dest, int len);
 
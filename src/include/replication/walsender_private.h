@@ -215,6 +215,16 @@ typedef struct WalSndCtlData {
      */
     DemoteMode demotion;
 
+    /*
+     * Newest commit record whose locks were released before it was flushed
+     * and replicated.  Transactions that did not write WAL wait for it at
+     * commit, since they may have seen its effects.
+     */
+    pg_atomic_uint64 elrCommitLSN;
+
+    /* Time commits spent waiting for sync standbys, see SyncRepReportWaitTime */
+    pg_atomic_uint64 syncRepWaitHist[NUM_SYNC_REP_WAIT_MODE][SYNC_REP_WAIT_HIST_BUCKETS];
+
     /* Protects shared variables of all walsnds. */
     slock_t mutex;
 
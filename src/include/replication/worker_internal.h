@@ -13,8 +13,12 @@
 #define WORKER_INTERNAL_H
 
 #include "catalog/pg_subscription.h"
+#include "lib/stringinfo.h"
+#include "replication/origin.h"
 #include "storage/lock/lock.h"
 
+struct ParallelApplyGroup;
+
 typedef struct LogicalRepWorker
 {
     /* Increased everytime the slot is tabken by new worker */
@@ -40,6 +44,10 @@ typedef struct LogicalRepWorker
 
     TimestampTz workerLaunchTime;
 
+    /* Used for parallel apply workers, paIndex is 1-based. NULL/0 otherwise. */
+    struct ParallelApplyGroup *paGroup;
+    int paIndex;
+
     /* Stats. */
     XLogRecPtr last_lsn;
     TimestampTz last_send_time;
@@ -48,6 +56,78 @@ typedef struct LogicalRepWorker
     TimestampTz reply_time;
 } LogicalRepWorker;
 
+/* Number of transactions that can be queued to one parallel apply worker */
+#define PARALLEL_APPLY_QUEUE_SIZE 64
+
+/*
+ * A committed remote transaction buffered by the leader apply worker and
+ * handed to a parallel apply worker. Allocated in the group's txnContext.
+ */
+typedef struct ParallelApplyTxn {
+    uint64 seq;               /* commit order assigned by the leader, from 1 */
+    XLogRecPtr endLsn;        /* remote end of the commit record */
+    TimestampTz commitTime;   /* remote commit timestamp */
+    int nmsgs;
+    int maxmsgs;
+    StringInfoData *msgs;     /* protocol messages, BEGIN to COMMIT */
+    int nkeys;
+    int maxkeys;
+    uint32 *keys;             /* hashes of the replica identity keys touched */
+    int nrelids;
+    int maxrelids;
+    uint32 *relids;           /* remote ids of the relations touched */
+    int nrelmsgs;
+    StringInfoData *relmsgs;  /* RELATION messages the worker has not seen yet */
+    bool serial;              /* must be applied by the leader itself */
+} ParallelApplyTxn;
+
+typedef struct ParallelApplyWorkerShared {
+    /* Slot of the worker, NULL until it attached or after it exited. */
+    LogicalRepWorker *worker;
+
+    /* Transaction ring, head is consumed by the worker, tail filled by the leader. */
+    slock_t mutex;
+    uint32 head;
+    uint32 tail;
+    ParallelApplyTxn *queue[PARALLEL_APPLY_QUEUE_SIZE];
+
+    /* Sequence of the transaction being applied, 0 if idle. */
+    volatile uint64 applyingSeq;
+
+    /* Stats. */
+    pg_atomic_uint64 assignedXacts;
+    pg_atomic_uint64 appliedXacts;
+    pg_atomic_uint64 conflictWaits;
+    pg_atomic_uint64 conflictWaitTime; /* microseconds */
+    volatile XLogRecPtr lastCommitLsn;
+    volatile int64 applyLag;           /* milliseconds, remote commit to local commit */
+} ParallelApplyWorkerShared;
+
+/*
+ * State shared by a leader apply worker and its parallel apply workers.
+ * Lives in a shared memory context created by the leader.
+ */
+typedef struct ParallelApplyGroup {
+    Oid subid;
+    ThreadId leaderPid;
+    LogicalRepWorker *leader;
+    RepOriginId originId;
+    MemoryContext txnContext;
+
+    /* Set by the leader to ask the workers to exit, or by a worker that failed. */
+    volatile bool shutdown;
+    volatile bool failed;
+
+    /* Transactions committed locally so far, in seq order. */
+    pg_atomic_uint64 committedSeq;
+    slock_t mutex;
+    XLogRecPtr committedRemoteEnd;
+    XLogRecPtr committedLocalEnd;
+
+    int nworkers;
+    ParallelApplyWorkerShared workers[FLEXIBLE_ARRAY_MEMBER];
+} ParallelApplyGroup;
+
 typedef struct ApplyLauncherShmStruct {
     LogicalRepWorker *startingWorker;
     ThreadId applyLauncherPid;
@@ -59,7 +139,8 @@ typedef struct ApplyLauncherShmStruct {
 extern void logicalrep_worker_attach();
 extern LogicalRepWorker *logicalrep_worker_find(Oid subid, Oid relid, bool only_running);
 extern List *logicalrep_workers_find(Oid subid, bool only_running);
-extern void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid);
+extern void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid,
+    ParallelApplyGroup *paGroup = NULL, int paIndex = 0);
 extern void logicalrep_worker_stop(Oid subid, Oid relid);
 extern void logicalrep_worker_wakeup(Oid subid, Oid relid);
 extern void logicalrep_worker_wakeup_ptr(LogicalRepWorker *worker);
@@ -73,6 +154,23 @@ extern char *LogicalRepSyncTableStart(XLogRecPtr *origin_startpos);
 void process_syncing_tables(XLogRecPtr current_lsn);
 void invalidate_syncing_table_states(Datum arg, int cacheid, uint32 hashvalue);
 
+extern void ParallelApplyStartWorkers(RepOriginId originid);
+extern List *ParallelApplyStopWorkers(void);
+extern void ParallelApplyReleaseTxns(List *txns);
+extern void ParallelApplyRememberRelation(StringInfo s);
+extern void ParallelApplyBufferMessage(StringInfo s);
+extern ParallelApplyTxn *ParallelApplyDispatchTxn(void);
+extern bool ParallelApplyWaitForAll(void);
+extern void ParallelApplyFreeTxn(ParallelApplyTxn *txn);
+extern bool ParallelApplyFailed(void);
+extern bool ParallelApplyHasPendingTxns(void);
+extern bool ParallelApplyGetProgress(XLogRecPtr *remote_end, XLogRecPtr *local_end);
+extern void ParallelApplyWorkerInit(void);
+extern ParallelApplyTxn *ParallelApplyNextTxn(void);
+extern void ParallelApplyWaitCommitTurn(void);
+extern void ParallelApplyFinishTxn(XLogRecPtr local_end);
+
 #define AM_TABLESYNC_WORKER (OidIsValid(t_thrd.applyworker_cxt.curWorker->relid))
+#define AM_PARALLEL_APPLY_WORKER (t_thrd.applyworker_cxt.curWorker->paIndex > 0)
 
 #endif /* WORKER_INTERNAL_H */
@@ -263,6 +263,7 @@ void shared_buffer_write_error_callback(void *arg);
  * prototypes for functions in bufmgr.c
  */
 extern void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum);
+extern bool PrefetchSharedBuffer(struct SMgrRelationData* smgr, ForkNumber forkNum, BlockNumber blockNum);
 extern void PageRangePrefetch(
     Relation reln, ForkNumber forkNum, BlockNumber blockNum, int32 n, uint32 flags, uint32 col);
 extern void PageListPrefetch(
@@ -303,6 +304,7 @@ extern void CheckPointBuffers(int flags, bool doFullCheckpoint);
 extern BlockNumber BufferGetBlockNumber(Buffer buffer);
 extern BlockNumber RelationGetNumberOfBlocksInFork(Relation relation, ForkNumber forkNum, bool estimate = false);
 extern void FlushRelationBuffers(Relation rel, HTAB *hashtbl = NULL);
+extern void FlushRelFileNodeAllBuffersUsingHash(HTAB *relfilenode_hashtbl);
 extern void FlushDatabaseBuffers(Oid dbid);
 
 extern void DropRelFileNodeBuffers(const RelFileNodeBackend& rnode, ForkNumber forkNum, BlockNumber firstDelBlock);
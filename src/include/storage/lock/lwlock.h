@@ -294,6 +294,25 @@ typedef enum LWLockMode {
                         * to be used as LWLockAcquire argument */
 } LWLockMode;
 
+/*
+ * Per-tranche wait statistics and wakeup policy, kept in shared memory and
+ * indexed by the built-in tranche ID.  waitHist[i] counts the acquisitions
+ * that had to sleep for less than 2^(i+1) microseconds in total; the last
+ * bucket also takes everything longer.
+ */
+#define LWLOCK_WAIT_HIST_BUCKETS 20
+
+/*
+ * Maximum number of consecutive handoffs to waiters on the releaser's NUMA
+ * node before the head of the wait queue is served again.
+ */
+#define LWLOCK_NUMA_HANDOFF_LIMIT 64
+
+typedef struct LWLockTrancheStat {
+    bool numaHandoff; /* prefer exclusive waiters on the releaser's NUMA node */
+    pg_atomic_uint64 waitHist[LWLOCK_WAIT_HIST_BUCKETS];
+} LWLockTrancheStat;
+
 /* To avoid pointer misuse during hash search, we wrapper the LWLock* in the following structure. */
 struct LWLock;
 typedef struct {
@@ -309,6 +328,7 @@ struct PGPROC;
 
 typedef struct LWLock {
     uint16      tranche;            /* tranche ID */
+    uint16      numaHandoffs;       /* consecutive same-NUMA-node handoffs, see LWLockWakeup */
     pg_atomic_uint32 state; /* state of exlusive/nonexclusive lockers */
     dlist_head waiters;     /* list of waiting PGPROCs */
 #ifdef LOCK_DEBUG
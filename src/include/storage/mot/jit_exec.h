@@ -47,6 +47,15 @@ extern bool JitInitialize();
 /** @brief Destroys the JIT module for MOT. */
 extern void JitDestroy();
 
+/**
+ * @brief Compiles the queries recorded by previous runs for the database of the current session, once per database
+ * in the process lifetime. Called when the session opens the database, so no query waits for the warm-up.
+ */
+extern void WarmupJitDatabase();
+
+/** @brief Writes the queries jitted since the last call to the warm-up file. Called on checkpoint and shutdown. */
+extern void FlushJitWarmup();
+
 /** @brief Queries whether MOT JIT compilation and execution is enabled. */
 extern bool IsMotCodegenEnabled();
 
@@ -99,9 +108,12 @@ extern MotJitContext* JitCodegenQuery(Query* query, const char* queryString, Jit
  * and @ref JitCodegenQuery.
  * @param query The parsed SQL query for which jitted code is to be generated.
  * @param queryString The query text.
+ * @param paramTypes The query parameter types, recorded for compiling the query again after restart.
+ * @param paramCount The number of query parameters.
  * @return The context of the jitted code required for later execution.
  */
-extern MotJitContext* TryJitCodegenQuery(Query* query, const char* queryString);
+extern MotJitContext* TryJitCodegenQuery(
+    Query* query, const char* queryString, const Oid* paramTypes = nullptr, int paramCount = 0);
 
 /**
  * @brief Generate jitted code for a stored procedure.
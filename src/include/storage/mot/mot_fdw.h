@@ -83,6 +83,15 @@ extern void MOTCheckpointFetchUnlock();
 extern bool MOTCheckpointExists(
     char* ctrlFilePath, size_t ctrlLen, char* checkpointDir, size_t checkpointLen, size_t& basePathLen);
 
+/**
+ * @brief Returns the path of an older checkpoint which the current delta checkpoint depends on.
+ * @param index the index of the requested checkpoint.
+ * @param checkpointDir a buffer to hold the checkpoint path.
+ * @param checkpointLen the length of the given checkpoint path buffer.
+ * @return True if the checkpoint path was returned, False indicates there are no more such checkpoints.
+ */
+extern bool MOTCheckpointChainDir(uint32_t index, char* checkpointDir, size_t checkpointLen);
+
 /**
  * The following helpers APIs are used for validating MOT GUC parameters.
  */
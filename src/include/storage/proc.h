@@ -74,8 +74,19 @@ struct XidCache {
  * RowShareLock, RowExclusiveLock) to be recorded in the PGPROC structure
  * rather than the main lock table.  This eases contention on the lock
  * manager LWLocks.  See storage/lmgr/README for additional details.
+ *
+ * The fast-path slots are split into groups of FP_LOCK_SLOTS_PER_GROUP, and
+ * each relation is mapped to exactly one group by FAST_PATH_REL_GROUP, so a
+ * lookup only has to scan one group instead of the whole array.  The number
+ * of groups follows FASTPATH_PART, rounded up to a whole group.
  */
-#define FP_LOCK_SLOTS_PER_BACKEND ((uint32)g_instance.attr.attr_storage.num_internal_lock_partitions[FASTPATH_PART])
+#define FP_LOCK_SLOTS_PER_GROUP 16
+#define FP_LOCK_GROUPS_PER_BACKEND                                                              \
+    (((uint32)g_instance.attr.attr_storage.num_internal_lock_partitions[FASTPATH_PART] +        \
+      FP_LOCK_SLOTS_PER_GROUP - 1) / FP_LOCK_SLOTS_PER_GROUP)
+#define FP_LOCK_SLOTS_PER_BACKEND (FP_LOCK_GROUPS_PER_BACKEND * FP_LOCK_SLOTS_PER_GROUP)
+#define FAST_PATH_SLOT(group, index) \
+    (AssertMacro((uint32)(index) < FP_LOCK_SLOTS_PER_GROUP), (uint32)(group) * FP_LOCK_SLOTS_PER_GROUP + (index))
 #define FP_LOCK_SLOTS_PER_LOCKBIT 20
 #define FP_LOCKBIT_NUM (((FP_LOCK_SLOTS_PER_BACKEND - 1) / FP_LOCK_SLOTS_PER_LOCKBIT) + 1)
 #define FAST_PATH_SET_LOCKBITS_ZERO(proc)                       \
@@ -96,6 +107,10 @@ typedef struct FastPathTag {
 #define FAST_PATH_TAG_EQUALS(tag1, tag2) \
     (((tag1).dbid == (tag2).dbid) && ((tag1).relid == (tag2).relid) && ((tag1).partitionid == (tag2).partitionid))
 
+/* Map a fast-path tag to its slot group; partitions of one table spread over groups. */
+#define FAST_PATH_REL_GROUP(tag) \
+    ((uint32)(((uint64)(tag).relid * 49157 + (uint64)(tag).partitionid * 98317) % FP_LOCK_GROUPS_PER_BACKEND))
+
 /*
  * An invalid pgprocno.  Must be larger than the maximum number of PGPROC
  * structures we could possibly have.  See comments for MAX_BACKENDS.
@@ -32,6 +32,7 @@ extern Size SInvalShmemSize(void);
 extern void CreateSharedInvalidationState(void);
 extern void CleanupWorkSessionInvalidation(void);
 extern void SharedInvalBackendInit(bool sendOnly, bool worksession);
+extern void SharedInvalSetDatabase(Oid dbId);
 extern PGPROC* BackendIdGetProc(int backendID);
 
 extern void SIInsertDataEntries(const SharedInvalidationMessage* data, int n);
@@ -1753,6 +1753,9 @@ extern Datum mot_session_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_jit_detail(PG_FUNCTION_ARGS);
 extern Datum mot_jit_profile(PG_FUNCTION_ARGS);
 
+/* LWLock */
+extern Datum gs_lwlock_wait_histogram(PG_FUNCTION_ARGS);
+
 /* UBtree index */
 Datum gs_index_verify(PG_FUNCTION_ARGS);
 Datum gs_index_recycle_queue(PG_FUNCTION_ARGS);
@@ -1818,6 +1821,7 @@ extern Datum pg_get_publication_tables(PG_FUNCTION_ARGS);
 
 /* launcher.cpp */
 extern Datum pg_stat_get_subscription(PG_FUNCTION_ARGS);
+extern Datum gs_get_parallel_apply_status(PG_FUNCTION_ARGS);
 
 /* sqlpatch.cpp */
 extern Datum create_sql_patch_by_id_hint(PG_FUNCTION_ARGS);
@@ -0,0 +1,40 @@
+abs_bindir=$1
+abs_srcdir=$2
+abs_port=$3
+refNode=$4
+incrNode=$5
+database=gs_basebackup_incr
+
+# reference backup, never started so that its pages match its start point
+$abs_bindir/gs_basebackup -D $abs_bindir/../$refNode -p $abs_port > $abs_bindir/../$incrNode.log 2>&1
+
+# update, extend and shrink the table, add a new one
+$abs_bindir/gsql -d$database -p$abs_port -f "$abs_srcdir/sql/gs_basebackup/init/incremental_change.sql" >> $abs_bindir/../$incrNode.log 2>&1
+
+# a database created from its template is copied without page WAL, all its files must be sent whole
+$abs_bindir/gsql -dpostgres -p$abs_port -c "create database ${database}_new;" >> $abs_bindir/../$incrNode.log 2>&1
+$abs_bindir/gsql -d${database}_new -p$abs_port -c "create table incremental_newdb_test as select generate_series(1, 100) a; checkpoint;" >> $abs_bindir/../$incrNode.log 2>&1
+
+# incremental backup merged into a copy of the reference
+$abs_bindir/gs_basebackup -D $abs_bindir/../$incrNode -p $abs_port --incremental=$abs_bindir/../$refNode --prefetch-depth=4 >> $abs_bindir/../$incrNode.log 2>&1
+
+# every .incr member must have been merged
+echo "unmerged files: `find $abs_bindir/../$incrNode -name '*.incr' | wc -l`"
+
+for gs_basebackup_port in {40000..60000};
+do 
+    if [ 'x'`netstat -an | grep -v STREAM | grep -v DGRAM | grep $gs_basebackup_port | head -n1 | awk '{print $1}'` == 'x' ]; 
+    then  
+        break; 
+    fi; 
+done; 
+
+$abs_bindir/gs_ctl start -o "-p ${gs_basebackup_port} -c listen_addresses=*" -D $abs_bindir/../$incrNode >> $abs_bindir/../$incrNode.log 2>&1
+sleep 10s
+
+#validate
+$abs_bindir/gsql -d$database -p$gs_basebackup_port -f "$abs_srcdir/sql/gs_basebackup/validate/incremental.sql";
+$abs_bindir/gsql -d${database}_new -p$gs_basebackup_port -c "select count(*), sum(a) from incremental_newdb_test";
+
+#stop node
+$abs_bindir/gsql -d$database -p$gs_basebackup_port -c 'SHUTDOWN IMMEDIATE'
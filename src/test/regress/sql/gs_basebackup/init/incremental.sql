@@ -0,0 +1,5 @@
+CREATE TABLE incremental_merge_test(a int, b text) WITH (fillfactor = 50);
+INSERT INTO incremental_merge_test SELECT i, repeat('x', 100) FROM generate_series(1, 10000) i;
+CREATE TABLE incremental_untouched_test(a int);
+INSERT INTO incremental_untouched_test SELECT generate_series(1, 1000);
+CHECKPOINT;
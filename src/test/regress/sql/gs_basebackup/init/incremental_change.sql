@@ -0,0 +1,5 @@
+UPDATE incremental_merge_test SET b = repeat('y', 100) WHERE a % 100 = 0;
+INSERT INTO incremental_merge_test SELECT i, repeat('z', 100) FROM generate_series(10001, 20000) i;
+DELETE FROM incremental_merge_test WHERE a BETWEEN 5001 AND 5100;
+CREATE TABLE incremental_new_test AS SELECT generate_series(1, 100) a;
+CHECKPOINT;
@@ -0,0 +1,5 @@
+SELECT count(*), sum(a) FROM incremental_merge_test;
+SELECT count(*) FROM incremental_merge_test WHERE b = repeat('y', 100);
+SELECT count(*) FROM incremental_merge_test WHERE b = repeat('z', 100);
+SELECT count(*), sum(a) FROM incremental_untouched_test;
+SELECT count(*) FROM incremental_new_test;
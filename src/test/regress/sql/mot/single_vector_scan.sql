@@ -0,0 +1,61 @@
+--
+-- Vectorized scan of MOT tables
+--
+CREATE FOREIGN TABLE vec_scan (id int PRIMARY KEY, i8 bigint, n numeric(10,2), v varchar(40), t text, d date);
+CREATE INDEX vec_scan_i8 ON vec_scan (i8);
+
+-- more rows than one batch, and a row of NULLs
+INSERT INTO vec_scan SELECT g, g * 10, g / 4.0, 'v' || g, repeat('t', g % 50 + 1), DATE '2020-01-01' + g
+    FROM generate_series(1, 3000) g;
+INSERT INTO vec_scan VALUES (3001, NULL, NULL, NULL, NULL, NULL);
+
+-- only the plan nodes, the MOT details depend on the chosen index
+CREATE FUNCTION vec_scan_plan(query text) RETURNS SETOF text AS $$
+DECLARE
+    ln text;
+BEGIN
+    FOR ln IN EXECUTE 'EXPLAIN (COSTS OFF) ' || query LOOP
+        ln := regexp_replace(ln, '^\s*(->\s*)?', '');
+        IF ln ~ '^(Row Adapter|LockRows|Update on|Delete on|Vector Foreign Scan on|Foreign Scan on)' THEN
+            RETURN NEXT ln;
+        END IF;
+    END LOOP;
+END;
+$$ LANGUAGE plpgsql;
+
+-- row path
+SET try_vector_engine_strategy = off;
+SELECT vec_scan_plan('SELECT id, n, v FROM vec_scan WHERE n > 100');
+SELECT id, i8, n, v, length(t), d - DATE '2020-01-01' AS days FROM vec_scan WHERE id > 2995 ORDER BY id;
+SELECT count(*), count(i8), count(n), count(v), count(t), count(d), sum(i8), sum(n), sum(length(t)), min(v),
+    max(d) - DATE '2020-01-01' AS max_days FROM vec_scan;
+SELECT count(*), sum(n) FROM vec_scan WHERE i8 BETWEEN 1000 AND 20000;
+SELECT id, v, length(t) FROM vec_scan WHERE v LIKE 'v299%' ORDER BY id;
+SELECT count(*) FROM vec_scan WHERE i8 IS NULL AND t IS NULL;
+
+-- batch path, same results
+SET try_vector_engine_strategy = force;
+SELECT vec_scan_plan('SELECT id, n, v FROM vec_scan WHERE n > 100');
+SELECT vec_scan_plan('SELECT count(*), sum(n) FROM vec_scan WHERE i8 BETWEEN 1000 AND 20000');
+SELECT id, i8, n, v, length(t), d - DATE '2020-01-01' AS days FROM vec_scan WHERE id > 2995 ORDER BY id;
+SELECT count(*), count(i8), count(n), count(v), count(t), count(d), sum(i8), sum(n), sum(length(t)), min(v),
+    max(d) - DATE '2020-01-01' AS max_days FROM vec_scan;
+SELECT count(*), sum(n) FROM vec_scan WHERE i8 BETWEEN 1000 AND 20000;
+SELECT id, v, length(t) FROM vec_scan WHERE v LIKE 'v299%' ORDER BY id;
+SELECT count(*) FROM vec_scan WHERE i8 IS NULL AND t IS NULL;
+
+-- scans whose rows are locked, updated or deleted stay row based
+SELECT vec_scan_plan('SELECT id, v FROM vec_scan WHERE id < 10 FOR UPDATE');
+SELECT vec_scan_plan('UPDATE vec_scan SET v = v || ''u'' WHERE n > 700');
+SELECT vec_scan_plan('DELETE FROM vec_scan WHERE n > 700');
+BEGIN;
+SELECT id, v FROM vec_scan WHERE id < 4 ORDER BY id FOR UPDATE;
+UPDATE vec_scan SET v = v || 'u' WHERE n > 749;
+DELETE FROM vec_scan WHERE id > 2998;
+COMMIT;
+SELECT id, i8, n, v, length(t), d - DATE '2020-01-01' AS days FROM vec_scan WHERE id > 2995 ORDER BY id;
+SELECT count(*), count(v), sum(i8) FROM vec_scan;
+
+RESET try_vector_engine_strategy;
+DROP FUNCTION vec_scan_plan(text);
+DROP FOREIGN TABLE vec_scan;
@@ -0,0 +1,150 @@
+#!/bin/sh
+
+source $1/env_utils.sh $1 $2
+
+case_db="pa_db"
+sub_data_dir="$data_dir/sub_datanode1"
+sql_file="$scripts_dir/results/parallel_apply.sql"
+
+# run the statements of a file, each one in a transaction of its own
+function exec_sql_file(){
+	gsql -d $1 -p $2 -Atq -f "$3" > /dev/null
+}
+
+function wait_for_parallel_workers(){
+	max_attempts=20
+	attempt=0
+	while (($attempt < $max_attempts))
+	do
+		if [ "$(exec_sql $1 $2 "SELECT count(*) FROM gs_get_parallel_apply_status() WHERE pid IS NOT NULL")" = "$3" ]; then
+			echo "parallel apply workers have been started"
+			break
+		fi
+		sleep 1
+		attempt=`expr $attempt \+ 1`
+	done
+
+	if [ $attempt -eq $max_attempts ]; then
+		echo "$failed_keyword, timed out waiting for parallel apply workers."
+		exit 1
+	fi
+}
+
+function check_same_data(){
+	query="SELECT md5(string_agg(a || ':' || b, ',' ORDER BY a)) FROM $1"
+	if [ "$(exec_sql $case_db $pub_node1_port "$query")" = "$(exec_sql $case_db $sub_node1_port "$query")" ]; then
+		echo "check $1 is the same on subscriber $2 success"
+	else
+		echo "$failed_keyword when check $1 is the same on subscriber $2"
+		exit 1
+	fi
+}
+
+function test_1() {
+	echo "create database and tables."
+	exec_sql $db $pub_node1_port "CREATE DATABASE $case_db"
+	exec_sql $db $sub_node1_port "CREATE DATABASE $case_db"
+	exec_sql $case_db $pub_node1_port "CREATE TABLE tab_pa (a int primary key, b int)"
+	exec_sql $case_db $pub_node1_port "CREATE TABLE tab_order (a int primary key, b int)"
+	exec_sql $case_db $pub_node1_port "INSERT INTO tab_order VALUES (1, 0)"
+	exec_sql $case_db $sub_node1_port "CREATE TABLE tab_pa (a int primary key, b int)"
+	exec_sql $case_db $sub_node1_port "CREATE TABLE tab_order (a int primary key, b int)"
+
+	echo "create publication and subscription."
+	publisher_connstr="port=$pub_node1_port host=$g_local_ip dbname=$case_db user=$username password=$passwd"
+	exec_sql $case_db $pub_node1_port "CREATE PUBLICATION tap_pub FOR ALL TABLES"
+	exec_sql $case_db $sub_node1_port "CREATE SUBSCRIPTION tap_sub CONNECTION '$publisher_connstr' PUBLICATION tap_pub"
+
+	# Wait for initial table sync to finish, the table sync workers take worker slots
+	wait_for_subscription_sync $case_db $sub_node1_port
+
+	# Restart the apply worker with two parallel apply workers
+	gs_guc reload -D $sub_data_dir -c "max_parallel_apply_workers_per_subscription=2"
+	exec_sql $case_db $sub_node1_port "ALTER SUBSCRIPTION tap_sub SET (enabled = false)"
+	exec_sql $case_db $sub_node1_port "ALTER SUBSCRIPTION tap_sub ENABLE"
+	wait_for_parallel_workers $case_db $sub_node1_port 2
+
+	# Independent transactions are handed out to both workers
+	rm -f $sql_file
+	for i in `seq 1 200`
+	do
+		echo "INSERT INTO tab_pa VALUES ($i, 0);" >> $sql_file
+	done
+	exec_sql_file $case_db $pub_node1_port $sql_file
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT count(*) FROM gs_get_parallel_apply_status() WHERE assigned_xacts > 0")" = "2" ]; then
+		echo "check transactions are dispatched to all parallel apply workers success"
+	else
+		echo "$failed_keyword when check transactions are dispatched to all parallel apply workers"
+		exit 1
+	fi
+	check_same_data tab_pa "after dispatch"
+
+	# Transactions on other keys go to either worker, the ones on the shared row must commit
+	# in publisher order, so the last value written wins on the subscriber too
+	rm -f $sql_file
+	for i in `seq 1 200`
+	do
+		echo "UPDATE tab_pa SET b = $i WHERE a = $i;" >> $sql_file
+		echo "UPDATE tab_order SET b = $i WHERE a = 1;" >> $sql_file
+		echo "UPDATE tab_pa SET b = b + 1 WHERE a = `expr 201 - $i`;" >> $sql_file
+	done
+	exec_sql_file $case_db $pub_node1_port $sql_file
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+
+	if [ "$(exec_sql $case_db $sub_node1_port "SELECT b FROM tab_order WHERE a = 1")" = "200" ]; then
+		echo "check commit order across parallel apply workers success"
+	else
+		echo "$failed_keyword when check commit order across parallel apply workers"
+		exit 1
+	fi
+	check_same_data tab_pa "after ordered commits"
+
+	# A parallel apply worker fails on a conflicting row: the leader stops the workers and
+	# applies their transactions itself
+	exec_sql $case_db $sub_node1_port "INSERT INTO tab_pa VALUES (1000, -1)"
+	rm -f $sql_file
+	for i in `seq 990 1010`
+	do
+		echo "INSERT INTO tab_pa VALUES ($i, $i);" >> $sql_file
+	done
+	exec_sql_file $case_db $pub_node1_port $sql_file
+
+	max_attempts=20
+	attempt=0
+	while (($attempt < $max_attempts))
+	do
+		if [ $(grep -h "applying changes serially" $sub_data_dir/pg_log/* 2>/dev/null | wc -l) -gt 0 ]; then
+			echo "leader fell back to serial apply"
+			break
+		fi
+		sleep 1
+		attempt=`expr $attempt \+ 1`
+	done
+	if [ $attempt -eq $max_attempts ]; then
+		echo "$failed_keyword, timed out waiting for the fallback to serial apply."
+		exit 1
+	fi
+
+	# Resolve the conflict, the restarted apply worker catches up with parallel apply again
+	exec_sql $case_db $sub_node1_port "DELETE FROM tab_pa WHERE a = 1000"
+	wait_for_catchup $case_db $pub_node1_port "tap_sub"
+	check_same_data tab_pa "after fallback"
+	wait_for_parallel_workers $case_db $sub_node1_port 2
+}
+
+function tear_down() {
+	exec_sql $case_db $sub_node1_port "DROP SUBSCRIPTION tap_sub"
+	exec_sql $case_db $pub_node1_port "DROP PUBLICATION tap_pub"
+	gs_guc reload -D $sub_data_dir -c "max_parallel_apply_workers_per_subscription=0"
+	rm -f $sql_file
+
+	exec_sql $db $sub_node1_port "DROP DATABASE $case_db"
+	exec_sql $db $pub_node1_port "DROP DATABASE $case_db"
+
+	echo "tear down"
+}
+
+test_1
+tear_down
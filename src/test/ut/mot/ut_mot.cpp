@@ -0,0 +1,928 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_mot.cpp
+ *        Unit tests of the MOT engine background tasks and indexes.
+ *
+ * IDENTIFICATION
+ *        src/test/ut/mot/ut_mot.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "ut_mot.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "postgres.h"
+#include "catalog/pg_type.h"
+#include "knl/knl_session.h"
+#include "knl/knl_thread.h"
+#include "nodes/makefuncs.h"
+#include "utils/memutils.h"
+
+#include "mot_engine.h"
+#include "session_manager.h"
+#include "session_context.h"
+#include "table.h"
+#include "index.h"
+#include "index_iterator.h"
+#include "primary_sentinel.h"
+#include "cold_row_store.h"
+#include "row.h"
+#include "mm_gc_manager.h"
+#include "irecovery_manager.h"
+#include "redo_log_buffer.h"
+#include "redo_log_writer.h"
+#include "checkpoint_manager.h"
+#include "checkpoint_utils.h"
+#include "buffer.h"
+#include "jit_warmup.h"
+
+GUNIT_TEST_REGISTRATION(ut_mot, TestCase01)
+GUNIT_TEST_REGISTRATION(ut_mot, TestCase02)
+GUNIT_TEST_REGISTRATION(ut_mot, TestCase03)
+GUNIT_TEST_REGISTRATION(ut_mot, TestCase04)
+GUNIT_TEST_REGISTRATION(ut_mot, TestCase05)
+GUNIT_TEST_REGISTRATION(ut_mot, TestCase06)
+GUNIT_TEST_REGISTRATION(ut_mot, TestCase07)
+GUNIT_TEST_REGISTRATION(ut_mot, TestCase08)
+
+#define UT_MOT_ROW_COUNT 5000
+#define UT_MOT_TIMEOUT_SECONDS 30
+#define UT_MOT_GC_OBJECT_COUNT 100
+#define UT_MOT_GC_OBJECT_SIZE 64
+#define UT_MOT_REDO_TXN_COUNT 2000
+#define UT_MOT_SCAN_ROW_COUNT 200000
+#define UT_MOT_SCAN_CHUNK 10000
+#define UT_MOT_DELETE_STRIDE 10
+#define UT_MOT_WARMUP_DATABASE_ID 16384
+#define UT_MOT_WARMUP_FIRST_RELID 20000
+#define UT_MOT_WARMUP_SECOND_RELID 20001
+#define UT_MOT_CONTENTION_ROUNDS 4
+#define UT_MOT_CONTENTION_SAMPLES 1000
+#define UT_MOT_LOCK_HOLD_MICROS 200000
+#define UT_MOT_LOCK_HOLDER_TID 1000
+#define UT_MOT_SEGMENT_ROW_COUNT 500000
+#define UT_MOT_BLOCK_SIZE (64 * 1024)
+
+char ut_mot::m_dir[PATH_MAX];
+MOT::ScopedSessionManager* ut_mot::m_scopedSession = nullptr;
+MOT::SessionContext* ut_mot::m_session = nullptr;
+
+static bool g_kernelInitialized = false;
+
+void ut_mot::SetUp()
+{
+    if (!g_kernelInitialized) {
+        MemoryContextInit();
+        knl_thread_init(WORKER);
+        g_kernelInitialized = true;
+    }
+    int rc = snprintf_s(m_dir, PATH_MAX, PATH_MAX - 1, "/tmp/ut_mot_XXXXXX");
+    securec_check_ss(rc, "\0", "\0");
+    ASSERT_NE(mkdtemp(m_dir), nullptr);
+    m_scopedSession = new MOT::ScopedSessionManager();
+}
+
+void ut_mot::TearDown()
+{
+    if (m_session != nullptr) {
+        MOT::GetSessionManager()->DestroySessionContext(m_session);
+        m_session = nullptr;
+    }
+    MOT::MOTEngine::DestroyInstance();
+    delete m_scopedSession;
+    m_scopedSession = nullptr;
+    std::string cmd = std::string("rm -rf ") + m_dir;
+    (void)system(cmd.c_str());
+}
+
+bool ut_mot::StartEngine(const char* confLines, bool createSession)
+{
+    char confPath[PATH_MAX];
+    int rc = snprintf_s(confPath, PATH_MAX, PATH_MAX - 1, "%s/mot.conf", m_dir);
+    securec_check_ss(rc, "\0", "\0");
+    FILE* conf = fopen(confPath, "w");
+    if (conf == nullptr) {
+        return false;
+    }
+    // the checkpoint tests enable it in their own lines, and a key set twice fails the configuration
+    const char* checkpointLine =
+        (strstr(confLines, "enable_checkpoint") == nullptr) ? "enable_checkpoint = false\n" : "";
+    (void)fprintf(conf,
+        "max_mot_global_memory = 1 GB\n"
+        "min_mot_global_memory = 0 MB\n"
+        "max_mot_local_memory = 256 MB\n"
+        "min_mot_local_memory = 0 MB\n"
+        "enable_redo_log = false\n"
+        "%s"
+        "enable_stats = false\n"
+        "checkpoint_dir = %s\n"
+        "cold_row_store_dir = %s\n"
+        "%s",
+        checkpointLine,
+        m_dir,
+        m_dir,
+        confLines);
+    (void)fclose(conf);
+
+    if (MOT::MOTEngine::CreateInstance(confPath) == nullptr) {
+        return false;
+    }
+    if (!createSession) {
+        return true;
+    }
+    m_session = MOT::GetSessionManager()->CreateSessionContext();
+    return (m_session != nullptr);
+}
+
+MOT::Table* ut_mot::CreateTable(const char* name, bool hashIndex)
+{
+    MOT::Table* table = new (std::nothrow) MOT::Table();
+    if (table == nullptr) {
+        return nullptr;
+    }
+    std::string longName = std::string("ut_mot_") + name;
+    if (!table->Init(name, longName.c_str(), 2) ||
+        table->AddColumn("null_bytes", 1, MOT::MOT_CATALOG_FIELD_TYPES::MOT_TYPE_NULLBYTES) != MOT::RC_OK ||
+        table->AddColumn("id", sizeof(uint64_t), MOT::MOT_CATALOG_FIELD_TYPES::MOT_TYPE_LONG, true) != MOT::RC_OK) {
+        delete table;
+        return nullptr;
+    }
+    table->SetFixedLengthRow(true);
+    if (!table->InitRowPool() || !table->InitTombStonePool()) {
+        delete table;
+        return nullptr;
+    }
+
+    MOT::Table::CommonIndexMeta meta;
+    meta.m_name = longName + "_pkey";
+    meta.m_fake = false;
+    meta.m_unique = true;
+    meta.m_indexOrder = MOT::IndexOrder::INDEX_ORDER_PRIMARY;
+    meta.m_indexingMethod =
+        hashIndex ? MOT::IndexingMethod::INDEXING_METHOD_HASH : MOT::IndexingMethod::INDEXING_METHOD_TREE;
+    meta.m_indexExtId = 0;
+    meta.m_numKeyFields = 1;
+    meta.m_numTableFields = 2;
+    meta.m_keyLength = sizeof(uint64_t);
+    meta.m_lengthKeyFields[0] = sizeof(uint64_t);
+    meta.m_columnKeyFields[0] = 1;
+    if (table->CreateIndexFromMeta(meta, true, MOTCurrThreadId, MOT::MetadataProtoVersion::METADATA_VER_CURR) !=
+        MOT::RC_OK) {
+        delete table;
+        return nullptr;
+    }
+    if (!MOT::GetTableManager()->AddTable(table)) {
+        delete table;
+        return nullptr;
+    }
+    return table;
+}
+
+bool ut_mot::InsertRows(MOT::Table* table, uint64_t count, uint64_t first)
+{
+    for (uint64_t i = first; i < first + count; i++) {
+        MOT::Row* row = table->CreateNewRow();
+        if (row == nullptr) {
+            return false;
+        }
+        row->SetValue<uint8_t>(0, 0);
+        row->SetValue<uint64_t>(1, i);
+        row->SetCommitSequenceNumber(MOT::GetCSNManager().GetNextCSN());
+        if (table->InsertRowNonTransactional(row, MOTCurrThreadId) != MOT::RC_OK) {
+            table->DestroyRow(row);
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t ut_mot::CountEvicted(MOT::Table* table)
+{
+    uint64_t evicted = 0;
+    MOT::IndexIterator* it = table->GetPrimaryIndex()->Begin(MOTCurrThreadId);
+    if (it == nullptr) {
+        return 0;
+    }
+    while (it->IsValid()) {
+        MOT::PrimarySentinel* ps = static_cast<MOT::PrimarySentinel*>(it->GetPrimarySentinel());
+        if (ps->IsEvicted()) {
+            evicted++;
+        }
+        it->Next();
+    }
+    delete it;
+    return evicted;
+}
+
+uint64_t ut_mot::SumKeys(MOT::Table* table, uint64_t& count)
+{
+    uint64_t sum = 0;
+    count = 0;
+    MOT::IndexIterator* it = table->GetPrimaryIndex()->Begin(MOTCurrThreadId);
+    if (it == nullptr) {
+        return 0;
+    }
+    while (it->IsValid()) {
+        MOT::Row* row = it->GetPrimarySentinel()->GetData();
+        if (row != nullptr && !row->IsRowDeleted()) {
+            uint64_t key = 0;
+            row->GetValue(1, key);
+            sum += key;
+            count++;
+        }
+        it->Next();
+    }
+    delete it;
+    return sum;
+}
+
+bool ut_mot::WaitFor(bool (*cond)(void*), void* arg, uint32_t timeoutSeconds)
+{
+    const uint32_t pollMicros = 100000;
+    for (uint64_t waited = 0; waited < (uint64_t)timeoutSeconds * 1000000; waited += pollMicros) {
+        if (cond(arg)) {
+            return true;
+        }
+        (void)usleep(pollMicros);
+    }
+    return cond(arg);
+}
+
+static bool AllRowsEvicted(void* arg)
+{
+    return ut_mot::CountEvicted((MOT::Table*)arg) == UT_MOT_ROW_COUNT;
+}
+
+/* TestCase01: the cold row evictor runs its passes without a kernel snapshot and evicts idle rows */
+void ut_mot::TestCase01()
+{
+    ASSERT_TRUE(StartEngine("enable_cold_row_eviction = true\n"
+                            "cold_row_eviction_period = 1 s\n"));
+    MOT::Table* table = CreateTable("evict", false);
+    ASSERT_NE(table, nullptr);
+    ASSERT_TRUE(InsertRows(table, UT_MOT_ROW_COUNT));
+
+    // the first pass clears the access marks, the next one evicts the rows committed before the first
+    ASSERT_TRUE(WaitFor(AllRowsEvicted, table, UT_MOT_TIMEOUT_SECONDS));
+    ASSERT_EQ(table->GetColdStore()->GetLiveRecords(), (uint64_t)UT_MOT_ROW_COUNT);
+
+    // reading the rows faults them back in
+    uint64_t count = 0;
+    ASSERT_EQ(SumKeys(table, count), (uint64_t)UT_MOT_ROW_COUNT * (UT_MOT_ROW_COUNT - 1) / 2);
+    ASSERT_EQ(count, (uint64_t)UT_MOT_ROW_COUNT);
+}
+
+static std::atomic<uint32_t> g_reclaimedObjects(0);
+
+static uint32_t CountReclaimedObject(void* gcElement, void* oper, void* aux)
+{
+    (void)g_reclaimedObjects.fetch_add(1);
+    return UT_MOT_GC_OBJECT_SIZE;
+}
+
+static bool AllObjectsReclaimed(void* arg)
+{
+    return g_reclaimedObjects.load() == UT_MOT_GC_OBJECT_COUNT;
+}
+
+/* TestCase02: the GC reclaimer runs its passes without a kernel snapshot and releases the limbo of idle sessions */
+void ut_mot::TestCase02()
+{
+    ASSERT_TRUE(StartEngine("enable_gc_reclaimer = true\n"
+                            "gc_reclaimer_period = 10 ms\n"));
+    MOT::GcManager* gcSession = m_session->GetTxnManager()->GetGcSession();
+    static uint64_t objects[UT_MOT_GC_OBJECT_COUNT];
+
+    // a few small objects stay far below the reclamation threshold, so the session keeps them in its limbo
+    g_reclaimedObjects = 0;
+    ASSERT_EQ(gcSession->GcStartTxn(), MOT::RC_OK);
+    for (uint32_t i = 0; i < UT_MOT_GC_OBJECT_COUNT; i++) {
+        gcSession->GcRecordObject(MOT::GC_QUEUE_TYPE::GENERIC_QUEUE,
+            0,
+            &objects[i],
+            nullptr,
+            CountReclaimedObject,
+            UT_MOT_GC_OBJECT_SIZE,
+            MOT::GetCSNManager().GetGcEpoch());
+    }
+    gcSession->GcEndTxn();
+    ASSERT_EQ(g_reclaimedObjects.load(), 0U);
+
+    // once the global epoch moves past the objects, the idle session limbo is released by the reclaimer
+    (void)MOT::GetCSNManager().GetNextCSN();
+    ASSERT_TRUE(WaitFor(AllObjectsReclaimed, nullptr, UT_MOT_TIMEOUT_SECONDS));
+    ASSERT_EQ(gcSession->GetTotalLimboInuseElements(), 0U);
+}
+
+/* logs a single-row insert or delete transaction of a table and hands it to the recovery manager */
+static bool ApplyRedoTxn(MOT::Table* table, uint64_t key, bool insert, bool viaCommitQueue, uint64_t txnId,
+    uint64_t prevTxnId, uint64_t lsn)
+{
+    MOT::RedoLogBuffer buffer;
+    if (!buffer.Initialize()) {
+        return false;
+    }
+    MOT::Row* row = table->CreateNewRow();
+    if (row == nullptr) {
+        return false;
+    }
+    row->SetValue<uint8_t>(0, 0);
+    row->SetValue<uint64_t>(1, key);
+    MOT::MaxKey pk;
+    MOT::Index* index = table->GetPrimaryIndex();
+    pk.InitKey(index->GetKeyLength());
+    index->BuildKey(table, row, &pk);
+    bool result = insert ? MOT::RedoLogWriter::AppendCreateRow(buffer,
+                               table->GetTableId(),
+                               &pk,
+                               row->GetData(),
+                               row->GetTupleSize(),
+                               table->GetTableExId(),
+                               key + 1)
+                         : MOT::RedoLogWriter::AppendRemove(
+                               buffer, table->GetTableId(), &pk, prevTxnId, table->GetTableExId());
+    table->DestroyRow(row);
+    if (!result) {
+        return false;
+    }
+
+    // the update index column flag keeps a transaction out of the partitions, so it commits through the queue
+    uint16_t flags = viaCommitQueue ? MOT::EndSegmentBlock::MOT_UPDATE_INDEX_COLUMN_FLAG : 0;
+    MOT::EndSegmentBlock block(MOT::OperationCode::COMMIT_TX, flags, txnId, txnId, txnId);
+    buffer.Append(block);
+    uint32_t size = 0;
+    uint8_t* data = buffer.Serialize(&size);
+    return MOT::GetRecoveryManager()->ApplyRedoLog(lsn, (char*)data, size);
+}
+
+/* TestCase03: partitioned redo transactions commit after the prior transactions of the commit queue, and vice versa */
+void ut_mot::TestCase03()
+{
+    ASSERT_TRUE(StartEngine("parallel_recovery_workers = 4\n"
+                            "enable_parallel_recovery_partitioning = true\n",
+                            false));
+    ASSERT_TRUE(MOT::MOTEngine::GetInstance()->StartRecovery());
+    MOT::Table* table = CreateTable("recovery", false);
+    ASSERT_NE(table, nullptr);
+
+    // each row is inserted and then deleted on the other replay path, so a reordered commit fails the delete
+    uint64_t txnId = 0;
+    uint64_t lsn = 0;
+    for (uint64_t key = 0; key < UT_MOT_REDO_TXN_COUNT; key++) {
+        bool insertViaCommitQueue = ((key % 2) == 0);
+        uint64_t insertTxnId = ++txnId;
+        ASSERT_TRUE(ApplyRedoTxn(table, key, true, insertViaCommitQueue, insertTxnId, 0, ++lsn));
+        ASSERT_TRUE(ApplyRedoTxn(table, key, false, !insertViaCommitQueue, ++txnId, insertTxnId, ++lsn));
+    }
+    ASSERT_FALSE(MOT::GetRecoveryManager()->IsErrorSet());
+    ASSERT_TRUE(MOT::MOTEngine::GetInstance()->EndRecovery());
+
+    m_session = MOT::GetSessionManager()->CreateSessionContext();
+    ASSERT_NE(m_session, nullptr);
+    uint64_t count = 0;
+    (void)SumKeys(table, count);
+    ASSERT_EQ(count, 0U);
+}
+
+/* scans a table in chunks, each in a GC epoch of its own and re-positioned at the key the previous one stopped at */
+static uint64_t ChunkedScan(MOT::Table* table, MOT::GcManager* gcSession, uint64_t& count)
+{
+    MOT::Index* index = table->GetPrimaryIndex();
+    MOT::MaxKey nextKey;
+    bool started = false;
+    uint64_t sum = 0;
+    count = 0;
+    while (true) {
+        if (gcSession->GcStartTxn() != MOT::RC_OK) {
+            return 0;
+        }
+        MOT::IndexIterator* it = started ? index->Seek(&nextKey, MOTCurrThreadId) : index->Begin(MOTCurrThreadId);
+        started = true;
+        if (it == nullptr) {
+            gcSession->GcEndTxn();
+            return 0;
+        }
+        for (uint32_t i = 0; i < UT_MOT_SCAN_CHUNK && it->IsValid(); i++) {
+            uint64_t key = 0;
+            it->GetPrimarySentinel()->GetData()->GetValue(1, key);
+            sum += key;
+            count++;
+            it->Next();
+        }
+        bool done = !it->IsValid();
+        if (!done) {
+            nextKey.CpKey(*(const MOT::Key*)(it->GetKey()));
+        }
+        delete it;
+        gcSession->GcEndTxn();
+        if (done) {
+            return sum;
+        }
+    }
+}
+
+/* looks up every key of a table through its primary index, returns the number of keys found */
+static uint64_t LookupAll(MOT::Table* table, MOT::Row* scratch)
+{
+    MOT::Index* index = table->GetPrimaryIndex();
+    MOT::MaxKey key;
+    uint64_t found = 0;
+    for (uint64_t i = 0; i < UT_MOT_SCAN_ROW_COUNT; i++) {
+        scratch->SetValue<uint64_t>(1, i);
+        key.InitKey(index->GetKeyLength());
+        index->BuildKey(table, scratch, &key);
+        if (index->IndexReadSentinel(&key, MOTCurrThreadId) != nullptr) {
+            found++;
+        }
+    }
+    return found;
+}
+
+/* TestCase04: hash and tree index scans are re-positioned by key between GC epochs, and find every key */
+void ut_mot::TestCase04()
+{
+    ASSERT_TRUE(StartEngine(""));
+    MOT::GcManager* gcSession = m_session->GetTxnManager()->GetGcSession();
+    const uint64_t expectedSum = (uint64_t)UT_MOT_SCAN_ROW_COUNT * (UT_MOT_SCAN_ROW_COUNT - 1) / 2;
+    const char* names[] = {"scan_hash", "scan_tree"};
+
+    for (uint32_t i = 0; i < 2; i++) {
+        bool hashIndex = (i == 0);
+        MOT::Table* table = CreateTable(names[i], hashIndex);
+        ASSERT_NE(table, nullptr);
+        ASSERT_TRUE(InsertRows(table, UT_MOT_SCAN_ROW_COUNT));
+        MOT::Row* scratch = table->CreateNewRow();
+        ASSERT_NE(scratch, nullptr);
+        scratch->SetValue<uint8_t>(0, 0);
+
+        // every row is visited exactly once although no iterator outlives its epoch
+        uint64_t count = 0;
+        ASSERT_EQ(ChunkedScan(table, gcSession, count), expectedSum);
+        ASSERT_EQ(count, (uint64_t)UT_MOT_SCAN_ROW_COUNT);
+
+        ASSERT_EQ(LookupAll(table, scratch), (uint64_t)UT_MOT_SCAN_ROW_COUNT);
+
+        // resuming at an existing key starts at that key
+        MOT::MaxKey key;
+        scratch->SetValue<uint64_t>(1, UT_MOT_SCAN_ROW_COUNT / 2);
+        key.InitKey(table->GetPrimaryIndex()->GetKeyLength());
+        table->GetPrimaryIndex()->BuildKey(table, scratch, &key);
+        MOT::IndexIterator* it = table->GetPrimaryIndex()->Seek(&key, MOTCurrThreadId);
+        ASSERT_NE(it, nullptr);
+        ASSERT_TRUE(it->IsValid());
+        uint64_t value = 0;
+        it->GetPrimarySentinel()->GetData()->GetValue(1, value);
+        ASSERT_EQ(value, (uint64_t)UT_MOT_SCAN_ROW_COUNT / 2);
+        delete it;
+        table->DestroyRow(scratch);
+    }
+}
+
+/* deletes a row of a table in a transaction of its own, so the delete reaches the checkpoint delete log */
+static bool DeleteRow(MOT::TxnManager* txn, MOT::Table* table, MOT::Row* scratch, uint64_t key, uint64_t txnId)
+{
+    MOT::MaxKey pk;
+    MOT::Index* index = table->GetPrimaryIndex();
+    scratch->SetValue<uint64_t>(1, key);
+    pk.InitKey(index->GetKeyLength());
+    index->BuildKey(table, scratch, &pk);
+
+    // the test thread has no kernel snapshot, so the transaction runs on the global GC epoch
+    MOT::RC rc = MOT::RC_OK;
+    txn->StartTransaction(txnId, MOT::READ_COMMITED);
+    if (txn->GcSessionStart(MOT::GetCSNManager().GetGcEpoch()) != MOT::RC_OK) {
+        txn->EndTransaction();
+        return false;
+    }
+    MOT::Row* row = txn->RowLookupByKey(table, MOT::AccessType::DEL, &pk, rc);
+    if (row == nullptr || rc != MOT::RC_OK || txn->DeleteLastRow() != MOT::RC_OK) {
+        txn->Rollback();
+        txn->EndTransaction();
+        return false;
+    }
+    rc = txn->Commit();
+    if (rc != MOT::RC_OK) {
+        txn->Rollback();
+    }
+    txn->EndTransaction();
+    return (rc == MOT::RC_OK);
+}
+
+/* runs a checkpoint through all its phases, as the kernel checkpointer does */
+static bool RunCheckpoint(uint64_t lsn)
+{
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    return engine->CreateSnapshot() && engine->SnapshotReady(lsn) && engine->BeginCheckpoint();
+}
+
+/* reads the number of deltas since the full image from the chain file of the last checkpoint */
+static bool ReadNumDeltas(uint64_t& numDeltas)
+{
+    std::string workingDir;
+    std::string fileName;
+    uint64_t checkpointId = MOT::GetCheckpointManager()->GetId();
+    if (!MOT::CheckpointUtils::SetWorkingDir(workingDir, checkpointId)) {
+        return false;
+    }
+    MOT::CheckpointUtils::MakeChainFilename(fileName, workingDir, checkpointId);
+    int fd = -1;
+    if (!MOT::CheckpointUtils::OpenFileRead(fileName, fd)) {
+        return false;
+    }
+    MOT::CheckpointUtils::ChainFileHeader header;
+    bool result = (MOT::CheckpointUtils::ReadFile(fd, (char*)&header, sizeof(header)) == sizeof(header)) &&
+                  (header.m_magic == MOT::CheckpointUtils::HEADER_MAGIC);
+    (void)MOT::CheckpointUtils::CloseFile(fd);
+    numDeltas = header.m_numDeltas;
+    return result;
+}
+
+/* TestCase05: a delta checkpoint of inserts and deletes is recovered on top of the full image it follows */
+void ut_mot::TestCase05()
+{
+    const char* confLines = "enable_checkpoint = true\n"
+                            "enable_delta_checkpoint = true\n"
+                            "checkpoint_full_image_interval = 8\n";
+    ASSERT_TRUE(StartEngine(confLines));
+    MOT::Table* table = CreateTable("delta", false);
+    ASSERT_NE(table, nullptr);
+    ASSERT_TRUE(InsertRows(table, UT_MOT_ROW_COUNT));
+    ASSERT_TRUE(RunCheckpoint(1));
+    uint64_t numDeltas = 0;
+    ASSERT_TRUE(ReadNumDeltas(numDeltas));
+    ASSERT_EQ(numDeltas, 0U);
+
+    // the delta holds the new rows, and the deletes of rows from both the full image and the delta itself
+    ASSERT_TRUE(InsertRows(table, UT_MOT_ROW_COUNT, UT_MOT_ROW_COUNT));
+    MOT::Row* scratch = table->CreateNewRow();
+    ASSERT_NE(scratch, nullptr);
+    scratch->SetValue<uint8_t>(0, 0);
+    MOT::TxnManager* txn = m_session->GetTxnManager();
+    uint64_t deletedSum = 0;
+    uint64_t deletedCount = 0;
+    for (uint64_t key = 0; key < 2 * UT_MOT_ROW_COUNT; key += UT_MOT_DELETE_STRIDE) {
+        ASSERT_TRUE(DeleteRow(txn, table, scratch, key, key + 1));
+        deletedSum += key;
+        deletedCount++;
+    }
+    table->DestroyRow(scratch);
+    ASSERT_TRUE(RunCheckpoint(2));
+    ASSERT_TRUE(ReadNumDeltas(numDeltas));
+    ASSERT_EQ(numDeltas, 1U);
+
+    // restart the engine and recover the chain
+    MOT::GetSessionManager()->DestroySessionContext(m_session);
+    m_session = nullptr;
+    MOT::MOTEngine::DestroyInstance();
+    delete m_scopedSession;
+    m_scopedSession = new MOT::ScopedSessionManager();
+    ASSERT_TRUE(StartEngine(confLines, false));
+    ASSERT_TRUE(MOT::MOTEngine::GetInstance()->StartRecovery());
+    ASSERT_TRUE(MOT::MOTEngine::GetInstance()->EndRecovery());
+    m_session = MOT::GetSessionManager()->CreateSessionContext();
+    ASSERT_NE(m_session, nullptr);
+
+    table = MOT::GetTableManager()->GetTable("ut_mot_delta");
+    ASSERT_NE(table, nullptr);
+    uint64_t count = 0;
+    const uint64_t totalRows = 2 * UT_MOT_ROW_COUNT;
+    ASSERT_EQ(SumKeys(table, count), totalRows * (totalRows - 1) / 2 - deletedSum);
+    ASSERT_EQ(count, totalRows - deletedCount);
+}
+
+/* runs the JIT warm-up list of a test in the test directory, on behalf of a session of the warm-up database */
+class WarmupScope {
+public:
+    WarmupScope() : m_prevSession(u_sess), m_changedDir(false)
+    {
+        m_session = create_session_context(t_thrd.top_mem_cxt, 0);
+        m_session->proc_cxt.MyDatabaseId = UT_MOT_WARMUP_DATABASE_ID;
+        u_sess = m_session;
+        // the warm-up file is kept in the current directory, which is the data directory of the server
+        if (getcwd(m_cwd, sizeof(m_cwd)) != nullptr) {
+            m_changedDir = (chdir(ut_mot::m_dir) == 0);
+        }
+    }
+
+    ~WarmupScope()
+    {
+        JitExec::DestroyJitWarmup();
+        if (m_changedDir) {
+            (void)chdir(m_cwd);
+        }
+        u_sess = m_prevSession;
+        free_session_context(m_session);
+    }
+
+    bool IsValid() const
+    {
+        return m_changedDir;
+    }
+
+private:
+    knl_session_context* m_prevSession;
+    knl_session_context* m_session;
+    char m_cwd[PATH_MAX];
+    bool m_changedDir;
+};
+
+/* reads the warm-up file of the test directory, returns an empty string if there is none */
+static std::string ReadWarmupFile()
+{
+    std::string content;
+    std::string fileName = std::string(ut_mot::m_dir) + "/mot_jit_warmup";
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (file == nullptr) {
+        return content;
+    }
+    char chunk[BUFSIZ];
+    size_t bytesRead = 0;
+    while ((bytesRead = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        (void)content.append(chunk, bytesRead);
+    }
+    (void)fclose(file);
+    return content;
+}
+
+/* makes a query referring to a single relation, the only part of the query that the warm-up list records */
+static Query* MakeWarmupQuery(Oid relationId)
+{
+    RangeTblEntry* rte = makeNode(RangeTblEntry);
+    rte->rtekind = RTE_RELATION;
+    rte->relid = relationId;
+    Query* query = makeNode(Query);
+    query->commandType = CMD_SELECT;
+    query->rtable = list_make1(rte);
+    return query;
+}
+
+/* TestCase06: jitted queries are buffered by the warm-up list, and written to the warm-up file only on flush */
+void ut_mot::TestCase06()
+{
+    ASSERT_TRUE(StartEngine("enable_mot_codegen_warmup = true\n", false));
+    WarmupScope scope;
+    ASSERT_TRUE(scope.IsValid());
+    ASSERT_TRUE(JitExec::InitJitWarmup());
+
+    const char* firstQuery = "select id from ut_mot_first where id = $1";
+    const char* secondQuery = "select id from ut_mot_second where id = $1";
+    Oid paramTypes[] = {INT8OID};
+    JitExec::RecordJitWarmupQuery(MakeWarmupQuery(UT_MOT_WARMUP_FIRST_RELID), firstQuery, paramTypes, 1);
+    JitExec::RecordJitWarmupQuery(MakeWarmupQuery(UT_MOT_WARMUP_SECOND_RELID), secondQuery, paramTypes, 1);
+    ASSERT_TRUE(ReadWarmupFile().empty());
+
+    JitExec::FlushJitWarmup();
+    std::string content = ReadWarmupFile();
+    ASSERT_NE(content.find(firstQuery), std::string::npos);
+    ASSERT_NE(content.find(secondQuery), std::string::npos);
+
+    // dropping a relation removes its queries from the file on the next flush
+    JitExec::PurgeJitWarmup(UT_MOT_WARMUP_FIRST_RELID);
+    ASSERT_EQ(ReadWarmupFile(), content);
+    JitExec::FlushJitWarmup();
+    content = ReadWarmupFile();
+    ASSERT_EQ(content.find(firstQuery), std::string::npos);
+    ASSERT_NE(content.find(secondQuery), std::string::npos);
+
+    // the file is loaded after restart, so a query of the previous run is not recorded twice
+    JitExec::DestroyJitWarmup();
+    ASSERT_TRUE(JitExec::InitJitWarmup());
+    JitExec::RecordJitWarmupQuery(MakeWarmupQuery(UT_MOT_WARMUP_SECOND_RELID), secondQuery, paramTypes, 1);
+    JitExec::RecordJitWarmupQuery(MakeWarmupQuery(UT_MOT_WARMUP_FIRST_RELID), firstQuery, paramTypes, 1);
+    JitExec::DestroyJitWarmup();
+    std::string restarted = ReadWarmupFile();
+    ASSERT_EQ(restarted.compare(0, content.size(), content), 0);
+    ASSERT_NE(restarted.find(firstQuery, content.size()), std::string::npos);
+    ASSERT_EQ(restarted.find(secondQuery, content.size()), std::string::npos);
+}
+
+/* holds the lock of a row sentinel for a while and releases it unchanged, as a committing transaction that aborts */
+static void HoldSentinelLock(MOT::Sentinel* sentinel, std::atomic<bool>* locked)
+{
+    sentinel->Lock(UT_MOT_LOCK_HOLDER_TID);
+    locked->store(true);
+    (void)usleep(UT_MOT_LOCK_HOLD_MICROS);
+    sentinel->Unlock();
+}
+
+/* deletes a row of a table, committing while another thread holds the row lock, returns the commit result */
+static MOT::RC DeleteRowBehindLock(
+    MOT::TxnManager* txn, MOT::Table* table, MOT::Row* scratch, uint64_t key, uint64_t txnId)
+{
+    MOT::MaxKey pk;
+    MOT::Index* index = table->GetPrimaryIndex();
+    scratch->SetValue<uint64_t>(1, key);
+    pk.InitKey(index->GetKeyLength());
+    index->BuildKey(table, scratch, &pk);
+    MOT::Sentinel* sentinel = index->IndexReadSentinel(&pk, MOTCurrThreadId);
+    if (sentinel == nullptr) {
+        return MOT::RC_ERROR;
+    }
+
+    MOT::RC rc = MOT::RC_OK;
+    txn->StartTransaction(txnId, MOT::READ_COMMITED);
+    if (txn->GcSessionStart(MOT::GetCSNManager().GetGcEpoch()) != MOT::RC_OK) {
+        txn->EndTransaction();
+        return MOT::RC_ERROR;
+    }
+    MOT::Row* row = txn->RowLookupByKey(table, MOT::AccessType::DEL, &pk, rc);
+    if (row == nullptr || rc != MOT::RC_OK || txn->DeleteLastRow() != MOT::RC_OK) {
+        txn->Rollback();
+        txn->EndTransaction();
+        return MOT::RC_ERROR;
+    }
+
+    std::atomic<bool> locked(false);
+    std::thread holder(HoldSentinelLock, sentinel, &locked);
+    while (!locked.load()) {
+        (void)usleep(100);
+    }
+    rc = txn->Commit();
+    holder.join();
+    if (rc != MOT::RC_OK) {
+        txn->Rollback();
+    }
+    txn->EndTransaction();
+    return rc;
+}
+
+/* TestCase07: commits on a contended table wait for a row lock that is released unchanged, instead of aborting */
+void ut_mot::TestCase07()
+{
+    ASSERT_TRUE(StartEngine("enable_adaptive_validation = true\n"));
+    MOT::Table* table = CreateTable("contention", false);
+    ASSERT_NE(table, nullptr);
+    ASSERT_TRUE(InsertRows(table, 2 * UT_MOT_CONTENTION_ROUNDS));
+    MOT::Row* scratch = table->CreateNewRow();
+    ASSERT_NE(scratch, nullptr);
+    scratch->SetValue<uint8_t>(0, 0);
+    MOT::TxnManager* txn = m_session->GetTxnManager();
+
+    // the no-wait validation gives up long before the lock is released
+    uint32_t aborts = 0;
+    for (uint64_t key = 0; key < UT_MOT_CONTENTION_ROUNDS; key++) {
+        MOT::RC rc = DeleteRowBehindLock(txn, table, scratch, key, key + 1);
+        ASSERT_TRUE(rc == MOT::RC_OK || rc == MOT::RC_ABORT);
+        aborts += (rc == MOT::RC_ABORT) ? 1 : 0;
+    }
+    ASSERT_EQ(aborts, (uint32_t)UT_MOT_CONTENTION_ROUNDS);
+
+    // once the table is contended the commits wait for the lock, and the unchanged rows pass the validation
+    for (uint32_t i = 0; i < UT_MOT_CONTENTION_SAMPLES && !table->IsContended(); i++) {
+        table->RecordValidation(true);
+    }
+    ASSERT_TRUE(table->IsContended());
+    aborts = 0;
+    for (uint64_t key = UT_MOT_CONTENTION_ROUNDS; key < 2 * UT_MOT_CONTENTION_ROUNDS; key++) {
+        MOT::RC rc = DeleteRowBehindLock(txn, table, scratch, key, key + 1);
+        ASSERT_TRUE(rc == MOT::RC_OK || rc == MOT::RC_ABORT);
+        aborts += (rc == MOT::RC_ABORT) ? 1 : 0;
+    }
+    ASSERT_EQ(aborts, 0U);
+    table->DestroyRow(scratch);
+
+    uint64_t count = 0;
+    (void)SumKeys(table, count);
+    ASSERT_EQ(count, (uint64_t)UT_MOT_CONTENTION_ROUNDS);
+}
+
+/* fills a buffer with pseudo-random bytes, which LZ4 cannot compress */
+static void FillRandom(char* data, size_t len)
+{
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (size_t i = 0; i < len; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        data[i] = (char)(state & 0xff);
+    }
+}
+
+/* reads the header of a compressed block at the current position of a data file, and skips its data */
+static bool SkipCompressedBlock(int fd, MOT::CheckpointUtils::CompressedBlockHeader& header)
+{
+    if (MOT::CheckpointUtils::ReadFile(fd, (char*)&header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+    return (lseek(fd, (off_t)header.m_compressedLen, SEEK_CUR) != (off_t)-1);
+}
+
+/* TestCase08: a multi-segment tree-indexed table is checkpointed compressed by all workers and recovered */
+void ut_mot::TestCase08()
+{
+    const char* confLines = "enable_checkpoint = true\n"
+                            "enable_checkpoint_compression = true\n"
+                            "checkpoint_workers = 4\n";
+    ASSERT_TRUE(StartEngine(confLines));
+
+    // a compressible and an incompressible block, read back in chunks that cross the block boundary
+    static char blocks[2 * UT_MOT_BLOCK_SIZE];
+    static char readBack[2 * UT_MOT_BLOCK_SIZE];
+    errno_t erc = memset_s(blocks, UT_MOT_BLOCK_SIZE, 'a', UT_MOT_BLOCK_SIZE);
+    securec_check(erc, "\0", "\0");
+    FillRandom(blocks + UT_MOT_BLOCK_SIZE, UT_MOT_BLOCK_SIZE);
+    std::string blockFile = std::string(m_dir) + "/blocks";
+    char* compressBuf = new (std::nothrow) char[MOT::CheckpointUtils::CompressBound(UT_MOT_BLOCK_SIZE)];
+    ASSERT_NE(compressBuf, nullptr);
+    int fd = -1;
+    ASSERT_TRUE(MOT::CheckpointUtils::OpenFileWrite(blockFile, fd));
+    bool written = MOT::CheckpointUtils::WriteCompressedBlock(fd, blocks, UT_MOT_BLOCK_SIZE, compressBuf) &&
+                   MOT::CheckpointUtils::WriteCompressedBlock(
+                       fd, blocks + UT_MOT_BLOCK_SIZE, UT_MOT_BLOCK_SIZE, compressBuf);
+    delete[] compressBuf;
+    ASSERT_EQ(MOT::CheckpointUtils::CloseFile(fd), 0);
+    ASSERT_TRUE(written);
+
+    ASSERT_TRUE(MOT::CheckpointUtils::OpenFileRead(blockFile, fd));
+    MOT::CheckpointUtils::CompressedBlockHeader first;
+    MOT::CheckpointUtils::CompressedBlockHeader second;
+    bool skipped = SkipCompressedBlock(fd, first) && SkipCompressedBlock(fd, second);
+    (void)MOT::CheckpointUtils::CloseFile(fd);
+    ASSERT_TRUE(skipped);
+    ASSERT_LT(first.m_compressedLen, first.m_rawLen);
+    ASSERT_EQ(second.m_compressedLen, second.m_rawLen);
+
+    ASSERT_TRUE(MOT::CheckpointUtils::OpenFileRead(blockFile, fd));
+    size_t bytesRead = 0;
+    {
+        MOT::CheckpointUtils::DataFileReader reader;
+        ASSERT_TRUE(reader.Attach(fd, true));
+        const size_t chunk = UT_MOT_BLOCK_SIZE / 3;
+        size_t len = 0;
+        while ((len = reader.Read(readBack + bytesRead, std::min(chunk, sizeof(readBack) - bytesRead))) > 0) {
+            bytesRead += len;
+        }
+    }
+    (void)MOT::CheckpointUtils::CloseFile(fd);
+    ASSERT_EQ(bytesRead, sizeof(blocks));
+    ASSERT_EQ(memcmp(readBack, blocks, sizeof(blocks)), 0);
+
+    // a table larger than a segment, scanned in ranges by the workers that join it
+    MOT::Table* table = CreateTable("compressed", false);
+    ASSERT_NE(table, nullptr);
+    uint32_t tableId = table->GetTableId();
+    ASSERT_TRUE(InsertRows(table, UT_MOT_SEGMENT_ROW_COUNT));
+    ASSERT_TRUE(RunCheckpoint(1));
+
+    // segment ids are handed out once each, so the segments are numbered without gaps and hold every row once
+    std::string workingDir;
+    ASSERT_TRUE(MOT::CheckpointUtils::SetWorkingDir(workingDir, MOT::GetCheckpointManager()->GetId()));
+    uint32_t numSegments = 0;
+    uint64_t numOps = 0;
+    std::string fileName;
+    MOT::CheckpointUtils::MakeCpFilename(tableId, fileName, workingDir, 0);
+    while (access(fileName.c_str(), F_OK) == 0) {
+        MOT::CheckpointUtils::FileHeader header;
+        ASSERT_TRUE(MOT::CheckpointUtils::OpenFileRead(fileName, fd));
+        size_t headerLen = MOT::CheckpointUtils::ReadFile(fd, (char*)&header, sizeof(header));
+        (void)MOT::CheckpointUtils::CloseFile(fd);
+        ASSERT_EQ(headerLen, sizeof(header));
+        ASSERT_EQ(header.m_magic, MOT::CheckpointUtils::COMPRESSED_HEADER_MAGIC);
+        ASSERT_EQ(header.m_tableId, (uint64_t)tableId);
+        numOps += header.m_numOps;
+        numSegments++;
+        MOT::CheckpointUtils::MakeCpFilename(tableId, fileName, workingDir, (int)numSegments);
+    }
+    ASSERT_GT(numSegments, 1U);
+    ASSERT_EQ(numOps, (uint64_t)UT_MOT_SEGMENT_ROW_COUNT);
+
+    // restart the engine and recover the compressed segments
+    MOT::GetSessionManager()->DestroySessionContext(m_session);
+    m_session = nullptr;
+    MOT::MOTEngine::DestroyInstance();
+    delete m_scopedSession;
+    m_scopedSession = new MOT::ScopedSessionManager();
+    ASSERT_TRUE(StartEngine(confLines, false));
+    ASSERT_TRUE(MOT::MOTEngine::GetInstance()->StartRecovery());
+    ASSERT_TRUE(MOT::MOTEngine::GetInstance()->EndRecovery());
+    m_session = MOT::GetSessionManager()->CreateSessionContext();
+    ASSERT_NE(m_session, nullptr);
+
+    table = MOT::GetTableManager()->GetTable("ut_mot_compressed");
+    ASSERT_NE(table, nullptr);
+    uint64_t count = 0;
+    ASSERT_EQ(SumKeys(table, count), (uint64_t)UT_MOT_SEGMENT_ROW_COUNT * (UT_MOT_SEGMENT_ROW_COUNT - 1) / 2);
+    ASSERT_EQ(count, (uint64_t)UT_MOT_SEGMENT_ROW_COUNT);
+}
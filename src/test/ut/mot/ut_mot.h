@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_mot.h
+ *        Unit tests of the MOT engine background tasks and indexes.
+ *
+ * IDENTIFICATION
+ *        src/test/ut/mot/ut_mot.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef UT_MOT_H
+#define UT_MOT_H
+
+#include "gunit_test.h"
+#include "mockcpp/mockcpp.hpp"
+
+namespace MOT {
+class Table;
+class SessionContext;
+class ScopedSessionManager;
+}  // namespace MOT
+
+class ut_mot : public testing::Test {
+    GUNIT_TEST_SUITE(ut_mot);
+
+public:
+    virtual void SetUp();
+
+    virtual void TearDown();
+
+public:
+    /* cold row eviction pass */
+    void TestCase01();
+    /* GC reclamation pass over idle sessions */
+    void TestCase02();
+    /* partitioned redo replay interleaved with the commit queue */
+    void TestCase03();
+    /* hash and tree index scans re-positioned between GC epochs, and point lookups of every key */
+    void TestCase04();
+    /* delta checkpoint of inserts and deletes recovered on top of the full image */
+    void TestCase05();
+    /* JIT warm-up records buffered in memory and written to the warm-up file on flush */
+    void TestCase06();
+    /* commits on a contended table waiting for a row lock released unchanged */
+    void TestCase07();
+    /* compressed checkpoint of a multi-segment table written by several workers, and its recovery */
+    void TestCase08();
+
+    /* starts the engine with the common test configuration followed by the given mot.conf lines */
+    static bool StartEngine(const char* confLines, bool createSession = true);
+
+    /* creates a table with a single unique 8-byte key column */
+    static MOT::Table* CreateTable(const char* name, bool hashIndex);
+
+    /* inserts rows with keys [first, first + count) committed at the current CSN */
+    static bool InsertRows(MOT::Table* table, uint64_t count, uint64_t first = 0);
+
+    /* counts the rows of a table that are evicted to its cold row store */
+    static uint64_t CountEvicted(MOT::Table* table);
+
+    /* sums the keys of all live rows of a table, faulting evicted rows back in */
+    static uint64_t SumKeys(MOT::Table* table, uint64_t& count);
+
+    /* waits until a condition holds or the timeout expires */
+    static bool WaitFor(bool (*cond)(void*), void* arg, uint32_t timeoutSeconds);
+
+    /* test directory holding mot.conf, the checkpoint and the cold row stores */
+    static char m_dir[];
+
+    /* session members of the test thread, which is not a kernel thread */
+    static MOT::ScopedSessionManager* m_scopedSession;
+
+    /* session context of the test thread */
+    static MOT::SessionContext* m_session;
+};
+
+#endif